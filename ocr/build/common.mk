@@ -26,7 +26,11 @@ DEFAULT_CONFIG ?= jenkins-common-8w-lockableDB.cfg
 # **** Workpiles Parameters ****
 
 # Impl-specific for Work-stealing deques
-# - Static size for deques used to contain EDTs
+# - Initial size for deques used to contain EDTs (grows on demand, power of two)
+# CFLAGS += -DINIT_WST_DEQUE_CAPACITY=256
+
+# Impl-specific for other deques
+# - Static size for non work-stealing deques
 # CFLAGS += -DINIT_DEQUE_CAPACITY=2048
 
 # **** Registration Parameters ****
@@ -48,6 +52,31 @@ DEFAULT_CONFIG ?= jenkins-common-8w-lockableDB.cfg
 # [Experimental flag] Make all Channel Events non-FIFO
 # CFLAGS += -DXP_CHANNEL_EVT_NONFIFO
 
+# **** Policy-Domain Parameters ****
+
+# Impl-specific for the HC policy domain
+# - Per worker caches of runtime objects of up to 1KB in front of
+#   pdMalloc/pdFree. Objects are recycled by the worker that allocated them;
+#   frees from other workers are handed back in batches. Sizes are tunable
+#   with PD_MALLOC_CACHE_DEPTH (objects per size class, default 64) and
+#   PD_MALLOC_CACHE_BATCH (default 16)
+CFLAGS += -DPD_MALLOC_CACHE
+
+# - Print per worker hit rate, remote frees and cached bytes at shutdown
+# CFLAGS += -DPD_MALLOC_CACHE_STATS
+
+# - Data-blocks are placed on the NUMA node of the creating worker (or per the
+#   OCR_HINT_DB_NEAR/FAR/HIGHBW hints) when the allocators are on several
+#   nodes, as given by 'numa_node' and 'highbw' in the mem-platform instances.
+#   Print per node placement counts and fallbacks at shutdown
+# CFLAGS += -DHC_DB_PLACEMENT_STATS
+
+# - Data-blocks of up to HC_DB_COALLOC_MAX_SIZE bytes (default 4096) share a
+#   single allocation with their metadata (one allocation and one free per
+#   data-block instead of two). Labeled data-blocks are always split, as are
+#   all data-blocks with the PTR GUID provider, which allocates per GUID anyway
+CFLAGS += -DHC_DB_COALLOC
+
 # **** GUID-Provider Parameters ****
 
 # All impl-specific for counted-map and labeled-guid providers
@@ -59,9 +88,16 @@ CFLAGS += -DGUID_PROVIDER_LOCID_SIZE=10
 #   number of workers supported per PD
 # CFLAGS += -DGUID_PROVIDER_WID_INGUID += -DGUID_WID_SIZE=4
 
+# - Per worker GUID counter blocks: workers lease ranges of
+#   GUID_PROVIDER_COUNTER_BLOCK_SIZE (default 4096) values from the shared
+#   counter. Incompatible with GUID_PROVIDER_WID_INGUID
+# CFLAGS += -DGUID_PROVIDER_COUNTER_BLOCK -DGUID_PROVIDER_COUNTER_BLOCK_SIZE=4096
+
 # - Activate a different hashmap implementation
 #   Warning: Necessitates an additional -D activating the alternate implementation
-# CFLAGS += -DGUID_PROVIDER_CUSTOM_MAP -D_TODO_FILL_ME_IN
+#   GUID_PROVIDER_SHARDED_MAP: sharded open-addressing map with lock-free lookups
+#   that grows online (HASHTABLE_SHARDS_PER_WORKER shards per worker, default 4)
+CFLAGS += -DGUID_PROVIDER_CUSTOM_MAP -DGUID_PROVIDER_SHARDED_MAP
 
 # **** EDTs parameters ****
 
@@ -99,6 +135,36 @@ CFLAGS += -DGUID_PROVIDER_LOCID_SIZE=10
 # Bypass runtime allocators in favor of standard malloc
 # CFLAGS += -DNANNYMODE_SYSALLOC
 
+# Spinlocks
+# x86 only
+#
+# Runtime locks spin on a plain read and back off exponentially
+# (up to HAL_LOCK_BACKOFF_MAX pause instructions, default 1024)
+# when they fail to grab the lock. Revert to a bare test-and-set loop with
+# CFLAGS += -DHAL_LOCK_TAS
+#
+# Hot locks that are only ever taken and released in the same scope
+# (event waiter lists, GUID map shards) are queued locks. They are
+# test-and-test-and-set locks unless one of the following is defined:
+# - FIFO ticket lock
+# CFLAGS += -DHAL_QLOCK_TICKET
+# - MCS lock, each waiter spins on its own stack node
+# CFLAGS += -DHAL_QLOCK_MCS
+#
+# Count acquisitions, contended acquisitions and spins per lock call site
+# and print the contended sites at exit
+# CFLAGS += -DHAL_LOCK_STATS
+
+# Datablock copies
+#
+# ocrDbCopy splits copies into chunks of DB_COPY_CHUNK_SIZE bytes
+# (default 1MB) executed by as many workers as possible
+# CFLAGS += -DDB_COPY_CHUNK_SIZE=1048576
+#
+# x86 only: background copies of at least HAL_MEMCOPY_STREAM_MIN bytes
+# (default 256KB) bypass the cache with non-temporal stores
+# CFLAGS += -DHAL_MEMCOPY_STREAM_MIN=262144
+
 # Declare flags for AddressSanitizer
 # Warning: Applications must use the same flags else it will crash.
 ifeq (${OCR_ASAN}, yes)
@@ -107,6 +173,11 @@ ifeq (${OCR_ASAN}, yes)
   LDFLAGS += $(ASAN_FLAGS) $(LDFLAGS)
 endif
 
+# Startup timings
+# Prints the time spent in each phase of the runtime's bring-up
+# and tear-down (Linux only)
+# CFLAGS += -DOCR_STARTUP_TIMINGS
+
 # Runtime overhead profiler
 # x86 only
 #
@@ -169,6 +240,10 @@ endif
 # (Primarily for LLNL tools inter-operability)
 # CFLAGS += -DOCR_TRACE_BINARY
 
+# Size in bytes (power of 2) of the per-worker trace buffers. Records that
+# do not fit are dropped and counted (default 1MB)
+# CFLAGS += -DTRACE_BUFFER_SIZE=1048576
+
 # Enable monitoring/logging of message traffic between policy domains
 # Requires Tracing (-DOCR_TRACE_BINARY)
 # CFLAGS += -DOCR_MONITOR_NETWORK -DOCR_TRACE_BINARY
@@ -177,6 +252,11 @@ endif
 # Requires OCR_TRACE_BINARY
 # CFLAGS += -DOCR_MONITOR_SCHEDULER -DOCR_TRACE_BINARY
 
+# Per datablock contention statistics for the lockable datablock
+# (wait time percentiles, queue depth, waiters overtaken). Printed
+# when a datablock that had waiters is destroyed
+# CFLAGS += -DOCR_MONITOR_DB_CONTENTION
+
 ####################################################
 # Experimental flags
 ####################################################
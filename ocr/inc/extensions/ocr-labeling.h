@@ -76,6 +76,34 @@ u8 ocrGuidMapCreate(ocrGuid_t *mapGuid, u32 numParams, ocrGuid_t (*mapFunc)(
  */
 u8 ocrGuidRangeCreate(ocrGuid_t *rangeGuid, u64 numberGuid, ocrGuidUserKind kind);
 
+/**
+ * @brief Distribution of the GUIDs of a range over the policy domains
+ */
+typedef enum {
+    GUID_DIST_BLOCK = 0,  /**< Policy domain 'p' owns the p-th block of numberGuid/#PDs
+                               (rounded up) consecutive indices */
+    GUID_DIST_CYCLIC = 1  /**< Index 'idx' is owned by policy domain idx % #PDs */
+} ocrGuidDistKind;
+
+/**
+ * @brief Creates a range of GUIDs distributed over the policy domains
+ *
+ * This function is similar to ocrGuidRangeCreate() except that the GUIDs of the
+ * range are not all owned by the calling policy domain. The owner of an index
+ * is determined by 'distribution' and is encoded in the GUID returned by
+ * ocrGuidFromIndex(): the creation of the object is carried out by its owner
+ * whichever policy domain requests it. ocrAffinityQuery() on the GUID returns
+ * the affinity of the owner.
+ *
+ * @param[out] rangeGuid         Returns the GUID of this range
+ * @param[in] numberGuid         Total number of GUIDs to reserve
+ * @param[in] kind               Kind of the GUIDs stored in this range
+ * @param[in] distribution       How indices are distributed over the policy domains
+ * @return 0 on success or a non-zero error code
+ */
+u8 ocrGuidRangeCreateDistributed(ocrGuid_t *rangeGuid, u64 numberGuid, ocrGuidUserKind kind,
+                                 ocrGuidDistKind distribution);
+
 /**
  * @brief Destroys a map function
  *
@@ -133,6 +161,23 @@ u8 ocrGuidMapSetDefaultMap(u32 numParams, ocrGuid_t (*mapFunc)(
  */
 u8 ocrGuidFromLabel(ocrGuid_t *outGuid, ocrGuid_t mapGuid, s64* tuple);
 
+/**
+ * @brief Convert several user "labels" (tuples) to GUIDs
+ *
+ * This function is equivalent to calling ocrGuidFromLabel() for each tuple
+ * but only looks up the map once.
+ *
+ * @param[out] outGuids  Array of 'count' GUIDs, one per tuple
+ * @param[in] mapGuid    GUID for the map function to use (created by
+ *                       ocrGuidMapCreate())
+ * @param[in] tuples     Tuples to convert, stored one after the other
+ * @param[in] tupleSize  Number of values in each tuple
+ * @param[in] count      Number of tuples to convert
+ * @return 0 on success or a non-zero error code:
+ *     - OCR_EINVAL if mapGuid does not refer to a valid map
+ */
+u8 ocrGuidFromLabels(ocrGuid_t *outGuids, ocrGuid_t mapGuid, s64* tuples, u32 tupleSize, u64 count);
+
 /**
  * @brief Convert a user index to a GUID
  *
@@ -147,6 +192,23 @@ u8 ocrGuidFromLabel(ocrGuid_t *outGuid, ocrGuid_t mapGuid, s64* tuple);
  */
 u8 ocrGuidFromIndex(ocrGuid_t *outGuid, ocrGuid_t rangeGuid, u64 idx);
 
+/**
+ * @brief Convert consecutive user indices to GUIDs
+ *
+ * This function is equivalent to calling ocrGuidFromIndex() for each index
+ * in [startIdx, startIdx+count) but only looks up the range once.
+ *
+ * @param[out] outGuids  Array of 'count' GUIDs; outGuids[i] is the GUID of
+ *                       index startIdx+i
+ * @param[in] rangeGuid  GUID of the range to use (created by ocrGuidRangeCreate())
+ * @param[in] startIdx   First index to convert
+ * @param[in] count      Number of indices to convert
+ * @return 0 on success or a non-zero error code:
+ *     - OCR_EINVAL if rangeGuid does not refer to a valid range or if
+ *       the indices do not all belong to the range
+ */
+u8 ocrGuidFromIndices(ocrGuid_t *outGuids, ocrGuid_t rangeGuid, u64 startIdx, u64 count);
+
 /**
  * @brief Determines the type of a GUID and whether or not it is valid
  *
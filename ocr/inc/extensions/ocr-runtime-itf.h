@@ -91,6 +91,24 @@ u64 ocrNbWorkers();
  **/
 ocrGuid_t ocrCurrentWorkerGuid();
 
+/**
+ * @brief Get the data-block placement statistics of a memory node
+ * of the current policy domain
+ *
+ * @note Exposed as a convenience to runtime implementors,
+ * may be deprecated anytime.
+ *
+ * @param[in] node        Index of the node (0 to number of nodes - 1)
+ * @param[out] nodeId     NUMA node number of that node
+ * @param[out] count      Number of data-blocks placed on that node
+ * @param[out] fallbacks  Number of those placed there because the
+ *                        preferred memory was full
+ * @return 0 on success, OCR_EINVAL if 'node' is out of range or
+ * OCR_ENOTSUP if data-block placement is off or its statistics are
+ * not built in (HC_DB_PLACEMENT_STATS)
+ **/
+u8 ocrDbPlacementStats(u32 node, u64 * nodeId, u64 * count, u64 * fallbacks);
+
 /**
  * @brief Inform the OCR runtime that the currently
  * executing thread is logically blocked
@@ -72,7 +72,8 @@ extern "C" {
  *
  * @note The default allocator (NO_ALLOC) will disallow calls to ocrDbMalloc and ocrDbFree.
  * If an allocator is used, part of the data block's space will be taken up by the
- * allocator's management overhead
+ * allocator's management overhead. The allocator is set up through the address
+ * returned so it cannot be combined with DB_PROP_NO_ACQUIRE or a labeled GUID (EINVAL)
  *
  **/
 u8 ocrDbCreate(ocrGuid_t *db, void** addr, u64 len, u16 flags, ocrHint_t *hint,
@@ -142,12 +143,13 @@ u8 ocrDbRelease(ocrGuid_t db);
  *      - 0: successful
  *      - ENOMEM: Not enough space to allocate
  *      - EINVAL: Data block does not support allocation
+ *      - EACCES: The calling EDT does not hold the data block in RW or EW mode
  *
  * @warning The address returned is valid *only* for the current
  * acquire of the data block (ie: it is an absolute address).
  * Use ocrDbMallocOffset() to get a more stable 'pointer'
  *
- * @note This call is not supported at this time.
+ * @note Concurrent calls on a data block shared in RW mode are safe
  */
 u8 ocrDbMalloc(ocrGuid_t guid, u64 size, void** addr);
 
@@ -168,8 +170,7 @@ u8 ocrDbMalloc(ocrGuid_t guid, u64 size, void** addr);
  *      - 0: successful
  *      - ENOMEM: Not enough space to allocate
  *      - EINVAL: Data block does not support allocation
- *
- * @note This call is not supported at this time.
+ *      - EACCES: The calling EDT does not hold the data block in RW or EW mode
  */
 u8 ocrDbMallocOffset(ocrGuid_t guid, u64 size, u64* offset);
 
@@ -183,13 +184,12 @@ u8 ocrDbMallocOffset(ocrGuid_t guid, u64 size, u64* offset);
  *      - 0: successful
  *      - EINVAL: Data block does not support allocation or addr
  *                is invalid
+ *      - EACCES: The calling EDT does not hold the data block in RW or EW mode
  *
  * @warning The address 'addr' must have been
  * allocated before the release of the containing data block. Use
  * ocrDbFreeOffset if allocating and freeing across EDTs for
  * example
- *
- * @note This call is not supported at this time.
  */
 u8 ocrDbFree(ocrGuid_t guid, void* addr);
 
@@ -204,8 +204,7 @@ u8 ocrDbFree(ocrGuid_t guid, void* addr);
  *      - 0: successful
  *      - EINVAL: Data block does not support allocation or
  *                offset is invalid
- *
- * @note This call is not supported at this time.
+ *      - EACCES: The calling EDT does not hold the data block in RW or EW mode
  */
 u8 ocrDbFreeOffset(ocrGuid_t guid, u64 offset);
 
@@ -235,7 +234,7 @@ u8 ocrDbFreeOffset(ocrGuid_t guid, u64 offset);
  * @param[in] size              Number of bytes to copy
  * @param[in] copyType          Reserved
  * @param[out] completionEvt    GUID of the event that will be satisfied when the
- *                              copy is successful
+ *                              copy is successful. May be NULL if not needed
  *
  * @return a status code
  *      - 0: successful (note that this does not mean that the copy was done)
@@ -243,7 +242,8 @@ u8 ocrDbFreeOffset(ocrGuid_t guid, u64 offset);
  *      - EPERM: Overlapping data blocks
  *      - ENOMEM: Destination too small to copy into or source too small to copy from
  *
- * @note This call is not supported at this time.
+ * @note Sizes are only checked for data blocks local to the calling policy
+ * domain. Large copies are split across several EDTs.
  */
 u8 ocrDbCopy(ocrGuid_t destination, u64 destinationOffset, ocrGuid_t source,
              u64 sourceOffset, u64 size, u64 copyType, ocrGuid_t * completionEvt);
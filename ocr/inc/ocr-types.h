@@ -121,7 +121,10 @@ typedef u8 bool;
  * allocators.
  */
 typedef enum {
-    NO_ALLOC = 0 /**< No allocation is possible with the data block */
+    NO_ALLOC = 0,   /**< No allocation is possible with the data block */
+    ARENA_ALLOC = 1 /**< Segregated fit allocator keeping its state at the
+                     *   start of the data block. Chunks are only referred to
+                     *   by offsets so they survive moves of the data block */
 } ocrInDbAllocator_t;
 
 /**
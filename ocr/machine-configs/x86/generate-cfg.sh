@@ -10,4 +10,5 @@ $CFG_SCRIPT --threads 8 --dbtype Regular --output mach-hc-8w.cfg --remove-destin
 $CFG_SCRIPT --threads 8 --dbtype Regular --binding spread --output mach-hc-8w-binding.cfg --remove-destination
 $CFG_SCRIPT --threads 16 --dbtype Regular --output mach-hc-16w.cfg --remove-destination
 $CFG_SCRIPT --threads 8 --scheduler STATIC --output static-8w-lockableDB.cfg --remove-destination
+$CFG_SCRIPT --threads 8 --alloctype quick --alloc 64 --numanodes 2 --highbw 1 --output jenkins-numa-2n-highbw-lockableDB.cfg --remove-destination
 unset CFG_SCRIPT
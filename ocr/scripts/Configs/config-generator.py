@@ -28,10 +28,22 @@ parser.add_argument('--alloc', dest='alloc', default='32',
                    help='size (in MB) of memory available for app use (default: 32)')
 parser.add_argument('--alloctype', dest='alloctype', default='mallocproxy', choices=['quick', 'mallocproxy', 'tlsf', 'simple'],
                    help='type of allocator to use (default: mallocproxy)')
+parser.add_argument('--hugepages', dest='hugepages', default='none', choices=['none', 'transparent', 'explicit'],
+                   help='pages backing the allocator pool (default: none)')
+parser.add_argument('--numanodes', dest='numanodes', type=int, default=1,
+                   help='number of NUMA nodes, each with its own allocator of --alloc MB (default: 1)')
+parser.add_argument('--highbw', dest='highbw', type=int, default=0,
+                   help='size (in MB) of an additional high-bandwidth allocator on node 0 (default: 0, none)')
 parser.add_argument('--dbtype', dest='dbtype', default='Lockable', choices=['Lockable', 'Regular'],
                    help='type of datablocks to use (default: Lockable)')
 parser.add_argument('--scheduler', dest='scheduler', default='HC', choices=['HC', 'PRIORITY', 'PLACEMENT_AFFINITY', 'LEGACY', 'ST', 'STATIC'],
                    help='scheduler heuristic (default: HC)')
+parser.add_argument('--stealvictim', dest='stealvictim', default='ROUND_ROBIN', choices=['ROUND_ROBIN', 'RANDOM', 'LOCALITY'],
+                   help='victim selection of the HC scheduler heuristic (default: ROUND_ROBIN)')
+parser.add_argument('--stealbatch', dest='stealbatch', default='ONE', choices=['ONE', 'HALF'],
+                   help='number of EDTs taken per steal by the HC scheduler heuristic (default: ONE)')
+parser.add_argument('--workerspersocket', dest='workerspersocket', type=int, default=0,
+                   help='workers per socket for LOCALITY victim selection when the OS topology of the bound workers is unknown (default: 0, single socket)')
 parser.add_argument('--dequetype', dest='dequetype', default='WORK_STEALING_DEQUE', choices=['WORK_STEALING_DEQUE', 'LOCKED_DEQUE'],
                    help='deque type to use with LEGACY scheduler (default: WORK_STEALING_DEQUE)')
 parser.add_argument('--output', dest='output', default='default.cfg',
@@ -50,8 +62,14 @@ threads = args.threads
 binding = args.binding
 alloc = args.alloc
 alloctype = args.alloctype
+hugepages = args.hugepages
+numanodes = args.numanodes
+highbw = args.highbw
 dbtype = args.dbtype
 scheduler = args.scheduler
+stealvictim = args.stealvictim
+stealbatch = args.stealbatch
+workerspersocket = args.workerspersocket
 dequetype = args.dequetype
 outputfilename = args.output
 rmdest = args.rmdest
@@ -77,7 +95,11 @@ def GeneratePd(output, pdtype, dbtype, threads):
     output.write("\ttype\t\t\t=\t%s\n" % (pdtype))
     output.write("\tworker\t\t\t=\t0-%d\n" % (threads-1))
     output.write("\tscheduler\t\t=\t0\n")
-    output.write("\tallocator\t\t=\t0\n")
+    allocators = numanodes + (1 if highbw != 0 else 0)
+    if allocators > 1:
+        output.write("\tallocator\t\t=\t0-%d\n" % (allocators-1))
+    else:
+        output.write("\tallocator\t\t=\t0\n")
     if pdtype == 'HCDist':
         output.write("\tcommapi\t\t\t=\t0-%d\n" % (threads-1))
     else:
@@ -99,25 +121,38 @@ def GenerateCommon(output, pdtype, dbtype):
     output.write("\n#======================================================\n")
 
 def GenerateMem(output, size, count, alloctype):
+    # One pool per NUMA node, then the high-bandwidth one if any
+    pools = [(size, node, False) for node in range(count)]
+    if highbw != 0:
+        pools.append((highbw*1048576, 0, True))
     output.write("[MemPlatformType0]\n\tname\t=\t%s\n" % ("malloc"))
-    output.write("[MemPlatformInst0]\n")
-    output.write("\tid\t=\t0\n")
-    output.write("\ttype\t=\t%s\n" % ("malloc"))
-    output.write("\tsize\t=\t%d\n" % (int(size*1.05)))
+    for i, (poolsize, node, fast) in enumerate(pools):
+        output.write("[MemPlatformInst%d]\n" % (i))
+        output.write("\tid\t=\t%d\n" % (i))
+        output.write("\ttype\t=\t%s\n" % ("malloc"))
+        output.write("\tsize\t=\t%d\n" % (int(poolsize*1.05)))
+        if hugepages != 'none':
+            output.write("\thugepages\t=\t%s\n" % (hugepages))
+        if len(pools) > 1:
+            output.write("\tnuma_node\t=\t%d\n" % (node))
+        if fast:
+            output.write("\thighbw\t=\t1\n")
     output.write("\n#======================================================\n")
     output.write("[MemTargetType0]\n\tname\t=\t%s\n" % ("shared"))
-    output.write("[MemTargetInst0]\n")
-    output.write("\tid\t=\t0\n")
-    output.write("\ttype\t=\t%s\n" % ("shared"))
-    output.write("\tsize\t=\t%d\n" % (int(size*1.05)))
-    output.write("\tmemplatform\t=\t0\n")
+    for i, (poolsize, node, fast) in enumerate(pools):
+        output.write("[MemTargetInst%d]\n" % (i))
+        output.write("\tid\t=\t%d\n" % (i))
+        output.write("\ttype\t=\t%s\n" % ("shared"))
+        output.write("\tsize\t=\t%d\n" % (int(poolsize*1.05)))
+        output.write("\tmemplatform\t=\t%d\n" % (i))
     output.write("\n#======================================================\n")
     output.write("[AllocatorType0]\n\tname\t=\t%s\n" % (alloctype))
-    output.write("[AllocatorInst0]\n")
-    output.write("\tid\t=\t0\n")
-    output.write("\ttype\t=\t%s\n" % (alloctype))
-    output.write("\tsize\t=\t%d\n" % (size))
-    output.write("\tmemtarget\t=\t0\n")
+    for i, (poolsize, node, fast) in enumerate(pools):
+        output.write("[AllocatorInst%d]\n" % (i))
+        output.write("\tid\t=\t%d\n" % (i))
+        output.write("\ttype\t=\t%s\n" % (alloctype))
+        output.write("\tsize\t=\t%d\n" % (poolsize))
+        output.write("\tmemtarget\t=\t%d\n" % (i))
     output.write("\n#======================================================\n")
 
 def GenerateComm(output, comms, pdtype, threads):
@@ -341,6 +376,13 @@ def GenerateComp(output, pdtype, threads, binding, sysworker, schedtype):
             output.write("[SchedulerHeuristicInst0]\n")
             output.write("\tid\t\t=\t0\n")
             output.write("\ttype\t=\t%s\n" % (scheduler))
+            if scheduler == 'HC':
+                if stealvictim != 'ROUND_ROBIN':
+                    output.write("\tstealvictim\t=\t%s\n" % (stealvictim))
+                if stealbatch != 'ONE':
+                    output.write("\tstealbatch\t=\t%s\n" % (stealbatch))
+                if workerspersocket != 0:
+                    output.write("\tworkerspersocket\t=\t%d\n" % (workerspersocket))
         output.write("\n#======================================================\n")
         output.write("[SchedulerType0]\n\tname\t=\t%s\n" % (schedtype))
         output.write("[SchedulerInst0]\n")
@@ -369,7 +411,7 @@ def GenerateConfig(filehandle, guid, platform, target, threads, binding, syswork
     if target=='X86':
         GeneratePd(filehandle, "HC", dbtype, threads)
         GenerateCommon(filehandle, "HC", dbtype)
-        GenerateMem(filehandle, alloc, 1, alloctype)
+        GenerateMem(filehandle, alloc, numanodes, alloctype)
         GenerateComm(filehandle, "null", "HC", threads)
         GenerateComp(filehandle, "HC", threads, binding, sysworker, "COMMON")
     elif (target=='FSIM'):
@@ -13,6 +13,7 @@
 #define BIN_PATH_LENGTH 128
 
 void translateObject(ocrTraceObj_t *trace, int lineCount, long *fctPtrs);
+int decodeTraceFile(FILE *f, ocrTraceObj_t *trace, int lineCount, long *fctPtrs);
 int getLineCount(FILE *fname);
 void readFctPtrsFromBinary(char *binaryPath, int lineCount, long *fctPtrs);
 bool fctPtrExists(long lookup, int lineCount, long *fctPtrs);
@@ -82,14 +83,86 @@ int main(int argc, char *argv[]){
             return 1;
         }
 
-        while(fread(trace, sizeof(ocrTraceObj_t), 1, f)){
-            translateObject(trace, lineCount, fctPtrs);
+        if(decodeTraceFile(f, trace, lineCount, fctPtrs)){
+            printf("Error:  %s is not a trace binary of this version of OCR\n", argv[i]);
+            fclose(f);
+            return 1;
         }
         fclose(f);
     }
     return 0;
 }
 
+//Decode a word encoded as a mask of its non-zero bytes followed by these bytes
+static u64 decodeWord(unsigned char **cursor){
+    unsigned char mask = *(*cursor)++;
+    u64 word = 0;
+    int i;
+    for(i = 0; i < 8; i++){
+        if(mask & (1 << i)){
+            word |= ((u64) *(*cursor)++) << (i * 8);
+        }
+    }
+    return word;
+}
+
+//Decode the chunks of a trace file (see tracer.h), translating each record
+int decodeTraceFile(FILE *f, ocrTraceObj_t *trace, int lineCount, long *fctPtrs){
+    traceFileHeader_t header;
+    if((fread(&header, sizeof(header), 1, f) != 1) ||
+       (memcmp(header.magic, TRACE_FILE_MAGIC, sizeof(header.magic)) != 0) ||
+       (header.version != TRACE_FILE_VERSION) || (header.guidWords != (sizeof(ocrGuid_t) / sizeof(u64)))){
+        return 1;
+    }
+
+    //Timestamps are encoded relatively to the previous record of the worker
+    u64 *lastTime = NULL;
+    u64 workerCount = 0;
+    traceChunkHeader_t chunk;
+    while(fread(&chunk, sizeof(chunk), 1, f)){
+        if(chunk.workerId >= workerCount){
+            lastTime = realloc(lastTime, (chunk.workerId + 1) * sizeof(u64));
+            memset(&lastTime[workerCount], 0, (chunk.workerId + 1 - workerCount) * sizeof(u64));
+            workerCount = chunk.workerId + 1;
+        }
+        if(chunk.dropped != 0){
+            fprintf(stderr, "[TRACE] PD: 0x%"PRIx64" | WORKER_ID: %"PRIu64" | DROPPED: %"PRIu64" records\n",
+                    chunk.location, chunk.workerId, chunk.dropped);
+        }
+        unsigned char *records = malloc(chunk.size);
+        if(fread(records, 1, chunk.size, f) != chunk.size){
+            free(records);
+            break;
+        }
+        unsigned char *cursor = records;
+        while(cursor < (records + chunk.size)){
+            memset(trace, 0, sizeof(ocrTraceObj_t));
+            trace->typeSwitch = (ocrTraceType_t)(cursor[0] + OCR_TRACE_TYPE_EDT);
+            trace->actionSwitch = (ocrTraceAction_t)(cursor[1] & 0x7F);
+            trace->eventType = (cursor[1] >> 7);
+            cursor += 2;
+            lastTime[chunk.workerId] += decodeWord(&cursor);
+            trace->time = lastTime[chunk.workerId];
+            trace->location = chunk.location;
+            trace->workerId = chunk.workerId;
+            u64 *words = (u64 *)&(trace->parent);
+            u32 i;
+            for(i = 0; i < header.guidWords; i++){
+                words[i] = decodeWord(&cursor);
+            }
+            words = (u64 *)&(trace->type);
+            u32 count = traceRecordWords(trace->typeSwitch, trace->actionSwitch);
+            for(i = 0; i < count; i++){
+                words[i] = decodeWord(&cursor);
+            }
+            translateObject(trace, lineCount, fctPtrs);
+        }
+        free(records);
+    }
+    free(lastTime);
+    return 0;
+}
+
 void genericPrint(bool evtType, ocrTraceType_t ttype, ocrTraceAction_t action,
                   u64 location, u64 workerId, u64 timestamp, ocrGuid_t self, ocrGuid_t parent){
 
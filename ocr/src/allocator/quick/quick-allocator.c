@@ -571,13 +571,13 @@ static void quickCleanPool(poolHdr_t *pool)
                     }
                     hal_unlock32(&head->per_agent->lock);
                     if (slabs != head) {
+                        // Leave it alone and move on to the next block
                         DPRINTF(DEBUG_LVL_WARN, "cleanup pool -- empty slab found but it was not the first slab in this slab list?\n");
+                    } else {
+                        quickFreeInternal(head);
+                        p = prev;
                         continue;
                     }
-
-                    quickFreeInternal(head);
-                    p = prev;
-                    continue;
                 } else {
                     count_slab_inuse++;
                 }
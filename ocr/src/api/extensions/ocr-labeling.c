@@ -22,6 +22,16 @@
 // Related to GUIDs
 #define DEBUG_TYPE GUID
 
+// Bumped whenever a map is destroyed to invalidate the workers' caches
+static volatile u64 guidMapEpoch = 1;
+
+// See BUG #928 on GUID issues
+#if GUID_BIT_COUNT == 64
+#define GUID_MAP_CACHE_IDX(g) ((((u64)(g).guid) ^ (((u64)(g).guid) >> 16)) & (GUID_MAP_CACHE_SIZE-1))
+#elif GUID_BIT_COUNT == 128
+#define GUID_MAP_CACHE_IDX(g) ((((u64)(g).lower) ^ (((u64)(g).lower) >> 16)) & (GUID_MAP_CACHE_SIZE-1))
+#endif
+
 u8 ocrGuidMapCreate(ocrGuid_t *mapGuid, u32 numParams,
                     ocrGuid_t (*mapFunc)(ocrGuid_t startGuid, u64 skipGuid,
                                          s64* params, s64* tuple),
@@ -52,6 +62,9 @@ u8 ocrGuidMapCreate(ocrGuid_t *mapGuid, u32 numParams,
     myMap->params = (s64*)((char*)myMap + ((sizeof(ocrGuidMap_t) + sizeof(s64) - 1) & ~(sizeof(s64)-1)));
     myMap->numGuids = numberGuid;
     myMap->numParams = numParams;
+    myMap->locationSkip = 0;
+    myMap->blockSize = numberGuid;
+    myMap->numLocations = 1;
     hal_memCopy(myMap->params, params, sizeof(s64)*numParams, false);
 
     // Now actually reserve the GUID space
@@ -73,10 +86,10 @@ u8 ocrGuidMapCreate(ocrGuid_t *mapGuid, u32 numParams,
     RETURN_PROFILE(0);
 }
 
-u8 ocrGuidRangeCreate(ocrGuid_t *mapGuid,
-                      u64 numberGuid, ocrGuidUserKind kind) {
-
-    START_PROFILE(api_ocrGuidRangeCreate);
+// Creates a range whose indices are distributed by blocks of 'blockSize' over
+// 'numLocations' locations (1 for a range local to the current policy domain)
+static u8 guidRangeCreate(ocrGuid_t *mapGuid, u64 numberGuid, ocrGuidUserKind kind,
+                          u32 numLocations, u64 blockSize) {
     ocrPolicyDomain_t *pd = NULL;
     ocrGuidMap_t *myMap = NULL;
     PD_MSG_STACK(msg);
@@ -92,7 +105,7 @@ u8 ocrGuidRangeCreate(ocrGuid_t *mapGuid,
     PD_MSG_FIELD_I(properties) = 0;
     u8 returnCode = pd->fcts.processMessage(pd, &msg, true);
     if(!((returnCode == 0) && ((returnCode = PD_MSG_FIELD_O(returnDetail)) == 0))) {
-        RETURN_PROFILE(returnCode);
+        return returnCode;
     }
 
     myMap = PD_MSG_FIELD_IO(guid.metaDataPtr);
@@ -103,6 +116,8 @@ u8 ocrGuidRangeCreate(ocrGuid_t *mapGuid,
     myMap->params = NULL;
     myMap->numGuids = numberGuid;
     myMap->numParams = 0;
+    myMap->blockSize = blockSize;
+    myMap->numLocations = numLocations;
 
     // Now actually reserve the GUID space
     getCurrentEnv(NULL, NULL, NULL, &msg);
@@ -113,13 +128,53 @@ u8 ocrGuidRangeCreate(ocrGuid_t *mapGuid,
     //BUG #527: memory reclaim: There is a leak if this fails
     returnCode = pd->fcts.processMessage(pd, &msg, true);
     if(!((returnCode == 0) && ((returnCode = PD_MSG_FIELD_O(returnDetail)) == 0))) {
-        RETURN_PROFILE(returnCode);
+        return returnCode;
     }
     myMap->startGuid = PD_MSG_FIELD_O(startGuid);
     myMap->skipGuid = PD_MSG_FIELD_O(skipGuid);
+    myMap->locationSkip = PD_MSG_FIELD_O(locationSkip);
 #undef PD_TYPE
 #undef PD_MSG
-    RETURN_PROFILE(0);
+    if(numLocations > 1) {
+        if(myMap->locationSkip == 0) {
+            DPRINTF(DEBUG_LVL_WARN, "The GUID provider does not support distributed ranges\n");
+            return OCR_ENOTSUP;
+        }
+        // The reserved range encodes the current location; rebase it on location 0
+        // See BUG #928 on GUID issues
+#if GUID_BIT_COUNT == 64
+        myMap->startGuid.guid -= ((u64)pd->myLocation)*myMap->locationSkip;
+#elif GUID_BIT_COUNT == 128
+        myMap->startGuid.lower -= ((u64)pd->myLocation)*myMap->locationSkip;
+#endif
+    } else {
+        myMap->locationSkip = 0;
+    }
+    return 0;
+}
+
+u8 ocrGuidRangeCreate(ocrGuid_t *mapGuid,
+                      u64 numberGuid, ocrGuidUserKind kind) {
+    START_PROFILE(api_ocrGuidRangeCreate);
+    RETURN_PROFILE(guidRangeCreate(mapGuid, numberGuid, kind, 1, numberGuid));
+}
+
+u8 ocrGuidRangeCreateDistributed(ocrGuid_t *mapGuid, u64 numberGuid, ocrGuidUserKind kind,
+                                 ocrGuidDistKind distribution) {
+    START_PROFILE(api_ocrGuidRangeCreateDistributed);
+    ocrPolicyDomain_t *pd = NULL;
+    getCurrentEnv(&pd, NULL, NULL, NULL);
+    //BUG #606/#VV4 Neighbors/affinities: this is assuming each PD knows about every other PDs
+    //and that locations are numbered from 0 (as for affinities)
+    u32 numLocations = pd->neighborCount + 1;
+    u64 blockSize = 1;
+    if(distribution == GUID_DIST_BLOCK) {
+        blockSize = (numberGuid + numLocations - 1) / numLocations;
+    } else if(distribution != GUID_DIST_CYCLIC) {
+        DPRINTF(DEBUG_LVL_WARN, "Unknown GUID range distribution %"PRIu32"\n", (u32)distribution);
+        RETURN_PROFILE(OCR_EINVAL);
+    }
+    RETURN_PROFILE(guidRangeCreate(mapGuid, numberGuid, kind, numLocations, (blockSize == 0) ? 1 : blockSize));
 }
 
 u8 ocrGuidMapDestroy(ocrGuid_t mapGuid) {
@@ -142,6 +197,8 @@ u8 ocrGuidMapDestroy(ocrGuid_t mapGuid) {
     getCurrentEnv(NULL, NULL, NULL, &msg);
 #define PD_TYPE PD_MSG_GUID_UNRESERVE
     ASSERT(myMap); // This means that the map was not found. Runtime error
+    // Workers may have cached the map; drop all their entries
+    hal_xadd64(&guidMapEpoch, 1);
     msg.type = PD_MSG_GUID_UNRESERVE | PD_MSG_REQUEST | PD_MSG_REQ_RESPONSE;
     PD_MSG_FIELD_I(startGuid) = myMap->startGuid;
     PD_MSG_FIELD_I(skipGuid) = myMap->skipGuid;
@@ -174,13 +231,23 @@ u8 ocrGuidMapSetDefaultMap(u32 numParams, ocrGuid_t (*mapFunc)(
     return OCR_ENOTSUP;
 }
 
-u8 ocrGuidFromLabel(ocrGuid_t *outGuid, ocrGuid_t mapGuid, s64* tuple) {
-    START_PROFILE(api_ocrGuidFromLabel);
-    ASSERT(!(ocrGuidIsNull(mapGuid)));  // Default map unsupported for now
+// Resolves the metadata of a map, going through the worker's cache first
+static u8 guidMapResolve(ocrGuid_t mapGuid, ocrGuidMap_t **outMap) {
     ocrPolicyDomain_t *pd = NULL;
-    ocrGuidMap_t *myMap = NULL;
+    ocrWorker_t *worker = NULL;
+    getCurrentEnv(&pd, &worker, NULL, NULL);
+    u64 epoch = hal_loadAcquire(&guidMapEpoch);
+    ocrGuidMapCacheEntry_t *entry = NULL;
+    if(worker != NULL) {
+        entry = &(worker->guidMapCache[GUID_MAP_CACHE_IDX(mapGuid)]);
+        if((entry->epoch == epoch) && ocrGuidIsEq(entry->guid, mapGuid)) {
+            *outMap = entry->map;
+            return 0;
+        }
+    }
+
     PD_MSG_STACK(msg);
-    getCurrentEnv(&pd, NULL, NULL, &msg);
+    getCurrentEnv(NULL, NULL, NULL, &msg);
 #define PD_MSG (&msg)
 #define PD_TYPE PD_MSG_GUID_INFO
     msg.type = PD_MSG_GUID_INFO | PD_MSG_REQUEST | PD_MSG_REQ_RESPONSE;
@@ -190,12 +257,28 @@ u8 ocrGuidFromLabel(ocrGuid_t *outGuid, ocrGuid_t mapGuid, s64* tuple) {
     u8 returnCode = pd->fcts.processMessage(pd, &msg, true);
     //Warning PD_MSG_GUID_INFO returns GUID properties as 'returnDetail', not error code
     if(returnCode != 0) {
-        RETURN_PROFILE(returnCode);
+        return returnCode;
     }
-    myMap = (ocrGuidMap_t*)PD_MSG_FIELD_IO(guid.metaDataPtr);
+    *outMap = (ocrGuidMap_t*)PD_MSG_FIELD_IO(guid.metaDataPtr);
 #undef PD_TYPE
 #undef PD_MSG
-    ASSERT(myMap != NULL);
+    ASSERT(*outMap != NULL);
+    if(entry != NULL) {
+        entry->guid = mapGuid;
+        entry->map = *outMap;
+        entry->epoch = epoch;
+    }
+    return 0;
+}
+
+u8 ocrGuidFromLabel(ocrGuid_t *outGuid, ocrGuid_t mapGuid, s64* tuple) {
+    START_PROFILE(api_ocrGuidFromLabel);
+    ASSERT(!(ocrGuidIsNull(mapGuid)));  // Default map unsupported for now
+    ocrGuidMap_t *myMap = NULL;
+    u8 returnCode = guidMapResolve(mapGuid, &myMap);
+    if(returnCode != 0) {
+        RETURN_PROFILE(returnCode);
+    }
     DPRINTF(DEBUG_LVL_VVERB, "For map "GUIDF", calling map with start: "GUIDF", stride: 0x%"PRIx64"\n",
             GUIDA(mapGuid), GUIDA(myMap->startGuid), myMap->skipGuid);
     if(myMap->mapFunc == NULL) {
@@ -207,54 +290,106 @@ u8 ocrGuidFromLabel(ocrGuid_t *outGuid, ocrGuid_t mapGuid, s64* tuple) {
     RETURN_PROFILE(0);
 }
 
-u8 ocrGuidFromIndex(ocrGuid_t *outGuid, ocrGuid_t rangeGuid, u64 idx) {
-    START_PROFILE(api_ocrGuidFromIndex);
-    if(ocrGuidIsNull(rangeGuid)){
+u8 ocrGuidFromLabels(ocrGuid_t *outGuids, ocrGuid_t mapGuid, s64* tuples, u32 tupleSize, u64 count) {
+    START_PROFILE(api_ocrGuidFromLabels);
+    ASSERT(!(ocrGuidIsNull(mapGuid)));  // Default map unsupported for now
+    ocrGuidMap_t *myMap = NULL;
+    u8 returnCode = guidMapResolve(mapGuid, &myMap);
+    if(returnCode != 0) {
+        RETURN_PROFILE(returnCode);
+    }
+    if(myMap->mapFunc == NULL) {
+        DPRINTF(DEBUG_LVL_WARN, "ocrGuidFromLabels requires a map created with ocrGuidMapCreate (not a range)\n");
         RETURN_PROFILE(OCR_EINVAL);
     }
+    u64 i;
+    for(i = 0; i < count; ++i) {
+        outGuids[i] = myMap->mapFunc(myMap->startGuid, myMap->skipGuid, myMap->params, tuples + i*tupleSize);
+    }
+    DPRINTF(DEBUG_LVL_VERB, "Returning %"PRIu64" GUIDs for map "GUIDF"\n", count, GUIDA(mapGuid));
+    RETURN_PROFILE(0);
+}
 
-    ocrPolicyDomain_t *pd = NULL;
-    ocrGuidMap_t *myMap = NULL;
-    PD_MSG_STACK(msg);
-    getCurrentEnv(&pd, NULL, NULL, &msg);
-#define PD_MSG (&msg)
-#define PD_TYPE PD_MSG_GUID_INFO
-    msg.type = PD_MSG_GUID_INFO | PD_MSG_REQUEST | PD_MSG_REQ_RESPONSE;
-    PD_MSG_FIELD_IO(guid.guid) = rangeGuid;
-    PD_MSG_FIELD_IO(guid.metaDataPtr) = NULL;
-    PD_MSG_FIELD_I(properties) = RMETA_GUIDPROP;
-    u8 returnCode = pd->fcts.processMessage(pd, &msg, true);
-    //Warning PD_MSG_GUID_INFO returns GUID properties as 'returnDetail', not error code
+// Resolves a range and checks that [idx, idx+count) is within it
+static u8 guidRangeResolve(ocrGuid_t rangeGuid, u64 idx, u64 count, ocrGuidMap_t **outMap) {
+    if(ocrGuidIsNull(rangeGuid)){
+        return OCR_EINVAL;
+    }
+    u8 returnCode = guidMapResolve(rangeGuid, outMap);
     if(returnCode != 0) {
-        RETURN_PROFILE(returnCode);
+        return returnCode;
     }
-    myMap = (ocrGuidMap_t*)PD_MSG_FIELD_IO(guid.metaDataPtr);
-#undef PD_TYPE
-#undef PD_MSG
-    ASSERT(myMap != NULL);
+    ocrGuidMap_t *myMap = *outMap;
     DPRINTF(DEBUG_LVL_VVERB, "For range "GUIDF", calling map with start: "GUIDF", stride: 0x%"PRIx64"\n",
             GUIDA(rangeGuid), GUIDA(myMap->startGuid), myMap->skipGuid);
     if(myMap->mapFunc != NULL) {
         DPRINTF(DEBUG_LVL_WARN, "ocrGuidFromLabel requires a map created with ocrGuidRangeCreate (not a map)\n");
-        RETURN_PROFILE(OCR_EINVAL);
+        return OCR_EINVAL;
     }
-    if(idx >= myMap->numGuids) {
-        DPRINTF(DEBUG_LVL_WARN, "Invalid index value in ocrGuidFromIndex. Got %"PRIu64", expected 0..%"PRIu64"\n",
-                idx, myMap->numGuids-1);
-        RETURN_PROFILE(OCR_EINVAL);
+    if((idx >= myMap->numGuids) || (count > myMap->numGuids - idx)) {
+        DPRINTF(DEBUG_LVL_WARN, "Invalid index value in ocrGuidFromIndex. Got %"PRIu64"+%"PRIu64", expected 0..%"PRIu64"\n",
+                idx, count, myMap->numGuids-1);
+        return OCR_EINVAL;
+    }
+    return 0;
+}
+
+u8 ocrGuidFromIndex(ocrGuid_t *outGuid, ocrGuid_t rangeGuid, u64 idx) {
+    START_PROFILE(api_ocrGuidFromIndex);
+    ocrGuidMap_t *myMap = NULL;
+    u8 returnCode = guidRangeResolve(rangeGuid, idx, 1, &myMap);
+    if(returnCode != 0) {
+        RETURN_PROFILE(returnCode);
     }
 
+    // The owner of the index is computed, not looked up
+    u64 offset = myMap->skipGuid*idx + ((idx/myMap->blockSize) % myMap->numLocations)*myMap->locationSkip;
     // See BUG #928 on GUID issues
 #if GUID_BIT_COUNT == 64
-    outGuid->guid = myMap->startGuid.guid + myMap->skipGuid*idx;
+    outGuid->guid = myMap->startGuid.guid + offset;
 #elif GUID_BIT_COUNT == 128
-    outGuid->lower = myMap->startGuid.lower + myMap->skipGuid*idx;
+    outGuid->lower = myMap->startGuid.lower + offset;
     outGuid->upper = 0x0;
 #endif
     DPRINTF(DEBUG_LVL_VERB, "Returning GUID "GUIDF"\n", GUIDA(*outGuid));
     RETURN_PROFILE(0);
 }
 
+u8 ocrGuidFromIndices(ocrGuid_t *outGuids, ocrGuid_t rangeGuid, u64 startIdx, u64 count) {
+    START_PROFILE(api_ocrGuidFromIndices);
+    ocrGuidMap_t *myMap = NULL;
+    u8 returnCode = guidRangeResolve(rangeGuid, startIdx, count, &myMap);
+    if(returnCode != 0) {
+        RETURN_PROFILE(returnCode);
+    }
+
+    // Walk the indices block by block: the owner only changes at block boundaries
+    u64 idx = startIdx;
+    u64 endIdx = startIdx + count;
+    while(idx < endIdx) {
+        u64 blockEnd = (idx/myMap->blockSize + 1)*myMap->blockSize;
+        if(blockEnd > endIdx) {
+            blockEnd = endIdx;
+        }
+        u64 base = ((idx/myMap->blockSize) % myMap->numLocations)*myMap->locationSkip;
+        // See BUG #928 on GUID issues
+#if GUID_BIT_COUNT == 64
+        base += myMap->startGuid.guid;
+        for(; idx < blockEnd; ++idx) {
+            outGuids[idx - startIdx].guid = base + myMap->skipGuid*idx;
+        }
+#elif GUID_BIT_COUNT == 128
+        base += myMap->startGuid.lower;
+        for(; idx < blockEnd; ++idx) {
+            outGuids[idx - startIdx].lower = base + myMap->skipGuid*idx;
+            outGuids[idx - startIdx].upper = 0x0;
+        }
+#endif
+    }
+    DPRINTF(DEBUG_LVL_VERB, "Returning %"PRIu64" GUIDs for range "GUIDF"\n", count, GUIDA(rangeGuid));
+    RETURN_PROFILE(0);
+}
+
 u8 ocrGetGuidKind(ocrGuidUserKind *outKind, ocrGuid_t guid) {
     ASSERT(0); // Not supported just now
     return 0;
@@ -8,11 +8,16 @@
 #ifdef ENABLE_EXTENSION_RTITF
 
 #include "debug.h"
+#include "ocr-errors.h"
 #include "ocr-runtime.h"
 #include "ocr-sal.h"
 
 #include "utils/profiler/profiler.h"
 
+#if defined(ENABLE_POLICY_DOMAIN_HC) && defined(HC_DB_PLACEMENT_STATS)
+#include "policy-domain/hc/hc-policy.h"
+#endif
+
 #pragma message "RT-ITF extension is experimental and may not be supported on all platforms"
 
 /**
@@ -70,6 +75,26 @@ ocrGuid_t ocrCurrentWorkerGuid() {
     RETURN_PROFILE(worker->fguid.guid);
 }
 
+// exposed to runtime implementers as convenience
+u8 ocrDbPlacementStats(u32 node, u64 * nodeId, u64 * count, u64 * fallbacks) {
+    START_PROFILE(api_ocrDbPlacementStats);
+#if defined(ENABLE_POLICY_DOMAIN_HC) && defined(HC_DB_PLACEMENT_STATS)
+    ocrPolicyDomain_t * pd = NULL;
+    getCurrentEnv(&pd, NULL, NULL, NULL);
+    pdHcDbPlacement_t * placement = &(((ocrPolicyDomainHc_t *) pd)->dbPlacement);
+    if (placement->nodeCount == 0)
+        RETURN_PROFILE(OCR_ENOTSUP);
+    if (node >= placement->nodeCount)
+        RETURN_PROFILE(OCR_EINVAL);
+    *nodeId = placement->nodeId[node];
+    *count = placement->allocCount[node];
+    *fallbacks = placement->fallbackCount[node];
+    RETURN_PROFILE(0);
+#else
+    RETURN_PROFILE(OCR_ENOTSUP);
+#endif
+}
+
 // Inform the OCR runtime the currently executing thread is logically blocked
 u8 ocrInformLegacyCodeBlocking() {
     START_PROFILE(api_ocrInformLegacyCodeBlocking);
@@ -13,9 +13,14 @@
 #include "ocr-allocator.h"
 #include "ocr-datablock.h"
 #include "ocr-db.h"
+#include "ocr-edt.h"
 #include "ocr-errors.h"
+#include "extensions/ocr-affinity.h"
+#include "extensions/ocr-hints.h"
 #include "ocr-policy-domain.h"
 #include "ocr-runtime-types.h"
+#include "ocr-task.h"
+#include "utils/dbArena.h"
 
 #ifdef OCR_ENABLE_STATISTICS
 #include "ocr-statistics.h"
@@ -37,6 +42,15 @@ u8 ocrDbCreate(ocrGuid_t *db, void** addr, u64 len, u16 flags,
     u8 returnCode = 0;
     getCurrentEnv(&policy, NULL, &task, &msg);
 
+    // In-DB allocators are set up through the address of the new data block
+    if ((allocator != NO_ALLOC) &&
+        ((allocator != ARENA_ALLOC) || (flags & (DB_PROP_NO_ACQUIRE | GUID_PROP_IS_LABELED)))) {
+        *addr = NULL;
+        DPRINTF(DEBUG_LVL_WARN, "EXIT ocrDbCreate -> %"PRIu32"; unsupported allocator for these flags\n",
+                (u32)OCR_EINVAL);
+        RETURN_PROFILE(OCR_EINVAL);
+    }
+
     //Copy the hints so that the runtime modifications
     //are not reflected back to the user
     ocrHint_t userHint;
@@ -75,7 +89,8 @@ u8 ocrDbCreate(ocrGuid_t *db, void** addr, u64 len, u16 flags,
 #undef PD_MSG
 #undef PD_TYPE
 
-    if((!(flags & DB_PROP_NO_ACQUIRE)) &&  task && (returnCode == 0)) {
+    // Labeled data-blocks are not acquired on creation (the PD returns no pointer)
+    if((!(flags & (DB_PROP_NO_ACQUIRE | GUID_PROP_IS_LABELED))) && task && (returnCode == 0)) {
         // Here we inform the task that we created a DB
         // This is most likely ALWAYS a local message but let's leave the
         // API as it is for now. It is possible that the EDTs move at some point so
@@ -97,11 +112,20 @@ u8 ocrDbCreate(ocrGuid_t *db, void** addr, u64 len, u16 flags,
 #undef PD_MSG
 #undef PD_TYPE
     } else {
-        if(!(flags & (DB_PROP_IGNORE_WARN | DB_PROP_NO_ACQUIRE)) && (returnCode == 0)) {
+        if(!(flags & (DB_PROP_IGNORE_WARN | DB_PROP_NO_ACQUIRE | GUID_PROP_IS_LABELED)) && (returnCode == 0)) {
             DPRINTF(DEBUG_LVL_WARN, "Acquiring DB (GUID: "GUIDF") from outside an EDT ... auto-release will fail\n",
                     GUIDA(*db));
         }
     }
+    if ((allocator != NO_ALLOC) && (returnCode == 0)) {
+        returnCode = dbArenaInit(*addr, len);
+        if (returnCode != 0) {
+            // Too small for the allocator's book-keeping
+            ocrDbDestroy(*db);
+            *db = NULL_GUID;
+            *addr = NULL;
+        }
+    }
     DPRINTF_COND_LVL(((returnCode != 0) && (returnCode != OCR_EGUIDEXISTS)), DEBUG_LVL_WARN, DEBUG_LVL_INFO,
                      "EXIT ocrDbCreate -> %"PRIu32"; GUID: "GUIDF"; ADDR: %p size: %"PRIu64"\n",
                      returnCode, GUIDA(*db), *addr, len);
@@ -235,23 +259,283 @@ u8 ocrDbRelease(ocrGuid_t db) {
     RETURN_PROFILE(returnCode);
 }
 
+// Metadata of a data block known to the current policy domain, NULL otherwise
+static ocrDataBlock_t * dbLocalMetadata(ocrPolicyDomain_t *pd, ocrGuid_t guid) {
+    ocrLocation_t loc;
+    pd->guidProviders[0]->fcts.getLocation(pd->guidProviders[0], guid, &loc);
+    if (loc != pd->myLocation) {
+        return NULL;
+    }
+    PD_MSG_STACK(msg);
+    getCurrentEnv(NULL, NULL, NULL, &msg);
+#define PD_MSG (&msg)
+#define PD_TYPE PD_MSG_GUID_INFO
+    msg.type = PD_MSG_GUID_INFO | PD_MSG_REQUEST | PD_MSG_REQ_RESPONSE;
+    PD_MSG_FIELD_IO(guid.guid) = guid;
+    PD_MSG_FIELD_IO(guid.metaDataPtr) = NULL;
+    PD_MSG_FIELD_I(properties) = KIND_GUIDPROP | RMETA_GUIDPROP;
+    //Warning PD_MSG_GUID_INFO returns GUID properties as 'returnDetail', not error code
+    if ((pd->fcts.processMessage(pd, &msg, true) != 0) ||
+        (PD_MSG_FIELD_O(kind) != OCR_GUID_DB)) {
+        return NULL;
+    }
+    return (ocrDataBlock_t *) PD_MSG_FIELD_IO(guid.metaDataPtr);
+#undef PD_MSG
+#undef PD_TYPE
+}
+
+// Start of a data block the calling EDT may allocate from. Allocating
+// writes to the data block so it must be held in a writable mode.
+static u8 dbArenaBase(ocrGuid_t guid, void ** base) {
+    ocrPolicyDomain_t *pd = NULL;
+    ocrTask_t *task = NULL;
+    getCurrentEnv(&pd, NULL, &task, NULL);
+    ocrDbAccessMode_t mode;
+    if ((task == NULL) || ocrGuidIsNull(guid) ||
+        (pd->taskFactories[0]->fcts.getAcquiredDb(task, guid, base, &mode) != 0) ||
+        ((mode != DB_MODE_RW) && (mode != DB_MODE_EW))) {
+        return OCR_EACCES;
+    }
+    if (*base == NULL) {
+        // Created by the EDT, hence local
+        ocrDataBlock_t * db = dbLocalMetadata(pd, guid);
+        if (db == NULL) {
+            return OCR_EACCES;
+        }
+        *base = db->ptr;
+    }
+    return 0;
+}
+
 u8 ocrDbMalloc(ocrGuid_t guid, u64 size, void** addr) {
-    return OCR_EINVAL; /* not yet implemented */
+    START_PROFILE(api_ocrDbMalloc);
+    DPRINTF(DEBUG_LVL_INFO, "ENTER ocrDbMalloc(guid="GUIDF", size=%"PRIu64")\n", GUIDA(guid), size);
+    void * base = NULL;
+    u64 offset = 0;
+    u8 returnCode = dbArenaBase(guid, &base);
+    if (returnCode == 0) {
+        returnCode = dbArenaAlloc(base, size, &offset);
+    }
+    *addr = (returnCode == 0) ? (((u8 *) base) + offset) : NULL;
+    // Running out of space is not unusual, leave it to the caller
+    DPRINTF_COND_LVL(((returnCode != 0) && (returnCode != OCR_ENOMEM)), DEBUG_LVL_WARN, DEBUG_LVL_INFO,
+                     "EXIT ocrDbMalloc -> %"PRIu32"; ADDR: %p\n", returnCode, *addr);
+    RETURN_PROFILE(returnCode);
 }
 
 u8 ocrDbMallocOffset(ocrGuid_t guid, u64 size, u64* offset) {
-    return OCR_EINVAL; /* not yet implemented */
+    START_PROFILE(api_ocrDbMallocOffset);
+    DPRINTF(DEBUG_LVL_INFO, "ENTER ocrDbMallocOffset(guid="GUIDF", size=%"PRIu64")\n", GUIDA(guid), size);
+    void * base = NULL;
+    u8 returnCode = dbArenaBase(guid, &base);
+    if (returnCode == 0) {
+        returnCode = dbArenaAlloc(base, size, offset);
+    }
+    DPRINTF_COND_LVL(((returnCode != 0) && (returnCode != OCR_ENOMEM)), DEBUG_LVL_WARN, DEBUG_LVL_INFO,
+                     "EXIT ocrDbMallocOffset -> %"PRIu32"; offset: %"PRIu64"\n", returnCode,
+                     (returnCode == 0) ? *offset : 0);
+    RETURN_PROFILE(returnCode);
+}
+
+// ocrDbCopy is carried out by runtime-created EDTs that acquire both data
+// blocks. A copy of up to DB_COPY_CHUNK_SIZE bytes is done by a single EDT
+// that returns the destination so that its output event, the completion
+// event, carries it. Larger copies are split in chunks (at most one per
+// worker) copied by the children of a finish EDT. A last EDT then waits for
+// the finish scope to close and returns the destination.
+#ifndef DB_COPY_CHUNK_SIZE
+#define DB_COPY_CHUNK_SIZE (1024*1024)
+#endif
+
+// paramv of the copy EDTs. Only the finish EDT gets the chunk size
+#define DB_COPY_PARAM_DST_OFFSET 0
+#define DB_COPY_PARAM_SRC_OFFSET 1
+#define DB_COPY_PARAM_SIZE       2
+#define DB_COPY_PARAM_CHUNK      3
+
+// The copy EDTs run runtime code whose address is only valid in this
+// process so they must not be placed on another policy domain
+static ocrHint_t * dbCopyHint(ocrHint_t * hint) {
+#ifdef ENABLE_EXTENSION_AFFINITY
+    ocrGuid_t affinity;
+    ocrAffinityGetCurrent(&affinity);
+    ocrHintInit(hint, OCR_HINT_EDT_T);
+    ocrSetHintValue(hint, OCR_HINT_EDT_AFFINITY, ocrAffinityToHintValue(affinity));
+    return hint;
+#else
+    return NULL_HINT;
+#endif
+}
+
+static ocrGuid_t dbCopyChunkEdt(u32 paramc, u64 *paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u8 * dst = ((u8 *) depv[0].ptr) + paramv[DB_COPY_PARAM_DST_OFFSET];
+    u8 * src = ((u8 *) depv[1].ptr) + paramv[DB_COPY_PARAM_SRC_OFFSET];
+    // Nobody reads the destination before the completion event is satisfied
+    hal_memCopy(dst, src, paramv[DB_COPY_PARAM_SIZE], true);
+    return NULL_GUID;
+}
+
+static ocrGuid_t dbCopyEdt(u32 paramc, u64 *paramv, u32 depc, ocrEdtDep_t depv[]) {
+    dbCopyChunkEdt(paramc, paramv, depc, depv);
+    return depv[0].guid;
+}
+
+static ocrGuid_t dbCopySplitEdt(u32 paramc, u64 *paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 size = paramv[DB_COPY_PARAM_SIZE];
+    u64 chunk = paramv[DB_COPY_PARAM_CHUNK];
+    ocrHint_t hint;
+    ocrHint_t * chunkHint = dbCopyHint(&hint);
+    ocrGuid_t chunkTemplateGuid;
+    // This EDT copies the first chunk and whatever could not be handed out
+    u64 offset = chunk;
+    if (ocrEdtTemplateCreate(&chunkTemplateGuid, dbCopyChunkEdt, 3, 2) == 0) {
+        while (offset < size) {
+            u64 chunkParamv[3];
+            chunkParamv[DB_COPY_PARAM_DST_OFFSET] = paramv[DB_COPY_PARAM_DST_OFFSET] + offset;
+            chunkParamv[DB_COPY_PARAM_SRC_OFFSET] = paramv[DB_COPY_PARAM_SRC_OFFSET] + offset;
+            chunkParamv[DB_COPY_PARAM_SIZE] = ((size - offset) < chunk) ? (size - offset) : chunk;
+            ocrGuid_t chunkEdtGuid;
+            u8 returnCode = ocrEdtCreate(&chunkEdtGuid, chunkTemplateGuid, 3, chunkParamv, 2, NULL,
+                                         EDT_PROP_NONE, chunkHint, NULL);
+            if (returnCode != 0) {
+                DPRINTF(DEBUG_LVL_WARN, "ocrDbCopy: chunk EDT creation failed (%"PRIu32"), copying in place\n", returnCode);
+                break;
+            }
+            ocrAddDependence(depv[0].guid, chunkEdtGuid, 0, DB_MODE_RW);
+            ocrAddDependence(depv[1].guid, chunkEdtGuid, 1, DB_MODE_CONST);
+            offset += chunk;
+        }
+        ocrEdtTemplateDestroy(chunkTemplateGuid);
+    } else {
+        DPRINTF(DEBUG_LVL_WARN, "ocrDbCopy: chunk template creation failed, copying in place\n");
+    }
+    paramv[DB_COPY_PARAM_SIZE] = chunk;
+    dbCopyChunkEdt(paramc, paramv, depc, depv);
+    if (offset < size) {
+        paramv[DB_COPY_PARAM_DST_OFFSET] += offset;
+        paramv[DB_COPY_PARAM_SRC_OFFSET] += offset;
+        paramv[DB_COPY_PARAM_SIZE] = size - offset;
+        dbCopyChunkEdt(paramc, paramv, depc, depv);
+    }
+    return NULL_GUID;
+}
+
+static ocrGuid_t dbCopyDoneEdt(u32 paramc, u64 *paramv, u32 depc, ocrEdtDep_t depv[]) {
+    // Slot 0 is the split EDT's output event, slot 1 the destination
+    return depv[1].guid;
 }
 
 u8 ocrDbCopy(ocrGuid_t destination, u64 destinationOffset, ocrGuid_t source,
              u64 sourceOffset, u64 size, u64 copyType, ocrGuid_t *completionEvt) {
-    return OCR_EINVAL; /* not yet implemented */
+
+    START_PROFILE(api_ocrDbCopy);
+    DPRINTF(DEBUG_LVL_INFO, "ENTER ocrDbCopy(dest="GUIDF", destOffset=%"PRIu64", src="GUIDF", srcOffset=%"PRIu64
+            ", size=%"PRIu64", copyType=%"PRIu64")\n", GUIDA(destination), destinationOffset, GUIDA(source),
+            sourceOffset, size, copyType);
+    ocrPolicyDomain_t *pd = NULL;
+    getCurrentEnv(&pd, NULL, NULL, NULL);
+    u8 returnCode = 0;
+    if (ocrGuidIsNull(destination) || ocrGuidIsNull(source)) {
+        returnCode = OCR_EINVAL;
+    } else if (ocrGuidIsEq(destination, source) &&
+               (destinationOffset < (sourceOffset + size)) && (sourceOffset < (destinationOffset + size))) {
+        returnCode = OCR_EPERM;
+    } else {
+        // Sizes can only be checked for local data blocks. The source may
+        // also be an event, in which case it is only known once satisfied
+        ocrDataBlock_t * db = dbLocalMetadata(pd, destination);
+        if ((db != NULL) && ((destinationOffset + size) > db->size)) {
+            returnCode = OCR_ENOMEM;
+        }
+        db = dbLocalMetadata(pd, source);
+        if ((db != NULL) && ((sourceOffset + size) > db->size)) {
+            returnCode = OCR_ENOMEM;
+        }
+    }
+    if (returnCode != 0) {
+        DPRINTF(DEBUG_LVL_WARN, "EXIT ocrDbCopy -> %"PRIu32"\n", returnCode);
+        RETURN_PROFILE(returnCode);
+    }
+
+    u64 paramv[4];
+    paramv[DB_COPY_PARAM_DST_OFFSET] = destinationOffset;
+    paramv[DB_COPY_PARAM_SRC_OFFSET] = sourceOffset;
+    paramv[DB_COPY_PARAM_SIZE] = size;
+    ocrHint_t hint;
+    ocrHint_t * copyHint = dbCopyHint(&hint);
+    ocrGuid_t edtGuid;
+    ocrGuid_t templateGuid;
+    u64 nbChunks = (size + DB_COPY_CHUNK_SIZE - 1) / DB_COPY_CHUNK_SIZE;
+    if (nbChunks > pd->workerCount) {
+        nbChunks = pd->workerCount;
+    }
+    if (nbChunks <= 1) {
+        returnCode = ocrEdtTemplateCreate(&templateGuid, dbCopyEdt, 3, 2);
+        if (returnCode == 0) {
+            returnCode = ocrEdtCreate(&edtGuid, templateGuid, 3, paramv, 2, NULL,
+                                      EDT_PROP_NONE, copyHint, completionEvt);
+            ocrEdtTemplateDestroy(templateGuid);
+        }
+        if (returnCode == 0) {
+            ocrAddDependence(destination, edtGuid, 0, DB_MODE_RW);
+            ocrAddDependence(source, edtGuid, 1, DB_MODE_CONST);
+        }
+    } else {
+        paramv[DB_COPY_PARAM_CHUNK] = (size + nbChunks - 1) / nbChunks;
+        // Create the EDT returning the destination first so that the
+        // split EDT's output event has a waiter by the time it is satisfied
+        ocrGuid_t doneEdtGuid;
+        returnCode = ocrEdtTemplateCreate(&templateGuid, dbCopyDoneEdt, 0, 2);
+        if (returnCode == 0) {
+            returnCode = ocrEdtCreate(&doneEdtGuid, templateGuid, 0, NULL, 2, NULL,
+                                      EDT_PROP_NONE, copyHint, completionEvt);
+            ocrEdtTemplateDestroy(templateGuid);
+        }
+        if (returnCode == 0) {
+            ocrGuid_t splitDoneEvt;
+            returnCode = ocrEdtTemplateCreate(&templateGuid, dbCopySplitEdt, 4, 2);
+            if (returnCode == 0) {
+                returnCode = ocrEdtCreate(&edtGuid, templateGuid, 4, paramv, 2, NULL,
+                                          EDT_PROP_FINISH, copyHint, &splitDoneEvt);
+                ocrEdtTemplateDestroy(templateGuid);
+            }
+            if (returnCode == 0) {
+                ocrAddDependence(splitDoneEvt, doneEdtGuid, 0, DB_MODE_NULL);
+                ocrAddDependence(destination, doneEdtGuid, 1, DB_MODE_RO);
+                ocrAddDependence(destination, edtGuid, 0, DB_MODE_RW);
+                ocrAddDependence(source, edtGuid, 1, DB_MODE_CONST);
+            }
+        }
+    }
+    DPRINTF_COND_LVL(returnCode, DEBUG_LVL_WARN, DEBUG_LVL_INFO,
+                     "EXIT ocrDbCopy -> %"PRIu32"; completion: "GUIDF"\n", returnCode,
+                     GUIDA(((completionEvt == NULL) || (returnCode != 0)) ? NULL_GUID : *completionEvt));
+    RETURN_PROFILE(returnCode);
 }
 
 u8 ocrDbFree(ocrGuid_t guid, void* addr) {
-    return OCR_EINVAL; /* not yet implemented */
+    START_PROFILE(api_ocrDbFree);
+    DPRINTF(DEBUG_LVL_INFO, "ENTER ocrDbFree(guid="GUIDF", addr=%p)\n", GUIDA(guid), addr);
+    void * base = NULL;
+    u8 returnCode = dbArenaBase(guid, &base);
+    if (returnCode == 0) {
+        returnCode = ((u8 *) addr < (u8 *) base) ? OCR_EINVAL :
+            dbArenaFree(base, ((u8 *) addr) - ((u8 *) base));
+    }
+    DPRINTF_COND_LVL(returnCode, DEBUG_LVL_WARN, DEBUG_LVL_INFO,
+                     "EXIT ocrDbFree -> %"PRIu32"\n", returnCode);
+    RETURN_PROFILE(returnCode);
 }
 
 u8 ocrDbFreeOffset(ocrGuid_t guid, u64 offset) {
-    return OCR_EINVAL; /* not yet implemented */
+    START_PROFILE(api_ocrDbFreeOffset);
+    DPRINTF(DEBUG_LVL_INFO, "ENTER ocrDbFreeOffset(guid="GUIDF", offset=%"PRIu64")\n", GUIDA(guid), offset);
+    void * base = NULL;
+    u8 returnCode = dbArenaBase(guid, &base);
+    if (returnCode == 0) {
+        returnCode = dbArenaFree(base, offset);
+    }
+    DPRINTF_COND_LVL(returnCode, DEBUG_LVL_WARN, DEBUG_LVL_INFO,
+                     "EXIT ocrDbFreeOffset -> %"PRIu32"\n", returnCode);
+    RETURN_PROFILE(returnCode);
 }
@@ -34,6 +34,22 @@
 
 // DEBUG_MPI_HOSTNAMES: Dumps hostname MPI processes are started on
 
+// Initial capacity of the arrays of pending communications
+#ifndef MPI_COMM_PENDING_INIT
+#define MPI_COMM_PENDING_INIT 64
+#endif
+
+// Maximum number of handles and of message buffers kept for reuse
+#ifndef MPI_COMM_POOL_MAX
+#define MPI_COMM_POOL_MAX 1024
+#endif
+
+// Size of the recycled message buffers. Larger messages are
+// allocated and freed on demand.
+#ifndef MPI_COMM_POOL_MSG_SIZE
+#define MPI_COMM_POOL_MSG_SIZE (sizeof(ocrPolicyMsg_t))
+#endif
+
 #define DEBUG_TYPE COMM_PLATFORM
 
 #ifdef OCR_MONITOR_NETWORK
@@ -98,9 +114,9 @@ void platformFinalizeMPIComm() {
 // to listen to and what to do with the response
 // This is a bit more complicated because it currently supports
 // both the old style and the MT style of communication
-typedef struct {
+typedef struct _mpiCommHandleBase_t {
     u64 msgId;
-    MPI_Request status;
+    MPI_Request status; /**< Only used by pre-posted receives, sends keep theirs in outgoingReqs */
 #if STRATEGY_PROBE_RECV
     int src;
 #endif
@@ -120,6 +136,17 @@ typedef struct {
     pdStrand_t *myStrand;  /**< For two way messages, store the strand containing message */
 } mpiCommHandleMt_t;
 
+// Both kinds of handles are recycled through the same free list
+typedef union {
+    mpiCommHandle_t handle;
+    mpiCommHandleMt_t mtHandle;
+} mpiCommHandleSlot_t;
+
+// Overlays a recycled handle or message buffer
+typedef struct _mpiCommFreeNode_t {
+    struct _mpiCommFreeNode_t * next;
+} mpiCommFreeNode_t;
+
 static ocrLocation_t mpiRankToLocation(int mpiRank) {
     //BUG #605 Locations spec: identity integer cast for now
     return (ocrLocation_t) mpiRank;
@@ -132,28 +159,67 @@ static int locationToMpiRank(ocrLocation_t location) {
 
 /**
  * @brief Internal use - Returns a new message
+ *
+ * Messages small enough are taken from the free list and have a
+ * bufferSize of MPI_COMM_POOL_MSG_SIZE. They are regular pdMalloc
+ * allocations so the upper layers may pdFree the ones they receive.
  */
 static ocrPolicyMsg_t * allocateNewMessage(ocrCommPlatform_t * self, u32 size) {
+    ocrCommPlatformMPI_t * mpiComm = (ocrCommPlatformMPI_t *) self;
     ocrPolicyDomain_t * pd = self->pd;
-    ocrPolicyMsg_t * message = pd->fcts.pdMalloc(pd, size);
+    ocrPolicyMsg_t * message;
+    if (size <= MPI_COMM_POOL_MSG_SIZE) {
+        size = MPI_COMM_POOL_MSG_SIZE;
+        if (mpiComm->freeMsgs != NULL) {
+            message = (ocrPolicyMsg_t *) mpiComm->freeMsgs;
+            mpiComm->freeMsgs = mpiComm->freeMsgs->next;
+            mpiComm->freeMsgsCount--;
+            initializePolicyMessage(message, size);
+            return message;
+        }
+    }
+    message = pd->fcts.pdMalloc(pd, size);
     initializePolicyMessage(message, size);
     return message;
 }
 
+/**
+ * @brief Internal use - Frees a message the comm-platform is done with
+ *
+ * Any heap message with a pool-sized buffer can be recycled, whoever allocated it.
+ */
+static void freeMessage(ocrCommPlatformMPI_t * mpiComm, ocrPolicyMsg_t * message) {
+    if ((message->bufferSize == MPI_COMM_POOL_MSG_SIZE) && (mpiComm->freeMsgsCount < MPI_COMM_POOL_MAX)) {
+        mpiCommFreeNode_t * node = (mpiCommFreeNode_t *) message;
+        node->next = mpiComm->freeMsgs;
+        mpiComm->freeMsgs = node;
+        mpiComm->freeMsgsCount++;
+    } else {
+        ocrPolicyDomain_t * pd = mpiComm->base.pd;
+        pd->fcts.pdFree(pd, message);
+    }
+}
+
 /**
  * @brief Internal use - Create a mpi handle to represent pending communications
  */
 static mpiCommHandleBase_t * createMpiHandle(ocrCommPlatform_t * self, u64 id, u32 properties,
                                              ocrPolicyMsg_t * msg, u8 deleteSendMsg, u8 newMTMode) {
+    ocrCommPlatformMPI_t * mpiComm = (ocrCommPlatformMPI_t *) self;
     mpiCommHandleBase_t *handleBase = NULL;
+    if (mpiComm->freeHandles != NULL) {
+        handleBase = (mpiCommHandleBase_t *) mpiComm->freeHandles;
+        mpiComm->freeHandles = mpiComm->freeHandles->next;
+        mpiComm->freeHandlesCount--;
+    } else {
+        handleBase = self->pd->fcts.pdMalloc(self->pd, sizeof(mpiCommHandleSlot_t));
+    }
     if(newMTMode) {
-        handleBase = self->pd->fcts.pdMalloc(self->pd, sizeof(mpiCommHandleMt_t));
         handleBase->isMtHandle = true;
         mpiCommHandleMt_t *handle = (mpiCommHandleMt_t*)handleBase;
         handle->myStrand = NULL;
         handle->myMsg = NULL;
     } else {
-        handleBase = self->pd->fcts.pdMalloc(self->pd, sizeof(mpiCommHandle_t));
         handleBase->isMtHandle = false;
         mpiCommHandle_t *handle = (mpiCommHandle_t*)handleBase;
         handle->properties = properties;
@@ -164,6 +230,79 @@ static mpiCommHandleBase_t * createMpiHandle(ocrCommPlatform_t * self, u64 id, u
     return handleBase;
 }
 
+/**
+ * @brief Internal use - Recycle a handle once its communication is over
+ */
+static void destroyMpiHandle(ocrCommPlatformMPI_t * mpiComm, mpiCommHandleBase_t * handle) {
+    if (mpiComm->freeHandlesCount < MPI_COMM_POOL_MAX) {
+        mpiCommFreeNode_t * node = (mpiCommFreeNode_t *) handle;
+        node->next = mpiComm->freeHandles;
+        mpiComm->freeHandles = node;
+        mpiComm->freeHandlesCount++;
+    } else {
+        ocrPolicyDomain_t * pd = mpiComm->base.pd;
+        pd->fcts.pdFree(pd, handle);
+    }
+}
+
+/**
+ * @brief Internal use - Double the capacity of an array of pending communications
+ */
+static void * growPendingArray(ocrPolicyDomain_t * pd, void * array, u32 count, u32 newMax, u32 eltSize) {
+    void * newArray = pd->fcts.pdMalloc(pd, ((u64) newMax) * eltSize);
+    if (array != NULL) {
+        hal_memCopy(newArray, array, ((u64) count) * eltSize, false);
+        pd->fcts.pdFree(pd, array);
+    }
+    return newArray;
+}
+
+/**
+ * @brief Internal use - Record a handle waiting for a response
+ */
+static void pushIncoming(ocrCommPlatformMPI_t * mpiComm, mpiCommHandleBase_t * handle) {
+    if (mpiComm->incomingCount == mpiComm->incomingMax) {
+        ocrPolicyDomain_t * pd = mpiComm->base.pd;
+        u32 newMax = (mpiComm->incomingMax == 0) ? MPI_COMM_PENDING_INIT : (mpiComm->incomingMax * 2);
+        mpiComm->incoming = growPendingArray(pd, mpiComm->incoming, mpiComm->incomingCount,
+                                             newMax, sizeof(mpiCommHandleBase_t *));
+        mpiComm->incomingMax = newMax;
+    }
+    mpiComm->incoming[mpiComm->incomingCount++] = handle;
+}
+
+/**
+ * @brief Internal use - Remove the incoming handle at 'idx' (the last one takes its place)
+ */
+static void removeIncoming(ocrCommPlatformMPI_t * mpiComm, u32 idx) {
+    ASSERT(idx < mpiComm->incomingCount);
+    mpiComm->incoming[idx] = mpiComm->incoming[--mpiComm->incomingCount];
+}
+
+/**
+ * @brief Internal use - Reserve room for one more outgoing send
+ *
+ * Returns the MPI request the send must be posted with. The send
+ * only becomes pending once commitOutgoing is called.
+ */
+static MPI_Request * reserveOutgoing(ocrCommPlatformMPI_t * mpiComm) {
+    if (mpiComm->outgoingCount == mpiComm->outgoingMax) {
+        ocrPolicyDomain_t * pd = mpiComm->base.pd;
+        u32 count = mpiComm->outgoingCount;
+        u32 newMax = (mpiComm->outgoingMax == 0) ? MPI_COMM_PENDING_INIT : (mpiComm->outgoingMax * 2);
+        mpiComm->outgoing = growPendingArray(pd, mpiComm->outgoing, count, newMax, sizeof(mpiCommHandleBase_t *));
+        mpiComm->outgoingReqs = growPendingArray(pd, mpiComm->outgoingReqs, count, newMax, sizeof(MPI_Request));
+        mpiComm->outgoingDone = growPendingArray(pd, mpiComm->outgoingDone, 0, newMax, sizeof(int));
+        mpiComm->outgoingMax = newMax;
+    }
+    return &(mpiComm->outgoingReqs[mpiComm->outgoingCount]);
+}
+
+static void commitOutgoing(ocrCommPlatformMPI_t * mpiComm, mpiCommHandleBase_t * handle) {
+    ASSERT(mpiComm->outgoingCount < mpiComm->outgoingMax);
+    mpiComm->outgoing[mpiComm->outgoingCount++] = handle;
+}
+
 #if STRATEGY_PRE_POST_RECV
 /**
  * @brief Internal use - Asks the comm-platform to listen for incoming communication.
@@ -189,98 +328,142 @@ static void postRecvAny(ocrCommPlatform_t * self) {
     buf->rcvTime = salGetTime();
 #endif
 
-    mpiComm->incoming->pushFront(mpiComm->incoming, handle);
+    pushIncoming(mpiComm, handle);
 }
 #endif
 
+/**
+ * @brief Internal -- release the resources of a send that completed
+ *
+ * Sends that expect a response move on to the incoming array.
+ */
+static void completeOutgoing(ocrCommPlatformMPI_t *mpiComm, mpiCommHandleBase_t * mpiHandle) {
+    ocrPolicyDomain_t *pd __attribute__((unused)) = mpiComm->base.pd;
+    ocrPolicyMsg_t *msg = NULL;
+    if(mpiHandle->isMtHandle) {
+        mpiCommHandleMt_t *t = (mpiCommHandleMt_t*)mpiHandle;
+        if(t->myMsg) {
+            msg = t->myMsg;
+            DPRINTF(DEBUG_LVL_VVERB,"[MPI %"PRId32"] ONE WAY sent msg=%p src=%"PRId32", dst=%"PRId32", msgId=%"PRIu64", type=0x%"PRIx32", usefulSize=%"PRIu64"\n",
+                locationToMpiRank(pd->myLocation), msg,
+                locationToMpiRank(msg->srcLocation), locationToMpiRank(msg->destLocation),
+                msg->msgId, msg->type, msg->usefulSize);
+        } else {
+            pdStrand_t* strand = t->myStrand;
+            msg = ((pdEventMsg_t*)(strand->curEvent))->msg;
+            DPRINTF(DEBUG_LVL_VVERB,"[MPI %"PRId32"] TWO WAY sent evt=%p, msg=%p src=%"PRId32", dst=%"PRId32", msgId=%"PRIu64", type=0x%"PRIx32", usefulSize=%"PRIu64"\n",
+                locationToMpiRank(pd->myLocation), strand->curEvent, msg,
+                locationToMpiRank(msg->srcLocation), locationToMpiRank(msg->destLocation),
+                msg->msgId, msg->type, msg->usefulSize);
+        }
+    } else {
+        msg = ((mpiCommHandle_t *)mpiHandle)->msg;
+        DPRINTF(DEBUG_LVL_VVERB,"[MPI %"PRId32"] sent msg=%p src=%"PRId32", dst=%"PRId32", msgId=%"PRIu64", type=0x%"PRIx32", usefulSize=%"PRIu64"\n",
+            locationToMpiRank(pd->myLocation), msg,
+            locationToMpiRank(msg->srcLocation), locationToMpiRank(msg->destLocation),
+            msg->msgId, msg->type, msg->usefulSize);
+    }
+
+    if(mpiHandle->isMtHandle) {
+        mpiCommHandleMt_t *t = (mpiCommHandleMt_t*)mpiHandle;
+        if(t->myMsg) {
+            DPRINTF(DEBUG_LVL_VVERB, "[MPI %"PRId32"] ONE_WAY message being freed\n",
+                    locationToMpiRank(pd->myLocation));
+            ASSERT(t->myStrand == NULL);
+            // This means that a COMM_ONE_WAY message was sent, we
+            // free things
+            freeMessage(mpiComm, t->myMsg);
+            destroyMpiHandle(mpiComm, mpiHandle);
+        } else {
+            ASSERT(t->myStrand);
+            // Don't do anything, push things on the incomming queue so
+            // we can periodically check for it
+            DPRINTF(DEBUG_LVL_VVERB, "[MPI %"PRId32"] Pushing MT handle to incoming queue\n",
+                    locationToMpiRank(pd->myLocation));
+            pushIncoming(mpiComm, mpiHandle);
+        }
+    } else {
+        u32 msgProperties = ((mpiCommHandle_t*)mpiHandle)->properties;
+        // By construction, either messages are persistent in API's upper levels
+        // or they've been made persistent on the send through a copy.
+        ASSERT(msgProperties & PERSIST_MSG_PROP);
+        // Delete the message if one-way (request or response).
+        // Otherwise message might be used to store the response later.
+        if (!(msgProperties & TWOWAY_MSG_PROP) || (msgProperties & ASYNC_MSG_PROP)) {
+            freeMessage(mpiComm, ((mpiCommHandle_t*)mpiHandle)->msg);
+            destroyMpiHandle(mpiComm, mpiHandle);
+        } else {
+            // The message requires a response, put it in the incoming list
+            pushIncoming(mpiComm, mpiHandle);
+        }
+    }
+}
+
 /**
  * @brief Internal -- verify that outgoing messages are sent
+ *
+ * All the pending sends are tested with a single MPI_Testsome call.
+ * Completed entries are then squeezed out of the outgoing arrays.
  */
 static u8 verifyOutgoing(ocrCommPlatformMPI_t *mpiComm) {
     ocrPolicyDomain_t *pd = mpiComm->base.pd;
-    // Iterate over outgoing communications (mpi sends)
-    iterator_t * outgoingIt = mpiComm->outgoingIt;
-    outgoingIt->reset(outgoingIt);
-    DPRINTF(DEBUG_LVL_VERB, "[MPI %"PRId32"] Going to check for outgoing messages\n",
-            locationToMpiRank(pd->myLocation));
-    while (outgoingIt->hasNext(outgoingIt)) {
-        mpiCommHandleBase_t * mpiHandle = (mpiCommHandleBase_t *) outgoingIt->next(outgoingIt);
-        int completed = 0;
-        int res = MPI_SUCCESS;
-        res = MPI_Test(&(mpiHandle->status), &completed, MPI_STATUS_IGNORE);        
+    u32 count = mpiComm->outgoingCount;
+    if (count == 0) {
+        return 0;
+    }
+    DPRINTF(DEBUG_LVL_VERB, "[MPI %"PRId32"] Going to check for %"PRIu32" outgoing messages\n",
+            locationToMpiRank(pd->myLocation), count);
+    int nbDone = 0;
+    int res = MPI_Testsome((int) count, mpiComm->outgoingReqs, &nbDone,
+                           mpiComm->outgoingDone, MPI_STATUSES_IGNORE);
+    bool removed = false;
 #ifndef OPEN_MPI_ULFM
-        RESULT_ASSERT(res, ==, MPI_SUCCESS);
+    RESULT_ASSERT(res, ==, MPI_SUCCESS);
 #else
-        ASSERT (res == MPI_SUCCESS || isProcessFailureError(res));
-        if (isProcessFailureError(res)) { // destination is dead; clean up current outgoing request
-        	outgoingIt->removeCurrent(outgoingIt);
-        	pd->fcts.pdFree(pd, ((mpiCommHandle_t*)mpiHandle)->msg);
-        	pd->fcts.pdFree(pd, mpiHandle);
-        	continue;
+    ASSERT (res == MPI_SUCCESS || res == MPI_ERR_IN_STATUS || isProcessFailureError(res));
+    if (res != MPI_SUCCESS) {
+        // Some destination is dead: fall back to testing the sends one by one
+        // so that the ones that failed can be cleaned up.
+        nbDone = 0;
+        u32 i;
+        for (i = 0; i < count; i++) {
+            int completed = 0;
+            res = MPI_Test(&(mpiComm->outgoingReqs[i]), &completed, MPI_STATUS_IGNORE);
+            ASSERT (res == MPI_SUCCESS || isProcessFailureError(res));
+            if (isProcessFailureError(res)) { // destination is dead; clean up current outgoing request
+                freeMessage(mpiComm, ((mpiCommHandle_t*)mpiComm->outgoing[i])->msg);
+                destroyMpiHandle(mpiComm, mpiComm->outgoing[i]);
+                mpiComm->outgoing[i] = NULL;
+                removed = true;
+            } else if (completed) {
+                mpiComm->outgoingDone[nbDone++] = (int) i;
+            }
         }
+    }
 #endif
-        if(completed) {
-            ocrPolicyMsg_t *msg = NULL;
-            if(mpiHandle->isMtHandle) {
-                mpiCommHandleMt_t *t = (mpiCommHandleMt_t*)mpiHandle;
-                if(t->myMsg) {
-                    msg = t->myMsg;
-                    DPRINTF(DEBUG_LVL_VVERB,"[MPI %"PRId32"] ONE WAY sent msg=%p src=%"PRId32", dst=%"PRId32", msgId=%"PRIu64", type=0x%"PRIx32", usefulSize=%"PRIu64"\n",
-                        locationToMpiRank(pd->myLocation), msg,
-                        locationToMpiRank(msg->srcLocation), locationToMpiRank(msg->destLocation),
-                        msg->msgId, msg->type, msg->usefulSize);
-                } else {
-                    pdStrand_t* strand = t->myStrand;
-                    msg = ((pdEventMsg_t*)(strand->curEvent))->msg;
-                    DPRINTF(DEBUG_LVL_VVERB,"[MPI %"PRId32"] TWO WAY sent evt=%p, msg=%p src=%"PRId32", dst=%"PRId32", msgId=%"PRIu64", type=0x%"PRIx32", usefulSize=%"PRIu64"\n",
-                        locationToMpiRank(pd->myLocation), strand->curEvent, msg,
-                        locationToMpiRank(msg->srcLocation), locationToMpiRank(msg->destLocation),
-                        msg->msgId, msg->type, msg->usefulSize);
-                }
-            } else {
-                msg = ((mpiCommHandle_t *)mpiHandle)->msg;
-                DPRINTF(DEBUG_LVL_VVERB,"[MPI %"PRId32"] sent msg=%p src=%"PRId32", dst=%"PRId32", msgId=%"PRIu64", type=0x%"PRIx32", usefulSize=%"PRIu64"\n",
-                    locationToMpiRank(pd->myLocation), msg,
-                    locationToMpiRank(msg->srcLocation), locationToMpiRank(msg->destLocation),
-                    msg->msgId, msg->type, msg->usefulSize);
-            }
-
-
-            if(mpiHandle->isMtHandle) {
-                mpiCommHandleMt_t *t = (mpiCommHandleMt_t*)mpiHandle;
-                if(t->myMsg) {
-                    DPRINTF(DEBUG_LVL_VVERB, "[MPI %"PRId32"] ONE_WAY message being freed\n",
-                            locationToMpiRank(pd->myLocation));
-                    ASSERT(t->myStrand == NULL);
-                    // This means that a COMM_ONE_WAY message was sent, we
-                    // free things
-                    pd->fcts.pdFree(pd, t->myMsg);
-                    pd->fcts.pdFree(pd, mpiHandle);
-                } else {
-                    ASSERT(t->myStrand);
-                    // Don't do anything, push things on the incomming queue so
-                    // we can periodically check for it
-                    DPRINTF(DEBUG_LVL_VVERB, "[MPI %"PRId32"] Pushing MT handle to incoming queue\n",
-                            locationToMpiRank(pd->myLocation));
-                    mpiComm->incoming->pushFront(mpiComm->incoming, mpiHandle);
-                }
-            } else {
-                u32 msgProperties = ((mpiCommHandle_t*)mpiHandle)->properties;
-                // By construction, either messages are persistent in API's upper levels
-                // or they've been made persistent on the send through a copy.
-                ASSERT(msgProperties & PERSIST_MSG_PROP);
-                // Delete the message if one-way (request or response).
-                // Otherwise message might be used to store the response later.
-                if (!(msgProperties & TWOWAY_MSG_PROP) || (msgProperties & ASYNC_MSG_PROP)) {
-                    pd->fcts.pdFree(pd, ((mpiCommHandle_t*)mpiHandle)->msg);
-                    pd->fcts.pdFree(pd, mpiHandle);
-                } else {
-                    // The message requires a response, put it in the incoming list
-                    mpiComm->incoming->pushFront(mpiComm->incoming, mpiHandle);
-                }
+    if (nbDone == MPI_UNDEFINED) {
+        // Only inactive requests, cannot happen as completed sends are removed
+        ASSERT(false);
+        nbDone = 0;
+    }
+    removed |= (nbDone != 0);
+    int k;
+    for (k = 0; k < nbDone; k++) {
+        u32 idx = (u32) mpiComm->outgoingDone[k];
+        completeOutgoing(mpiComm, mpiComm->outgoing[idx]);
+        mpiComm->outgoing[idx] = NULL;
+    }
+    if (removed) {
+        // Compact the arrays, keeping the pending sends in posting order
+        u32 i, j = 0;
+        for (i = 0; i < count; i++) {
+            if (mpiComm->outgoing[i] != NULL) {
+                mpiComm->outgoing[j] = mpiComm->outgoing[i];
+                mpiComm->outgoingReqs[j] = mpiComm->outgoingReqs[i];
+                j++;
             }
-            outgoingIt->removeCurrent(outgoingIt);
         }
+        mpiComm->outgoingCount = j;
     }
     DPRINTF(DEBUG_LVL_VERB, "[MPI %"PRId32"] Done checking for outgoing messages\n",
             locationToMpiRank(pd->myLocation));
@@ -291,6 +474,49 @@ static u8 verifyOutgoing(ocrCommPlatformMPI_t *mpiComm) {
 u8 probeIncoming(ocrCommPlatform_t *self, int src, int tag, ocrPolicyMsg_t ** msg, int bufferSize);
 #endif
 
+/**
+ * @brief Internal -- find the pending response the next incoming message answers
+ *
+ * Probes once for a message of any tag rather than once per handle waiting
+ * for a response. Returns POLL_MORE_MESSAGE and the handle's index in the
+ * incoming array if that message is a response to one of our 'isMt' handles.
+ */
+static u8 findResponse(ocrCommPlatformMPI_t *mpiComm, u8 isMt, u32 *idx) {
+    if (mpiComm->incomingCount == 0) {
+        return POLL_NO_MESSAGE;
+    }
+    MPI_Status status;
+    int available = 0;
+    int res = MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &available, &status);
+#ifndef OPEN_MPI_ULFM
+    RESULT_ASSERT(res, ==, MPI_SUCCESS);
+#else
+    ASSERT (res == MPI_SUCCESS || isProcessFailureError(res));
+    if (isProcessFailureError(res)) {
+        return POLL_PROCESS_FAILED;
+    }
+#endif
+    // Unsolicited messages are picked up by the callers' RECV_ANY_ID probe
+    if (!available || (status.MPI_TAG == RECV_ANY_ID)) {
+        return POLL_NO_MESSAGE;
+    }
+    u32 i;
+    for (i = 0; i < mpiComm->incomingCount; i++) {
+        mpiCommHandleBase_t * mpiHandle = mpiComm->incoming[i];
+        if (((int) mpiHandle->msgId == status.MPI_TAG) && (mpiHandle->src == status.MPI_SOURCE)) {
+            if (mpiHandle->isMtHandle != isMt) {
+                DPRINTF(DEBUG_LVL_WARN, "[MPI %"PRId32"] Found a response for a %sMT handle!!!\n",
+                        locationToMpiRank(mpiComm->base.pd->myLocation), isMt ? "non " : "");
+                return POLL_NO_MESSAGE;
+            }
+            *idx = i;
+            return POLL_MORE_MESSAGE;
+        }
+    }
+    // The send of the request may not have been seen completing yet
+    return POLL_NO_MESSAGE;
+}
+
 /**
  * @brief Internal -- check for incomming responses to messages we sent (only responses)
  *
@@ -298,69 +524,62 @@ u8 probeIncoming(ocrCommPlatform_t *self, int src, int tag, ocrPolicyMsg_t ** ms
  * with differently than other incoming messages
  */
 static u8 verifyIncomingResponsesMT(ocrCommPlatformMPI_t *mpiComm, bool doUntilEmpty) {
-    iterator_t * incomingIt = mpiComm->incomingIt;
     ocrPolicyDomain_t *pd = ((ocrCommPlatform_t*)mpiComm)->pd;
-    incomingIt->reset(incomingIt);
     DPRINTF(DEBUG_LVL_VERB, "[MPI %"PRId32"] Going to check for incoming MT responses\n",
             locationToMpiRank(pd->myLocation));
-    while(incomingIt->hasNext(incomingIt)) {
-        mpiCommHandleBase_t * mpiHandle = (mpiCommHandleBase_t *) incomingIt->next(incomingIt);
-
-        // We check if this is a MT message
-        if(mpiHandle->isMtHandle) {
-            DPRINTF(DEBUG_LVL_VVERB, "[MPI %"PRId32"] Found a MT MPI handle @ %p\n",
-                    locationToMpiRank(pd->myLocation), mpiHandle);
-            mpiCommHandleMt_t *handle = (mpiCommHandleMt_t*)mpiHandle;
-            ASSERT(handle->myStrand); // If the message is in the incoming queue, it has a strand to contain the result
-            ocrPolicyMsg_t **addrOfMsg = &(((pdEventMsg_t*)(handle->myStrand->curEvent))->msg);
-            pdEventMsg_t *msgEvent = (pdEventMsg_t*)(handle->myStrand->curEvent);
-            ocrPolicyMsg_t * reqMsg = *addrOfMsg;
-            DPRINTF(DEBUG_LVL_VVERB, "[MPI %"PRId32"] Handle has Strand:%p; event:%p, addrMsg:%p, reqMsg:%p\n",
-                locationToMpiRank(pd->myLocation), handle->myStrand,
-                handle->myStrand->curEvent, addrOfMsg, reqMsg);
-            u8 res = probeIncoming((ocrCommPlatform_t*)mpiComm, mpiHandle->src, (int) mpiHandle->msgId,
-                                   addrOfMsg, reqMsg->bufferSize);
-
-            // The message is properly unmarshalled at this point
-            if (res == POLL_MORE_MESSAGE) {
-                DPRINTF(DEBUG_LVL_VVERB, "[MPI %"PRId32"] received response on strand %p, orig msg=%p, new msg=%p\n",
-                        locationToMpiRank(pd->myLocation), handle->myStrand, reqMsg, *addrOfMsg);
+    u32 idx;
+    while(findResponse(mpiComm, true, &idx) == POLL_MORE_MESSAGE) {
+        mpiCommHandleBase_t * mpiHandle = mpiComm->incoming[idx];
+        DPRINTF(DEBUG_LVL_VVERB, "[MPI %"PRId32"] Found a MT MPI handle @ %p\n",
+                locationToMpiRank(pd->myLocation), mpiHandle);
+        mpiCommHandleMt_t *handle = (mpiCommHandleMt_t*)mpiHandle;
+        ASSERT(handle->myStrand); // If the message is in the incoming queue, it has a strand to contain the result
+        ocrPolicyMsg_t **addrOfMsg = &(((pdEventMsg_t*)(handle->myStrand->curEvent))->msg);
+        pdEventMsg_t *msgEvent = (pdEventMsg_t*)(handle->myStrand->curEvent);
+        ocrPolicyMsg_t * reqMsg = *addrOfMsg;
+        DPRINTF(DEBUG_LVL_VVERB, "[MPI %"PRId32"] Handle has Strand:%p; event:%p, addrMsg:%p, reqMsg:%p\n",
+            locationToMpiRank(pd->myLocation), handle->myStrand,
+            handle->myStrand->curEvent, addrOfMsg, reqMsg);
+        u8 res = probeIncoming((ocrCommPlatform_t*)mpiComm, mpiHandle->src, (int) mpiHandle->msgId,
+                               addrOfMsg, reqMsg->bufferSize);
+
+        // The message is properly unmarshalled at this point
+        if (res != POLL_MORE_MESSAGE) {
+            break;
+        }
+        DPRINTF(DEBUG_LVL_VVERB, "[MPI %"PRId32"] received response on strand %p, orig msg=%p, new msg=%p\n",
+                locationToMpiRank(pd->myLocation), handle->myStrand, reqMsg, *addrOfMsg);
 #ifdef OCR_ASSERT
-                if(reqMsg != *addrOfMsg) {
-                    // This means a new message was allocate as the response
-                    // and the original request should be left as is)
-                    ASSERT((reqMsg->srcLocation == pd->myLocation) && (reqMsg->destLocation != pd->myLocation));
-                    ASSERT(((*addrOfMsg)->srcLocation != pd->myLocation) && ((*addrOfMsg)->destLocation == pd->myLocation));
-                } else {
-                    // Message was overwritten
-                    ASSERT(((*addrOfMsg)->srcLocation != pd->myLocation) && ((*addrOfMsg)->destLocation == pd->myLocation));
-                }
+        if(reqMsg != *addrOfMsg) {
+            // This means a new message was allocate as the response
+            // and the original request should be left as is)
+            ASSERT((reqMsg->srcLocation == pd->myLocation) && (reqMsg->destLocation != pd->myLocation));
+            ASSERT(((*addrOfMsg)->srcLocation != pd->myLocation) && ((*addrOfMsg)->destLocation == pd->myLocation));
+        } else {
+            // Message was overwritten
+            ASSERT(((*addrOfMsg)->srcLocation != pd->myLocation) && ((*addrOfMsg)->destLocation == pd->myLocation));
+        }
 #endif
-                if(reqMsg != *addrOfMsg) {
-                    // Free the original request message
-                    if(!(msgEvent->properties & COMM_STACK_MSG)) {
-                        pd->fcts.pdFree(pd, reqMsg);
-                    } else {
-                        msgEvent->properties &= ~(COMM_STACK_MSG);
-                    }
-                }
-                ASSERT((*addrOfMsg)->msgId == mpiHandle->msgId);
-
-                // Mark the event as being ready so that someone can pick it up
-                RESULT_ASSERT(pdMarkReadyEvent(pd, handle->myStrand->curEvent), ==, 0);
-
-                // Free the handle and remove from incoming list
-                pd->fcts.pdFree(pd, mpiHandle);
-                incomingIt->removeCurrent(incomingIt);
-                if(!doUntilEmpty) {
-                    DPRINTF(DEBUG_LVL_VERB, "[MPI %"PRId32"] Done checking for incoming MT responses\n",
-                            locationToMpiRank(pd->myLocation));
-                    return POLL_MORE_MESSAGE;
-                }
+        if(reqMsg != *addrOfMsg) {
+            // Free the original request message
+            if(!(msgEvent->properties & COMM_STACK_MSG)) {
+                freeMessage(mpiComm, reqMsg);
+            } else {
+                msgEvent->properties &= ~(COMM_STACK_MSG);
             }
-        } else {
-            DPRINTF(DEBUG_LVL_WARN, "[MPI %"PRId32"] Found a non MT handle!!!\n",
+        }
+        ASSERT((*addrOfMsg)->msgId == mpiHandle->msgId);
+
+        // Mark the event as being ready so that someone can pick it up
+        RESULT_ASSERT(pdMarkReadyEvent(pd, handle->myStrand->curEvent), ==, 0);
+
+        // Free the handle and remove from incoming list
+        destroyMpiHandle(mpiComm, mpiHandle);
+        removeIncoming(mpiComm, idx);
+        if(!doUntilEmpty) {
+            DPRINTF(DEBUG_LVL_VERB, "[MPI %"PRId32"] Done checking for incoming MT responses\n",
                     locationToMpiRank(pd->myLocation));
+            return POLL_MORE_MESSAGE;
         }
     }
     DPRINTF(DEBUG_LVL_VERB, "[MPI %"PRId32"] done checking for incoming MT responses\n",
@@ -423,7 +642,7 @@ u8 MPICommSendMessage(ocrCommPlatform_t * self,
                 //  - The message is one-way: By design, all one-way are heap-allocated copies.
                 //    It is the comm-platform responsibility to free them, do it now since we've
                 //    made our own copy.
-                self->pd->fcts.pdFree(self->pd, message);
+                freeMessage(mpiComm, message);
                 message = NULL; // to catch misuses later in this function call
             }
         } else {
@@ -489,7 +708,7 @@ u8 MPICommSendMessage(ocrCommPlatform_t * self,
         respMsg->rcvTime = salGetTime();
 #endif
 
-        mpiComm->incoming->pushFront(mpiComm->incoming, respHandle);
+        pushIncoming(mpiComm, respHandle);
 #endif
 #if STRATEGY_PROBE_RECV
         // In probe mode just record the recipient id to be checked later
@@ -504,7 +723,7 @@ u8 MPICommSendMessage(ocrCommPlatform_t * self,
     // is not tied to any particular request at destination
     int tag = (messageBuffer->type & PD_MSG_RESPONSE) ? messageBuffer->msgId : SEND_ANY_ID;
 
-    MPI_Request * status = &(handle->status);
+    MPI_Request * status = reserveOutgoing(mpiComm);
 
     DPRINTF(DEBUG_LVL_VVERB,"[MPI %"PRId32"] posting isend for msgId=%"PRIu64" msg=%p type=%"PRIx32" "
             "fullMsgSize=%"PRIu64" marshalledSize=%"PRIu64" to MPI rank %"PRId32"\n",
@@ -525,7 +744,7 @@ u8 MPICommSendMessage(ocrCommPlatform_t * self,
     int res = MPI_Isend(messageBuffer, (int) fullMsgSize, datatype, targetRank, tag, comm, status);
 
     if (res == MPI_SUCCESS) { //ULFM Note: no process failure errors are expected from MPI_Isend
-        mpiComm->outgoing->pushFront(mpiComm->outgoing, handle);
+        commitOutgoing(mpiComm, handle);
         *id = mpiId;
     } else {
         //BUG #603 define error for comm-api
@@ -600,7 +819,7 @@ u8 MPICommSendMessageMT(ocrCommPlatform_t * self,
         // Replace the message in the event with the larger one and destroy the old one
         msgEvent->msg = messageBuffer;
         if(!(msgEvent->properties & COMM_STACK_MSG)) {
-            self->pd->fcts.pdFree(self->pd, message);
+            freeMessage(mpiComm, message);
         }
         msgEvent->properties &= ~COMM_STACK_MSG;
         message = msgEvent->msg;
@@ -649,7 +868,7 @@ u8 MPICommSendMessageMT(ocrCommPlatform_t * self,
     //   - to a two-way message: we use msgId which will have been properly set
     int tag = (message->type & PD_MSG_RESPONSE) ? message->msgId : SEND_ANY_ID;
 
-    MPI_Request * status = &(handle->status);
+    MPI_Request * status = reserveOutgoing(mpiComm);
 
     DPRINTF(DEBUG_LVL_VVERB,"[MPI %"PRId32"] posting isend for msgId=%"PRIu64" msg=%p type=%"PRIx32" "
             "fullMsgSize=%"PRIu64" marshalledSize=%"PRIu64" to MPI rank %"PRId32" with tag %"PRId32"\n",
@@ -716,7 +935,7 @@ u8 MPICommSendMessageMT(ocrCommPlatform_t * self,
         }
         // We push this to the outgoing queue because we need to check if we
         // can free the buffer at some point
-        mpiComm->outgoing->pushFront(mpiComm->outgoing, handle);
+        commitOutgoing(mpiComm, handle);
     } else {
         //BUG #603 define error for comm-api
         ASSERT(false);
@@ -843,23 +1062,18 @@ u8 MPICommPollMessageInternal(ocrCommPlatform_t *self, ocrPolicyMsg_t **msg,
 
     verifyOutgoing(mpiComm);
 
-    // Iterate over incoming communications (mpi recvs)
-    iterator_t * incomingIt = mpiComm->incomingIt;
-    incomingIt->reset(incomingIt);
-#if STRATEGY_PRE_POST_RECV
-    bool debugIts = false;
-#endif
-    while (incomingIt->hasNext(incomingIt)) {
-        mpiCommHandleBase_t * mpiHandleBase = (mpiCommHandleBase_t *) incomingIt->next(incomingIt);
-        // Ignore anything that has to do with MT
-        if(mpiHandleBase->isMtHandle) {
-            continue;
-        }
-        mpiCommHandle_t* mpiHandle = (mpiCommHandle_t*)mpiHandleBase;
-
+#if STRATEGY_PROBE_RECV
+    // Check whether the next incoming message is the response to one of our requests
+    u32 idx;
+    u8 found = findResponse(mpiComm, false, &idx);
+    if (found == POLL_PROCESS_FAILED) {
+        //FIXME: do not hide the error here, propagate it up the stack
+        return POLL_NO_MESSAGE;
+    }
+    if (found == POLL_MORE_MESSAGE) {
+        mpiCommHandle_t* mpiHandle = (mpiCommHandle_t*) mpiComm->incoming[idx];
         //PERF: Would it be better to always probe and allocate messages for responses on the fly
         //rather than having all this book-keeping for receiving and reusing requests space ?
-    #if STRATEGY_PROBE_RECV
         // Probe a specific incoming message. Response message overwrites the request one
         // if it fits. Otherwise, a new message is allocated. Upper-layers are responsible
         // for deallocating the request/response buffers.
@@ -867,11 +1081,11 @@ u8 MPICommPollMessageInternal(ocrCommPlatform_t *self, ocrPolicyMsg_t **msg,
         u8 res = probeIncoming(self, mpiHandle->base.src, (int) mpiHandle->base.msgId, &mpiHandle->msg, mpiHandle->msg->bufferSize);
         // The message is properly unmarshalled at this point
         if (res == POLL_PROCESS_FAILED) {
-        	pd->fcts.pdFree(pd, mpiHandle);
-            incomingIt->removeCurrent(incomingIt);
-        	//FIXME: do not hide the error here, propagate it up the stack
-    	    return POLL_NO_MESSAGE;
-    	}
+            destroyMpiHandle(mpiComm, (mpiCommHandleBase_t *) mpiHandle);
+            removeIncoming(mpiComm, idx);
+            //FIXME: do not hide the error here, propagate it up the stack
+            return POLL_NO_MESSAGE;
+        }
         else if (res == POLL_MORE_MESSAGE) {
 #ifdef OCR_ASSERT
             if (reqMsg != mpiHandle->msg) {
@@ -890,16 +1104,28 @@ u8 MPICommPollMessageInternal(ocrCommPlatform_t *self, ocrPolicyMsg_t **msg,
                 // made by the comm-platform, hence the pointer is only
                 // known here and must be deallocated. The sendMessage
                 // caller still has a pointer to the original message.
-                pd->fcts.pdFree(pd, reqMsg);
+                freeMessage(mpiComm, reqMsg);
             }
             ASSERT(mpiHandle->msg->msgId == mpiHandle->base.msgId);
             *msg = mpiHandle->msg;
-            pd->fcts.pdFree(pd, mpiHandle);
-            incomingIt->removeCurrent(incomingIt);
+            destroyMpiHandle(mpiComm, (mpiCommHandleBase_t *) mpiHandle);
+            removeIncoming(mpiComm, idx);
             return res;
         }
-    #endif
-    #if STRATEGY_PRE_POST_RECV
+    }
+#endif
+#if STRATEGY_PRE_POST_RECV
+    // Iterate over incoming communications (mpi recvs)
+    bool debugIts = false;
+    u32 i = 0;
+    while (i < mpiComm->incomingCount) {
+        mpiCommHandleBase_t * mpiHandleBase = mpiComm->incoming[i];
+        // Ignore anything that has to do with MT
+        if(mpiHandleBase->isMtHandle) {
+            i++;
+            continue;
+        }
+        mpiCommHandle_t* mpiHandle = (mpiCommHandle_t*)mpiHandleBase;
         debugIts = true;
         int completed = 0;
         int ret = MPI_Test(&(mpiHandle->base.status), &completed, MPI_STATUS_IGNORE);
@@ -908,8 +1134,8 @@ u8 MPICommPollMessageInternal(ocrCommPlatform_t *self, ocrPolicyMsg_t **msg,
         #else
             ASSERT (ret == MPI_SUCCESS || isProcessFailureError(ret));
             if (isProcessFailureError(ret)) { // destination is dead; clean up current outgoing request
-                pd->fcts.pdFree(pd, mpiHandle);
-                incomingIt->removeCurrent(incomingIt);
+                destroyMpiHandle(mpiComm, mpiHandleBase);
+                removeIncoming(mpiComm, i);
                 //ULFM Question: should I call postRecvAny(self); ???
                 continue;
             }
@@ -930,8 +1156,8 @@ u8 MPICommPollMessageInternal(ocrCommPlatform_t *self, ocrPolicyMsg_t **msg,
             ASSERT(baseSize + marshalledSize <= mpiComm->maxMsgSize);
             ocrPolicyMsgUnMarshallMsg((u8*)*msg, NULL, *msg,
                                       MARSHALL_APPEND | MARSHALL_DBPTR | MARSHALL_NSADDR);
-            pd->fcts.pdFree(pd, mpiHandle);
-            incomingIt->removeCurrent(incomingIt);
+            destroyMpiHandle(mpiComm, mpiHandleBase);
+            removeIncoming(mpiComm, i);
             if (needRecvAny) {
                 // Receiving a request indicates a mpi recv any
                 // has completed. Post a new one.
@@ -939,9 +1165,8 @@ u8 MPICommPollMessageInternal(ocrCommPlatform_t *self, ocrPolicyMsg_t **msg,
             }
             return POLL_MORE_MESSAGE;
         }
-    #endif
+        i++;
     }
-#if STRATEGY_PRE_POST_RECV
     ASSERT(debugIts != false); // There should always be an irecv any posted
 #endif
     u8 retCode = POLL_NO_MESSAGE;
@@ -953,8 +1178,8 @@ u8 MPICommPollMessageInternal(ocrCommPlatform_t *self, ocrPolicyMsg_t **msg,
     // Message is properly un-marshalled at this point
 #endif
     if (retCode == POLL_NO_MESSAGE) {
-        retCode |= (mpiComm->outgoing->isEmpty(mpiComm->outgoing)) ? POLL_NO_OUTGOING_MESSAGE : 0;
-        retCode |= (mpiComm->incoming->isEmpty(mpiComm->incoming)) ? POLL_NO_INCOMING_MESSAGE : 0;
+        retCode |= (mpiComm->outgoingCount == 0) ? POLL_NO_OUTGOING_MESSAGE : 0;
+        retCode |= (mpiComm->incomingCount == 0) ? POLL_NO_INCOMING_MESSAGE : 0;
     }
     if (retCode == POLL_PROCESS_FAILED) {
         //FIXME: do not hide the error here, propagate it up the stack
@@ -998,8 +1223,8 @@ u8 MPICommPollMessageInternalMT(ocrCommPlatform_t *self, pdEvent_t **outEvent,
 
     // Message is properly un-marshalled at this point
     if (retCode == POLL_NO_MESSAGE) {
-        retCode |= (mpiComm->outgoing->isEmpty(mpiComm->outgoing)) ? POLL_NO_OUTGOING_MESSAGE : 0;
-        retCode |= (mpiComm->incoming->isEmpty(mpiComm->incoming)) ? POLL_NO_INCOMING_MESSAGE : 0;
+        retCode |= (mpiComm->outgoingCount == 0) ? POLL_NO_OUTGOING_MESSAGE : 0;
+        retCode |= (mpiComm->incomingCount == 0) ? POLL_NO_INCOMING_MESSAGE : 0;
     }
     return retCode;
 }
@@ -1081,10 +1306,8 @@ u8 MPICommSwitchRunlevel(ocrCommPlatform_t *self, ocrPolicyDomain_t *PD, ocrRunl
             //BUG #602 multi-comm-worker: multi-initialization if multiple comm-worker
             //Initialize mpi comm internal queues
             mpiComm->msgId = 1;
-            mpiComm->incoming = newLinkedList(PD);
-            mpiComm->outgoing = newLinkedList(PD);
-            mpiComm->incomingIt = mpiComm->incoming->iterator(mpiComm->incoming);
-            mpiComm->outgoingIt = mpiComm->outgoing->iterator(mpiComm->outgoing);
+            // The pending arrays are allocated on first use
+            ASSERT((mpiComm->incomingCount == 0) && (mpiComm->outgoingCount == 0));
 
             // Default max size is customizable through setMaxExpectedMessageSize()
 #if STRATEGY_PRE_POST_RECV
@@ -1128,10 +1351,8 @@ u8 MPICommSwitchRunlevel(ocrCommPlatform_t *self, ocrPolicyDomain_t *PD, ocrRunl
         }
         if ((properties & RL_TEAR_DOWN) && RL_IS_FIRST_PHASE_DOWN(self->pd, RL_GUID_OK, phase)) {
 #if STRATEGY_PROBE_RECV
-            iterator_t * incomingIt = mpiComm->incomingIt;
-            incomingIt->reset(incomingIt);
-            if (incomingIt->hasNext(incomingIt)) {
-                mpiCommHandleBase_t * mpiHandle = (mpiCommHandleBase_t *) incomingIt->next(incomingIt);
+            if (mpiComm->incomingCount != 0) {
+                mpiCommHandleBase_t * mpiHandle = mpiComm->incoming[0];
                 ocrPolicyMsg_t *msg = NULL;
                 if(mpiHandle->isMtHandle) {
                     mpiCommHandleMt_t *t = (mpiCommHandleMt_t*)mpiHandle;
@@ -1140,16 +1361,39 @@ u8 MPICommSwitchRunlevel(ocrCommPlatform_t *self, ocrPolicyDomain_t *PD, ocrRunl
                     msg = ((mpiCommHandle_t*)mpiHandle)->msg;
                 }
                 self->pd->fcts.pdFree(self->pd, msg);
-                self->pd->fcts.pdFree(self->pd, mpiHandle);
-                incomingIt->removeCurrent(incomingIt);
+                destroyMpiHandle(mpiComm, mpiHandle);
+                removeIncoming(mpiComm, 0);
             }
 #endif
-            ASSERT(mpiComm->incoming->isEmpty(mpiComm->incoming));
-            mpiComm->incoming->destruct(mpiComm->incoming);
-            ASSERT(mpiComm->outgoing->isEmpty(mpiComm->outgoing));
-            mpiComm->outgoing->destruct(mpiComm->outgoing);
-            mpiComm->incomingIt->destruct(mpiComm->incomingIt);
-            mpiComm->outgoingIt->destruct(mpiComm->outgoingIt);
+            ASSERT(mpiComm->incomingCount == 0);
+            ASSERT(mpiComm->outgoingCount == 0);
+            if (mpiComm->incoming != NULL) {
+                PD->fcts.pdFree(PD, mpiComm->incoming);
+            }
+            if (mpiComm->outgoing != NULL) {
+                PD->fcts.pdFree(PD, mpiComm->outgoing);
+                PD->fcts.pdFree(PD, mpiComm->outgoingReqs);
+                PD->fcts.pdFree(PD, mpiComm->outgoingDone);
+            }
+            mpiComm->incoming = NULL;
+            mpiComm->outgoing = NULL;
+            mpiComm->outgoingReqs = NULL;
+            mpiComm->outgoingDone = NULL;
+            mpiComm->incomingMax = 0;
+            mpiComm->outgoingMax = 0;
+            // Empty the pools
+            while (mpiComm->freeHandles != NULL) {
+                mpiCommFreeNode_t * node = mpiComm->freeHandles;
+                mpiComm->freeHandles = node->next;
+                PD->fcts.pdFree(PD, node);
+            }
+            while (mpiComm->freeMsgs != NULL) {
+                mpiCommFreeNode_t * node = mpiComm->freeMsgs;
+                mpiComm->freeMsgs = node->next;
+                PD->fcts.pdFree(PD, node);
+            }
+            mpiComm->freeHandlesCount = 0;
+            mpiComm->freeMsgsCount = 0;
             PD->fcts.pdFree(PD, PD->neighbors);
             PD->neighbors = NULL;
         }
@@ -1206,9 +1450,17 @@ void initializeCommPlatformMPI(ocrCommPlatformFactory_t * factory, ocrCommPlatfo
     ocrCommPlatformMPI_t * mpiComm = (ocrCommPlatformMPI_t*) base;
     mpiComm->msgId = 1; // all recv ANY use id '0'
     mpiComm->incoming = NULL;
+    mpiComm->incomingCount = 0;
+    mpiComm->incomingMax = 0;
     mpiComm->outgoing = NULL;
-    mpiComm->incomingIt = NULL;
-    mpiComm->outgoingIt = NULL;
+    mpiComm->outgoingReqs = NULL;
+    mpiComm->outgoingDone = NULL;
+    mpiComm->outgoingCount = 0;
+    mpiComm->outgoingMax = 0;
+    mpiComm->freeHandles = NULL;
+    mpiComm->freeMsgs = NULL;
+    mpiComm->freeHandlesCount = 0;
+    mpiComm->freeMsgsCount = 0;
     mpiComm->maxMsgSize = 0;
     mpiComm->curState = 0;
 }
@@ -14,8 +14,8 @@
 #ifdef ENABLE_COMM_PLATFORM_MPI
 
 #include "utils/ocr-utils.h"
-#include "utils/list.h"
 #include "ocr-comm-platform.h"
+#include <mpi.h>
 
 typedef struct {
     ocrCommPlatformFactory_t base;
@@ -23,13 +23,29 @@ typedef struct {
 
 #define MPI_COMM_RL_MAX 3
 
+// Declared in .c
+struct _mpiCommHandleBase_t;
+struct _mpiCommFreeNode_t;
+
 typedef struct {
     ocrCommPlatform_t base;
     u64 msgId;
-    linkedlist_t * incoming;
-    linkedlist_t * outgoing;
-    iterator_t * incomingIt;
-    iterator_t * outgoingIt;
+    // Pending communications are kept in arrays that grow on demand.
+    // Outgoing sends have their MPI requests in a parallel array so
+    // that they are all tested at once with MPI_Testsome.
+    struct _mpiCommHandleBase_t ** incoming;
+    u32 incomingCount;
+    u32 incomingMax;
+    struct _mpiCommHandleBase_t ** outgoing;
+    MPI_Request * outgoingReqs;
+    int * outgoingDone; /**< Completed indices returned by MPI_Testsome */
+    u32 outgoingCount;
+    u32 outgoingMax;
+    // Handles and small message buffers are recycled through these lists
+    struct _mpiCommFreeNode_t * freeHandles;
+    struct _mpiCommFreeNode_t * freeMsgs;
+    u32 freeHandlesCount;
+    u32 freeMsgsCount;
     u64 maxMsgSize;
     // The state encodes the RL (top 4 bits) and the phase (bottom 4 bits)
     // This is mainly for debugging purpose
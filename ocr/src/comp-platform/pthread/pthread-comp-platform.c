@@ -47,6 +47,9 @@ static void pthreadRoutineInitializer(ocrCompPlatformPthread_t * pthreadCompPlat
         DPRINTF(DEBUG_LVL_INFO, "Binding comp-platform to cpu_id %"PRId32"\n", cpuBind);
         bindThread(cpuBind);
     }
+    // Sample the NUMA node once, now that the thread is bound
+    if(pthreadCompPlatform->base.worker != NULL)
+        pthreadCompPlatform->base.worker->numaNode = hal_numaNode();
 #ifdef OCR_RUNTIME_PROFILER
     {
         _profilerData *d = (_profilerData*) runtimeChunkAlloc(sizeof(_profilerData), PERSISTENT_CHUNK);
@@ -313,6 +316,7 @@ void initializeCompPlatformPthread(ocrCompPlatformFactory_t * factory, ocrCompPl
     ocrCompPlatformPthread_t *compPlatformPthread = (ocrCompPlatformPthread_t *)derived;
     compPlatformPthread->base.fcts = factory->platformFcts;
     compPlatformPthread->binding = (params != NULL) ? params->binding : -1;
+    compPlatformPthread->socket = (params != NULL) ? params->socket : -1;
     compPlatformPthread->stackSize = ((params != NULL) && (params->stackSize > 0)) ? params->stackSize : 8388608;
     ((ocrCompPlatformPthread_t*)compPlatformPthread)->tls.pd = NULL;
     ((ocrCompPlatformPthread_t*)compPlatformPthread)->tls.worker = NULL;
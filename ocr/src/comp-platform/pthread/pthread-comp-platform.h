@@ -44,6 +44,7 @@ typedef struct {
     perThreadStorage_t tls;
     u64 stackSize;
     s32 binding;
+    s32 socket; // Socket from the machine description, -1 if not given
     u32 threadStatus; // RL_NODE_MASTER or RL_PD_MASTER or 0
 } ocrCompPlatformPthread_t;
 
@@ -51,6 +52,7 @@ typedef struct {
     paramListCompPlatformInst_t base;
     u64 stackSize;
     s32 binding;
+    s32 socket;
 } paramListCompPlatformPthread_t;
 
 extern ocrCompPlatformFactory_t* newCompPlatformFactoryPthread(ocrParamList_t *perType);
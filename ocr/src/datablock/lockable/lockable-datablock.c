@@ -56,7 +56,11 @@ typedef struct _dbWaiter_t {
     ocrGuid_t guid;
     u32 slot;
     u32 properties; // properties specified with the acquire request
+    ocrDbAccessMode_t mode;
     bool isInternal;
+#ifdef OCR_MONITOR_DB_CONTENTION
+    u64 enqueueTime;
+#endif
     struct _dbWaiter_t * next;
 } dbWaiter_t;
 
@@ -94,32 +98,87 @@ static ocrLocation_t guidToLocation(ocrPolicyDomain_t * pd, ocrGuid_t edtGuid) {
 }
 
 //Warning: Calling context must own rself->lock
-static dbWaiter_t * popEwWaiter(ocrDataBlock_t * self) {
-    ocrDataBlockLockable_t * rself = (ocrDataBlockLockable_t*) self;
-    ASSERT(rself->ewWaiterList != NULL);
-    dbWaiter_t * waiter = rself->ewWaiterList;
-    rself->ewWaiterList = waiter->next;
-    return waiter;
+static void enqueueWaiter(ocrDataBlockLockable_t * rself, ocrFatGuid_t edt, u32 edtSlot,
+                          ocrDbAccessMode_t mode, bool isInternal, u32 properties) {
+    // Nodes of granted waiters are kept with the DB so that a DB
+    // contended over and over does not hit the allocator each time
+    dbWaiter_t * waiter = rself->freeWaiters;
+    if (waiter != NULL) {
+        rself->freeWaiters = waiter->next;
+    } else {
+        ocrPolicyDomain_t * pd = NULL;
+        getCurrentEnv(&pd, NULL, NULL, NULL);
+        waiter = (dbWaiter_t *) pd->fcts.pdMalloc(pd, sizeof(dbWaiter_t));
+    }
+    waiter->guid = edt.guid;
+    waiter->slot = edtSlot;
+    waiter->properties = properties;
+    waiter->mode = mode;
+    waiter->isInternal = isInternal;
+    waiter->next = NULL;
+    if (rself->waitTail == NULL) {
+        rself->waitHead = waiter;
+    } else {
+        rself->waitTail->next = waiter;
+    }
+    rself->waitTail = waiter;
+#ifdef OCR_MONITOR_DB_CONTENTION
+    waiter->enqueueTime = salGetTime();
+    rself->stats.queueLength++;
+    if (rself->stats.queueLength > rself->stats.queueMax) {
+        rself->stats.queueMax = rself->stats.queueLength;
+    }
+#endif
 }
 
 //Warning: Calling context must own rself->lock
-static dbWaiter_t * popItwWaiter(ocrDataBlock_t * self) {
-    ocrDataBlockLockable_t * rself = (ocrDataBlockLockable_t*) self;
-    ASSERT(rself->itwWaiterList != NULL);
-    dbWaiter_t * waiter = rself->itwWaiterList;
-    rself->itwWaiterList = waiter->next;
-    return waiter;
+static void recycleWaiter(ocrDataBlockLockable_t * rself, dbWaiter_t * waiter) {
+    waiter->next = rself->freeWaiters;
+    rself->freeWaiters = waiter;
 }
 
+#ifdef OCR_MONITOR_DB_CONTENTION
 //Warning: Calling context must own rself->lock
-static dbWaiter_t * popRoWaiter(ocrDataBlock_t * self) {
-    ocrDataBlockLockable_t * rself = (ocrDataBlockLockable_t*) self;
-    ASSERT(rself->roWaiterList != NULL);
-    dbWaiter_t * waiter = rself->roWaiterList;
-    rself->roWaiterList = waiter->next;
-    return waiter;
+static void recordWait(ocrDataBlockLockable_t * rself, dbWaiter_t * waiter, bool overtake) {
+    ocrDataBlockLockableStats_t * stats = &rself->stats;
+    u64 wait = salGetTime() - waiter->enqueueTime;
+    stats->queueLength--;
+    stats->waited++;
+    stats->overtakes += overtake;
+    stats->waitTotal += wait;
+    if (wait > stats->waitMax) {
+        stats->waitMax = wait;
+    }
+    stats->waitHist[fls64(wait)]++;
+}
+
+// Upper bound (ns) of the wait time of 'pct' percent of the waiters
+static u64 waitPercentile(ocrDataBlockLockableStats_t * stats, u32 pct) {
+    u64 threshold = (stats->waited * pct + 99) / 100;
+    u64 seen = 0;
+    u32 b;
+    for (b = 0; b < DB_LOCKABLE_WAIT_BUCKETS - 1; ++b) {
+        seen += stats->waitHist[b];
+        if (seen >= threshold) {
+            return (2ULL << b);
+        }
+    }
+    return stats->waitMax;
 }
 
+static void reportContention(ocrDataBlockLockable_t * rself) {
+    ocrDataBlockLockableStats_t * stats = &rself->stats;
+    if (stats->waited == 0) {
+        return;
+    }
+    PRINTF("DB "GUIDF" contention: %"PRIu64" acquires, %"PRIu64" waited, %"PRIu64" overtaken, queue max %"PRIu32
+           ", wait ns avg %"PRIu64" p50 %"PRIu64" p90 %"PRIu64" p99 %"PRIu64" max %"PRIu64"\n",
+           GUIDA(rself->base.guid), stats->acquires, stats->waited, stats->overtakes, stats->queueMax,
+           stats->waitTotal / stats->waited, waitPercentile(stats, 50), waitPercentile(stats, 90),
+           waitPercentile(stats, 99), stats->waitMax);
+}
+#endif
+
 static bool lockButSelf(ocrDataBlockLockable_t *rself) {
     ocrWorker_t * worker;
     getCurrentEnv(NULL, &worker, NULL, NULL);
@@ -138,6 +197,91 @@ static bool lockButSelf(ocrDataBlockLockable_t *rself) {
     return unlock;
 }
 
+// The attributes word is shared with the lock-free RO/CONST fast paths of
+// acquire and release, which only ever change numUsers. The other fields are
+// only changed under rself->lock but must still be written with a CAS so
+// that concurrent fast path updates of numUsers are not lost.
+static inline ocrDataBlockLockableAttr_t loadAttributes(ocrDataBlockLockable_t * rself) {
+    ocrDataBlockLockableAttr_t attr;
+    attr.data = hal_loadRelaxed(&(rself->attributes.data));
+    return attr;
+}
+
+static inline bool casAttributes(ocrDataBlockLockable_t * rself, ocrDataBlockLockableAttr_t oldAttr,
+                                 ocrDataBlockLockableAttr_t newAttr) {
+    return (hal_cmpswap64(&(rself->attributes.data), oldAttr.data, newAttr.data) == oldAttr.data);
+}
+
+//Warning: Calling context must own rself->lock
+static void clearHasWaiters(ocrDataBlockLockable_t * rself) {
+    ocrDataBlockLockableAttr_t oldAttr, newAttr;
+    do {
+        oldAttr = loadAttributes(rself);
+        newAttr = oldAttr;
+        newAttr.hasWaiters = 0;
+    } while (!casAttributes(rself, oldAttr, newAttr));
+}
+
+//Warning: Calling context must own rself->lock
+static bool isAcquireBlocked(ocrDataBlockLockable_t * rself, ocrDataBlockLockableAttr_t attr,
+                             ocrFatGuid_t edt, ocrDbAccessMode_t mode) {
+    switch(mode) {
+    case DB_MODE_CONST:
+        return (attr.modeLock != DB_LOCKED_NONE);
+    case DB_MODE_EW:
+        return (attr.modeLock != DB_LOCKED_NONE) || (attr.numUsers != 0);
+    case DB_MODE_RW:
+        if (attr.modeLock == DB_LOCKED_ITW) {
+            ocrPolicyDomain_t * pd = NULL;
+            getCurrentEnv(&pd, NULL, NULL, NULL);
+            // check of DB already in ITW use by another location
+            return (fatGuidToLocation(pd, edt) != rself->itwLocation);
+        }
+        return (attr.numUsers != 0) || (attr.modeLock == DB_LOCKED_EW);
+    default:
+        // mode == DB_MODE_RO never waits
+        return false;
+    }
+}
+
+// Attributes once an acquire in 'mode' is granted
+static ocrDataBlockLockableAttr_t grantedAttributes(ocrDataBlockLockableAttr_t attr, ocrDbAccessMode_t mode) {
+    if (mode == DB_MODE_EW) {
+        attr.modeLock = DB_LOCKED_EW;
+    } else if ((mode == DB_MODE_RW) && (attr.numUsers == 0)) {
+        attr.modeLock = DB_LOCKED_ITW;
+    }
+    attr.numUsers += 1;
+    return attr;
+}
+
+//Warning: Calling context must own rself->lock
+static void grantAcquired(ocrDataBlockLockable_t * rself, ocrDataBlockLockableAttr_t oldAttr,
+                          ocrDataBlockLockableAttr_t newAttr, ocrFatGuid_t edt, ocrDbAccessMode_t mode, bool isInternal) {
+    if ((mode == DB_MODE_RW) && (oldAttr.numUsers == 0)) {
+        // First ITW user, the lock is for its location
+        ocrPolicyDomain_t * pd = NULL;
+        getCurrentEnv(&pd, NULL, NULL, NULL);
+        rself->itwLocation = fatGuidToLocation(pd, edt);
+    }
+#ifdef OCR_MONITOR_DB_CONTENTION
+    rself->stats.acquires += (mode != DB_MODE_RO);
+#endif
+    DPRINTF(DEBUG_LVL_VERB, "Acquiring DB @ 0x%"PRIx64" (GUID: "GUIDF") from EDT (GUID: "GUIDF") (runtime acquire: %"PRId32") (mode: %"PRId32") (numUsers: %"PRId32") (modeLock: %"PRId32")\n",
+            (u64)rself->base.ptr, GUIDA(rself->base.guid), GUIDA(edt.guid), (u32)isInternal, (int) mode,
+            newAttr.numUsers, newAttr.modeLock);
+}
+
+//Warning: Calling context must own rself->lock and the acquire must not be blocked
+static void grantAcquire(ocrDataBlockLockable_t * rself, ocrFatGuid_t edt, ocrDbAccessMode_t mode, bool isInternal) {
+    ocrDataBlockLockableAttr_t oldAttr, newAttr;
+    do {
+        oldAttr = loadAttributes(rself);
+        newAttr = grantedAttributes(oldAttr, mode);
+    } while (!casAttributes(rself, oldAttr, newAttr));
+    grantAcquired(rself, oldAttr, newAttr, edt, mode, isInternal);
+}
+
 //Warning: This call must be protected with the self->lock in the calling context
 //
 //If the datablock is not available for immediate acquisition, the implementation
@@ -147,8 +291,9 @@ static bool lockButSelf(ocrDataBlockLockable_t *rself) {
 static u8 lockableAcquireInternal(ocrDataBlock_t *self, void** ptr, ocrFatGuid_t edt, u32 edtSlot,
                   ocrDbAccessMode_t mode, bool isInternal, u32 properties) {
     ocrDataBlockLockable_t * rself = (ocrDataBlockLockable_t*) self;
+    ocrDataBlockLockableAttr_t oldAttr = loadAttributes(rself);
 
-    if(rself->attributes.freeRequested && (rself->attributes.numUsers == 0)) {
+    if(oldAttr.freeRequested && (oldAttr.numUsers == 0)) {
         // Most likely stemming from an error in the user-code
         // There's a race between the datablock being freed and having no
         // users with someone else trying to acquire the DB
@@ -162,85 +307,32 @@ static u8 lockableAcquireInternal(ocrDataBlock_t *self, void** ptr, ocrFatGuid_t
         return 0;
     }
 
-    // mode == DB_MODE_RO just fall through
-
-    if (mode == DB_MODE_CONST) {
-        if (rself->attributes.modeLock) {
-            ASSERT(edtSlot != EDT_SLOT_NONE);
-            ocrPolicyDomain_t * pd = NULL;
-            getCurrentEnv(&pd, NULL, NULL, NULL);
-            dbWaiter_t * waiterEntry = (dbWaiter_t *) pd->fcts.pdMalloc(pd, sizeof(dbWaiter_t));
-            waiterEntry->guid = edt.guid;
-            waiterEntry->slot = edtSlot;
-            waiterEntry->isInternal = isInternal;
-            waiterEntry->properties = properties;
-            waiterEntry->next = rself->roWaiterList;
-            rself->roWaiterList = waiterEntry;
-            *ptr = NULL; // not contractual, but should ease debug if misread
-            return OCR_EBUSY;
-        }
-    }
-
-    if (mode == DB_MODE_EW) {
-        if ((rself->attributes.modeLock) || (rself->attributes.numUsers != 0)) {
-            ASSERT(edtSlot != EDT_SLOT_NONE);
-            // The DB is already in use
-            ocrPolicyDomain_t * pd = NULL;
-            getCurrentEnv(&pd, NULL, NULL, NULL);
-            dbWaiter_t * waiterEntry = (dbWaiter_t *) pd->fcts.pdMalloc(pd, sizeof(dbWaiter_t));
-            waiterEntry->guid = edt.guid;
-            waiterEntry->slot = edtSlot;
-            waiterEntry->isInternal = isInternal;
-            waiterEntry->properties = properties;
-            waiterEntry->next = rself->ewWaiterList;
-            rself->ewWaiterList = waiterEntry;
-            *ptr = NULL; // not contractual, but should ease debug if misread
-            return OCR_EBUSY;
-        } else {
-            rself->attributes.modeLock = DB_LOCKED_EW;
-        }
-    }
-
-    if (mode == DB_MODE_RW) {
-        bool enque = false;
-        if (rself->attributes.modeLock == DB_LOCKED_ITW) {
-            ocrPolicyDomain_t * pd = NULL;
-            getCurrentEnv(&pd, NULL, NULL, NULL);
-            // check of DB already in ITW use by another location
-            enque = (fatGuidToLocation(pd, edt) != rself->itwLocation);
-        } else {
-            enque = (rself->attributes.numUsers != 0) || (rself->attributes.modeLock == DB_LOCKED_EW);
-        }
-        if (enque) {
-            ASSERT(edtSlot != EDT_SLOT_NONE);
-            // The DB is already in use, enque
-            ocrPolicyDomain_t * pd = NULL;
-            getCurrentEnv(&pd, NULL, NULL, NULL);
-            dbWaiter_t * waiterEntry = (dbWaiter_t *) pd->fcts.pdMalloc(pd, sizeof(dbWaiter_t));
-            waiterEntry->guid = edt.guid;
-            waiterEntry->slot = edtSlot;
-            waiterEntry->isInternal = isInternal;
-            waiterEntry->properties = properties;
-            waiterEntry->next = rself->itwWaiterList;
-            rself->itwWaiterList = waiterEntry;
-            *ptr = NULL; // not contractual, but should ease debug if misread
-            return OCR_EBUSY;
+    // Waiters are served in arrival order: an acquire that can wait queues up
+    // behind older waiters even if its mode is compatible with the current users.
+    // Acquires that cannot wait only need to be compatible.
+    bool queued = (rself->waitHead != NULL) && (edtSlot != EDT_SLOT_NONE) && (mode != DB_MODE_RO);
+    ocrDataBlockLockableAttr_t newAttr;
+    while (true) {
+        if (queued || isAcquireBlocked(rself, oldAttr, edt, mode)) {
+            // Turn the fast paths off. The CAS also checks that no fast path
+            // release made the DB available since the attributes were read.
+            newAttr = oldAttr;
+            newAttr.hasWaiters = 1;
+            if (casAttributes(rself, oldAttr, newAttr)) {
+                ASSERT(edtSlot != EDT_SLOT_NONE);
+                enqueueWaiter(rself, edt, edtSlot, mode, isInternal, properties);
+                *ptr = NULL; // not contractual, but should ease debug if misread
+                return OCR_EBUSY;
+            }
         } else {
-            // Ruled out all enque scenario, we can acquire.
-            // Just check if we need to grab lock too
-            if (rself->attributes.numUsers == 0) {
-                ocrPolicyDomain_t * pd = NULL;
-                getCurrentEnv(&pd, NULL, NULL, NULL);
-                rself->attributes.modeLock = DB_LOCKED_ITW;
-                rself->itwLocation = fatGuidToLocation(pd, edt);
+            newAttr = grantedAttributes(oldAttr, mode);
+            if (casAttributes(rself, oldAttr, newAttr)) {
+                break;
             }
         }
+        oldAttr = loadAttributes(rself);
     }
-
-    rself->attributes.numUsers += 1;
-    DPRINTF(DEBUG_LVL_VERB, "Acquiring DB @ 0x%"PRIx64" (GUID: "GUIDF") from EDT (GUID: "GUIDF") (runtime acquire: %"PRId32") (mode: %"PRId32") (numUsers: %"PRId32") (modeLock: %"PRId32")\n",
-            (u64)self->ptr, GUIDA(rself->base.guid), GUIDA(edt.guid), (u32)isInternal, (int) mode,
-            rself->attributes.numUsers, rself->attributes.modeLock);
+    grantAcquired(rself, oldAttr, newAttr, edt, mode, isInternal);
 
 #ifdef OCR_ENABLE_STATISTICS
     {
@@ -255,7 +347,7 @@ static u8 lockableAcquireInternal(ocrDataBlock_t *self, void** ptr, ocrFatGuid_t
 /**
  * @brief Setup a callback response message and acquire on behalf of the waiter
  **/
-static void processAcquireCallback(ocrDataBlock_t *self, dbWaiter_t * waiter, ocrDbAccessMode_t waiterMode, u32 properties, ocrPolicyMsg_t * msg) {
+static void processAcquireCallback(ocrDataBlock_t *self, dbWaiter_t * waiter, ocrPolicyMsg_t * msg) {
     ASSERT(waiter->slot != EDT_SLOT_NONE);
     getCurrentEnv(NULL, NULL, NULL, msg);
     //BUG #273: The In/Out nature of certain parameters is exposed here
@@ -269,23 +361,122 @@ static void processAcquireCallback(ocrDataBlock_t *self, dbWaiter_t * waiter, oc
     PD_MSG_FIELD_IO(edtSlot) = waiter->slot;
     // In this implementation properties encodes the MODE + isInternal +
     // any additional flags set by the PD (such as the FETCH flag)
-    PD_MSG_FIELD_IO(properties) = properties;
+    PD_MSG_FIELD_IO(properties) = waiter->properties;
     // A response msg is being built, must set all the OUT fields
     PD_MSG_FIELD_O(size) = self->size;
     PD_MSG_FIELD_O(returnDetail) = 0;
-    //NOTE: we still have the lock, calling the internal version
-    u8 res __attribute__((unused)) = lockableAcquireInternal(self, &PD_MSG_FIELD_O(ptr), PD_MSG_FIELD_IO(edt),
-                                  PD_MSG_FIELD_IO(edtSlot), waiterMode, waiter->isInternal,
-                                  PD_MSG_FIELD_IO(properties));
-    // Not much we would be able to recover here
-    ASSERT(!res);
+    //NOTE: we still have the lock and the waiter has been elected, no need to check
+    grantAcquire((ocrDataBlockLockable_t *) self, PD_MSG_FIELD_IO(edt), waiter->mode, waiter->isInternal);
+    PD_MSG_FIELD_O(ptr) = self->ptr;
 #undef PD_MSG
 #undef PD_TYPE
 }
 
+/**
+ * @brief Grant access to the oldest waiter and to every waiter that can share it
+ *
+ * An EW waiter is granted alone. A CONST waiter is granted along with all the
+ * CONST waiters in the queue and an RW waiter along with all the RW waiters from
+ * the same location (ITW).
+ * Warning: Calling context must own rself->lock, it is released on return
+ **/
+static u8 grantWaiters(ocrDataBlock_t *self) {
+    ocrDataBlockLockable_t * rself = (ocrDataBlockLockable_t*) self;
+    ocrPolicyDomain_t * pd = NULL;
+    PD_MSG_STACK(msg);
+    getCurrentEnv(&pd, NULL, NULL, NULL);
+    dbWaiter_t * waiter = rself->waitHead;
+    ocrDbAccessMode_t mode = waiter->mode;
+    ASSERT((loadAttributes(rself).numUsers == 0) && (loadAttributes(rself).modeLock == DB_LOCKED_NONE));
+
+    if (mode == DB_MODE_EW) {
+        rself->waitHead = waiter->next;
+        if (rself->waitHead == NULL) {
+            rself->waitTail = NULL;
+        }
+#ifdef OCR_MONITOR_DB_CONTENTION
+        recordWait(rself, waiter, false);
+#endif
+        // Acquire the DB on behalf of the next waiter (i.e. numUser++)
+        processAcquireCallback(self, waiter, &msg);
+        recycleWaiter(rself, waiter);
+        if (rself->waitHead == NULL) {
+            clearHasWaiters(rself);
+        }
+        // Will process asynchronous callback message outside of the critical section
+        rself->worker = NULL;
+        hal_unlock32(&(rself->lock));
+        RESULT_ASSERT(pd->fcts.processMessage(pd, &msg, true), ==, 0);
+        return 0;
+    }
+
+    // Detach all the waiters that are granted. Responses may be processed
+    // synchronously and re-enter this DB (see lockButSelf) so the queue
+    // must be consistent before any of them is sent.
+    ocrLocation_t itwLocation = (mode == DB_MODE_RW) ? guidToLocation(pd, waiter->guid) : INVALID_LOCATION;
+    dbWaiter_t * granted = NULL;
+    dbWaiter_t ** grantedTail = &granted;
+    dbWaiter_t ** prev = &(rself->waitHead);
+    dbWaiter_t * kept = NULL;
+    while (waiter != NULL) {
+        dbWaiter_t * next = waiter->next;
+        if ((waiter->mode == mode) &&
+            ((mode == DB_MODE_CONST) || (guidToLocation(pd, waiter->guid) == itwLocation))) {
+#ifdef OCR_MONITOR_DB_CONTENTION
+            recordWait(rself, waiter, (kept != NULL));
+#endif
+            *prev = next;
+            waiter->next = NULL;
+            *grantedTail = waiter;
+            grantedTail = &(waiter->next);
+        } else {
+            kept = waiter;
+            prev = &(waiter->next);
+        }
+        waiter = next;
+    }
+    rself->waitTail = kept;
+
+    waiter = granted;
+    while (waiter != NULL) {
+        dbWaiter_t * next = waiter->next;
+        processAcquireCallback(self, waiter, &msg);
+        recycleWaiter(rself, waiter);
+        //PERF: Would be nice to do that outside the lock but it incurs allocating
+        // an array of messages and traversing the list of waiters again
+        RESULT_ASSERT(pd->fcts.processMessage(pd, &msg, true), ==, 0);
+        waiter = next;
+    }
+    if (rself->waitHead == NULL) {
+        clearHasWaiters(rself);
+    }
+    rself->worker = NULL;
+    hal_unlock32(&(rself->lock));
+    return 0;
+}
+
 u8 lockableAcquire(ocrDataBlock_t *self, void** ptr, ocrFatGuid_t edt, u32 edtSlot,
                   ocrDbAccessMode_t mode, bool isInternal, u32 properties) {
     ocrDataBlockLockable_t *rself = (ocrDataBlockLockable_t*)self;
+    // Fast path: readers join without taking the lock as long as nobody waits
+    // and no free is pending. RO never waits so it may also join a mode locked
+    // DB, CONST may not. With waiters, a release may be granting them under
+    // the lock and must not see a user appear: readers take the locked path.
+    if (((mode == DB_MODE_RO) || (mode == DB_MODE_CONST)) && !(properties & DB_PROP_RT_OBLIVIOUS)) {
+        ocrDataBlockLockableAttr_t oldAttr = loadAttributes(rself);
+        while (!oldAttr.freeRequested && !oldAttr.hasWaiters &&
+               ((mode == DB_MODE_RO) || (oldAttr.modeLock == DB_LOCKED_NONE))) {
+            ocrDataBlockLockableAttr_t newAttr = oldAttr;
+            newAttr.numUsers += 1;
+            if (casAttributes(rself, oldAttr, newAttr)) {
+                DPRINTF(DEBUG_LVL_VERB, "Acquiring DB @ 0x%"PRIx64" (GUID: "GUIDF") from EDT (GUID: "GUIDF") (runtime acquire: %"PRId32") (mode: %"PRId32") (numUsers: %"PRId32") (lock-free)\n",
+                        (u64)self->ptr, GUIDA(rself->base.guid), GUIDA(edt.guid), (u32)isInternal, (int) mode, newAttr.numUsers);
+                *ptr = self->ptr;
+                return 0;
+            }
+            oldAttr = loadAttributes(rself);
+        }
+    }
     bool unlock = lockButSelf(rself);
     u8 res = lockableAcquireInternal(self, ptr, edt, edtSlot, mode, isInternal, properties);
     if (unlock) {
@@ -297,9 +488,28 @@ u8 lockableAcquire(ocrDataBlock_t *self, void** ptr, ocrFatGuid_t edt, u32 edtSl
 
 u8 lockableRelease(ocrDataBlock_t *self, ocrFatGuid_t edt, bool isInternal) {
     ocrDataBlockLockable_t *rself = (ocrDataBlockLockable_t*)self;
-    dbWaiter_t * waiter = NULL;
     DPRINTF(DEBUG_LVL_VERB, "Releasing DB @ 0x%"PRIx64" (GUID "GUIDF") from EDT "GUIDF" (runtime release: %"PRId32")\n",
             (u64)self->ptr, GUIDA(rself->base.guid), GUIDA(edt.guid), (u32)isInternal);
+    ocrDataBlockLockableAttr_t oldAttr, newAttr;
+    // Fast path: leave without taking the lock unless this is the last
+    // user and there is a mode lock, waiters or a pending free to handle.
+    oldAttr = loadAttributes(rself);
+    while ((oldAttr.numUsers > 1) ||
+           ((oldAttr.numUsers == 1) && (oldAttr.modeLock == DB_LOCKED_NONE) &&
+            !oldAttr.hasWaiters && !oldAttr.freeRequested)) {
+        newAttr = oldAttr;
+        newAttr.numUsers -= 1;
+        if (casAttributes(rself, oldAttr, newAttr)) {
+#ifdef OCR_ENABLE_STATISTICS
+            {
+                statsDB_REL(getCurrentPD(), edt.guid, (ocrTask_t*)edt.metaDataPtr, self->guid, self);
+            }
+#endif /* OCR_ENABLE_STATISTICS */
+            return 0;
+        }
+        oldAttr = loadAttributes(rself);
+    }
+
     // Start critical section
     hal_lock32(&(rself->lock));
     ocrWorker_t * worker;
@@ -309,143 +519,43 @@ u8 lockableRelease(ocrDataBlock_t *self, ocrFatGuid_t edt, bool isInternal) {
     // The registered EDT can be different if a DB has been released by the user
     // and the runtime tries to release it afterwards. It could be that in
     // between the two releases, the slot is used for another EDT's DB.
-    rself->attributes.numUsers -= 1;
-
-    // catch errors when release is called one too many time
-    ASSERT(rself->attributes.numUsers != (u32)-1);
-
-    //IMPL: this is probably not very fair
-    if (rself->attributes.numUsers == 0) {
-        // last user of the DB, check what the transition looks like:
-        // W -> W (pop the next EW waiter)
-        // RO -> EW (pop the next EW waiter)
-        // EW -> RO (pop all RO waiter)
-        // RO -> RO (nothing to do)
-        if (rself->attributes.modeLock) {
-            // Last ITW writer. Most likely there are either more ITW on their way
-            // or we're done writing and there are RO piling up or on their way.
-            rself->attributes.modeLock = DB_LOCKED_NONE; // release and see what we got
-            rself->itwLocation = INVALID_LOCATION;
-            if (rself->roWaiterList != NULL) {
-                waiter = popRoWaiter(self);
-            }
-        } else {
-            // We're in RO, by all means there should be no RO waiter
-            ASSERT(rself->roWaiterList == NULL);
-            // Try to favor writers
-        }
-
-        if (waiter == NULL) {
-            if (rself->itwWaiterList != NULL) {
-                waiter = popItwWaiter(self);
-                rself->attributes.modeLock = DB_LOCKED_ITW;
-            } else if (rself->ewWaiterList != NULL) {
-                waiter = popEwWaiter(self);
-                rself->attributes.modeLock = DB_LOCKED_EW;
-            }
+    do {
+        oldAttr = loadAttributes(rself);
+        // catch errors when release is called one too many time
+        ASSERT(oldAttr.numUsers != 0);
+        newAttr = oldAttr;
+        newAttr.numUsers -= 1;
+        if (newAttr.numUsers == 0) {
+            // Last user of the DB, release any mode lock
+            newAttr.modeLock = DB_LOCKED_NONE;
         }
+    } while (!casAttributes(rself, oldAttr, newAttr));
 
-        if (rself->attributes.modeLock == DB_LOCKED_ITW) {
-            // NOTE: by design there should be a waiter otherwise we would have exit the modeLock
-            ASSERT(waiter != NULL);
-            // Switching to ITW mode, now we can release all waiters that belong
-            // to the same location the elected waiter is.
-            ocrPolicyDomain_t * pd = NULL;
-            PD_MSG_STACK(msg);
-            getCurrentEnv(&pd, NULL, NULL, NULL);
-            // Setup: Have ITW lock + its right location for acquire
-            ocrLocation_t itwLocation = guidToLocation(pd, waiter->guid);
-            rself->itwLocation = itwLocation;
-            dbWaiter_t * prev = waiter;
-            do {
-                dbWaiter_t * next = waiter->next;
-                if (itwLocation == guidToLocation(pd, waiter->guid)) {
-                    processAcquireCallback(self, waiter, DB_MODE_RW, waiter->properties, &msg);
-                    if (prev == waiter) { // removing head
-                        prev = next;
-                        rself->itwWaiterList = prev;
-                    } else {
-                        prev->next = next;
-                    }
-                    pd->fcts.pdFree(pd, waiter);
-                    waiter = next;
-                    //PERF: Would be nice to do that outside the lock but it incurs allocating
-                    // an array of messages and traversing the list of waiters again
-                    RESULT_ASSERT(pd->fcts.processMessage(pd, &msg, true), ==, 0);
-                } else {
-                    prev = waiter;
-                    waiter = next;
-                }
-            } while (waiter != NULL);
-            #ifdef OCR_ENABLE_STATISTICS
-                {
-                    statsDB_REL(getCurrentPD(), edt.guid, (ocrTask_t*)edt.metaDataPtr, self->guid, self);
-                }
-            #endif /* OCR_ENABLE_STATISTICS */
-            rself->worker = NULL;
-            hal_unlock32(&(rself->lock));
-            return 0;
-        } else if (rself->attributes.modeLock == DB_LOCKED_EW) {
-            // EW: by design there should be a waiter otherwise we would have exit the modeLock
-            ASSERT(waiter != NULL);
-            ocrPolicyDomain_t * pd = NULL;
-            PD_MSG_STACK(msg);
-            getCurrentEnv(&pd, NULL, NULL, &msg);
-            rself->attributes.modeLock = DB_LOCKED_NONE; // technicality so that acquire sees the DB is not acquired
-            // Acquire the DB on behalf of the next waiter (i.e. numUser++)
-            processAcquireCallback(self, waiter, DB_MODE_EW, waiter->properties, &msg);
-            // Will process asynchronous callback message outside of the critical section
+    if (newAttr.numUsers == 0) {
+        // Hand the DB over to the waiters, oldest first.
+        rself->itwLocation = INVALID_LOCATION;
+        if (rself->waitHead != NULL) {
             #ifdef OCR_ENABLE_STATISTICS
                 {
                     statsDB_REL(getCurrentPD(), edt.guid, (ocrTask_t*)edt.metaDataPtr, self->guid, self);
                 }
             #endif /* OCR_ENABLE_STATISTICS */
-            rself->worker = NULL;
-            hal_unlock32(&(rself->lock));
-            pd->fcts.pdFree(pd, waiter);
-            RESULT_ASSERT(pd->fcts.processMessage(pd, &msg, true), ==, 0);
-            return 0;
-        } else { // RO
-            //NOTE: if waiter is NULL it means there was nobody queued up for any mode
-            if (waiter != NULL) {
-                // transition EW -> RO, release all RO waiters
-                ocrPolicyDomain_t * pd = NULL;
-                PD_MSG_STACK(msg);
-                getCurrentEnv(&pd, NULL, NULL, NULL);
-                rself->roWaiterList = NULL;
-                do {
-                    processAcquireCallback(self, waiter, DB_MODE_CONST, waiter->properties, &msg);
-                    dbWaiter_t * next = waiter->next;
-                    pd->fcts.pdFree(pd, waiter);
-                    //PERF: Would be nice to do that outside the lock but it incurs allocating
-                    // an array of messages and traversing the list of waiters again
-                    RESULT_ASSERT(pd->fcts.processMessage(pd, &msg, true), ==, 0);
-                    waiter = next;
-                } while (waiter != NULL);
-                ASSERT(rself->roWaiterList == NULL);
-                #ifdef OCR_ENABLE_STATISTICS
-                    {
-                        statsDB_REL(getCurrentPD(), edt.guid, (ocrTask_t*)edt.metaDataPtr, self->guid, self);
-                    }
-                #endif /* OCR_ENABLE_STATISTICS */
-                rself->worker = NULL;
-                hal_unlock32(&(rself->lock));
-                return 0;
-            }
+            return grantWaiters(self);
         }
     }
     DPRINTF(DEBUG_LVL_VVERB, "DB (GUID: "GUIDF") attributes: numUsers %"PRId32" (including %"PRId32" runtime users); freeRequested %"PRId32"\n",
-            GUIDA(self->guid), rself->attributes.numUsers, rself->attributes.internalUsers, rself->attributes.freeRequested);
+            GUIDA(self->guid), newAttr.numUsers, newAttr.internalUsers, newAttr.freeRequested);
 
 #ifdef OCR_ENABLE_STATISTICS
     {
         statsDB_REL(getCurrentPD(), edt.guid, (ocrTask_t*)edt.metaDataPtr, self->guid, self);
     }
 #endif /* OCR_ENABLE_STATISTICS */
-    // Check if we need to free the block
-    if(rself->attributes.numUsers == 0 &&
-        rself->attributes.internalUsers == 0 &&
-        rself->attributes.freeRequested == 1) {
+    // Check if we need to free the block. A pending free turns the fast
+    // paths off so the DB cannot have gained users since the CAS.
+    if(newAttr.numUsers == 0 &&
+        newAttr.internalUsers == 0 &&
+        newAttr.freeRequested == 1) {
         rself->worker = NULL;
         hal_unlock32(&(rself->lock));
         return lockableDestruct(self);
@@ -460,36 +570,35 @@ u8 lockableDestruct(ocrDataBlock_t *self) {
     ocrPolicyDomain_t *pd = NULL;
     PD_MSG_STACK(msg);
     getCurrentEnv(&pd, NULL, NULL, &msg);
+    ocrDataBlockLockable_t *rself = (ocrDataBlockLockable_t*)self;
+    ASSERT(rself->waitHead == NULL);
+    while (rself->freeWaiters != NULL) {
+        dbWaiter_t * next = rself->freeWaiters->next;
+        pd->fcts.pdFree(pd, rself->freeWaiters);
+        rself->freeWaiters = next;
+    }
 
     if (self->flags & DB_PROP_RT_PROXY) {
         pd->fcts.pdFree(pd, self);
         return 0;
     }
 
+#ifdef OCR_MONITOR_DB_CONTENTION
+    reportContention(rself);
+#endif
 #ifdef OCR_ASSERT
-    ocrDataBlockLockable_t *rself = (ocrDataBlockLockable_t*)self;
     // Any of these wrong would indicate a race between free and DB's consumers
     ASSERT(rself->attributes.numUsers == 0);
     ASSERT(rself->attributes.internalUsers == 0);
     ASSERT(rself->attributes.freeRequested == 1);
-    ASSERT(rself->roWaiterList == NULL);
-    ASSERT(rself->ewWaiterList == NULL);
-    ASSERT(rself->itwWaiterList == NULL);
     ASSERT(rself->lock == 0);
 #endif
 
-#define PD_MSG (&msg)
-#define PD_TYPE PD_MSG_MEM_UNALLOC
-    msg.type = PD_MSG_MEM_UNALLOC | PD_MSG_REQUEST;
-    PD_MSG_FIELD_I(allocatingPD.guid) = self->allocatingPD;
-    PD_MSG_FIELD_I(allocatingPD.metaDataPtr) = NULL;
-    PD_MSG_FIELD_I(allocator.guid) = self->allocator;
-    PD_MSG_FIELD_I(allocator.metaDataPtr) = NULL;
-    PD_MSG_FIELD_I(ptr) = self->ptr;
-    PD_MSG_FIELD_I(type) = DB_MEMTYPE;
-    PD_MSG_FIELD_I(properties) = 0;
-    RESULT_PROPAGATE(pd->fcts.processMessage(pd, &msg, false));
-
+    // Co-allocated metadata is freed along with the data, after the GUID is released
+    bool coalloc = ((self->flags & DB_PROP_RT_COALLOC) != 0);
+    ocrGuid_t allocatingPD = self->allocatingPD;
+    ocrGuid_t allocator = self->allocator;
+    void * block = coalloc ? (void*)self : self->ptr;
 
 #ifdef OCR_ENABLE_STATISTICS
     // This needs to be done before GUID is freed.
@@ -499,14 +608,25 @@ u8 lockableDestruct(ocrDataBlock_t *self) {
         statsDB_DESTROY(pd, task->guid, task, self->allocator, NULL, self->guid, self);
     }
 #endif /* OCR_ENABLE_STATISTICS */
-#undef PD_TYPE
+#define PD_MSG (&msg)
 #define PD_TYPE PD_MSG_GUID_DESTROY
-    getCurrentEnv(NULL, NULL, NULL, &msg);
     msg.type = PD_MSG_GUID_DESTROY | PD_MSG_REQUEST;
     // These next two statements may be not required. Just to be safe
     PD_MSG_FIELD_I(guid.guid) = self->guid;
     PD_MSG_FIELD_I(guid.metaDataPtr) = self;
-    PD_MSG_FIELD_I(properties) = 1; // Free metadata
+    PD_MSG_FIELD_I(properties) = coalloc ? 0 : 1; // Free metadata
+    RESULT_PROPAGATE(pd->fcts.processMessage(pd, &msg, false));
+#undef PD_TYPE
+#define PD_TYPE PD_MSG_MEM_UNALLOC
+    getCurrentEnv(NULL, NULL, NULL, &msg);
+    msg.type = PD_MSG_MEM_UNALLOC | PD_MSG_REQUEST;
+    PD_MSG_FIELD_I(allocatingPD.guid) = allocatingPD;
+    PD_MSG_FIELD_I(allocatingPD.metaDataPtr) = NULL;
+    PD_MSG_FIELD_I(allocator.guid) = allocator;
+    PD_MSG_FIELD_I(allocator.metaDataPtr) = NULL;
+    PD_MSG_FIELD_I(ptr) = block;
+    PD_MSG_FIELD_I(type) = DB_MEMTYPE;
+    PD_MSG_FIELD_I(properties) = 0;
     RESULT_PROPAGATE(pd->fcts.processMessage(pd, &msg, false));
 #undef PD_MSG
 #undef PD_TYPE
@@ -521,13 +641,18 @@ u8 lockableFree(ocrDataBlock_t *self, ocrFatGuid_t edt, u32 properties) {
             (u64)self->ptr, GUIDA(rself->base.guid), properties);
 
     hal_lock32(&(rself->lock));
-    if(rself->attributes.freeRequested) {
-        hal_unlock32(&(rself->lock));
-        return OCR_EPERM;
-    }
+    ocrDataBlockLockableAttr_t oldAttr, newAttr;
+    do {
+        oldAttr = loadAttributes(rself);
+        if(oldAttr.freeRequested) {
+            hal_unlock32(&(rself->lock));
+            return OCR_EPERM;
+        }
+        newAttr = oldAttr;
+        newAttr.freeRequested = 1;
+    } while (!casAttributes(rself, oldAttr, newAttr));
 
-    rself->attributes.freeRequested = 1;
-    if(rself->attributes.numUsers == 0 && rself->attributes.internalUsers == 0) {
+    if(newAttr.numUsers == 0 && newAttr.internalUsers == 0) {
         hal_unlock32(&(rself->lock));
         return lockableDestruct(self);
     }
@@ -577,7 +702,14 @@ u8 newDataBlockLockable(ocrDataBlockFactory_t *factory, ocrFatGuid_t *guid, ocrF
 #define PD_TYPE PD_MSG_GUID_CREATE
         msg.type = PD_MSG_GUID_CREATE | PD_MSG_REQUEST | PD_MSG_REQ_RESPONSE;
         PD_MSG_FIELD_IO(guid) = *guid;
-        PD_MSG_FIELD_I(size) = mSize;
+        if (flags & DB_PROP_RT_COALLOC) {
+            // The metadata was allocated with the data: only associate a GUID
+            ASSERT(mSize <= factory->metaSize);
+            PD_MSG_FIELD_IO(guid.metaDataPtr) = (void*)((u64)ptr - factory->metaSize);
+            PD_MSG_FIELD_I(size) = 0;
+        } else {
+            PD_MSG_FIELD_I(size) = mSize;
+        }
         PD_MSG_FIELD_I(kind) = OCR_GUID_DB;
         PD_MSG_FIELD_I(properties) = flags & GUID_PROP_ALL;
 
@@ -601,18 +733,31 @@ u8 newDataBlockLockable(ocrDataBlockFactory_t *factory, ocrFatGuid_t *guid, ocrF
     result->base.fctId = factory->factoryId;
     // Only keep flags that represent the nature of
     // the DB as opposed to one-time usage creation flags
-    result->base.flags = (flags & (DB_PROP_SINGLE_ASSIGNMENT | DB_PROP_RT_PROXY));
+    result->base.flags = (flags & (DB_PROP_SINGLE_ASSIGNMENT | DB_PROP_RT_PROXY | DB_PROP_RT_COALLOC));
     result->lock = 0;
     result->attributes.flags = result->base.flags;
     result->attributes.numUsers = 0;
     result->attributes.internalUsers = 0;
     result->attributes.freeRequested = 0;
     result->attributes.modeLock = DB_LOCKED_NONE;
-    result->ewWaiterList = NULL;
-    result->roWaiterList = NULL;
-    result->itwWaiterList = NULL;
+    result->attributes.hasWaiters = 0;
+    result->waitHead = NULL;
+    result->waitTail = NULL;
+    result->freeWaiters = NULL;
     result->itwLocation = INVALID_LOCATION;
     result->worker = NULL;
+#ifdef OCR_MONITOR_DB_CONTENTION
+    {
+        ocrDataBlockLockableStats_t * stats = &(result->stats);
+        stats->acquires = stats->waited = stats->overtakes = 0;
+        stats->waitTotal = stats->waitMax = 0;
+        stats->queueLength = stats->queueMax = 0;
+        u32 b;
+        for (b = 0; b < DB_LOCKABLE_WAIT_BUCKETS; ++b) {
+            stats->waitHist[b] = 0;
+        }
+    }
+#endif
 
     if (hintc == 0) {
         result->hint.hintMask = 0;
@@ -634,7 +779,7 @@ u8 newDataBlockLockable(ocrDataBlockFactory_t *factory, ocrFatGuid_t *guid, ocrF
 
     // Do this at the very end; it indicates that the object
     // is actually valid
-    hal_fence();
+    hal_fenceRelease();
     result->base.guid = resultGuid;
 
     guid->guid = resultGuid;
@@ -690,6 +835,9 @@ ocrDataBlockFactory_t *newDataBlockFactoryLockable(ocrParamList_t *perType, u32
     base->fcts.getHint = FUNC_ADDR(u8 (*)(ocrDataBlock_t*, ocrHint_t*), lockableGetHint);
     base->fcts.getRuntimeHint = FUNC_ADDR(ocrRuntimeHint_t* (*)(ocrDataBlock_t*), getRuntimeHintDbLockable);
     base->factoryId = factoryId;
+    // Whole cache lines of metadata, so that the payload of co-allocated DBs
+    // keeps the alignment of the allocator's block (not a cache line per se)
+    base->metaSize = (sizeof(ocrDataBlockLockable_t) + OCR_HINT_COUNT_DB_LOCKABLE*sizeof(u64) + 63) & ~63ULL;
     //Setup hint framework
     base->hintPropMap = (u64*)runtimeChunkAlloc(sizeof(u64)*(OCR_HINT_DB_PROP_END - OCR_HINT_DB_PROP_START - 1), PERSISTENT_CHUNK);
     OCR_HINT_SETUP(base->hintPropMap, ocrHintPropDbLockable, OCR_HINT_COUNT_DB_LOCKABLE, OCR_HINT_DB_PROP_START, OCR_HINT_DB_PROP_END);
@@ -38,13 +38,34 @@ typedef union {
         u64 internalUsers : 15;
         u64 freeRequested: 1;
         u64 modeLock : 2;
-        u64 _padding : 1;
+        u64 hasWaiters : 1;
     };
-    u64 data;
+    u64 data; // Updated with CAS (see loadAttributes/casAttributes)
 } ocrDataBlockLockableAttr_t;
 
 // Declared in .c
-struct dbWaiter_t;
+struct _dbWaiter_t;
+
+#ifdef OCR_MONITOR_DB_CONTENTION
+// One bucket per power of two of the wait time in ns
+#define DB_LOCKABLE_WAIT_BUCKETS 64
+
+/**
+ * @brief Contention statistics of a datablock
+ *
+ * Reported when the datablock is destroyed if any acquire had to wait.
+ */
+typedef struct {
+    u64 acquires;      /**< Acquires granted under the lock (RO excluded) */
+    u64 waited;        /**< Acquires granted after waiting in the queue */
+    u64 overtakes;     /**< Waiters granted ahead of an older waiter */
+    u64 waitTotal;     /**< Sum of the wait times (ns) */
+    u64 waitMax;       /**< Longest wait time (ns) */
+    u32 queueLength;   /**< Current number of waiters */
+    u32 queueMax;      /**< Largest number of waiters seen */
+    u32 waitHist[DB_LOCKABLE_WAIT_BUCKETS]; /**< Wait times histogram (log2 ns) */
+} ocrDataBlockLockableStats_t;
+#endif
 
 typedef struct _ocrDataBlockLockable_t {
     ocrDataBlock_t base;
@@ -53,12 +74,15 @@ typedef struct _ocrDataBlockLockable_t {
     u32 lock; /**< Lock for this data-block */
     ocrDataBlockLockableAttr_t attributes; /**< Attributes for this data-block */
 
-    struct _dbWaiter_t * ewWaiterList;  /**< EDTs waiting for exclusive write access */
-    struct _dbWaiter_t * itwWaiterList; /**< EDTs waiting for intent-to-write access */
-    struct _dbWaiter_t * roWaiterList;  /**< EDTs waiting for read only access */
+    struct _dbWaiter_t * waitHead;    /**< Oldest EDT waiting for access (any mode) */
+    struct _dbWaiter_t * waitTail;    /**< Most recent EDT waiting for access */
+    struct _dbWaiter_t * freeWaiters; /**< Waiter nodes kept for reuse */
     ocrLocation_t itwLocation;
     ocrWorker_t * worker; /**< worker currently owning the DB internal lock */
     ocrRuntimeHint_t hint;
+#ifdef OCR_MONITOR_DB_CONTENTION
+    ocrDataBlockLockableStats_t stats;
+#endif
 } ocrDataBlockLockable_t;
 
 extern ocrDataBlockFactory_t* newDataBlockFactoryLockable(ocrParamList_t *perType, u32 factoryId);
@@ -285,7 +285,7 @@ u8 newDataBlockRegular(ocrDataBlockFactory_t *factory, ocrFatGuid_t *guid, ocrFa
 
     // Do this at the very end; it indicates that the object
     // is actually valid
-    hal_fence();
+    hal_fenceRelease();
     result->base.guid = resultGuid;
 
     guid->guid = resultGuid;
@@ -341,6 +341,7 @@ ocrDataBlockFactory_t *newDataBlockFactoryRegular(ocrParamList_t *perType, u32 f
     base->fcts.getHint = FUNC_ADDR(u8 (*)(ocrDataBlock_t*, ocrHint_t*), regularGetHint);
     base->fcts.getRuntimeHint = FUNC_ADDR(ocrRuntimeHint_t* (*)(ocrDataBlock_t*), getRuntimeHintDbRegular);
     base->factoryId = factoryId;
+    base->metaSize = 0;
     //Setup hint framework
     base->hintPropMap = (u64*)runtimeChunkAlloc(sizeof(u64)*(OCR_HINT_DB_PROP_END - OCR_HINT_DB_PROP_START - 1), PERSISTENT_CHUNK);
     OCR_HINT_SETUP(base->hintPropMap, ocrHintPropDbRegular, OCR_HINT_COUNT_DB_REGULAR, OCR_HINT_DB_PROP_START, OCR_HINT_DB_PROP_END);
@@ -39,6 +39,60 @@
 
 #define DEBUG_TYPE INIPARSING
 
+#ifdef OCR_STARTUP_TIMINGS
+// Phases of the bring-up, timed in the order in which they happen
+typedef enum {
+    STARTUP_PLATFORM_INIT,
+    STARTUP_CONFIG_LOAD,
+    STARTUP_FACTORIES,
+    STARTUP_INSTANCES,
+    STARTUP_DEPENDENCES,
+    STARTUP_RL_CONFIG_PARSE,
+    STARTUP_RL_NETWORK_OK,
+    STARTUP_RL_PD_OK,
+    STARTUP_RL_MEMORY_OK,
+    STARTUP_RL_GUID_OK,
+    STARTUP_RL_COMPUTE_OK,
+    STARTUP_RL_USER_OK,
+    STARTUP_TEAR_DOWN,
+    STARTUP_MAX
+} startupPhase_t;
+
+static const char * startupPhase_str[] = {
+    "platform init",
+    "config load",
+    "factories",
+    "instances",
+    "dependences",
+    "RL_CONFIG_PARSE",
+    "RL_NETWORK_OK",
+    "RL_PD_OK",
+    "RL_MEMORY_OK",
+    "RL_GUID_OK",
+    "RL_COMPUTE_OK",
+    "RL_USER_OK (application)",
+    "tear down",
+};
+
+// startupTimes[p+1] is the time at which phase p ended
+static u64 startupTimes[STARTUP_MAX+1];
+#define STARTUP_TIME_BEGIN() startupTimes[0] = salGetTime()
+#define STARTUP_TIME_END(phase) startupTimes[(phase)+1] = salGetTime()
+
+static void printStartupTimes(void) {
+    u32 i;
+    for (i = 0; i < STARTUP_MAX; ++i) {
+        fprintf(stderr, "Startup %-26s %10"PRIu64" us\n", startupPhase_str[i],
+                (startupTimes[i+1] - startupTimes[i])/1000);
+    }
+    fprintf(stderr, "Startup %-26s %10"PRIu64" us\n", "bring-up total",
+            (startupTimes[STARTUP_RL_COMPUTE_OK+1] - startupTimes[0])/1000);
+}
+#else
+#define STARTUP_TIME_BEGIN()
+#define STARTUP_TIME_END(phase)
+#endif
+
 /* Configuration parsing options */
 #ifndef ENABLE_EXTENSION_LEGACY
 // Defined in ocr-legacy.h but only included in ENABLE_EXTENSION_LEGACY
@@ -49,9 +103,12 @@ typedef struct _ocrConfig_t {
 } ocrConfig_t;
 #endif
 enum {
-    OPT_NONE, OPT_CONFIG, OPT_VERSION, OPT_HELP
+    OPT_NONE, OPT_CONFIG, OPT_CONFIG_COMPILE, OPT_VERSION, OPT_HELP
 };
 
+// Set with -ocr:cfgcompile
+static const char * planFile = NULL;
+
 // Helper methods
 static struct options {
     char *flag;
@@ -62,6 +119,9 @@ static struct options {
     {
         "cfg", "OCR_CONFIG", OPT_CONFIG, "-ocr:cfg <file> : the OCR runtime configuration file to use."
     },
+    {
+        "cfgcompile", "", OPT_CONFIG_COMPILE, "-ocr:cfgcompile <file> : compile the configuration file into a binary plan and exit."
+    },
     {
         "version", "", OPT_VERSION, "-ocr:version : print OCR version"
     },
@@ -149,6 +209,13 @@ static s32 readFromArgs(s32 argc, const char* argv[], ocrConfig_t * ocrConfig) {
                 argv[cur+1] = NULL;
                 cur++; // skip param
                 userArgs-=2;
+            } else if (strcmp("cfgcompile", ocrArg) == 0) {
+                checkNextArgExists(cur, argc, "cfgcompile");
+                planFile = argv[cur+1];
+                argv[cur] = NULL;
+                argv[cur+1] = NULL;
+                cur++; // skip param
+                userArgs-=2;
             } else if (strcmp("version", ocrArg) == 0) {
                 printVersion();
                 exit(0);
@@ -184,6 +251,10 @@ void ocrParseArgs(s32 argc, const char* argv[], ocrConfig_t * ocrConfig) {
     // Check for mandatory options
     checkOcrOption(ocrConfig);
 
+    if (planFile != NULL) {
+        exit(compile_config(ocrConfig->iniFile, planFile));
+    }
+
     // Pack argument list
     s32 cur = 0;
     s32 head = 0;
@@ -276,7 +347,7 @@ static dep_t typeDeps[] = {
 
 extern char* populate_type(ocrParamList_t **type_param, type_enum index, dictionary *dict, char *secname);
 int populate_inst(ocrParamList_t **inst_param, int inst_param_size, void **instance, int *type_counts, char ***factory_names, void ***all_factories, void ***all_instances, type_enum index, dictionary *dict, char *secname);
-extern int build_deps (dictionary *dict, int A, int B, char *refstr, void ***all_instances, ocrParamList_t ***inst_params);
+extern int build_deps (dictionary *dict, section_t *sections, int nsec, int A, int B, char *refstr, void ***all_instances, ocrParamList_t ***inst_params);
 extern int build_deps_types (int A, int B, char *refstr, void **pdinst, int pdcount, int type_counts, void ***all_factories, ocrParamList_t ***type_params);
 extern void *create_factory (type_enum index, char *factory_name, ocrParamList_t *paramlist);
 extern int read_range(dictionary *dict, char *sec, char *field, int *low, int *high);
@@ -471,8 +542,14 @@ void bringUpRuntime(ocrConfig_t *ocrConfig) {
     const char *inifile = ocrConfig->iniFile;
     ASSERT(inifile != NULL);
 
-    int i, j, count=0, nsec;
-    dictionary *dict = iniparser_load(inifile);
+    int i, j, count=0, nsec=0;
+    section_t *sections = NULL;
+    dictionary *dict = load_config(inifile, &sections, &nsec);
+    if (dict == NULL) {
+        fprintf(stderr, "ERROR: cannot load runtime configuration file: %s\n", inifile);
+        exit(1);
+    }
+    STARTUP_TIME_END(STARTUP_CONFIG_LOAD);
 
 #ifdef ENABLE_BUILDER_ONLY
     builderPreamble(dict);
@@ -497,76 +574,72 @@ void bringUpRuntime(ocrConfig_t *ocrConfig) {
     // POPULATE TYPES
     DPRINTF(DEBUG_LVL_INFO, "========= Create factories ==========\n");
 
-    nsec = iniparser_getnsec(dict);
     for (j = 0; j < total_types; j++) {
         type_counts[j] =  type_max[j];
     }
 
     for (i = 0; i < nsec; i++) {
-        char * secname = iniparser_getsecname(dict, i);
-        for (j = 0; j < total_types; j++) {
-            if (strncasecmp(type_str[j], secname, strlen(type_str[j]))==0) {
-                if(type_counts[j] && type_params[j]==NULL) {
-                    type_params[j] = (ocrParamList_t **)runtimeChunkAlloc(type_counts[j] * sizeof(ocrParamList_t *), NONPERSISTENT_CHUNK);
-                    factory_names[j] = (char **)runtimeChunkAlloc(type_counts[j] * sizeof(char *), NONPERSISTENT_CHUNK);
-                    // Persistent only for the 'higher' type factories
-                    if(j<taskfactory_type) {
-                        all_factories[j] = (void **)runtimeChunkAlloc(type_counts[j] * sizeof(void *), NONPERSISTENT_CHUNK);
-                    } else {
-                        all_factories[j] = (void **)runtimeChunkAlloc(type_counts[j] * sizeof(void *), PERSISTENT_CHUNK);
-                    }
-                }
-
-                // Find next empty spot
-                for(count = 0; count < type_counts[j]; count++) if(all_factories[j][count] == NULL) break;
-                // And fill it
-                factory_names[j][count] = populate_type(&type_params[j][count], j, dict, secname);
-                all_factories[j][count] = create_factory(j, factory_names[j][count], type_params[j][count]);
-
-                if (all_factories[j][count] == NULL) {
-                    runtimeChunkFree((u64)factory_names[j][count], NONPERSISTENT_CHUNK);
-                    factory_names[j][count] = NULL;
-                }
-                count++;
+        char * secname = sections[i].name;
+        j = sections[i].typeIndex;
+        if (j == -1)
+            continue;
+        if(type_counts[j] && type_params[j]==NULL) {
+            type_params[j] = (ocrParamList_t **)runtimeChunkAlloc(type_counts[j] * sizeof(ocrParamList_t *), NONPERSISTENT_CHUNK);
+            factory_names[j] = (char **)runtimeChunkAlloc(type_counts[j] * sizeof(char *), NONPERSISTENT_CHUNK);
+            // Persistent only for the 'higher' type factories
+            if(j<taskfactory_type) {
+                all_factories[j] = (void **)runtimeChunkAlloc(type_counts[j] * sizeof(void *), NONPERSISTENT_CHUNK);
+            } else {
+                all_factories[j] = (void **)runtimeChunkAlloc(type_counts[j] * sizeof(void *), PERSISTENT_CHUNK);
             }
         }
+
+        // Find next empty spot
+        for(count = 0; count < type_counts[j]; count++) if(all_factories[j][count] == NULL) break;
+        // And fill it
+        factory_names[j][count] = populate_type(&type_params[j][count], j, dict, secname);
+        all_factories[j][count] = create_factory(j, factory_names[j][count], type_params[j][count]);
+
+        if (all_factories[j][count] == NULL) {
+            runtimeChunkFree((u64)factory_names[j][count], NONPERSISTENT_CHUNK);
+            factory_names[j][count] = NULL;
+        }
+        count++;
     }
 
+    STARTUP_TIME_END(STARTUP_FACTORIES);
+
     // POPULATE INSTANCES
     DPRINTF(DEBUG_LVL_INFO, "========= Create instances ==========\n");
 
     for (i = 0; i < nsec; i++) {
-        char * secname = iniparser_getsecname(dict, i);
-        for (j = 0; j < total_types; j++) {
-            if (strncasecmp(inst_str[j], secname, strlen(inst_str[j]))==0) {
-                int low, high, count;
-                count = read_range(dict, secname, "id", &low, &high);
-                inst_counts[j]+=count;
-            }
-        }
+        j = sections[i].instIndex;
+        if (j != -1)
+            inst_counts[j] += sections[i].idHigh - sections[i].idLow + 1;
     }
 
     for (i = 0; i < nsec; i++) {
-        char * secname = iniparser_getsecname(dict, i);
-        for (j = total_types-1; j >= 0; j--) {
-            if (strncasecmp(inst_str[j], secname, strlen(inst_str[j]))==0) {
-                if(inst_counts[j] && inst_params[j] == NULL) {
-                    DPRINTF(DEBUG_LVL_INFO, "Create %"PRId32" instances of %s\n", inst_counts[j], inst_str[j]);
-                    inst_params[j] = (ocrParamList_t **)runtimeChunkAlloc(inst_counts[j] * sizeof(ocrParamList_t *), NONPERSISTENT_CHUNK);
-                    all_instances[j] = (void **)runtimeChunkAlloc((inst_counts[j]+1) * sizeof(void *), NONPERSISTENT_CHUNK); // We create an "end of instances" marker
-                    all_instances[j][inst_counts[j]] = NULL;
-                    count = 0;
-                }
-                populate_inst(inst_params[j], inst_counts[j], all_instances[j], type_counts, factory_names, all_factories, all_instances, j, dict, secname);
-            }
+        char * secname = sections[i].name;
+        j = sections[i].instIndex;
+        if (j == -1)
+            continue;
+        if(inst_counts[j] && inst_params[j] == NULL) {
+            DPRINTF(DEBUG_LVL_INFO, "Create %"PRId32" instances of %s\n", inst_counts[j], inst_str[j]);
+            inst_params[j] = (ocrParamList_t **)runtimeChunkAlloc(inst_counts[j] * sizeof(ocrParamList_t *), NONPERSISTENT_CHUNK);
+            all_instances[j] = (void **)runtimeChunkAlloc((inst_counts[j]+1) * sizeof(void *), NONPERSISTENT_CHUNK); // We create an "end of instances" marker
+            all_instances[j][inst_counts[j]] = NULL;
+            count = 0;
         }
+        populate_inst(inst_params[j], inst_counts[j], all_instances[j], type_counts, factory_names, all_factories, all_instances, j, dict, secname);
     }
 
+    STARTUP_TIME_END(STARTUP_INSTANCES);
+
     // BUILD DEPENDENCES
     DPRINTF(DEBUG_LVL_INFO, "========= Build dependences ==========\n");
 
     for (i = 0; i < OCR_CONFIG_DEP_COUNT(instanceDeps); i++) {
-        build_deps(dict, instanceDeps[i].from, instanceDeps[i].to, instanceDeps[i].refstr,
+        build_deps(dict, sections, nsec, instanceDeps[i].from, instanceDeps[i].to, instanceDeps[i].refstr,
                    all_instances, inst_params);
     }
 
@@ -678,6 +751,8 @@ void bringUpRuntime(ocrConfig_t *ocrConfig) {
  //         }
  //     }
 
+    STARTUP_TIME_END(STARTUP_DEPENDENCES);
+
     // START EXECUTION
     DPRINTF(DEBUG_LVL_INFO, "========= Start execution ==========\n");
 
@@ -712,6 +787,7 @@ void bringUpRuntime(ocrConfig_t *ocrConfig) {
     RESULT_ASSERT(rootPolicy->fcts.switchRunlevel(rootPolicy, RL_CONFIG_PARSE, RL_REQUEST |
                                                   RL_ASYNC | RL_BRING_UP | RL_NODE_MASTER),
                   ==, 0);
+    STARTUP_TIME_END(STARTUP_RL_CONFIG_PARSE);
 
     // BUG #583: This part may need to be specialized a bit. Basically,
     // we need this capable thread to determine which PDs it is responsible
@@ -732,6 +808,7 @@ void bringUpRuntime(ocrConfig_t *ocrConfig) {
     RESULT_ASSERT(rootPolicy->fcts.switchRunlevel(rootPolicy, RL_NETWORK_OK,
                                                   RL_REQUEST | RL_ASYNC | RL_BRING_UP | RL_NODE_MASTER),
                   ==, 0);
+    STARTUP_TIME_END(STARTUP_RL_NETWORK_OK);
 
     // Transition all PDs to PD_OK
     // This creates a capable module for each PD. The worker/thread executing
@@ -747,24 +824,28 @@ void bringUpRuntime(ocrConfig_t *ocrConfig) {
     RESULT_ASSERT(rootPolicy->fcts.switchRunlevel(rootPolicy, RL_PD_OK,
                                                   RL_REQUEST | RL_ASYNC | RL_BRING_UP | RL_NODE_MASTER),
                   ==, 0);
+    STARTUP_TIME_END(STARTUP_RL_PD_OK);
 
     // Transition the root PD to MEMORY_OK
     RESULT_ASSERT(rootPolicy->fcts.switchRunlevel(rootPolicy, RL_MEMORY_OK,
                                                   RL_REQUEST | RL_ASYNC | RL_BRING_UP | RL_NODE_MASTER),
                   ==, 0);
+    STARTUP_TIME_END(STARTUP_RL_MEMORY_OK);
 
     // Transition the root PD to GUID_OK and wait for all PDs to transition
     RESULT_ASSERT(rootPolicy->fcts.switchRunlevel(rootPolicy, RL_GUID_OK,
                                                   RL_REQUEST | RL_BARRIER | RL_BRING_UP | RL_NODE_MASTER),
                   ==, 0);
+    STARTUP_TIME_END(STARTUP_RL_GUID_OK);
 
     // Transition the root PD to COMPUTE_OK
     RESULT_ASSERT(rootPolicy->fcts.switchRunlevel(rootPolicy, RL_COMPUTE_OK,
                                                   RL_REQUEST | RL_ASYNC | RL_BRING_UP | RL_NODE_MASTER),
                   ==, 0);
+    STARTUP_TIME_END(STARTUP_RL_COMPUTE_OK);
 
 #endif
-    iniparser_freedict(dict);
+    free_config(dict, sections);
 
 #ifdef ENABLE_BUILDER_ONLY
     exit(0);
@@ -937,6 +1018,7 @@ int __attribute__ ((weak)) main(int argc, const char* argv[]) {
 
     ocrPolicyDomain_t *pd = NULL;
 
+    STARTUP_TIME_BEGIN();
     // Things that must initialize before OCR is started
     platformSpecificInit(&ocrConfig);
 
@@ -948,6 +1030,7 @@ int __attribute__ ((weak)) main(int argc, const char* argv[]) {
     // Pack and save user args for the mainEdt
     void * packedUserArgv = packUserArguments(ocrConfig.userArgc, ocrConfig.userArgv);
     userArgsSet(packedUserArgv);
+    STARTUP_TIME_END(STARTUP_PLATFORM_INIT);
 
     // Set up the runtime
     bringUpRuntime(&ocrConfig);
@@ -958,10 +1041,15 @@ int __attribute__ ((weak)) main(int argc, const char* argv[]) {
     RESULT_ASSERT(
         pd->fcts.switchRunlevel(pd, RL_USER_OK, RL_REQUEST | RL_ASYNC | RL_BRING_UP | RL_NODE_MASTER),
         ==, 0);
+    STARTUP_TIME_END(STARTUP_RL_USER_OK);
 
     u8 returnCode = 0;
 
     freeUpRuntime(true, &returnCode);
+    STARTUP_TIME_END(STARTUP_TEAR_DOWN);
+#ifdef OCR_STARTUP_TIMINGS
+    printStartupTimes();
+#endif
 
     // Warning: Finalizer specific to platforms may call exit
     platformSpecificFinalizer(returnCode);
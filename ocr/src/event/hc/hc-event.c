@@ -19,6 +19,15 @@
 #include "utils/ocr-utils.h"
 #include "ocr-worker.h"
 #include "ocr-errors.h"
+#ifdef ENABLE_TASK_HC
+#include "task/hc/hc-task.h"
+#endif
+
+// Waiters in other policy domains are satisfied with one
+// PD_MSG_DEP_SATISFY_BATCH per destination
+#ifdef ENABLE_POLICY_DOMAIN_HC_DIST
+#define HCEVT_REMOTE_BATCH
+#endif
 
 #ifdef OCR_ENABLE_STATISTICS
 #include "ocr-statistics.h"
@@ -78,51 +87,6 @@ ocrStaticAssert(OCR_HINT_COUNT_EVT_HC < OCR_RUNTIME_HINT_PROP_BITS);
 /******************************************************/
 
 
-static u8 createDbRegNode(ocrFatGuid_t * dbFatGuid, u32 nbElems, bool doRelease, regNode_t ** node) {
-    ocrPolicyDomain_t *pd = NULL;
-    PD_MSG_STACK(msg);
-    ocrTask_t *curTask = NULL;
-    u32 i;
-    getCurrentEnv(&pd, NULL, &curTask, &msg);
-    ocrFatGuid_t curEdt = {.guid = curTask!=NULL?curTask->guid:NULL_GUID, .metaDataPtr = curTask};
-#define PD_MSG (&msg)
-#define PD_TYPE PD_MSG_DB_CREATE
-    getCurrentEnv(NULL, NULL, NULL, &msg);
-    msg.type = PD_MSG_DB_CREATE | PD_MSG_REQUEST | PD_MSG_REQ_RESPONSE;
-    PD_MSG_FIELD_IO(guid) = (*dbFatGuid);
-    PD_MSG_FIELD_IO(size) = sizeof(regNode_t)*nbElems;
-    PD_MSG_FIELD_IO(properties) = DB_PROP_RT_ACQUIRE;
-    PD_MSG_FIELD_I(edt) = curEdt;
-    PD_MSG_FIELD_I(hint) = NULL_HINT;
-    PD_MSG_FIELD_I(dbType) = RUNTIME_DBTYPE;
-    PD_MSG_FIELD_I(allocator) = NO_ALLOC;
-    RESULT_PROPAGATE(pd->fcts.processMessage(pd, &msg, true));
-    (*dbFatGuid) = PD_MSG_FIELD_IO(guid);
-    regNode_t * temp = (regNode_t*) PD_MSG_FIELD_O(ptr);
-    *node = temp;
-    for(i = 0; i < nbElems; ++i) {
-        temp[i].guid = UNINITIALIZED_GUID;
-        temp[i].slot = 0;
-        temp[i].mode = -1;
-    }
-#undef PD_TYPE
-#define PD_TYPE PD_MSG_DB_RELEASE
-    if (doRelease) {
-        getCurrentEnv(NULL, NULL, NULL, &msg);
-        msg.type = PD_MSG_DB_RELEASE | PD_MSG_REQUEST | PD_MSG_REQ_RESPONSE;
-        PD_MSG_FIELD_IO(guid) = (*dbFatGuid);
-        PD_MSG_FIELD_I(edt) = curEdt;
-        PD_MSG_FIELD_I(ptr) = NULL;
-        PD_MSG_FIELD_I(size) = 0;
-        PD_MSG_FIELD_I(properties) = DB_PROP_RT_ACQUIRE;
-        RESULT_PROPAGATE(pd->fcts.processMessage(pd, &msg, true));
-        *node = NULL;
-    }
-#undef PD_MSG
-#undef PD_TYPE
-    return 0;
-}
-
 //
 // OCR-HC Single Events Implementation
 //
@@ -142,18 +106,12 @@ u8 destructEventHc(ocrEvent_t *base) {
     statsEVT_DESTROY(pd, getCurrentEDT(), NULL, base->guid, base);
 #endif
 
-    // Destroy datablocks linked with this event
-    if (!(ocrGuidIsUninitialized(event->waitersDb.guid))) {
-#define PD_MSG (&msg)
-#define PD_TYPE PD_MSG_DB_FREE
-        msg.type = PD_MSG_DB_FREE | PD_MSG_REQUEST;
-        PD_MSG_FIELD_I(guid) = event->waitersDb;
-        PD_MSG_FIELD_I(edt.guid) = curTask ? curTask->guid : NULL_GUID;
-        PD_MSG_FIELD_I(edt.metaDataPtr) = curTask;
-        PD_MSG_FIELD_I(properties) = DB_PROP_RT_ACQUIRE | DB_PROP_NO_RELEASE;
-        RESULT_PROPAGATE(pd->fcts.processMessage(pd, &msg, false));
-#undef PD_MSG
-#undef PD_TYPE
+    // Free the overflow waiter storage
+    hcWaiterChunk_t * chunk = event->waitersChunks;
+    while (chunk != NULL) {
+        hcWaiterChunk_t * next = chunk->next;
+        pd->fcts.pdFree(pd, chunk);
+        chunk = next;
     }
 
     // Now destroy the GUID
@@ -174,6 +132,153 @@ u8 destructEventHc(ocrEvent_t *base) {
 #define STATE_CHECKED_IN ((u32)-1)
 #define STATE_CHECKED_OUT ((u32)-2)
 #define STATE_DESTROY_SEEN ((u32)-3)
+#define IS_WAITERS_CLOSED(count) ((count) >= STATE_DESTROY_SEEN)
+
+// Waiters registration protocol:
+// - A registration reserves an index by CAS-incrementing waitersCount as long as
+//   it does not hold one of the STATE_* values and fills in the corresponding regNode_t.
+//   It then publishes it by setting the node's own ready flag. Registrations never
+//   wait for one another.
+// - Satisfy swaps waitersCount for STATE_CHECKED_IN. While draining, it waits for
+//   each reserved node to be ready before reading it.
+// - Unregistration only looks at the reserved nodes that are ready.
+// Indices past HCEVT_WAITER_STATIC_COUNT live in the waitersChunks list. A
+// registration that finds the chunk holding its index missing allocates it and
+// links it with a CAS; if another registration linked one first, it frees its own.
+
+// Returns the node at 'idx' and its ready flag or NULL if the chunk holding
+// it is not linked yet
+static regNode_t * findWaiterNode(ocrEventHc_t *event, u32 idx, volatile u8 ** ready) {
+    if (idx < HCEVT_WAITER_STATIC_COUNT) {
+        *ready = &(event->waitersReady[idx]);
+        return &(event->waiters[idx]);
+    }
+    idx -= HCEVT_WAITER_STATIC_COUNT;
+    hcWaiterChunk_t * chunk = hal_loadAcquire(&(event->waitersChunks));
+    while ((chunk != NULL) && (idx >= chunk->capacity)) {
+        idx -= chunk->capacity;
+        chunk = hal_loadAcquire(&(chunk->next));
+    }
+    if (chunk == NULL) {
+        return NULL;
+    }
+    *ready = &(chunk->ready[idx]);
+    return &(chunk->nodes[idx]);
+}
+
+// Returns the node at 'idx' and its ready flag, linking the chunks leading
+// to it as needed
+static regNode_t * getWaiterNode(ocrPolicyDomain_t *pd, ocrEventHc_t *event, u32 idx, volatile u8 ** ready) {
+    if (idx < HCEVT_WAITER_STATIC_COUNT) {
+        *ready = &(event->waitersReady[idx]);
+        return &(event->waiters[idx]);
+    }
+    idx -= HCEVT_WAITER_STATIC_COUNT;
+    hcWaiterChunk_t * volatile * link = &(event->waitersChunks);
+    u32 capacity = HCEVT_WAITER_DYNAMIC_COUNT;
+    while (true) {
+        hcWaiterChunk_t * chunk = hal_loadAcquire(link);
+        if (chunk == NULL) {
+            hcWaiterChunk_t * newChunk = (hcWaiterChunk_t *) pd->fcts.pdMalloc(pd, sizeof(hcWaiterChunk_t) +
+                                                                               (sizeof(regNode_t) + sizeof(u8))*capacity);
+            ASSERT(newChunk != NULL);
+            newChunk->next = NULL;
+            newChunk->capacity = capacity;
+            newChunk->nodes = (regNode_t *) (((u64) newChunk) + sizeof(hcWaiterChunk_t));
+            newChunk->ready = (volatile u8 *) &(newChunk->nodes[capacity]);
+            u32 i;
+            for(i = 0; i < capacity; ++i) {
+                newChunk->ready[i] = 0;
+            }
+            // The CAS is a full barrier: the chunk is initialized before it is visible
+            chunk = (hcWaiterChunk_t *) hal_cmpswap64((u64*) link, (u64) NULL, (u64) newChunk);
+            if (chunk == NULL) {
+                chunk = newChunk;
+            } else {
+                pd->fcts.pdFree(pd, newChunk);
+            }
+        }
+        if (idx < chunk->capacity) {
+            *ready = &(chunk->ready[idx]);
+            return &(chunk->nodes[idx]);
+        }
+        idx -= chunk->capacity;
+        capacity = chunk->capacity * 2;
+        link = &(chunk->next);
+    }
+}
+
+/**
+ * @brief Records a waiter in the event's waiter list
+ *
+ * Lock-free, contends with other registrations and with satisfy.
+ * Returns false and does not record anything if the list is already
+ * closed, i.e. the event is satisfied.
+ */
+#ifdef REG_ASYNC_SGL
+static bool commonEnqueueWaiter(ocrPolicyDomain_t *pd, ocrEventHc_t *event, ocrFatGuid_t waiter,
+                                u32 slot, ocrDbAccessMode_t mode) {
+#else
+static bool commonEnqueueWaiter(ocrPolicyDomain_t *pd, ocrEventHc_t *event, ocrFatGuid_t waiter,
+                                u32 slot) {
+#endif
+    u32 idx;
+    do {
+        idx = event->waitersCount;
+        if (IS_WAITERS_CLOSED(idx)) {
+            return false;
+        }
+    } while (hal_cmpswap32(&(event->waitersCount), idx, idx+1) != idx);
+    volatile u8 * ready;
+    regNode_t * node = getWaiterNode(pd, event, idx, &ready);
+    node->guid = waiter.guid;
+    node->slot = slot;
+#ifdef REG_ASYNC_SGL
+    node->mode = mode;
+#endif
+    // Pairs with the acquire in drainWaiters and removeWaiter
+    hal_storeRelease(ready, 1);
+    return true;
+}
+
+/**
+ * @brief Closes the waiter list of an event being satisfied
+ *
+ * Returns the number of reserved waiters. Some of them may still be
+ * filling in their node, drainWaiters waits for each of them.
+ */
+static u32 closeWaiters(ocrEventHc_t *event) {
+    u32 waitersCount;
+    do {
+        waitersCount = event->waitersCount;
+        ASSERT(!IS_WAITERS_CLOSED(waitersCount));
+    } while (hal_cmpswap32(&(event->waitersCount), waitersCount, STATE_CHECKED_IN) != waitersCount);
+    return waitersCount;
+}
+
+// Marks a registered waiter as removed. The list must still be open.
+// Registrations may proceed concurrently: only the nodes that are ready
+// are looked at and no chunk is ever allocated from here.
+static void removeWaiter(ocrEventHc_t *event, ocrFatGuid_t waiter, u32 slot) {
+    u32 waitersCount = event->waitersCount;
+    ASSERT(!IS_WAITERS_CLOSED(waitersCount));
+    u32 i;
+    for(i = 0; i < waitersCount; ++i) {
+        volatile u8 * ready;
+        regNode_t * node = findWaiterNode(event, i, &ready);
+        if (node == NULL) {
+            break; // Chunks are linked in order, none of the following nodes is ready
+        }
+        if (!hal_loadAcquire(ready)) {
+            continue;
+        }
+        if(ocrGuidIsEq(node->guid, waiter.guid) && node->slot == slot) {
+            // Nodes with a NULL_GUID are skipped when waiters are satisfied
+            node->guid = NULL_GUID;
+            break;
+        }
+    }
+}
 
 u8 destructEventHcPersist(ocrEvent_t *base) {
     ocrEventHc_t *event = (ocrEventHc_t*) base;
@@ -293,70 +398,220 @@ static u8 commonSatisfyRegNode(ocrPolicyDomain_t * pd, ocrPolicyMsg_t * msg,
     return 0;
 }
 
-static u8 commonSatisfyWaiters(ocrPolicyDomain_t *pd, ocrEvent_t *base, ocrFatGuid_t db, u32 waitersCount,
-                                ocrFatGuid_t currentEdt, ocrPolicyMsg_t * msg,
-                                bool isPersistentEvent) {
-    ocrEventHc_t * event = (ocrEventHc_t *) base;
-    // waitersDb is safe to read because non-persistent event forbids further
-    // registrations and persistent event registration is closed because of
-    // event->waitersCount set to STATE_CHECKED_IN.
-    ocrFatGuid_t dbWaiters = event->waitersDb;
+// Waiter living in another policy domain, set aside while the local
+// ones are satisfied so that it can be sent grouped by destination
+typedef struct {
+    ocrLocation_t location;
+    regNode_t * node;
+} hcRemoteWaiter_t;
+
+typedef struct {
+    hcRemoteWaiter_t * waiters;
+    u32 count;
+} hcRemoteWaiters_t;
+
+#ifdef HCEVT_REMOTE_BATCH
+// Sifts waiters[root] down the max-heap (by destination) waiters[0..end)
+static void siftDownRemoteWaiter(hcRemoteWaiter_t * waiters, u32 root, u32 end) {
+    u32 child;
+    while ((child = (2 * root) + 1) < end) {
+        if (((child + 1) < end) && (waiters[child].location < waiters[child+1].location))
+            child++;
+        if (waiters[root].location >= waiters[child].location)
+            return;
+        hcRemoteWaiter_t tmp = waiters[root];
+        waiters[root] = waiters[child];
+        waiters[child] = tmp;
+        root = child;
+    }
+}
+
+// Heap sort of the remote waiters by destination
+static void sortRemoteWaiters(hcRemoteWaiter_t * waiters, u32 count) {
     u32 i;
+    for (i = count / 2; i > 0; --i) {
+        siftDownRemoteWaiter(waiters, i - 1, count);
+    }
+    for (i = count; i > 1; --i) {
+        hcRemoteWaiter_t tmp = waiters[0];
+        waiters[0] = waiters[i - 1];
+        waiters[i - 1] = tmp;
+        siftDownRemoteWaiter(waiters, 0, i - 1);
+    }
+}
+
+// Satisfies the remote waiters with one PD_MSG_DEP_SATISFY_BATCH per destination
+static u8 satisfyRemoteWaiters(ocrPolicyDomain_t *pd, ocrPolicyMsg_t * msg, ocrGuid_t evtGuid,
+                               ocrFatGuid_t db, ocrFatGuid_t currentEdt, hcRemoteWaiters_t * remote) {
+    u32 count = remote->count;
+    sortRemoteWaiters(remote->waiters, count);
+    // The targets of all the messages, each message using a contiguous range
+    ocrSatisfyTarget_t * targets = (ocrSatisfyTarget_t *) pd->fcts.pdMalloc(pd, sizeof(ocrSatisfyTarget_t) * count);
+    u32 i, first;
+    for (i = 0; i < count; ++i) {
+        regNode_t * node = remote->waiters[i].node;
+#ifdef OCR_ENABLE_STATISTICS
+        statsDEP_SATISFYFromEvt(pd, evtGuid, NULL, node->guid, db.guid, node->slot);
+#endif
+        targets[i].guid = node->guid;
+        targets[i].slot = node->slot;
+#ifdef REG_ASYNC_SGL
+        targets[i].mode = node->mode;
+#endif
+    }
+    u8 res = 0;
+    for (first = 0; (first < count) && (res == 0); first = i) {
+        ocrLocation_t dest = remote->waiters[first].location;
+        for (i = first + 1; (i < count) && (remote->waiters[i].location == dest); ++i);
+        DPRINTF(DEBUG_LVL_INFO, "SatisfyFromEvent: src: "GUIDF" %"PRIu32" waiters at %"PRIu64"\n",
+                GUIDA(evtGuid), i - first, (u64) dest);
+#define PD_MSG (msg)
+#define PD_TYPE PD_MSG_DEP_SATISFY_BATCH
+        getCurrentEnv(NULL, NULL, NULL, msg);
+        msg->type = PD_MSG_DEP_SATISFY_BATCH | PD_MSG_REQUEST;
+        PD_MSG_FIELD_I(satisfierGuid.guid) = evtGuid;
+        PD_MSG_FIELD_I(satisfierGuid.metaDataPtr) = NULL;
+        PD_MSG_FIELD_I(payload) = db;
+        PD_MSG_FIELD_I(currentEdt) = currentEdt;
+        PD_MSG_FIELD_I(targets) = &targets[first];
+        PD_MSG_FIELD_I(count) = i - first;
+        PD_MSG_FIELD_I(properties) = 0;
+        // One-way: the message (and the targets) is copied before being sent
+        res = pd->fcts.processMessage(pd, msg, false);
+#undef PD_MSG
+#undef PD_TYPE
+    }
+    pd->fcts.pdFree(pd, targets);
+    return res;
+}
+#endif
+
+// Satisfies the waiter 'node' if it is local, otherwise records it in 'remote'.
+// Local HC tasks are satisfied directly and, if they become ready, collected in
+// 'batch'. Everything else goes through a DEP_SATISFY message.
+static u8 dispatchWaiter(ocrPolicyDomain_t *pd, ocrPolicyMsg_t * msg, ocrGuid_t evtGuid,
+                         ocrFatGuid_t db, ocrFatGuid_t currentEdt, regNode_t * node,
+                         ocrSchedReadyBatch_t * batch, hcRemoteWaiters_t * remote, u32 waitersCount) {
+    if (pd->neighborCount != 0) {
+        ocrLocation_t loc;
+        pd->guidProviders[0]->fcts.getLocation(pd->guidProviders[0], node->guid, &loc);
+        if (loc != pd->myLocation) {
+#ifdef HCEVT_REMOTE_BATCH
+#if defined(ENABLE_EXTENSION_CHANNEL_EVT) && !defined(XP_CHANNEL_EVT_NONFIFO)
+            // Remote channel events are satisfied with a blocking DEP_SATISFY
+            ocrGuidKind kind;
+            RESULT_ASSERT(pd->guidProviders[0]->fcts.getKind(pd->guidProviders[0], node->guid, &kind), ==, 0);
+            if (kind == OCR_GUID_EVENT_CHANNEL)
+                return commonSatisfyRegNode(pd, msg, evtGuid, db, currentEdt, node);
+#endif
+            if (remote->waiters == NULL) {
+                remote->waiters = (hcRemoteWaiter_t *) pd->fcts.pdMalloc(pd, sizeof(hcRemoteWaiter_t) * waitersCount);
+            }
+            remote->waiters[remote->count].location = loc;
+            remote->waiters[remote->count].node = node;
+            remote->count++;
+            return 0;
+#else
+            return commonSatisfyRegNode(pd, msg, evtGuid, db, currentEdt, node);
+#endif
+        }
+    }
+#ifdef HCEVT_BATCH_SATISFY
+    if (batch != NULL) {
+        ocrTask_t * task = NULL;
+        ocrGuidKind kind;
+        pd->guidProviders[0]->fcts.getVal(pd->guidProviders[0], node->guid, (u64*)&task, &kind);
+        if ((kind == OCR_GUID_EDT) && (task != NULL) && (task->fctId == pd->taskFactories[0]->factoryId)) {
+            DPRINTF(DEBUG_LVL_INFO, "SatisfyFromEvent: src: "GUIDF" dst: "GUIDF" \n", GUIDA(evtGuid), GUIDA(node->guid));
+#ifdef REG_ASYNC_SGL
+            return hcTaskSatisfyBatched(task, db, node->slot, node->mode, batch);
+#else
+            return hcTaskSatisfyBatched(task, db, node->slot, batch);
+#endif
+        }
+    }
+#endif
+    return commonSatisfyRegNode(pd, msg, evtGuid, db, currentEdt, node);
+}
+
+// Satisfies all the waiters of 'base' in a single pass over the waiter list.
+// Local waiters are satisfied as they are found and the tasks they make ready
+// go to the scheduler in one transaction (if 'batch' is not NULL). Remote
+// waiters are then sent with one message per destination policy domain.
+static u8 drainWaiters(ocrPolicyDomain_t *pd, ocrEvent_t *base, ocrFatGuid_t db, u32 waitersCount,
+                       ocrFatGuid_t currentEdt, ocrPolicyMsg_t * msg, ocrSchedReadyBatch_t * batch) {
+    ocrEventHc_t * event = (ocrEventHc_t *) base;
+    hcRemoteWaiters_t remote = {.waiters = NULL, .count = 0};
+    u32 total = waitersCount;
+    // The waiter list is closed (see closeWaiters) but registrations that
+    // reserved a node may still be filling it in: wait for each node (and the
+    // chunk holding it) to be published before reading it.
+    u32 i, ub;
 #if HCEVT_WAITER_STATIC_COUNT
-    u32 ub = ((waitersCount < HCEVT_WAITER_STATIC_COUNT) ? waitersCount : HCEVT_WAITER_STATIC_COUNT);
+    ub = ((waitersCount < HCEVT_WAITER_STATIC_COUNT) ? waitersCount : HCEVT_WAITER_STATIC_COUNT);
     // Do static waiters first
     for(i = 0; i < ub; ++i) {
-        RESULT_PROPAGATE(commonSatisfyRegNode(pd, msg, base->guid, db, currentEdt, &event->waiters[i]));
+        while (!hal_loadAcquire(&(event->waitersReady[i]))) {
+            hal_pause();
+        }
+        if (!ocrGuidIsNull(event->waiters[i].guid)) {
+            RESULT_PROPAGATE(dispatchWaiter(pd, msg, base->guid, db, currentEdt, &event->waiters[i], batch, &remote, total));
+        }
     }
     waitersCount -= ub;
 #endif
 
-    if(waitersCount > 0) {
-        ASSERT(!(ocrGuidIsUninitialized(dbWaiters.guid)));
-        // First acquire the DB that contains the waiters
-#define PD_MSG (msg)
-#define PD_TYPE PD_MSG_DB_ACQUIRE
-        msg->type = PD_MSG_DB_ACQUIRE | PD_MSG_REQUEST | PD_MSG_REQ_RESPONSE;
-        PD_MSG_FIELD_IO(guid) = dbWaiters;
-        PD_MSG_FIELD_IO(edt) = currentEdt;
-        PD_MSG_FIELD_IO(edtSlot) = EDT_SLOT_NONE;
-        if (isPersistentEvent) {
-            // !! Warning !! RW here (and not RO) works in pair with the lock
-            // being unlocked before DB_RELEASE is called in 'registerWaiterEventHcPersist'
-            PD_MSG_FIELD_IO(properties) = DB_MODE_RW | DB_PROP_RT_ACQUIRE;
-        } else {
-            PD_MSG_FIELD_IO(properties) = DB_MODE_CONST | DB_PROP_RT_ACQUIRE;
+    hcWaiterChunk_t * volatile * link = &(event->waitersChunks);
+    while(waitersCount > 0) {
+        hcWaiterChunk_t * chunk;
+        while ((chunk = hal_loadAcquire(link)) == NULL) {
+            hal_pause();
         }
-        u8 res __attribute__((unused)) = pd->fcts.processMessage(pd, msg, true);
-        ASSERT(!res);
-        regNode_t * waiters = (regNode_t*)PD_MSG_FIELD_O(ptr);
-        //BUG #273: related to 273: we should not get an updated deguidification...
-        dbWaiters = PD_MSG_FIELD_IO(guid); //Get updated deguidifcation if needed
-        ASSERT(waiters);
-#undef PD_TYPE
-
-        // Second, call satisfy on all the waiters
-        for(i = 0; i < waitersCount; ++i) {
-            RESULT_PROPAGATE(commonSatisfyRegNode(pd, msg, base->guid, db, currentEdt, &waiters[i]));
+        ub = ((waitersCount < chunk->capacity) ? waitersCount : chunk->capacity);
+        for(i = 0; i < ub; ++i) {
+            while (!hal_loadAcquire(&(chunk->ready[i]))) {
+                hal_pause();
+            }
+            if (!ocrGuidIsNull(chunk->nodes[i].guid)) {
+                RESULT_PROPAGATE(dispatchWaiter(pd, msg, base->guid, db, currentEdt, &chunk->nodes[i], batch, &remote, total));
+            }
         }
+        waitersCount -= ub;
+        link = &(chunk->next);
+    }
 
-        // Release the DB
-#define PD_TYPE PD_MSG_DB_RELEASE
-        getCurrentEnv(NULL, NULL, NULL, msg);
-        msg->type = PD_MSG_DB_RELEASE | PD_MSG_REQUEST | PD_MSG_REQ_RESPONSE;
-        PD_MSG_FIELD_IO(guid) = dbWaiters;
-        PD_MSG_FIELD_I(edt) = currentEdt;
-        PD_MSG_FIELD_I(ptr) = NULL;
-        PD_MSG_FIELD_I(size) = 0;
-        PD_MSG_FIELD_I(properties) = DB_PROP_RT_ACQUIRE;
-        RESULT_PROPAGATE(pd->fcts.processMessage(pd, msg, true));
-#undef PD_MSG
-#undef PD_TYPE
+#ifdef HCEVT_BATCH_SATISFY
+    if (batch != NULL) {
+        RESULT_PROPAGATE(hcTaskFlushReadyBatch(pd, batch));
     }
+#endif
 
+#ifdef HCEVT_REMOTE_BATCH
+    if (remote.waiters != NULL) {
+        u8 res = satisfyRemoteWaiters(pd, msg, base->guid, db, currentEdt, &remote);
+        pd->fcts.pdFree(pd, remote.waiters);
+        RESULT_PROPAGATE(res);
+    }
+#endif
     return 0;
 }
 
+static u8 commonSatisfyWaiters(ocrPolicyDomain_t *pd, ocrEvent_t *base, ocrFatGuid_t db, u32 waitersCount,
+                                ocrFatGuid_t currentEdt, ocrPolicyMsg_t * msg) {
+#ifdef HCEVT_BATCH_SATISFY
+    if (waitersCount > 1) {
+        // The batch only ever holds tasks made ready by this drain
+        ocrFatGuid_t readyGuids[HCEVT_READY_BATCH_COUNT];
+        ocrSchedReadyBatch_t batch;
+        batch.guids = readyGuids;
+        batch.count = 0;
+        batch.max = HCEVT_READY_BATCH_COUNT;
+        return drainWaiters(pd, base, db, waitersCount, currentEdt, msg, &batch);
+    }
+#endif
+    return drainWaiters(pd, base, db, waitersCount, currentEdt, msg, NULL);
+}
+
 // For once events, we don't have to worry about
 // concurrent registerWaiter calls (this would be a programmer error)
 u8 satisfyEventHcOnce(ocrEvent_t *base, ocrFatGuid_t db, u32 slot) {
@@ -372,16 +627,15 @@ u8 satisfyEventHcOnce(ocrEvent_t *base, ocrFatGuid_t db, u32 slot) {
     ocrFatGuid_t currentEdt;
     currentEdt.guid = (curTask == NULL) ? NULL_GUID : curTask->guid;
     currentEdt.metaDataPtr = curTask;
-    u32 waitersCount = event->waitersCount;
-    // This is only to help users find out about wrongful use of events
-    event->waitersCount = STATE_CHECKED_IN; // Indicate that the event is satisfied
+    // Also helps users find out about wrongful use of events
+    u32 waitersCount = closeWaiters(event); // Indicate that the event is satisfied
 
 #ifdef OCR_ENABLE_STATISTICS
     statsDEP_SATISFYToEvt(pd, currentEdt.guid, NULL, base->guid, base, data, slot);
 #endif
 
     if (waitersCount) {
-        RESULT_PROPAGATE(commonSatisfyWaiters(pd, base, db, waitersCount, currentEdt, &msg, false));
+        RESULT_PROPAGATE(commonSatisfyWaiters(pd, base, db, waitersCount, currentEdt, &msg));
     }
 
     //ULFM resilience //FIXMEULFM: use #ifdef MPI_ULFM
@@ -423,7 +677,7 @@ static u8 commonSatisfyEventHcPersist(ocrEvent_t *base, ocrFatGuid_t db, u32 slo
     currentEdt.metaDataPtr = curTask;
     // Process waiters to be satisfied
     if(waitersCount) {
-        RESULT_PROPAGATE(commonSatisfyWaiters(pd, base, db, waitersCount, currentEdt, &msg, true));
+        RESULT_PROPAGATE(commonSatisfyWaiters(pd, base, db, waitersCount, currentEdt, &msg));
     }
 
     u32 oldV = hal_cmpswap32(&(event->waitersCount), STATE_CHECKED_IN, STATE_CHECKED_OUT);
@@ -444,18 +698,18 @@ static u8 commonSatisfyEventHcPersist(ocrEvent_t *base, ocrFatGuid_t db, u32 slo
 u8 satisfyEventHcCounted(ocrEvent_t *base, ocrFatGuid_t db, u32 slot) {
     ocrEventHc_t * event = (ocrEventHc_t*) base;
     bool destroy = false;
-    hal_lock32(&(event->waitersLock));
+    halQLockNode_t lockNode;
+    hal_qlock(&(event->waitersLock), &lockNode);
     //BUG #809 Nanny-mode
     if ((event->waitersCount == STATE_CHECKED_IN) ||
         (event->waitersCount == STATE_CHECKED_OUT)) {
         DPRINTF(DEBUG_LVL_WARN, "User-level error detected: try to satisfy a counted event that's already satisfied: "GUIDF"\n", GUIDA(base->guid));
         ASSERT(false);
-        hal_unlock32(&(event->waitersLock));
+        hal_qunlock(&(event->waitersLock), &lockNode);
         return 1; //BUG #603 error codes: Put some error code here.
     }
     ((ocrEventHcPersist_t*)event)->data = db.guid;
-    u32 waitersCount = event->waitersCount;
-    event->waitersCount = STATE_CHECKED_IN; // Indicate the event is satisfied
+    u32 waitersCount = closeWaiters(event); // Indicate the event is satisfied
     ocrEventHcCounted_t * devt = (ocrEventHcCounted_t *) event;
     ASSERT_BLOCK_BEGIN(waitersCount <= devt->nbDeps)
     DPRINTF(DEBUG_LVL_WARN, "User-level error detected: too many registrations on counted-event "GUIDF"\n", GUIDA(base->guid));
@@ -463,7 +717,7 @@ u8 satisfyEventHcCounted(ocrEvent_t *base, ocrFatGuid_t db, u32 slot) {
 
     devt->nbDeps -= waitersCount;
     destroy = ((devt->nbDeps) == 0);
-    hal_unlock32(&(event->waitersLock));
+    hal_qunlock(&(event->waitersLock), &lockNode);
     u8 ret = commonSatisfyEventHcPersist(base, db, slot, waitersCount);
     if (destroy) {
         ret = destructEventHc(base);
@@ -476,16 +730,16 @@ u8 satisfyEventHcCounted(ocrEvent_t *base, ocrFatGuid_t db, u32 slot) {
 u8 satisfyEventHcPersistIdem(ocrEvent_t *base, ocrFatGuid_t db, u32 slot) {
     ocrEventHc_t * event = (ocrEventHc_t*) base;
     u32 waitersCount;
-    hal_lock32(&(event->waitersLock));
+    halQLockNode_t lockNode;
+    hal_qlock(&(event->waitersLock), &lockNode);
     if ((event->waitersCount == STATE_CHECKED_IN) || (event->waitersCount == STATE_CHECKED_OUT)) {
-        hal_unlock32(&(event->waitersLock));
+        hal_qunlock(&(event->waitersLock), &lockNode);
         // Legal for idempotent to ignore subsequent satisfy
         return 1; //BUG #603 error codes: Put some error code here.
     } else {
         ((ocrEventHcPersist_t*)event)->data = db.guid;
-        waitersCount = event->waitersCount;
-        event->waitersCount = STATE_CHECKED_IN; // Indicate the event is satisfied
-        hal_unlock32(&(event->waitersLock));
+        waitersCount = closeWaiters(event); // Indicate the event is satisfied
+        hal_qunlock(&(event->waitersLock), &lockNode);
     }
     return commonSatisfyEventHcPersist(base, db, slot, waitersCount);
 }
@@ -493,19 +747,19 @@ u8 satisfyEventHcPersistIdem(ocrEvent_t *base, ocrFatGuid_t db, u32 slot) {
 // For sticky event
 u8 satisfyEventHcPersistSticky(ocrEvent_t *base, ocrFatGuid_t db, u32 slot) {
     ocrEventHc_t * event = (ocrEventHc_t*) base;
-    hal_lock32(&(event->waitersLock));
+    halQLockNode_t lockNode;
+    hal_qlock(&(event->waitersLock), &lockNode);
     //BUG #809 Nanny-mode
     if ((event->waitersCount == STATE_CHECKED_IN) ||
         (event->waitersCount == STATE_CHECKED_OUT)) {
         DPRINTF(DEBUG_LVL_WARN, "User-level error detected: try to satisfy a sticky event that's already satisfied: "GUIDF"\n", GUIDA(base->guid));
         ASSERT(false);
-        hal_unlock32(&(event->waitersLock));
+        hal_qunlock(&(event->waitersLock), &lockNode);
         return 1; //BUG #603 error codes: Put some error code here.
     }
     ((ocrEventHcPersist_t*)event)->data = db.guid;
-    u32 waitersCount = event->waitersCount;
-    event->waitersCount = STATE_CHECKED_IN; // Indicate the event is satisfied
-    hal_unlock32(&(event->waitersLock));
+    u32 waitersCount = closeWaiters(event); // Indicate the event is satisfied
+    hal_qunlock(&(event->waitersLock), &lockNode);
 
     return commonSatisfyEventHcPersist(base, db, slot, waitersCount);
 }
@@ -543,12 +797,11 @@ u8 satisfyEventHcLatch(ocrEvent_t *base, ocrFatGuid_t db, u32 slot) {
     // Here the event is satisfied
     DPRINTF(DEBUG_LVL_INFO, "Satisfy %s: "GUIDF" reached zero\n", eventTypeToString(base), GUIDA(base->guid));
 
-    u32 waitersCount = event->base.waitersCount;
-    // This is only to help users find out about wrongful use of events
-    event->base.waitersCount = STATE_CHECKED_IN; // Indicate that the event is satisfied
+    // Also helps users find out about wrongful use of events
+    u32 waitersCount = closeWaiters(&(event->base)); // Indicate that the event is satisfied
 
     if (waitersCount) {
-        RESULT_PROPAGATE(commonSatisfyWaiters(pd, base, db, waitersCount, currentEdt, &msg, false));
+        RESULT_PROPAGATE(commonSatisfyWaiters(pd, base, db, waitersCount, currentEdt, &msg));
     }
 
     // The latch is satisfied so we destroy it
@@ -565,162 +818,6 @@ u8 unregisterSignalerHc(ocrEvent_t *self, ocrFatGuid_t signaler, u32 slot,
     return 0; // We do not do anything for signalers
 }
 
-#ifdef REG_ASYNC_SGL
-static u8 commonEnqueueWaiter(ocrPolicyDomain_t *pd, ocrEvent_t *base, ocrFatGuid_t waiter,
-                              u32 slot, ocrDbAccessMode_t mode, ocrFatGuid_t currentEdt, ocrPolicyMsg_t * msg) {
-#else
-static u8 commonEnqueueWaiter(ocrPolicyDomain_t *pd, ocrEvent_t *base, ocrFatGuid_t waiter,
-                              u32 slot, ocrFatGuid_t currentEdt, ocrPolicyMsg_t * msg) {
-#endif
-    // Warn: Caller must have acquired the waitersLock
-    ocrEventHc_t *event = (ocrEventHc_t*)base;
-    u32 waitersCount = event->waitersCount;
-
-#if HCEVT_WAITER_STATIC_COUNT
-    if (waitersCount < HCEVT_WAITER_STATIC_COUNT) {
-        event->waiters[waitersCount].guid = waiter.guid;
-        event->waiters[waitersCount].slot = slot;
-#ifdef REG_ASYNC_SGL
-        event->waiters[waitersCount].mode = mode;
-#endif
-        ++event->waitersCount;
-        // We can release the lock now
-        hal_unlock32(&(event->waitersLock));
-    } else {
-#endif
-        ocrFatGuid_t oldDbGuid = {.guid = NULL_GUID, .metaDataPtr = NULL};
-        ocrFatGuid_t dbGuid = {.guid = NULL_GUID, .metaDataPtr = NULL};
-        regNode_t *waiters = NULL;
-        regNode_t *waitersNew = NULL;
-        u8 toReturn = 0;
-        // We're working with the dynamically created waiter list
-        if (waitersCount == HCEVT_WAITER_STATIC_COUNT) {
-            // Initial setup
-            u8 toReturn = createDbRegNode(&(event->waitersDb), HCEVT_WAITER_DYNAMIC_COUNT, false, &waiters);
-            if (toReturn) {
-                ASSERT(false && "Failed allocating db waiter");
-                hal_unlock32(&(event->waitersLock));
-                return toReturn;
-            }
-            dbGuid = event->waitersDb; // for release
-            event->waitersMax += HCEVT_WAITER_DYNAMIC_COUNT;
-            waitersCount=0;
-        } else {
-            // Acquire the DB that contains the waiters
-#define PD_MSG (msg)
-#define PD_TYPE PD_MSG_DB_ACQUIRE
-            getCurrentEnv(NULL, NULL, NULL, msg);
-            msg->type = PD_MSG_DB_ACQUIRE | PD_MSG_REQUEST | PD_MSG_REQ_RESPONSE;
-            PD_MSG_FIELD_IO(guid) = event->waitersDb;
-            PD_MSG_FIELD_IO(edt) = currentEdt;
-            PD_MSG_FIELD_IO(edtSlot) = EDT_SLOT_NONE;
-            PD_MSG_FIELD_IO(properties) = DB_MODE_RW | DB_PROP_RT_ACQUIRE;
-            //Should be a local DB
-            if((toReturn = pd->fcts.processMessage(pd, msg, true))) {
-                // should be the only writer active on the waiter DB since we have the lock
-                ASSERT(false); // debug
-                ASSERT(toReturn != OCR_EBUSY);
-                hal_unlock32(&(event->waitersLock));
-                return toReturn; //BUG #603 error codes
-            }
-            waiters = (regNode_t*)PD_MSG_FIELD_O(ptr);
-            //BUG #273
-            event->waitersDb = PD_MSG_FIELD_IO(guid);
-            ASSERT(waiters);
-#undef PD_TYPE
-            if(waitersCount + 1 == event->waitersMax) {
-                // We need to create a new DB and copy things over
-#define PD_TYPE PD_MSG_DB_CREATE
-                getCurrentEnv(NULL, NULL, NULL, msg);
-                msg->type = PD_MSG_DB_CREATE | PD_MSG_REQUEST | PD_MSG_REQ_RESPONSE;
-                PD_MSG_FIELD_IO(guid) = dbGuid;
-                PD_MSG_FIELD_IO(properties) = DB_PROP_RT_ACQUIRE;
-                PD_MSG_FIELD_IO(size) = sizeof(regNode_t)*event->waitersMax*2;
-                PD_MSG_FIELD_I(edt) = currentEdt;
-                PD_MSG_FIELD_I(hint) = NULL_HINT;
-                PD_MSG_FIELD_I(dbType) = RUNTIME_DBTYPE;
-                PD_MSG_FIELD_I(allocator) = NO_ALLOC;
-                if((toReturn = pd->fcts.processMessage(pd, msg, true))) {
-                    ASSERT(false); // debug
-                    hal_unlock32(&(event->waitersLock));
-                    return toReturn; //BUG #603 error codes
-                }
-                waitersNew = (regNode_t*)PD_MSG_FIELD_O(ptr);
-                oldDbGuid = event->waitersDb;
-                dbGuid = PD_MSG_FIELD_IO(guid);
-                event->waitersDb = dbGuid;
-#undef PD_TYPE
-                // -HCEVT_WAITER_STATIC_COUNT because part of the waiters are in the statically allocated waiter array
-                u32 nbNodes = waitersCount-HCEVT_WAITER_STATIC_COUNT;
-                hal_memCopy(waitersNew, waiters, sizeof(regNode_t)*(nbNodes), false);
-                event->waitersMax *= 2;
-                u32 i;
-                u32 maxNbNodes = event->waitersMax-HCEVT_WAITER_STATIC_COUNT;
-                for(i = nbNodes; i < maxNbNodes; ++i) {
-                    waitersNew[i].guid = NULL_GUID;
-                    waitersNew[i].slot = 0;
-                    waitersNew[i].mode = -1;
-                }
-                waiters = waitersNew;
-            } else {
-                dbGuid = event->waitersDb; // for release
-            }
-            waitersCount=event->waitersCount-HCEVT_WAITER_STATIC_COUNT;
-        }
-
-        waiters[waitersCount].guid = waiter.guid;
-        waiters[waitersCount].slot = slot;
-#ifdef REG_ASYNC_SGL
-        waiters[waitersCount].mode = mode;
-#endif
-        ++event->waitersCount;
-
-        // We can release the lock now
-        hal_unlock32(&(event->waitersLock));
-
-        // Release the waiter datablock / free old waiter DB when necessary
-        //
-        // In both cases it is important to release the GUID read from the cached
-        // DB value and not from the event data-structure since we're operating
-        // outside the lock there can be a new db created and assigned before getting here
-#define PD_MSG (msg)
-#define PD_TYPE PD_MSG_DB_RELEASE
-        getCurrentEnv(NULL, NULL, NULL, msg);
-        msg->type = PD_MSG_DB_RELEASE | PD_MSG_REQUEST | PD_MSG_REQ_RESPONSE;
-        PD_MSG_FIELD_IO(guid) = dbGuid;
-        PD_MSG_FIELD_I(edt) = currentEdt;
-        PD_MSG_FIELD_I(ptr) = NULL;
-        PD_MSG_FIELD_I(size) = 0;
-        PD_MSG_FIELD_I(properties) = DB_PROP_RT_ACQUIRE;
-        RESULT_PROPAGATE(pd->fcts.processMessage(pd, msg, true));
-#undef PD_MSG
-#undef PD_TYPE
-
-        if(waitersNew) {
-            // We need to free the old DB (implicitely released as DB_PROP_NO_RELEASE
-            // is not provided here) and release the new one.
-#define PD_MSG (msg)
-#define PD_TYPE PD_MSG_DB_FREE
-            getCurrentEnv(NULL, NULL, NULL, msg);
-            msg->type = PD_MSG_DB_FREE | PD_MSG_REQUEST;
-            PD_MSG_FIELD_I(guid) = oldDbGuid;
-            PD_MSG_FIELD_I(edt) = currentEdt;
-            PD_MSG_FIELD_I(properties) = DB_PROP_RT_ACQUIRE;
-            if((toReturn = pd->fcts.processMessage(pd, msg, false))) {
-                ASSERT(false); // debug
-                return toReturn; //BUG #603 error codes
-            }
-#undef PD_MSG
-#undef PD_TYPE
-        }
-#if HCEVT_WAITER_STATIC_COUNT
-    }
-#endif
-    return 0; //Require registerSignaler invocation
-}
-
-
-
 /**
  * In this call, we do not contend with the satisfy (once and latch events) however,
  * we do contend with multiple registration.
@@ -738,23 +835,20 @@ u8 registerWaiterEventHc(ocrEvent_t *base, ocrFatGuid_t waiter, u32 slot, bool i
             eventTypeToString(base), GUIDA(base->guid), GUIDA(waiter.guid), slot);
 
     ocrPolicyDomain_t *pd = NULL;
-    ocrTask_t *curTask = NULL;
-    PD_MSG_STACK(msg);
-    getCurrentEnv(&pd, NULL, &curTask, &msg);
+    getCurrentEnv(&pd, NULL, NULL, NULL);
+#ifdef REG_ASYNC_SGL
+    bool enqueued = commonEnqueueWaiter(pd, event, waiter, slot, mode);
+#else
+    bool enqueued = commonEnqueueWaiter(pd, event, waiter, slot);
+#endif
     //BUG #809 this should be part of the n
-    if (event->waitersCount == STATE_CHECKED_IN) {
+    if (!enqueued) {
          // This is best effort race check
          DPRINTF(DEBUG_LVL_WARN, "User-level error detected: adding dependence to a non-persistent event that's already satisfied: "GUIDF"\n", GUIDA(base->guid));
          ASSERT(false);
          return 1; //BUG #603 error codes: Put some error code here.
     }
-    ocrFatGuid_t currentEdt = {.guid = curTask!=NULL?curTask->guid:NULL_GUID, .metaDataPtr = curTask};
-    hal_lock32(&(event->waitersLock)); // Lock is released by commonEnqueueWaiter
-#ifdef REG_ASYNC_SGL
-    return commonEnqueueWaiter(pd, base, waiter, slot, mode, currentEdt, &msg);
-#else
-    return commonEnqueueWaiter(pd, base, waiter, slot, currentEdt, &msg);
-#endif
+    return 0; //Require registerSignaler invocation
 }
 
 
@@ -806,27 +900,26 @@ u8 registerWaiterEventHcPersist(ocrEvent_t *base, ocrFatGuid_t waiter, u32 slot,
 
     DPRINTF(DEBUG_LVL_INFO, "Register waiter %s: "GUIDF" with waiter "GUIDF" on slot %"PRId32"\n",
             eventTypeToString(base), GUIDA(base->guid), GUIDA(waiter.guid), slot);
-    // Lock to read the event->data
-    hal_lock32(&(event->base.waitersLock));
-    if (!(ocrGuidIsUninitialized(event->data))) {
-        ocrFatGuid_t dataGuid = {.guid = event->data, .metaDataPtr = NULL};
-        hal_unlock32(&(event->base.waitersLock));
-
 #ifdef REG_ASYNC_SGL
-        regNode_t node = {.guid = waiter.guid, .slot = slot, .mode = mode};
+    if (commonEnqueueWaiter(pd, &(event->base), waiter, slot, mode)) {
 #else
-        regNode_t node = {.guid = waiter.guid, .slot = slot};
+    if (commonEnqueueWaiter(pd, &(event->base), waiter, slot)) {
 #endif
-        // We send a message saying that we satisfy whatever tried to wait on us
-        return commonSatisfyRegNode(pd, &msg, base->guid, dataGuid, currentEdt, &node);
+        return 0; //Require registerSignaler invocation
     }
 
-    // Lock is released by commonEnqueueWaiter
+    // The waiter list is closed: the event is satisfied and event->data
+    // was set before the list got closed
+    hal_fenceAcquire();
+    ASSERT(!(ocrGuidIsUninitialized(event->data)));
+    ocrFatGuid_t dataGuid = {.guid = event->data, .metaDataPtr = NULL};
 #ifdef REG_ASYNC_SGL
-    return commonEnqueueWaiter(pd, base, waiter, slot, mode, currentEdt, &msg);
+    regNode_t node = {.guid = waiter.guid, .slot = slot, .mode = mode};
 #else
-    return commonEnqueueWaiter(pd, base, waiter, slot, currentEdt, &msg);
+    regNode_t node = {.guid = waiter.guid, .slot = slot};
 #endif
+    // We send a message saying that we satisfy whatever tried to wait on us
+    return commonSatisfyRegNode(pd, &msg, base->guid, dataGuid, currentEdt, &node);
 }
 
 /**
@@ -874,11 +967,16 @@ u8 registerWaiterEventHcCounted(ocrEvent_t *base, ocrFatGuid_t waiter, u32 slot,
 
     DPRINTF(DEBUG_LVL_INFO, "Register waiter %s: "GUIDF" with waiter "GUIDF" on slot %"PRId32"\n",
             eventTypeToString(base), GUIDA(base->guid), GUIDA(waiter.guid), slot);
-    // Lock to read the data field
-    hal_lock32(&(event->base.waitersLock));
-    if(!(ocrGuidIsUninitialized(event->data))) {
+#ifdef REG_ASYNC_SGL
+    bool enqueued = commonEnqueueWaiter(pd, &(event->base), waiter, slot, mode);
+#else
+    bool enqueued = commonEnqueueWaiter(pd, &(event->base), waiter, slot);
+#endif
+    if(!enqueued) {
+        // The waiter list is closed: the event is satisfied
+        hal_fenceAcquire();
+        ASSERT(!(ocrGuidIsUninitialized(event->data)));
         ocrFatGuid_t dataGuid = {.guid = event->data, .metaDataPtr = NULL};
-        hal_unlock32(&(event->base.waitersLock));
 #ifdef REG_ASYNC_SGL
         regNode_t node = {.guid = waiter.guid, .slot = slot, .mode = mode};
 #else
@@ -889,7 +987,8 @@ u8 registerWaiterEventHcCounted(ocrEvent_t *base, ocrFatGuid_t waiter, u32 slot,
         // Here it is still safe to use the base pointer because the satisfy
         // call cannot trigger the destruction of the event. For counted-events
         // the runtime takes care of it
-        hal_lock32(&(event->base.waitersLock));
+        halQLockNode_t lockNode;
+        hal_qlock(&(event->base.waitersLock), &lockNode);
         ocrEventHcCounted_t * devt = (ocrEventHcCounted_t *) event;
         // Account for this registration. When it reaches zero the event
         // can be deallocated since it is already satisfied and this call
@@ -897,21 +996,14 @@ u8 registerWaiterEventHcCounted(ocrEvent_t *base, ocrFatGuid_t waiter, u32 slot,
         ASSERT(devt->nbDeps > 0);
         devt->nbDeps--;
         u64 nbDeps = devt->nbDeps;
-        hal_unlock32(&(event->base.waitersLock));
+        hal_qunlock(&(event->base.waitersLock), &lockNode);
         // Check if we'll need to destroy the event
         if (nbDeps == 0) {
             // Can move that after satisfy to reduce CPL
             destructEventHc(base);
         }
-        return 0; //Require registerSignaler invocation
     }
-
-    // Lock is released by commonEnqueueWaiter
-#ifdef REG_ASYNC_SGL
-    return commonEnqueueWaiter(pd, base, waiter, slot, mode, currentEdt, &msg);
-#else
-    return commonEnqueueWaiter(pd, base, waiter, slot, currentEdt, &msg);
-#endif
+    return 0; //Require registerSignaler invocation
 }
 #endif
 
@@ -922,59 +1014,10 @@ u8 unregisterWaiterEventHc(ocrEvent_t *base, ocrFatGuid_t waiter, u32 slot, bool
     // ignore isDepRem
     ocrEventHc_t *event = (ocrEventHc_t*)base;
 
-
     DPRINTF(DEBUG_LVL_INFO, "UnRegister waiter %s: "GUIDF" with waiter "GUIDF" on slot %"PRId32"\n",
             eventTypeToString(base), GUIDA(base->guid), GUIDA(waiter.guid), slot);
 
-    ocrPolicyDomain_t *pd = NULL;
-    ocrTask_t *curTask = NULL;
-    PD_MSG_STACK(msg);
-    regNode_t *waiters = NULL;
-    u32 i;
-
-    getCurrentEnv(&pd, NULL, &curTask, &msg);
-    ocrFatGuid_t curEdt = {.guid = curTask!=NULL?curTask->guid:NULL_GUID, .metaDataPtr = curTask};
-
-    // Acquire the DB that contains the waiters
-#define PD_MSG (&msg)
-#define PD_TYPE PD_MSG_DB_ACQUIRE
-    msg.type = PD_MSG_DB_ACQUIRE | PD_MSG_REQUEST | PD_MSG_REQ_RESPONSE;
-    PD_MSG_FIELD_IO(guid) = event->waitersDb;
-    PD_MSG_FIELD_IO(edt) = curEdt;
-    PD_MSG_FIELD_IO(edtSlot) = EDT_SLOT_NONE;
-    PD_MSG_FIELD_IO(properties) = DB_MODE_RW | DB_PROP_RT_ACQUIRE;
-    //Should be a local DB
-    u8 res __attribute__((unused)) = pd->fcts.processMessage(pd, &msg, true);
-    ASSERT(!res); // Possible corruption of waitersDb
-
-    waiters = (regNode_t*)PD_MSG_FIELD_O(ptr);
-    //BUG #273
-    event->waitersDb = PD_MSG_FIELD_IO(guid);
-    ASSERT(waiters);
-#undef PD_TYPE
-    // We search for the waiter that we need and remove it
-    for(i = 0; i < event->waitersCount; ++i) {
-        if(ocrGuidIsEq(waiters[i].guid, waiter.guid) && waiters[i].slot == slot) {
-            // We will copy all the other ones
-            hal_memCopy((void*)&waiters[i], (void*)&waiters[i+1],
-                        sizeof(regNode_t)*(event->waitersCount - i - 1), false);
-            --event->waitersCount;
-            break;
-        }
-    }
-
-    // We always release waitersDb
-#define PD_TYPE PD_MSG_DB_RELEASE
-    getCurrentEnv(NULL, NULL, NULL, &msg);
-    msg.type = PD_MSG_DB_RELEASE | PD_MSG_REQUEST | PD_MSG_REQ_RESPONSE;
-    PD_MSG_FIELD_IO(guid) = event->waitersDb;
-    PD_MSG_FIELD_I(edt) = curEdt;
-    PD_MSG_FIELD_I(ptr) = NULL;
-    PD_MSG_FIELD_I(size) = 0;
-    PD_MSG_FIELD_I(properties) = DB_PROP_RT_ACQUIRE;
-    RESULT_PROPAGATE(pd->fcts.processMessage(pd, &msg, true));
-#undef PD_MSG
-#undef PD_TYPE
+    removeWaiter(event, waiter, slot);
     return 0;
 }
 
@@ -983,72 +1026,19 @@ u8 unregisterWaiterEventHc(ocrEvent_t *base, ocrFatGuid_t waiter, u32 slot, bool
 u8 unregisterWaiterEventHcPersist(ocrEvent_t *base, ocrFatGuid_t waiter, u32 slot) {
     ocrEventHcPersist_t *event = (ocrEventHcPersist_t*)base;
 
-
     DPRINTF(DEBUG_LVL_INFO, "Unregister waiter %s: "GUIDF" with waiter "GUIDF" on slot %"PRId32"\n",
             eventTypeToString(base), GUIDA(base->guid), GUIDA(waiter.guid), slot);
 
-    ocrPolicyDomain_t *pd = NULL;
-    ocrTask_t *curTask = NULL;
-    PD_MSG_STACK(msg);
-    regNode_t *waiters = NULL;
-    u32 i;
-    u8 toReturn = 0;
-
-    getCurrentEnv(&pd, NULL, &curTask, &msg);
-    ocrFatGuid_t curEdt = {.guid = curTask!=NULL?curTask->guid:NULL_GUID, .metaDataPtr = curTask};
-    hal_lock32(&(event->base.waitersLock));
+    // Satisfy sets the data and closes the waiter list while holding the lock
+    halQLockNode_t lockNode;
+    hal_qlock(&(event->base.waitersLock), &lockNode);
     if(!(ocrGuidIsUninitialized(event->data))) {
         // We don't really care at this point so we don't do anything
-        hal_unlock32(&(event->base.waitersLock));
+        hal_qunlock(&(event->base.waitersLock), &lockNode);
         return 0;
     }
-
-    // Here we need to actually update our waiter list. We still hold the lock
-    // Acquire the DB that contains the waiters
-#define PD_MSG (&msg)
-#define PD_TYPE PD_MSG_DB_ACQUIRE
-    msg.type = PD_MSG_DB_ACQUIRE | PD_MSG_REQUEST | PD_MSG_REQ_RESPONSE;
-    PD_MSG_FIELD_IO(guid) = event->base.waitersDb;
-    PD_MSG_FIELD_IO(edt) = curEdt;
-    PD_MSG_FIELD_IO(edtSlot) = EDT_SLOT_NONE;
-    PD_MSG_FIELD_IO(properties) = DB_MODE_RW | DB_PROP_RT_ACQUIRE;
-    //Should be a local DB
-    if((toReturn = pd->fcts.processMessage(pd, &msg, true))) {
-        ASSERT(!toReturn); // Possible corruption of waitersDb
-        hal_unlock32(&(event->base.waitersLock));
-        return toReturn;
-    }
-    //BUG #273: Guid reading
-    waiters = (regNode_t*)PD_MSG_FIELD_O(ptr);
-    event->base.waitersDb = PD_MSG_FIELD_IO(guid);
-    ASSERT(waiters);
-#undef PD_TYPE
-    // We search for the waiter that we need and remove it
-    for(i = 0; i < event->base.waitersCount; ++i) {
-        if(ocrGuidIsEq(waiters[i].guid, waiter.guid) && waiters[i].slot == slot) {
-            // We will copy all the other ones
-            hal_memCopy((void*)&waiters[i], (void*)&waiters[i+1],
-                        sizeof(regNode_t)*(event->base.waitersCount - i - 1), false);
-            --event->base.waitersCount;
-            break;
-        }
-    }
-
-    // We can release the lock now
-    hal_unlock32(&(event->base.waitersLock));
-
-    // We always release waitersDb
-#define PD_TYPE PD_MSG_DB_RELEASE
-    getCurrentEnv(NULL, NULL, NULL, &msg);
-    msg.type = PD_MSG_DB_RELEASE | PD_MSG_REQUEST | PD_MSG_REQ_RESPONSE;
-    PD_MSG_FIELD_IO(guid) = event->base.waitersDb;
-    PD_MSG_FIELD_I(edt) = curEdt;
-    PD_MSG_FIELD_I(ptr) = NULL;
-    PD_MSG_FIELD_I(size) = 0;
-    PD_MSG_FIELD_I(properties) = DB_PROP_RT_ACQUIRE;
-    RESULT_PROPAGATE(pd->fcts.processMessage(pd, &msg, true));
-#undef PD_MSG
-#undef PD_TYPE
+    removeWaiter(&(event->base), waiter, slot);
+    hal_qunlock(&(event->base.waitersLock), &lockNode);
     return 0;
 }
 
@@ -1181,8 +1171,8 @@ u8 newEventHc(ocrEventFactory_t * factory, ocrFatGuid_t *guid,
 
     // Set-up HC specific structures
     event->waitersCount = 0;
-    event->waitersMax = HCEVT_WAITER_STATIC_COUNT;
-    event->waitersLock = 0;
+    hal_qlockInit(&(event->waitersLock));
+    event->waitersChunks = NULL;
     event->properties = properties;//EVT_PROP_ULFM_PROXY
 
     int jj = 0;
@@ -1190,6 +1180,7 @@ u8 newEventHc(ocrEventFactory_t * factory, ocrFatGuid_t *guid,
         event->waiters[jj].guid = NULL_GUID;
         event->waiters[jj].slot = 0;
         event->waiters[jj].mode = -1;
+        event->waitersReady[jj] = 0;
         jj++;
     }
     if(eventType == OCR_EVENT_LATCH_T) {
@@ -1231,10 +1222,6 @@ u8 newEventHc(ocrEventFactory_t * factory, ocrFatGuid_t *guid,
         event->hint.hintVal = (u64*)((u64)base + sizeOfGuid);
     }
 
-    // Initialize GUIDs for the waiters data-blocks
-    event->waitersDb.guid = UNINITIALIZED_GUID;
-    event->waitersDb.metaDataPtr = NULL;
-
 #ifdef ENABLE_EXTENSION_COUNTED_EVT
     if(eventType == OCR_EVENT_COUNTED_T) {
         // Initialize the counter for dependencies tracking
@@ -1299,7 +1286,7 @@ u8 newEventHc(ocrEventFactory_t * factory, ocrFatGuid_t *guid,
 
     // Do this at the very end; it indicates that the object
     // of the GUID is actually valid
-    hal_fence(); // Make sure sure this really happens last
+    hal_fenceRelease(); // Make sure sure this really happens last
     base->guid = resultGuid;
 
     DPRINTF(DEBUG_LVL_INFO, "Create %s: "GUIDF"\n", eventTypeToString(base), GUIDA(base->guid));
@@ -1412,7 +1399,8 @@ u8 registerWaiterEventHcChannel(ocrEvent_t *base, ocrFatGuid_t waiter, u32 slot,
 #endif
     ocrEventHc_t * evt = ((ocrEventHc_t*)base);
     ocrEventHcChannel_t * devt = ((ocrEventHcChannel_t*)base);
-    hal_lock32(&evt->waitersLock);
+    halQLockNode_t lockNode;
+    hal_qlock(&evt->waitersLock, &lockNode);
     ocrGuid_t data = popSatisfy(devt);
     regNode_t regnode;
     regnode.guid = waiter.guid;
@@ -1423,7 +1411,7 @@ u8 registerWaiterEventHcChannel(ocrEvent_t *base, ocrFatGuid_t waiter, u32 slot,
     if (!ocrGuidIsUninitialized(data)) {
         DPRINTF(DEBUG_LVL_CHANNEL, "registerWaiterEventHcChannel "GUIDF" push dep and deque satisfy\n",
                 GUIDA(base->guid));
-        hal_unlock32(&evt->waitersLock);
+        hal_qunlock(&evt->waitersLock, &lockNode);
         // We can fire the event
         ocrPolicyDomain_t *pd = NULL;
         ocrTask_t *curTask = NULL;
@@ -1445,7 +1433,7 @@ u8 registerWaiterEventHcChannel(ocrEvent_t *base, ocrFatGuid_t waiter, u32 slot,
             channelWaiterResize(devt);
         }
         pushDependence(devt, &regnode);
-        hal_unlock32(&evt->waitersLock);
+        hal_qunlock(&evt->waitersLock, &lockNode);
     }
     return 0;
 }
@@ -1453,13 +1441,14 @@ u8 registerWaiterEventHcChannel(ocrEvent_t *base, ocrFatGuid_t waiter, u32 slot,
 u8 satisfyEventHcChannel(ocrEvent_t *base, ocrFatGuid_t db, u32 slot) {
     ocrEventHc_t * evt = ((ocrEventHc_t*)base);
     ocrEventHcChannel_t * devt = ((ocrEventHcChannel_t*)base);
-    hal_lock32(&evt->waitersLock);
+    halQLockNode_t lockNode;
+    hal_qlock(&evt->waitersLock, &lockNode);
     regNode_t regnode;
     u8 res = popDependence(devt, &regnode);
     if (res == 0) {
         DPRINTF(DEBUG_LVL_CHANNEL, "satisfyEventHcChannel "GUIDF" satisfy go through\n",
                 GUIDA(base->guid));
-        hal_unlock32(&evt->waitersLock);
+        hal_qunlock(&evt->waitersLock, &lockNode);
         // We can fire the event
         ocrPolicyDomain_t *pd = NULL;
         ocrTask_t *curTask = NULL;
@@ -1478,7 +1467,7 @@ u8 satisfyEventHcChannel(ocrEvent_t *base, ocrFatGuid_t db, u32 slot) {
             channelSatisfyResize(devt);
         }
         pushSatisfy(devt, db.guid);
-        hal_unlock32(&evt->waitersLock);
+        hal_qunlock(&evt->waitersLock, &lockNode);
     }
     return 0;
 }
@@ -27,24 +27,52 @@
 #define HCEVT_WAITER_STATIC_COUNT 4
 #endif
 
-// Size for the dynamically allocated waiter array
+// Size for the first dynamically allocated waiter chunk.
+// Each following chunk is twice as large as the previous one.
 #ifndef HCEVT_WAITER_DYNAMIC_COUNT
 #define HCEVT_WAITER_DYNAMIC_COUNT 4
 #endif
 
+// Number of ready EDTs a satisfied event hands to the scheduler in
+// a single batch when draining its waiters. 0 disables batching.
+#ifndef HCEVT_READY_BATCH_COUNT
+#define HCEVT_READY_BATCH_COUNT 64
+#endif
+
+// Local HC tasks waiting on an event are satisfied directly by the event
+// (or by the PD for PD_MSG_DEP_SATISFY_BATCH) and handed to the scheduler in
+// batches. The policy domain hooks of DEP_SATISFY (pause, statistics) are then
+// skipped so this is disabled when they are built in.
+#if defined(ENABLE_TASK_HC) && HCEVT_READY_BATCH_COUNT && !defined(ENABLE_EXTENSION_PAUSE) && !defined(OCR_ENABLE_STATISTICS)
+#define HCEVT_BATCH_SATISFY
+#endif
+
+/**
+ * @brief Overflow storage for the waiters of an event
+ *
+ * Chunks form an append-only list hanging off the event. The regNode_t
+ * array directly follows the chunk header in memory, then the ready flags.
+ */
+typedef struct _hcWaiterChunk_t {
+    struct _hcWaiterChunk_t * volatile next; /**< Next (twice larger) chunk or NULL */
+    u32 capacity; /**< Number of regNode_t in this chunk */
+    regNode_t * nodes; /**< Points right after this header */
+    volatile u8 * ready; /**< One flag per node, set once it is filled in. Follows the nodes */
+} hcWaiterChunk_t;
+
 typedef struct {
     ocrEventFactory_t base;
 } ocrEventFactoryHc_t;
 
 typedef struct ocrEventHc_t {
     ocrEvent_t base;
-    regNode_t waiters[HCEVT_WAITER_STATIC_COUNT]; /**< hold waiters. If overflows a dynamically
-                                              allocated waiter list is stored in waitersDb */
-    ocrFatGuid_t waitersDb; /**< DB containing an array of regNode_t listing the
-                             * events/EDTs depending on this event */
-    volatile u32 waitersCount; /**< Number of waiters in waitersDb */
-    u32 waitersMax; /**< Maximum number of waiters in waitersDb */
-    u32 waitersLock;
+    regNode_t waiters[HCEVT_WAITER_STATIC_COUNT]; /**< hold waiters. If overflows, the following
+                                              waiters are stored in waitersChunks */
+    hcWaiterChunk_t * volatile waitersChunks; /**< Overflow chunks listing the
+                                               * events/EDTs depending on this event */
+    volatile u32 waitersCount; /**< Number of slots reserved by waiters or a STATE_* value once satisfied */
+    volatile u8 waitersReady[HCEVT_WAITER_STATIC_COUNT]; /**< Set once the matching node in waiters is filled in */
+    halQLock_t waitersLock; /**< Serializes satisfy and unregister, not waiter registration */
     ocrRuntimeHint_t hint;
     u16 properties; //ULFM Resilience - properties field added to mark proxy events
 } ocrEventHc_t;
@@ -31,6 +31,10 @@
 #endif
 #define GUID_KIND_SIZE 5 // Warning! check ocrGuidKind struct definition for correct size
 
+#if defined(GUID_PROVIDER_WID_INGUID) && defined(GUID_PROVIDER_COUNTER_BLOCK)
+#error GUID_PROVIDER_WID_INGUID and GUID_PROVIDER_COUNTER_BLOCK are mutually exclusive
+#endif
+
 #ifdef GUID_PROVIDER_WID_INGUID
 #ifndef GUID_PROVIDER_WID_SIZE
 #define GUID_WID_SIZE 4
@@ -63,12 +67,25 @@
 
 #ifdef GUID_PROVIDER_CUSTOM_MAP
 // Set -DGUID_PROVIDER_CUSTOM_MAP and put other #ifdef for alternate implementation here
+#ifdef GUID_PROVIDER_SHARDED_MAP
+// Sharded open-addressing map: lock-free lookups, per-shard writers, online growth
+#define GP_RESOLVE_HASHTABLE(hashtable, key) hashtable
+#define GP_HASHTABLE_CREATE_MODULO newHashtableSharded
+#define GP_HASHTABLE_DESTRUCT(hashtable, key, entryDealloc, deallocParam) destructHashtableSharded(hashtable, entryDealloc, deallocParam)
+#define GP_HASHTABLE_GET(hashtable, key) hashtableConcShardedGet(GP_RESOLVE_HASHTABLE(hashtable,key), key)
+#define GP_HASHTABLE_PUT(hashtable, key, value) hashtableConcShardedPut(GP_RESOLVE_HASHTABLE(hashtable,key), key, value)
+#define GP_HASHTABLE_TRYPUT(hashtable, key, value) hashtableConcShardedTryPut(GP_RESOLVE_HASHTABLE(hashtable,key), key, value)
+#define GP_HASHTABLE_DEL(hashtable, key, valueBack) hashtableConcShardedRemove(GP_RESOLVE_HASHTABLE(hashtable,key), key, valueBack)
+#else
+#error GUID_PROVIDER_CUSTOM_MAP requires an implementation flag such as GUID_PROVIDER_SHARDED_MAP
+#endif
 #else
 #define GP_RESOLVE_HASHTABLE(hashtable, key) hashtable
 #define GP_HASHTABLE_CREATE_MODULO newHashtableBucketLocked
 #define GP_HASHTABLE_DESTRUCT(hashtable, key, entryDealloc, deallocParam) destructHashtableBucketLocked(hashtable, entryDealloc, deallocParam)
 #define GP_HASHTABLE_GET(hashtable, key) hashtableConcBucketLockedGet(GP_RESOLVE_HASHTABLE(hashtable,key), key)
 #define GP_HASHTABLE_PUT(hashtable, key, value) hashtableConcBucketLockedPut(GP_RESOLVE_HASHTABLE(hashtable,key), key, value)
+#define GP_HASHTABLE_TRYPUT(hashtable, key, value) hashtableConcBucketLockedTryPut(GP_RESOLVE_HASHTABLE(hashtable,key), key, value)
 #define GP_HASHTABLE_DEL(hashtable, key, valueBack) hashtableConcBucketLockedRemove(GP_RESOLVE_HASHTABLE(hashtable,key), key, valueBack)
 #endif
 
@@ -166,6 +183,11 @@ u8 countedMapSwitchRunlevel(ocrGuidProvider_t *self, ocrPolicyDomain_t *PD, ocrR
             void * deallocParam = NULL;
 #endif
             GP_HASHTABLE_DESTRUCT(((ocrGuidProviderCountedMap_t *) self)->guidImplTable, NULL, entryDeallocator, deallocParam);
+#ifdef GUID_PROVIDER_COUNTER_BLOCK
+            PD->fcts.pdFree(PD, ((ocrGuidProviderCountedMap_t *) self)->counterBlocksAlloc);
+            ((ocrGuidProviderCountedMap_t *) self)->counterBlocksAlloc = NULL;
+            ((ocrGuidProviderCountedMap_t *) self)->counterBlocks = NULL;
+#endif
 #ifdef GUID_PROVIDER_DESTRUCT_CHECK
             PRINTF("=========================\n");
             PRINTF("Remnant GUIDs summary:\n");
@@ -184,6 +206,18 @@ u8 countedMapSwitchRunlevel(ocrGuidProvider_t *self, ocrPolicyDomain_t *PD, ocrR
             //Initialize the map now that we have an assigned policy domain
             ocrGuidProviderCountedMap_t * derived = (ocrGuidProviderCountedMap_t *) self;
             derived->guidImplTable = GP_HASHTABLE_CREATE_MODULO(PD, GUID_PROVIDER_NB_BUCKETS, hashGuidCounterModulo);
+#ifdef GUID_PROVIDER_COUNTER_BLOCK
+            // Over-allocate so that the array starts on a cache line
+            derived->counterBlocksAlloc = PD->fcts.pdMalloc(PD, sizeof(guidCounterBlock_t) * PD->workerCount + 63);
+            guidCounterBlock_t * blocks = (guidCounterBlock_t *) (((u64) derived->counterBlocksAlloc + 63) & ~63ULL);
+            // Blocks start empty: each worker leases its first range on its first GUID
+            u32 i;
+            for (i = 0; i < PD->workerCount; ++i) {
+                blocks[i].next = 0;
+                blocks[i].end = 0;
+            }
+            derived->counterBlocks = blocks;
+#endif
 #ifdef GUID_PROVIDER_WID_INGUID
             ASSERT(((PD->workerCount-1) < ((u64)1 << GUID_WID_SIZE)) && "GUID worker count overflows");
 #endif
@@ -261,6 +295,24 @@ static u64 generateNextGuid(ocrGuidProvider_t* self, ocrGuidKind kind) {
     u64 widShifted = (wid << WID_LOCATION);
     u64 guid = (locIdShifted | kindShifted | widShifted) << GUID_COUNTER_SIZE;
     u64 newCount = guidCounters[wid*CACHE_SIZE]++;
+#elif defined(GUID_PROVIDER_COUNTER_BLOCK)
+    u64 guid = (locIdShifted | kindShifted) << GUID_COUNTER_SIZE;
+    ocrWorker_t * worker = NULL;
+    getCurrentEnv(NULL, &worker, NULL, NULL);
+    guidCounterBlock_t * blocks = ((ocrGuidProviderCountedMap_t *) self)->counterBlocks;
+    u64 newCount;
+    // GUIDs are generated before the map and the current worker are setup
+    if ((worker == NULL) || (blocks == NULL) || (worker->id >= self->pd->workerCount)) {
+        newCount = hal_xadd64(&guidCounter, 1);
+    } else {
+        guidCounterBlock_t * block = &blocks[worker->id];
+        if (block->next == block->end) {
+            // Lease a new range from the shared counter
+            block->next = hal_xadd64(&guidCounter, GUID_PROVIDER_COUNTER_BLOCK_SIZE);
+            block->end = block->next + GUID_PROVIDER_COUNTER_BLOCK_SIZE;
+        }
+        newCount = block->next++;
+    }
 #else
     u64 guid = (locIdShifted | kindShifted) << GUID_COUNTER_SIZE;
     u64 newCount = hal_xadd64(&guidCounter, 1);
@@ -272,7 +324,7 @@ static u64 generateNextGuid(ocrGuidProvider_t* self, ocrGuidKind kind) {
 }
 
 u8 countedMapGuidReserve(ocrGuidProvider_t *self, ocrGuid_t* startGuid, u64* skipGuid,
-                         u64 numberGuids, ocrGuidKind guidType) {
+                         u64* locationSkip, u64 numberGuids, ocrGuidKind guidType) {
     // Not supported; use labeled provider
     DPRINTF(DEBUG_LVL_WARN, "error: Must use labeled GUID provider for labeled GUID support, current is counted-map\n");
     ASSERT(false);
@@ -452,6 +504,11 @@ static ocrGuidProvider_t* newGuidProviderCountedMap(ocrGuidProviderFactory_t *fa
     base->fcts = factory->providerFcts;
     base->pd = NULL;
     base->id = factory->factoryId;
+    base->allocPerGuid = false;
+#ifdef GUID_PROVIDER_COUNTER_BLOCK
+    ((ocrGuidProviderCountedMap_t *) base)->counterBlocks = NULL;
+    ((ocrGuidProviderCountedMap_t *) base)->counterBlocksAlloc = NULL;
+#endif
     return base;
 }
 
@@ -474,7 +531,7 @@ ocrGuidProviderFactory_t *newGuidProviderFactoryCountedMap(ocrParamList_t *typeA
     base->providerFcts.destruct = FUNC_ADDR(void (*)(ocrGuidProvider_t*), countedMapDestruct);
     base->providerFcts.switchRunlevel = FUNC_ADDR(u8 (*)(ocrGuidProvider_t*, ocrPolicyDomain_t*, ocrRunlevel_t,
                                                          phase_t, u32, void (*)(ocrPolicyDomain_t*, u64), u64), countedMapSwitchRunlevel);
-    base->providerFcts.guidReserve = FUNC_ADDR(u8 (*)(ocrGuidProvider_t*, ocrGuid_t*, u64*, u64, ocrGuidKind), countedMapGuidReserve);
+    base->providerFcts.guidReserve = FUNC_ADDR(u8 (*)(ocrGuidProvider_t*, ocrGuid_t*, u64*, u64*, u64, ocrGuidKind), countedMapGuidReserve);
     base->providerFcts.guidUnreserve = FUNC_ADDR(u8 (*)(ocrGuidProvider_t*, ocrGuid_t, u64, u64), countedMapGuidUnreserve);
     base->providerFcts.getGuid = FUNC_ADDR(u8 (*)(ocrGuidProvider_t*, ocrGuid_t*, u64, ocrGuidKind), countedMapGetGuid);
     base->providerFcts.createGuid = FUNC_ADDR(u8 (*)(ocrGuidProvider_t*, ocrFatGuid_t*, u64, ocrGuidKind, u32), countedMapCreateGuid);
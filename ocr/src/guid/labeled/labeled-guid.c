@@ -31,6 +31,10 @@
 #endif
 #define GUID_KIND_SIZE 5 // Warning! check ocrGuidKind struct definition for correct size
 
+#if defined(GUID_PROVIDER_WID_INGUID) && defined(GUID_PROVIDER_COUNTER_BLOCK)
+#error GUID_PROVIDER_WID_INGUID and GUID_PROVIDER_COUNTER_BLOCK are mutually exclusive
+#endif
+
 #ifdef GUID_PROVIDER_WID_INGUID
 #ifndef GUID_PROVIDER_WID_SIZE
 #define GUID_WID_SIZE 4
@@ -60,6 +64,12 @@
 #define LOCID_LOCATION (GUID_KIND_SIZE)
 #endif
 
+// The counter of reserved GUIDs starts with the location that reserved them. A
+// range can then hold GUIDs for any location without overlapping the ranges
+// reserved by that location.
+#define GUID_RESERVED_COUNT_SIZE (GUID_COUNTER_SIZE-GUID_LOCID_SIZE)
+#define GUID_RESERVED_COUNT_MASK ((((u64)1)<<GUID_RESERVED_COUNT_SIZE)-1)
+
 // See BUG #928 on GUID issues
 #if GUID_BIT_COUNT == 64
 #define IS_RESERVED_GUID(guidVal) ((guidVal.guid & 0x8000000000000000ULL) != 0ULL)
@@ -69,12 +79,25 @@
 
 #ifdef GUID_PROVIDER_CUSTOM_MAP
 // Set -DGUID_PROVIDER_CUSTOM_MAP and put other #ifdef for alternate implementation here
+#ifdef GUID_PROVIDER_SHARDED_MAP
+// Sharded open-addressing map: lock-free lookups, per-shard writers, online growth
+#define GP_RESOLVE_HASHTABLE(hashtable, key) hashtable
+#define GP_HASHTABLE_CREATE_MODULO newHashtableSharded
+#define GP_HASHTABLE_DESTRUCT(hashtable, key, entryDealloc, deallocParam) destructHashtableSharded(hashtable, entryDealloc, deallocParam)
+#define GP_HASHTABLE_GET(hashtable, key) hashtableConcShardedGet(GP_RESOLVE_HASHTABLE(hashtable,key), key)
+#define GP_HASHTABLE_PUT(hashtable, key, value) hashtableConcShardedPut(GP_RESOLVE_HASHTABLE(hashtable,key), key, value)
+#define GP_HASHTABLE_TRYPUT(hashtable, key, value) hashtableConcShardedTryPut(GP_RESOLVE_HASHTABLE(hashtable,key), key, value)
+#define GP_HASHTABLE_DEL(hashtable, key, valueBack) hashtableConcShardedRemove(GP_RESOLVE_HASHTABLE(hashtable,key), key, valueBack)
+#else
+#error GUID_PROVIDER_CUSTOM_MAP requires an implementation flag such as GUID_PROVIDER_SHARDED_MAP
+#endif
 #else
 #define GP_RESOLVE_HASHTABLE(hashtable, key) hashtable
 #define GP_HASHTABLE_CREATE_MODULO newHashtableBucketLocked
 #define GP_HASHTABLE_DESTRUCT(hashtable, key, entryDealloc, deallocParam) destructHashtableBucketLocked(hashtable, entryDealloc, deallocParam)
 #define GP_HASHTABLE_GET(hashtable, key) hashtableConcBucketLockedGet(GP_RESOLVE_HASHTABLE(hashtable,key), key)
 #define GP_HASHTABLE_PUT(hashtable, key, value) hashtableConcBucketLockedPut(GP_RESOLVE_HASHTABLE(hashtable,key), key, value)
+#define GP_HASHTABLE_TRYPUT(hashtable, key, value) hashtableConcBucketLockedTryPut(GP_RESOLVE_HASHTABLE(hashtable,key), key, value)
 #define GP_HASHTABLE_DEL(hashtable, key, valueBack) hashtableConcBucketLockedRemove(GP_RESOLVE_HASHTABLE(hashtable,key), key, valueBack)
 #endif
 
@@ -179,6 +202,11 @@ u8 labeledGuidSwitchRunlevel(ocrGuidProvider_t *self, ocrPolicyDomain_t *PD, ocr
             void * deallocParam = NULL;
 #endif
             GP_HASHTABLE_DESTRUCT(((ocrGuidProviderLabeled_t *) self)->guidImplTable, NULL, entryDeallocator, deallocParam);
+#ifdef GUID_PROVIDER_COUNTER_BLOCK
+            PD->fcts.pdFree(PD, ((ocrGuidProviderLabeled_t *) self)->counterBlocksAlloc);
+            ((ocrGuidProviderLabeled_t *) self)->counterBlocksAlloc = NULL;
+            ((ocrGuidProviderLabeled_t *) self)->counterBlocks = NULL;
+#endif
 #ifdef GUID_PROVIDER_DESTRUCT_CHECK
             PRINTF("=========================\n");
             PRINTF("Remnant GUIDs summary:\n");
@@ -197,6 +225,18 @@ u8 labeledGuidSwitchRunlevel(ocrGuidProvider_t *self, ocrPolicyDomain_t *PD, ocr
             //Initialize the map now that we have an assigned policy domain
             ocrGuidProviderLabeled_t * derived = (ocrGuidProviderLabeled_t *) self;
             derived->guidImplTable = GP_HASHTABLE_CREATE_MODULO(PD, GUID_PROVIDER_NB_BUCKETS, hashGuidCounterModulo);
+#ifdef GUID_PROVIDER_COUNTER_BLOCK
+            // Over-allocate so that the array starts on a cache line
+            derived->counterBlocksAlloc = PD->fcts.pdMalloc(PD, sizeof(guidCounterBlock_t) * PD->workerCount + 63);
+            guidCounterBlock_t * blocks = (guidCounterBlock_t *) (((u64) derived->counterBlocksAlloc + 63) & ~63ULL);
+            // Blocks start empty: each worker leases its first range on its first GUID
+            u32 i;
+            for (i = 0; i < PD->workerCount; ++i) {
+                blocks[i].next = 0;
+                blocks[i].end = 0;
+            }
+            derived->counterBlocks = blocks;
+#endif
 #ifdef GUID_PROVIDER_WID_INGUID
             ASSERT(((PD->workerCount-1) < ((u64)1 << GUID_WID_SIZE)) && "GUID worker count overflows");
 #endif
@@ -269,6 +309,24 @@ static u64 generateNextGuid(ocrGuidProvider_t* self, ocrGuidKind kind) {
     u64 widShifted = (wid << WID_LOCATION);
     u64 guid = (locIdShifted | kindShifted | widShifted) << GUID_COUNTER_SIZE;
     u64 newCount = guidCounters[wid*CACHE_SIZE]++;
+#elif defined(GUID_PROVIDER_COUNTER_BLOCK)
+    u64 guid = (locIdShifted | kindShifted) << GUID_COUNTER_SIZE;
+    ocrWorker_t * worker = NULL;
+    getCurrentEnv(NULL, &worker, NULL, NULL);
+    guidCounterBlock_t * blocks = ((ocrGuidProviderLabeled_t *) self)->counterBlocks;
+    u64 newCount;
+    // GUIDs are generated before the map and the current worker are setup
+    if ((worker == NULL) || (blocks == NULL) || (worker->id >= self->pd->workerCount)) {
+        newCount = hal_xadd64(&guidCounter, 1);
+    } else {
+        guidCounterBlock_t * block = &blocks[worker->id];
+        if (block->next == block->end) {
+            // Lease a new range from the shared counter
+            block->next = hal_xadd64(&guidCounter, GUID_PROVIDER_COUNTER_BLOCK_SIZE);
+            block->end = block->next + GUID_PROVIDER_COUNTER_BLOCK_SIZE;
+        }
+        newCount = block->next++;
+    }
 #else
     u64 guid = (locIdShifted | kindShifted) << GUID_COUNTER_SIZE;
     u64 newCount = hal_xadd64(&guidCounter, 1);
@@ -283,7 +341,7 @@ static u64 generateNextGuid(ocrGuidProvider_t* self, ocrGuidKind kind) {
 }
 
 u8 labeledGuidReserve(ocrGuidProvider_t *self, ocrGuid_t *startGuid, u64* skipGuid,
-                      u64 numberGuids, ocrGuidKind guidType) {
+                      u64* locationSkip, u64 numberGuids, ocrGuidKind guidType) {
     // We just return a range using our "header" (location, etc) just like for
     // generateNextGuid
     // ocrGuidType_t and ocrGuidKind should be the same (there are more GuidKind but
@@ -302,8 +360,11 @@ u8 labeledGuidReserve(ocrGuidProvider_t *self, ocrGuid_t *startGuid, u64* skipGu
 #endif
 
     *skipGuid = 1; // Each GUID will just increment by 1
+    // The location of a GUID can be changed to distribute the range
+    *locationSkip = ((u64)1) << (LOCID_LOCATION + GUID_COUNTER_SIZE);
     u64 firstCount = hal_xadd64(&guidReservedCounter, numberGuids);
-    ASSERT(firstCount  + numberGuids < (u64)1<<GUID_COUNTER_SIZE);
+    ASSERT(firstCount  + numberGuids < (u64)1<<GUID_RESERVED_COUNT_SIZE);
+    firstCount |= locId << GUID_RESERVED_COUNT_SIZE;
 
     // See BUG #928 on GUID issues
 #if GUID_BIT_COUNT == 64
@@ -351,20 +412,21 @@ u8 labeledGuidCreateGuid(ocrGuidProvider_t* self, ocrFatGuid_t *fguid, u64 size,
         // We need to use the GUID provided; make sure it is non null and reserved
         ASSERT((!(ocrGuidIsNull(fguid->guid))) && (IS_RESERVED_GUID(fguid->guid)));
 
-        // We need to fix this: ie: return a code saying we can't do the reservation
-        // Ideally, we would either forward to the responsible party or return something
-        // so the PD knows what to do. This is going to take a lot more infrastructure
-        // change so we'll punt for now
+        // The policy domain routes the creation to the location encoded in the GUID,
+        // which may differ from the one that reserved the range (distributed ranges)
         // Related to BUG #535 and to BUG #536
         ASSERT(extractLocIdFromGuid(fguid->guid) == locationToLocId(self->pd->myLocation));
 
         // Other sanity check
         ASSERT(getKindFromGuid(fguid->guid) == kind); // Kind properly encoded
+        // Range actually reserved; only the reserving location can tell
         // See BUG #928 on GUID issues
 #if GUID_BIT_COUNT == 64
-        ASSERT((fguid->guid.guid & GUID_COUNTER_MASK) < guidReservedCounter); // Range actually reserved
+        ASSERT((((fguid->guid.guid & GUID_COUNTER_MASK) >> GUID_RESERVED_COUNT_SIZE) != locationToLocId(self->pd->myLocation)) ||
+               ((fguid->guid.guid & GUID_RESERVED_COUNT_MASK) < guidReservedCounter));
 #elif GUID_BIT_COUNT == 128
-        ASSERT((fguid->guid.lower & GUID_COUNTER_MASK) < guidReservedCounter); // Range actually reserved
+        ASSERT((((fguid->guid.lower & GUID_COUNTER_MASK) >> GUID_RESERVED_COUNT_SIZE) != locationToLocId(self->pd->myLocation)) ||
+               ((fguid->guid.lower & GUID_RESERVED_COUNT_MASK) < guidReservedCounter));
 #endif
     }
     ocrPolicyDomain_t *policy = NULL;
@@ -386,7 +448,7 @@ u8 labeledGuidCreateGuid(ocrGuidProvider_t* self, ocrFatGuid_t *fguid, u64 size,
 #undef PD_TYPE
     (*(ocrGuid_t*)ptr) = NULL_GUID; // The first field is always the GUID, either directly as ocrGuid_t or a ocrFatGuid_t
                                     // This is used to determine if a GUID metadata is "ready". See bug #627
-    hal_fence(); // Make sure the ptr update is visible before we update the hash table
+    hal_fenceRelease(); // Make sure the ptr update is visible before we update the hash table
     if(properties & GUID_PROP_IS_LABELED) {
         // Bug #865: Warning if ordering is important, first GUID_PROP_CHECK then GUID_PROP_BLOCK
         // because we want the first branch to intercept (GUID_PROP_CHECK | GUID_PROP_BLOCK)
@@ -395,11 +457,11 @@ u8 labeledGuidCreateGuid(ocrGuidProvider_t* self, ocrFatGuid_t *fguid, u64 size,
             DPRINTF(DEBUG_LVL_VERB, "LabeledGUID: try insert into hash table "GUIDF" -> %p\n", GUIDA(fguid->guid), ptr);
             // See BUG #928 on GUID issues
 #if GUID_BIT_COUNT == 64
-            void *value = hashtableConcBucketLockedTryPut(
+            void *value = GP_HASHTABLE_TRYPUT(
                 ((ocrGuidProviderLabeled_t*)self)->guidImplTable,
                 (void*)(fguid->guid.guid), ptr);
 #elif GUID_BIT_COUNT == 128
-            void *value = hashtableConcBucketLockedTryPut(
+            void *value = GP_HASHTABLE_TRYPUT(
                 ((ocrGuidProviderLabeled_t*)self)->guidImplTable,
                 (void*)(fguid->guid.lower), ptr);
 #endif
@@ -435,7 +497,7 @@ u8 labeledGuidCreateGuid(ocrGuidProvider_t* self, ocrFatGuid_t *fguid, u64 size,
                     while((*(volatile u64*)value) != fguid->guid.lower);
 #endif
                 }
-                hal_fence(); // May be overkill but there is a race that I don't get
+                hal_fenceAcquire(); // Metadata published by the creator is visible
                 return OCR_EGUIDEXISTS;
             }
         } else if((properties & GUID_PROP_BLOCK) == GUID_PROP_BLOCK) {
@@ -445,11 +507,11 @@ u8 labeledGuidCreateGuid(ocrGuidProvider_t* self, ocrFatGuid_t *fguid, u64 size,
 
 // See BUG #928 on GUID issues
 #if GUID_BIT_COUNT == 64
-                value = hashtableConcBucketLockedTryPut(
+                value = GP_HASHTABLE_TRYPUT(
                     ((ocrGuidProviderLabeled_t*)self)->guidImplTable,
                     (void*)(fguid->guid.guid), ptr);
 #elif GUID_BIT_COUNT == 128
-                value = hashtableConcBucketLockedTryPut(
+                value = GP_HASHTABLE_TRYPUT(
                     ((ocrGuidProviderLabeled_t*)self)->guidImplTable,
                     (void*)(fguid->guid.lower), ptr);
 #endif
@@ -509,7 +571,7 @@ u8 labeledGuidGetVal(ocrGuidProvider_t* self, ocrGuid_t guid, u64* val, ocrGuidK
 #elif GUID_BIT_COUNT == 128
             while((*(volatile u64*)(*val)) != guid.lower);
 #endif
-            hal_fence(); // May be overkill but there is a race that I don't get
+            hal_fenceAcquire(); // Metadata published by the creator is visible
         }
         if(kind) {
             *kind = getKindFromGuid(guid);
@@ -619,6 +681,11 @@ static ocrGuidProvider_t* newGuidProviderLabeled(ocrGuidProviderFactory_t *facto
     base->fcts = factory->providerFcts;
     base->pd = NULL;
     base->id = factory->factoryId;
+    base->allocPerGuid = false;
+#ifdef GUID_PROVIDER_COUNTER_BLOCK
+    ((ocrGuidProviderLabeled_t *) base)->counterBlocks = NULL;
+    ((ocrGuidProviderLabeled_t *) base)->counterBlocksAlloc = NULL;
+#endif
     return base;
 }
 
@@ -641,7 +708,7 @@ ocrGuidProviderFactory_t *newGuidProviderFactoryLabeled(ocrParamList_t *typeArg,
     base->providerFcts.switchRunlevel = FUNC_ADDR(u8 (*)(ocrGuidProvider_t*, ocrPolicyDomain_t*, ocrRunlevel_t,
                                                          phase_t, u32, void (*)(ocrPolicyDomain_t*, u64), u64),
         labeledGuidSwitchRunlevel);
-    base->providerFcts.guidReserve = FUNC_ADDR(u8 (*)(ocrGuidProvider_t*, ocrGuid_t*, u64*, u64, ocrGuidKind), labeledGuidReserve);
+    base->providerFcts.guidReserve = FUNC_ADDR(u8 (*)(ocrGuidProvider_t*, ocrGuid_t*, u64*, u64*, u64, ocrGuidKind), labeledGuidReserve);
     base->providerFcts.guidUnreserve = FUNC_ADDR(u8 (*)(ocrGuidProvider_t*, ocrGuid_t, u64, u64), labeledGuidUnreserve);
     base->providerFcts.getGuid = FUNC_ADDR(u8 (*)(ocrGuidProvider_t*, ocrGuid_t*, u64, ocrGuidKind), labeledGuidGetGuid);
     base->providerFcts.createGuid = FUNC_ADDR(u8 (*)(ocrGuidProvider_t*, ocrFatGuid_t*, u64, ocrGuidKind, u32), labeledGuidCreateGuid);
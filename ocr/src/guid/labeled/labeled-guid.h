@@ -25,11 +25,17 @@
  * - Hashtable implementation is backed by a simplistic hash function.
  * - The number of hashtable's buckets can be customize through 'GUID_PROVIDER_NB_BUCKETS'.
  * - GUID generation relies on an atomic incr shared by ALL the workers of the PD.
+ *   With GUID_PROVIDER_COUNTER_BLOCK each worker leases ranges of
+ *   'GUID_PROVIDER_COUNTER_BLOCK_SIZE' values and only increments the shared counter once per range.
  */
 
 typedef struct {
     ocrGuidProvider_t base;
     hashtable_t * guidImplTable;
+#ifdef GUID_PROVIDER_COUNTER_BLOCK
+    guidCounterBlock_t * counterBlocks; /**< Per-worker leased counter ranges */
+    void * counterBlocksAlloc;          /**< Allocation holding counterBlocks */
+#endif
 } ocrGuidProviderLabeled_t;
 
 typedef struct {
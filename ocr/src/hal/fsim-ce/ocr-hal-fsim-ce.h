@@ -36,6 +36,31 @@
  */
 #define hal_fence() tg_fence_fbm()
 
+/**
+ * @brief One-sided memory ordering (see the x86 HAL). These
+ * conservatively map onto full fences around volatile accesses
+ */
+#define hal_fenceAcquire() hal_fence()
+#define hal_fenceRelease() hal_fence()
+
+#define hal_loadAcquire(ptr)                                            \
+    ({                                                                  \
+        __typeof__(*(ptr)) __tmp = *((volatile __typeof__(*(ptr)) *) (ptr)); \
+        hal_fence();                                                    \
+        __tmp;                                                          \
+    })
+
+#define hal_loadRelaxed(ptr) (*((volatile __typeof__(*(ptr)) *) (ptr)))
+
+#define hal_storeRelease(ptr, value)                                    \
+    do {                                                                \
+        hal_fence();                                                    \
+        *((volatile __typeof__(*(ptr)) *) (ptr)) = (value);             \
+    } while(0)
+
+#define hal_storeRelaxed(ptr, value)                                    \
+    do { *((volatile __typeof__(*(ptr)) *) (ptr)) = (value); } while(0)
+
 /**
  * @brief Memory copy from source to destination
  *
@@ -393,6 +418,21 @@
  */
 #define hal_trylock32(lock) tg_cmpxchg32((u32*)lock, 0, 1)
 
+/**
+ * @brief Queued locks (see the x86 HAL) are plain 32 bit locks here
+ * and the caller-provided node is not used
+ */
+typedef u32 halQLock_t;
+
+typedef struct {
+    u8 unused;
+} halQLockNode_t;
+
+#define hal_qlockInit(lock)         do { *(lock) = 0; } while(0)
+#define hal_qlock(lock, node)       do { (void) (node); hal_lock32(lock); } while(0)
+#define hal_qunlock(lock, node)     do { (void) (node); hal_unlock32(lock); } while(0)
+#define hal_qtrylock(lock, node)    ((void) (node), hal_trylock32(lock))
+
 /**
  * @brief Convenience function that basically implements a simple
  * lock
@@ -526,6 +566,20 @@
  */
 #define hal_localizeAddr(addr, me) tg_localize(addr, me)
 
+/**
+ * @brief Returns the NUMA node of the core the caller is running on
+ *
+ * There is a single node on this platform
+ */
+#define hal_numaNode() 0
+
+/**
+ * @brief Returns the physical package of CPU 'cpu'
+ *
+ * Not known on this platform
+ */
+#define hal_cpuPackage(cpu) (-1)
+
 // Support for abstract load and store macros
 #define IS_REMOTE(addr) (__builtin_clzl(addr) < ((sizeof(u64) - 1) - MAP_AGENT_SHIFT))
 
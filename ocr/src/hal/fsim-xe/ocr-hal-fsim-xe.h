@@ -33,6 +33,31 @@
 #define hal_fence()                                     \
     do { __asm__ __volatile__("fence 0xF, B\n\t"); } while(0)
 
+/**
+ * @brief One-sided memory ordering (see the x86 HAL). These
+ * conservatively map onto full fences around volatile accesses
+ */
+#define hal_fenceAcquire() hal_fence()
+#define hal_fenceRelease() hal_fence()
+
+#define hal_loadAcquire(ptr)                                            \
+    ({                                                                  \
+        __typeof__(*(ptr)) __tmp = *((volatile __typeof__(*(ptr)) *) (ptr)); \
+        hal_fence();                                                    \
+        __tmp;                                                          \
+    })
+
+#define hal_loadRelaxed(ptr) (*((volatile __typeof__(*(ptr)) *) (ptr)))
+
+#define hal_storeRelease(ptr, value)                                    \
+    do {                                                                \
+        hal_fence();                                                    \
+        *((volatile __typeof__(*(ptr)) *) (ptr)) = (value);             \
+    } while(0)
+
+#define hal_storeRelaxed(ptr, value)                                    \
+    do { *((volatile __typeof__(*(ptr)) *) (ptr)) = (value); } while(0)
+
 
 /**
  * @brief Memory copy from source to destination
@@ -446,6 +471,21 @@
 #define hal_trylock32(lock)                     \
     hal_cmpswap32(lock, 0, 1)
 
+/**
+ * @brief Queued locks (see the x86 HAL) are plain 32 bit locks here
+ * and the caller-provided node is not used
+ */
+typedef u32 halQLock_t;
+
+typedef struct {
+    u8 unused;
+} halQLockNode_t;
+
+#define hal_qlockInit(lock)         do { *(lock) = 0; } while(0)
+#define hal_qlock(lock, node)       do { (void) (node); hal_lock32(lock); } while(0)
+#define hal_qunlock(lock, node)     do { (void) (node); hal_unlock32(lock); } while(0)
+#define hal_qtrylock(lock, node)    ((void) (node), hal_trylock32(lock))
+
 /**
  * @brief Convenience function that basically implements a simple
  * lock
@@ -572,6 +612,20 @@
  */
 #define hal_localizeAddr(addr) addr
 
+/**
+ * @brief Returns the NUMA node of the core the caller is running on
+ *
+ * There is a single node on this platform
+ */
+#define hal_numaNode() 0
+
+/**
+ * @brief Returns the physical package of CPU 'cpu'
+ *
+ * Not known on this platform
+ */
+#define hal_cpuPackage(cpu) (-1)
+
 // Abstraction to do a load operation from any level of the memory hierarchy
 #define GET8(temp, addr)   ((temp) = *((u8*)(addr)))
 #define GET16(temp, addr)  ((temp) = *((u16*)(addr)))
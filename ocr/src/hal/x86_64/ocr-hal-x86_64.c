@@ -0,0 +1,72 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr-config.h"
+#if defined(HAL_X86_64) && defined(HAL_LOCK_STATS)
+
+#include "ocr-hal.h"
+#include "debug.h"
+
+// Call sites that have acquired a lock at least once
+static halLockSite_t * volatile halLockSites = NULL;
+
+void halLockSiteRecord(halLockSite_t * site, u64 spins) {
+    if((site->registered == 0) && (__sync_lock_test_and_set(&(site->registered), 1) == 0)) {
+        halLockSite_t * head;
+        do {
+            head = halLockSites;
+            site->next = head;
+        } while(__sync_val_compare_and_swap(&halLockSites, head, site) != head);
+    }
+    __sync_fetch_and_add(&(site->acquires), 1);
+    if(spins != 0) {
+        __sync_fetch_and_add(&(site->contended), 1);
+        __sync_fetch_and_add(&(site->spins), spins);
+    }
+}
+
+static void __attribute__((destructor)) halLockStatsDump(void) {
+    halLockSite_t * site = halLockSites;
+    while(site != NULL) {
+        if(site->contended != 0) {
+            PRINTF("Lock site %s:%"PRIu32" acquires %"PRIu64" contended %"PRIu64" spins %"PRIu64"\n",
+                   site->file, site->line, site->acquires, site->contended, site->spins);
+        }
+        site = site->next;
+    }
+}
+
+#endif /* HAL_X86_64 && HAL_LOCK_STATS */
+
+#if defined(HAL_X86_64)
+
+#include "ocr-hal.h"
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <stdio.h>
+#endif
+
+s32 halCpuPackage(u32 cpu) {
+#ifdef __linux__
+    char path[96];
+    char buf[16];
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%"PRIu32"/topology/physical_package_id", cpu);
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return -1;
+    ssize_t len = read(fd, buf, sizeof(buf) - 1);
+    close(fd);
+    if (len <= 0)
+        return -1;
+    buf[len] = '\0';
+    return (s32)atoi(buf);
+#else
+    return -1;
+#endif
+}
+
+#endif /* HAL_X86_64 */
@@ -22,6 +22,10 @@
 #define _GNU_SOURCE
 #define __USE_GNU
 #include <sched.h>
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
 
 
 /****************************************************/
@@ -29,15 +33,67 @@
 /****************************************************/
 
 /**
- * @brief Perform a memory fence
+ * @brief Perform a full memory fence
  *
- * @todo Do we want to differentiate different types
- * of fences?
+ * See the MEMORY ORDERING section for one-sided barriers
  */
 
 #define hal_fence() \
     do { __sync_synchronize(); } while(0);
 
+/****************************************************/
+/* MEMORY ORDERING                                  */
+/****************************************************/
+
+// hal_fence() is a full (store-load) barrier and costs an mfence on x86.
+// Most publication patterns only need one-sided ordering, which the macros
+// below express with the C11 memory model (__atomic builtins). On x86 (TSO)
+// acquire loads, release stores and acquire/release fences are plain moves
+// that only restrict compiler reordering.
+//
+// 'ptr' must point to a naturally aligned scalar or pointer of at most
+// 64 bits; the macros are type generic.
+
+/**
+ * @brief Prevents loads and stores that follow from being
+ * performed before loads that precede the fence
+ */
+#define hal_fenceAcquire() __atomic_thread_fence(__ATOMIC_ACQUIRE)
+
+/**
+ * @brief Prevents loads and stores that precede from being
+ * performed after stores that follow the fence
+ */
+#define hal_fenceRelease() __atomic_thread_fence(__ATOMIC_RELEASE)
+
+/**
+ * @brief Atomic load; no access that follows in program order
+ * can be performed before it
+ *
+ * @param ptr       Pointer to the location to read
+ * @return Value at the location
+ */
+#define hal_loadAcquire(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+
+/**
+ * @brief Atomic load without ordering constraints
+ */
+#define hal_loadRelaxed(ptr) __atomic_load_n((ptr), __ATOMIC_RELAXED)
+
+/**
+ * @brief Atomic store; all accesses that precede it in program
+ * order are visible before the stored value is
+ *
+ * @param ptr       Pointer to the location to write
+ * @param value     Value to write
+ */
+#define hal_storeRelease(ptr, value) __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+
+/**
+ * @brief Atomic store without ordering constraints
+ */
+#define hal_storeRelaxed(ptr, value) __atomic_store_n((ptr), (value), __ATOMIC_RELAXED)
+
 /**
  * @brief Memory move from source to destination
  *
@@ -58,6 +114,50 @@
     do { memmove((void*)(destination), (const void*)(source), (size)); } while(0)
 
 
+// Background copies of at least this many bytes bypass the caches: the
+// destination is not expected to be read right away and streaming it in
+// would evict the working set of the worker doing the copy
+#ifndef HAL_MEMCOPY_STREAM_MIN
+#define HAL_MEMCOPY_STREAM_MIN (256*1024)
+#endif
+
+typedef long long halVec128_t __attribute__ ((vector_size (16)));
+
+/**
+ * @brief Copies with non-temporal stores, 64 bytes at a time
+ *
+ * Non-temporal stores are weakly ordered; the trailing sfence makes
+ * the copy complete (and visible) when this returns.
+ */
+static inline void halMemCopyStream(void * destination, const void * source, u64 size) {
+    u8 * dst = (u8 *) destination;
+    const u8 * src = (const u8 *) source;
+    // Align the destination on 16 bytes
+    u64 head = (-(u64) dst) & 15;
+    if(head > size)
+        head = size;
+    __builtin_memcpy(dst, src, head);
+    dst += head;
+    src += head;
+    size -= head;
+    while(size >= 64) {
+        halVec128_t v0, v1, v2, v3;
+        __builtin_memcpy(&v0, src, 16);
+        __builtin_memcpy(&v1, src + 16, 16);
+        __builtin_memcpy(&v2, src + 32, 16);
+        __builtin_memcpy(&v3, src + 48, 16);
+        __builtin_ia32_movntdq((halVec128_t *) dst, v0);
+        __builtin_ia32_movntdq((halVec128_t *) (dst + 16), v1);
+        __builtin_ia32_movntdq((halVec128_t *) (dst + 32), v2);
+        __builtin_ia32_movntdq((halVec128_t *) (dst + 48), v3);
+        dst += 64;
+        src += 64;
+        size -= 64;
+    }
+    __builtin_ia32_sfence();
+    __builtin_memcpy(dst, src, size);
+}
+
 /**
  * @brief Memory copy from source to destination
  *
@@ -70,12 +170,20 @@
  *                           return only once the copy is fully complete and a
  *                           non-zero value indicates the copy may proceed
  *                           in the background. A fence will then be
- *                           required to ensure completion of the copy
+ *                           required to ensure completion of the copy.
+ *                           On x86, large background copies use
+ *                           non-temporal stores and are complete on return
  * @todo Define what behavior we want for overlapping
  * source and destination
  */
-#define hal_memCopy(destination, source, size, isBackground) \
-    do { __builtin_memcpy((void*)(destination), (const void*)(source), (size)); } while(0)
+#define hal_memCopy(destination, source, size, isBackground)                \
+    do {                                                                    \
+        u64 __size = (size);                                                \
+        if((isBackground) && (__size >= HAL_MEMCOPY_STREAM_MIN))            \
+            halMemCopyStream((void*)(destination), (const void*)(source), __size); \
+        else                                                                \
+            __builtin_memcpy((void*)(destination), (const void*)(source), __size); \
+    } while(0)
 
 
 /**
@@ -180,6 +288,93 @@
 #define hal_radd32(atomic, addValue)            \
     __sync_fetch_and_add(atomic, addValue)
 
+/****************************************************/
+/* LOCKS                                            */
+/****************************************************/
+
+// Locks come in two families:
+//  - hal_lock32: a u32 that is 0 when free and 1 when held. Some code
+//    inspects or CASes the value directly so the encoding is fixed. It is
+//    a test-and-test-and-set lock with exponential backoff, or the plain
+//    test-and-set spin it used to be with HAL_LOCK_TAS.
+//  - hal_qlock: an opaque halQLock_t for hot locks whose holders only go
+//    through the hal_qlock* calls and release them in the scope that
+//    acquired them (the caller provides a halQLockNode_t for the duration).
+//    The implementation is picked at build time: HAL_QLOCK_TICKET (FIFO
+//    ticket lock), HAL_QLOCK_MCS (queue lock, each waiter spins on its
+//    own node) or, by default, the same TTAS lock as hal_lock32.
+//
+// With HAL_LOCK_STATS every call site that acquires a lock counts its
+// acquisitions, the contended ones and the backoff iterations they spun
+// for. The sites that saw contention are printed when the process exits.
+
+#if defined(HAL_QLOCK_TICKET) && defined(HAL_QLOCK_MCS)
+#error HAL_QLOCK_TICKET and HAL_QLOCK_MCS are mutually exclusive
+#endif
+
+// Upper bound of the exponential backoff (in pause instructions)
+#ifndef HAL_LOCK_BACKOFF_MAX
+#define HAL_LOCK_BACKOFF_MAX 1024
+#endif
+
+// Spin-wait hint: lets the sibling hyper-thread run and avoids the
+// memory-order violation flush when the awaited line changes
+#define HAL_SPIN_PAUSE() __builtin_ia32_pause()
+
+#ifdef HAL_LOCK_STATS
+typedef struct _halLockSite_t {
+    const char * file;
+    u32 line;
+    volatile u32 registered;
+    volatile u64 acquires;
+    volatile u64 contended;
+    volatile u64 spins;
+    struct _halLockSite_t * next;
+} halLockSite_t;
+
+extern void halLockSiteRecord(halLockSite_t * site, u64 spins);
+
+#define HAL_LOCK_RECORD(spins)                                              \
+    do {                                                                    \
+        static halLockSite_t __halLockSite = {__FILE__, __LINE__, 0, 0, 0, 0, NULL}; \
+        halLockSiteRecord(&__halLockSite, (spins));                         \
+    } while(0)
+#else
+#define HAL_LOCK_RECORD(spins) do { (void) (spins); } while(0)
+#endif
+
+// Returns the number of backoff iterations spent waiting
+static inline u64 halTtasAcquire(volatile u32 * lock) {
+    u64 spins = 0;
+#ifdef HAL_LOCK_TAS
+    while(__sync_lock_test_and_set(lock, 1) != 0)
+        ++spins;
+#else
+    u32 backoff = 1;
+    while(__sync_lock_test_and_set(lock, 1) != 0) {
+        // Wait for the lock to look free before trying again so that
+        // waiters share the line instead of bouncing it with writes
+        do {
+            u32 i;
+            for(i = 0; i < backoff; ++i)
+                HAL_SPIN_PAUSE();
+            spins += backoff;
+            if(backoff < HAL_LOCK_BACKOFF_MAX)
+                backoff <<= 1;
+        } while(*lock != 0);
+    }
+#endif
+    return spins;
+}
+
+static inline u32 halTtasTryAcquire(volatile u32 * lock) {
+#ifndef HAL_LOCK_TAS
+    if(*lock != 0)
+        return 1;
+#endif
+    return __sync_lock_test_and_set(lock, 1);
+}
+
 /**
  * @brief Convenience function that basically implements a simple
  * lock
@@ -191,7 +386,8 @@
  */
 #define hal_lock32(lock)                                    \
     do {                                                    \
-        while(__sync_lock_test_and_set(lock, 1) != 0) ;     \
+        u64 __spins = halTtasAcquire((volatile u32 *) (lock));  \
+        HAL_LOCK_RECORD(__spins);                           \
     } while(0);
 
 /**
@@ -215,10 +411,167 @@
  */
 #define hal_trylock32(lock)                                             \
     ({                                                                  \
-        u32 __tmp = __sync_lock_test_and_set(lock, 1);                  \
+        u32 __tmp = halTtasTryAcquire((volatile u32 *) (lock));         \
         __tmp;                                                          \
     })
 
+#if defined(HAL_QLOCK_TICKET)
+// Tickets are taken from 'next' and served in order through 'owner'
+typedef union {
+    u32 word;
+    struct {
+        u16 owner;
+        u16 next;
+    } ticket;
+} halQLock_t;
+
+typedef struct {
+    u8 unused;
+} halQLockNode_t;
+
+static inline u64 halQLockAcquire(volatile halQLock_t * lock, halQLockNode_t * node) {
+    u16 ticket = __atomic_fetch_add(&(lock->ticket.next), 1, __ATOMIC_RELAXED);
+    u64 spins = 0;
+    u16 owner;
+    while((owner = __atomic_load_n(&(lock->ticket.owner), __ATOMIC_ACQUIRE)) != ticket) {
+        // Back off in proportion to the number of holders ahead of us
+        u32 i, wait = ((u16) (ticket - owner)) * 8;
+        for(i = 0; i < wait; ++i)
+            HAL_SPIN_PAUSE();
+        spins += wait;
+    }
+    return spins;
+}
+
+static inline u32 halQLockTryAcquire(volatile halQLock_t * lock, halQLockNode_t * node) {
+    halQLock_t cur, next;
+    cur.word = lock->word;
+    if(cur.ticket.owner != cur.ticket.next)
+        return 1;
+    next = cur;
+    next.ticket.next++;
+    return (__sync_val_compare_and_swap(&(lock->word), cur.word, next.word) == cur.word) ? 0 : 1;
+}
+
+static inline void halQLockRelease(volatile halQLock_t * lock, halQLockNode_t * node) {
+    // Only the holder writes 'owner'
+    __atomic_store_n(&(lock->ticket.owner), (u16) (lock->ticket.owner + 1), __ATOMIC_RELEASE);
+}
+
+static inline void halQLockInit(volatile halQLock_t * lock) {
+    lock->word = 0;
+}
+
+#elif defined(HAL_QLOCK_MCS)
+typedef struct _halQLockNode_t {
+    struct _halQLockNode_t * volatile next;
+    volatile u32 waiting;
+} halQLockNode_t;
+
+// Tail of the queue of waiters, NULL when free
+typedef halQLockNode_t * halQLock_t;
+
+static inline u64 halQLockAcquire(halQLock_t volatile * lock, halQLockNode_t * node) {
+    node->next = NULL;
+    node->waiting = 1;
+    halQLockNode_t * pred = __atomic_exchange_n(lock, node, __ATOMIC_ACQ_REL);
+    if(pred == NULL)
+        return 0;
+    // Link behind the previous tail and spin on our own node
+    pred->next = node;
+    u64 spins = 0;
+    while(__atomic_load_n(&(node->waiting), __ATOMIC_ACQUIRE)) {
+        HAL_SPIN_PAUSE();
+        ++spins;
+    }
+    return spins;
+}
+
+static inline u32 halQLockTryAcquire(halQLock_t volatile * lock, halQLockNode_t * node) {
+    node->next = NULL;
+    node->waiting = 0;
+    halQLockNode_t * expected = NULL;
+    return __atomic_compare_exchange_n(lock, &expected, node, false,
+                                       __ATOMIC_ACQUIRE, __ATOMIC_RELAXED) ? 0 : 1;
+}
+
+static inline void halQLockRelease(halQLock_t volatile * lock, halQLockNode_t * node) {
+    halQLockNode_t * succ = node->next;
+    if(succ == NULL) {
+        halQLockNode_t * expected = node;
+        if(__atomic_compare_exchange_n(lock, &expected, NULL, false,
+                                       __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+            return;
+        // A waiter swapped itself in but has not linked to us yet
+        while((succ = node->next) == NULL)
+            HAL_SPIN_PAUSE();
+    }
+    __atomic_store_n(&(succ->waiting), 0, __ATOMIC_RELEASE);
+}
+
+static inline void halQLockInit(halQLock_t volatile * lock) {
+    *lock = NULL;
+}
+
+#else
+typedef u32 halQLock_t;
+
+typedef struct {
+    u8 unused;
+} halQLockNode_t;
+
+static inline u64 halQLockAcquire(volatile halQLock_t * lock, halQLockNode_t * node) {
+    return halTtasAcquire(lock);
+}
+
+static inline u32 halQLockTryAcquire(volatile halQLock_t * lock, halQLockNode_t * node) {
+    return halTtasTryAcquire(lock);
+}
+
+static inline void halQLockRelease(volatile halQLock_t * lock, halQLockNode_t * node) {
+    __sync_lock_release(lock);
+}
+
+static inline void halQLockInit(volatile halQLock_t * lock) {
+    *lock = 0;
+}
+#endif
+
+/**
+ * @brief Initializes a queued lock to the free state
+ *
+ * @param lock      Pointer to a halQLock_t
+ */
+#define hal_qlockInit(lock) halQLockInit(lock)
+
+/**
+ * @brief Acquires a queued lock
+ *
+ * Blocks until the lock is acquired. 'node' must stay valid until
+ * the matching hal_qunlock which must use the same node.
+ *
+ * @param lock      Pointer to a halQLock_t
+ * @param node      Pointer to a halQLockNode_t owned by the caller
+ */
+#define hal_qlock(lock, node)                               \
+    do {                                                    \
+        u64 __spins = halQLockAcquire((lock), (node));      \
+        HAL_LOCK_RECORD(__spins);                           \
+    } while(0)
+
+/**
+ * @brief Releases a queued lock acquired with 'node'
+ */
+#define hal_qunlock(lock, node) halQLockRelease((lock), (node))
+
+/**
+ * @brief Tries to acquire a queued lock
+ *
+ * @return 0 if the lock has been acquired and a non-zero
+ * value if it cannot be acquired
+ */
+#define hal_qtrylock(lock, node) halQLockTryAcquire((lock), (node))
+
 /**
  * @brief Abort the runtime
  *
@@ -275,6 +628,32 @@
 /* SYSTEM DISCOVERY                                 */
 /****************************************************/
 
+/**
+ * @brief Returns the NUMA node of the core the caller is running on
+ *
+ * Returns 0 if it cannot be determined. This is a system call: workers
+ * sample it once when their thread starts (see ocrWorker_t::numaNode).
+ * Unbound threads may migrate right after so this only guides placement
+ */
+#define hal_numaNode() halNumaNode()
+
+static inline u32 halNumaNode() {
+#if defined(__linux__) && defined(SYS_getcpu)
+    unsigned int cpu, node;
+    if (syscall(SYS_getcpu, &cpu, &node, NULL) == 0)
+        return node;
+#endif
+    return 0;
+}
+
+/**
+ * @brief Returns the physical package (socket) of CPU 'cpu'
+ *
+ * Returns -1 if it cannot be determined
+ */
+#define hal_cpuPackage(cpu) halCpuPackage(cpu)
+
+s32 halCpuPackage(u32 cpu);
 
 
 // Abstraction to do a load operation from any level of the memory hierarchy
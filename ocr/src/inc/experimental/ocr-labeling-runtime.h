@@ -22,11 +22,31 @@ typedef struct _ocrGuidMap_t {
     ocrGuid_t startGuid;
     u64 skipGuid;
     u64 numGuids;
+    u64 locationSkip;  // For ranges, the GUID of index 'idx' is startGuid + idx*skipGuid +
+    u64 blockSize;     // ((idx/blockSize) % numLocations)*locationSkip. The range is local
+    u32 numLocations;  // when numLocations is 1
     s64* params; // Points to the parameters (usually right after this structure
                  // Pointer is not absolutely necessary but convenient
     u32 numParams;
 } ocrGuidMap_t;
 
+#ifndef GUID_MAP_CACHE_SIZE
+#define GUID_MAP_CACHE_SIZE 8 // Must be a power of 2
+#endif
+
+/**
+ * @brief Entry of a worker's cache of map metadata
+ *
+ * Maps are immutable once created so a worker resolves a map GUID once and
+ * keeps the metadata pointer. An entry is only valid for the epoch it was
+ * filled in: destroying any map moves to a new epoch.
+ */
+typedef struct _ocrGuidMapCacheEntry_t {
+    ocrGuid_t guid;
+    ocrGuidMap_t *map;
+    u64 epoch;
+} ocrGuidMapCacheEntry_t;
+
 
 #endif /* ENABLE_EXTENSION_LABELING */
 #endif /* __OCR_LABELING_RUNTIME_H__ */
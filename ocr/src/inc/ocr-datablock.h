@@ -212,6 +212,7 @@ typedef struct _ocrDataBlock_t {
 #define DB_PROP_NO_RELEASE          0x40000 // Indicate a release is not required
 #define DB_PROP_RT_PD_ACQUIRE       0x80000 // DB acquired by scheduler for whole PD
 #define DB_PROP_RT_PROXY            0x100000// DB metadata instantiated as proxy (workaround for BUG #162)
+#define DB_PROP_RT_COALLOC          0x200000// DB metadata lives in the same allocation, just before ptr
 
 #define DB_FLAG_RT_FETCH            0x1000000
 #define DB_FLAG_RT_WRITE_BACK       0x2000000
@@ -234,7 +235,9 @@ typedef struct _ocrDataBlockFactory_t {
      * @param[in] allocator     Allocator guid used to allocate memory
      * @param[in] allocPD       Policy-domain of the allocator
      * @param[in] size          data-block size
-     * @param[in] ptr           Pointer to the memory to use (created through an allocator)
+     * @param[in] ptr           Pointer to the memory to use (created through an allocator).
+     *                          If DB_PROP_RT_COALLOC is set, the metaSize bytes preceding
+     *                          ptr belong to the same allocation and hold the metadata
      * @param[in] hint          Hints provided at time of creation
      * @param[in] properties    Properties for the data-block creation (GUID_PROP_* or DB_PROP_*)
      * @param[in] instanceArg   Arguments specific for this instance
@@ -252,6 +255,7 @@ typedef struct _ocrDataBlockFactory_t {
     u32 factoryId; /**< Corresponds to fctId in DB */
     ocrDataBlockFcts_t fcts; /**< Function pointers created instances should use */
     u64 *hintPropMap; /**< Mapping hint properties to implementation specific packed array */
+    u32 metaSize; /**< Bytes to reserve before ptr for DB_PROP_RT_COALLOC (0 if not supported) */
 } ocrDataBlockFactory_t;
 
 #endif /* __OCR_DATABLOCK_H__ */
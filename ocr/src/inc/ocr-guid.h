@@ -87,12 +87,15 @@ typedef struct _ocrGuidProviderFcts_t {
      * @param[in] self             GUID provider reserving the GUIDs
      * @param[out] startGuid       Returns the first GUID of the range
      * @param[out] skipGuid        Returns the "step" between valid GUIDs in the range
+     * @param[out] locationSkip    Returns the difference between the GUIDs encoding
+     *                             two consecutive locations for the same index in the
+     *                             range, 0 if the range cannot be distributed
      * @param[in] numberGuids      Number of GUIDs to reserve
      * @param[in] guidType         Type of GUIDs this range will be used to store
      * @return 0 on success a non-zero error code
      */
     u8 (*guidReserve)(struct _ocrGuidProvider_t *self, ocrGuid_t *startGuid, u64* skipGuid,
-                      u64 numberGuids, ocrGuidKind guidType);
+                      u64* locationSkip, u64 numberGuids, ocrGuidKind guidType);
 
     /**
      * @brief Un-reserves a GUID range when no longer needed.
@@ -244,8 +247,31 @@ typedef struct _ocrGuidProvider_t {
     struct _ocrPolicyDomain_t *pd;  /**< Policy domain of this GUID provider */
     u32 id;                         /**< Function IDs for this GUID provider */
     ocrGuidProviderFcts_t fcts;     /**< Functions for this instance */
+    bool allocPerGuid;              /**< Each GUID costs an allocation, even without metadata */
 } ocrGuidProvider_t;
 
+#ifdef GUID_PROVIDER_COUNTER_BLOCK
+#ifndef GUID_PROVIDER_COUNTER_BLOCK_SIZE
+#define GUID_PROVIDER_COUNTER_BLOCK_SIZE 4096
+#endif
+
+/**
+ * @brief Range of GUID counter values leased by a worker
+ *
+ * Counter-based providers hand each worker a contiguous block
+ * of GUID_PROVIDER_COUNTER_BLOCK_SIZE counter values taken from the
+ * shared counter. The worker then generates GUIDs from its block
+ * without touching the shared counter until the block is exhausted.
+ * The structure is padded to a cache line and the array of blocks
+ * starts on a cache line so that workers do not share lines.
+ */
+typedef struct _guidCounterBlock_t {
+    u64 next;       /**< Next counter value to hand out */
+    u64 end;        /**< One past the last value of the block */
+    u64 padding[6];
+} guidCounterBlock_t;
+#endif
+
 
 /****************************************************/
 /* OCR GUID PROVIDER FACTORY                        */
@@ -21,6 +21,18 @@
 
 struct _ocrPolicyDomain_t;
 
+/**
+ * @brief Pages backing the memory of a mem-platform
+ *
+ * Huge pages reduce TLB misses when large pools are walked. Only the
+ * platforms that reserve their memory from the OS honor this.
+ */
+typedef enum {
+    MEM_PLATFORM_PAGES_DEFAULT,     /**< Whatever the platform normally gets */
+    MEM_PLATFORM_PAGES_TRANSPARENT, /**< Transparent huge pages */
+    MEM_PLATFORM_PAGES_EXPLICIT     /**< Huge pages reserved by the administrator */
+} ocrMemPlatformPages_t;
+
 /****************************************************/
 /* PARAMETER LISTS                                  */
 /****************************************************/
@@ -39,6 +51,8 @@ typedef struct _paramListMemPlatformInst_t {
     ocrParamList_t base;
     u64 size;
     u32 numa_node;
+    bool highBandwidth;
+    ocrMemPlatformPages_t pages;
 } paramListMemPlatformInst_t;
 
 
@@ -188,6 +202,8 @@ typedef struct _ocrMemPlatformFcts_t {
 typedef struct _ocrMemPlatform_t {
     struct _ocrPolicyDomain_t *pd; /**< Policy domain that uses this mem-platform */
     u64 size, startAddr, endAddr;  /**< Size, start and end address for this instance */
+    u32 numaNode;                  /**< NUMA node the memory is on */
+    bool highBandwidth;            /**< True for high-bandwidth memory (MCDRAM, HBM) */
     ocrMemPlatformFcts_t fcts; /**< Functions for this instance */
 } ocrMemPlatform_t;
 
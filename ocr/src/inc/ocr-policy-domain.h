@@ -227,6 +227,11 @@ typedef struct _paramListPolicyDomainInst_t {
 
 #define PD_MSG_EVT_SAT_ADD      0x00089080
 
+/**< Satisfy several dependences, all in the destination policy domain,
+ * with the same payload. Equivalent to one PD_MSG_DEP_SATISFY per target
+ */
+#define PD_MSG_DEP_SATISFY_BATCH 0x000CA080
+
 /**< AND with this and if result non-null, low-level OS operation */
 #define PD_MSG_SAL_OP           0x100
 /**< Print operation */
@@ -365,6 +370,17 @@ struct _ocrPolicyDomain_t;
     name.usefulSize = 0; name.bufferSize = sizeof(ocrPolicyMsg_t); \
     name.srcLocation = name.destLocation = INVALID_LOCATION;
 
+/**
+ * @brief Event or task slot satisfied by a PD_MSG_DEP_SATISFY_BATCH
+ */
+typedef struct _ocrSatisfyTarget_t {
+    ocrGuid_t guid;         /**< GUID of the event/task to satisfy */
+    u32 slot;               /**< Slot to satisfy the event/task on */
+#ifdef REG_ASYNC_SGL
+    ocrDbAccessMode_t mode; /**< Mode the task acquires the payload in */
+#endif
+} ocrSatisfyTarget_t;
+
 /**
  * @brief Structure describing a "message" that is used to communicate between
  * policy domains in an asynchronous manner
@@ -723,6 +739,8 @@ typedef struct _ocrPolicyMsg_t {
                 struct {
                     ocrGuid_t startGuid;  /**< Out: First GUID usable in the reserved range */
                     u64 skipGuid;         /**< Out: Skip value between two consecutive GUIDs in the range */
+                    u64 locationSkip;     /**< Out: Skip value between the GUIDs of an index on two
+                                           * consecutive locations (0 if the range is not distributable) */
                     u32 returnDetail;     /**< Out: Return value; 0 on success */
                 } out;
             } inOrOut __attribute__ (( aligned(8) ));
@@ -958,6 +976,23 @@ typedef struct _ocrPolicyMsg_t {
             } inOrOut __attribute__ (( aligned(8) ));
         } PD_MSG_STRUCT_NAME(PD_MSG_DEP_SATISFY);
 
+        struct {
+            union {
+                struct {
+                    ocrFatGuid_t satisfierGuid; /**< In: GUID of the "satisfier" (usually an event) */
+                    ocrFatGuid_t payload;       /**< In: GUID of the "payload" to satisfy the
+                                                 * targets with (a DB usually). */
+                    ocrFatGuid_t currentEdt;    /**< In: EDT that is satisfying deps */
+                    ocrSatisfyTarget_t * targets; /**< In: Events/tasks to satisfy */
+                    u32 count;                  /**< In: Number of targets */
+                    u32 properties;             /**< In: Properties for the satisfaction */
+                } in;
+                struct {
+                    u32 returnDetail;     /**< Out: Success or error code */
+                } out;
+            } inOrOut __attribute__ (( aligned(8) ));
+        } PD_MSG_STRUCT_NAME(PD_MSG_DEP_SATISFY_BATCH);
+
         struct {
             union {
                 struct {
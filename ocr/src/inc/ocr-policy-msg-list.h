@@ -47,6 +47,7 @@ PER_TYPE(PD_MSG_EVT_SAT_ADD)
 PER_TYPE(PD_MSG_DEP_REGSIGNALER)
 PER_TYPE(PD_MSG_DEP_REGWAITER)
 PER_TYPE(PD_MSG_DEP_SATISFY)
+PER_TYPE(PD_MSG_DEP_SATISFY_BATCH)
 PER_TYPE(PD_MSG_DEP_UNREGSIGNALER)
 PER_TYPE(PD_MSG_DEP_UNREGWAITER)
 PER_TYPE(PD_MSG_DEP_DYNADD)
@@ -155,14 +155,26 @@ typedef enum {
     OCR_TRANSACT_PROP_REQUEST   =0x1,
     OCR_TRANSACT_PROP_TRANSFER  =0x2,
     OCR_TRANSACT_PROP_DONE      =0x4,
+    OCR_TRANSACT_PROP_BATCH     =0x8,               /* Local hand-off of a vector of ready EDTs */
 } ocrSchedulerTransactProp;
 
 typedef struct _ocrSchedulerOpTransactArgs_t {
     ocrSchedulerOpArgs_t base;
     ocrSchedulerTransactProp properties;            /* Transact properties */
     struct _ocrSchedulerObject_t schedObj;          /* The scheduler object element transacted */
+    ocrFatGuid_t *guids;                            /* OCR_TRANSACT_PROP_BATCH: ready EDTs */
+    u32 guidCount;                                  /* OCR_TRANSACT_PROP_BATCH: number of ready EDTs */
 } ocrSchedulerOpTransactArgs_t;
 
+/* Ready EDTs collected by a worker while it drains the waiters of
+ * satisfied events. They are handed to the scheduler in a single
+ * OCR_TRANSACT_PROP_BATCH transaction instead of one notify each. */
+typedef struct _ocrSchedReadyBatch_t {
+    ocrFatGuid_t *guids;                            /* Storage for the batched EDTs */
+    u32 count;                                      /* Number of EDTs in the batch */
+    u32 max;                                        /* Capacity of 'guids' */
+} ocrSchedReadyBatch_t;
+
 /* Scheduler analysis related arguments:
  * Analyze msgs are lightweight msgs intended for example,
  * to setup a heavyweight transfer of a scheduler object or
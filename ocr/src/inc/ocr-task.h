@@ -251,6 +251,21 @@ typedef struct _ocrTaskFcts_t {
      */
     u8 (*notifyDbRelease)(struct _ocrTask_t* self, ocrFatGuid_t db);
 
+    /**
+     * @brief Looks up a data-block the task currently holds
+     *
+     * Like notifyDbAcquire(), this is always called within the
+     * execution of self
+     *
+     * @param[in] self          Pointer to this task
+     * @param[in] db            GUID of the DB
+     * @param[out] ptr          Address of the DB for the task or NULL if the
+     *                          task created the DB (use the DB's metadata)
+     * @param[out] mode         Mode the task acquired the DB with
+     * @return 0 if the task holds the DB and OCR_ENOENT otherwise
+     */
+    u8 (*getAcquiredDb)(struct _ocrTask_t* self, ocrGuid_t db, void** ptr, ocrDbAccessMode_t* mode);
+
     /**
      * @brief Executes this EDT
      *
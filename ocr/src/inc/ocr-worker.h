@@ -12,6 +12,7 @@
 #include "ocr-runtime-types.h"
 #include "ocr-scheduler.h"
 #include "ocr-types.h"
+#include "experimental/ocr-labeling-runtime.h"
 
 #ifdef OCR_ENABLE_STATISTICS
 #include "ocr-statistics.h"
@@ -106,6 +107,7 @@ typedef struct _ocrWorker_t {
     ocrWorkerType_t type;
     u8 amBlessed; // BUG #583: Clean-up runlevels; maybe merge in type?
     u64 id; //Worker id as indicated in runtime config
+    u32 numaNode; // NUMA node the worker runs on, sampled when its thread starts
     // Workers are capable modules so
     // part of their runlevel processing happens asynchronously
     // This provides a convenient location to save
@@ -123,6 +125,9 @@ typedef struct _ocrWorker_t {
     ocrCompTarget_t **computes; /**< Compute node(s) associated with this worker */
     u64 computeCount;           /**< Number of compute node(s) associated */
     struct _ocrTask_t * volatile curTask; /**< Currently executing task */
+#ifdef ENABLE_EXTENSION_LABELING
+    ocrGuidMapCacheEntry_t guidMapCache[GUID_MAP_CACHE_SIZE]; /**< Maps recently used by this worker */
+#endif
 
     ocrWorkerFcts_t fcts;
 
@@ -0,0 +1,54 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+/**
+ * @brief Allocator managing memory inside a data block
+ *
+ * The allocator's state lives at the start of the data block it manages
+ * and only refers to its blocks through offsets from that start. It
+ * therefore remains valid when the data block is moved or copied to
+ * another address space.
+ */
+
+#ifndef __DB_ARENA_H__
+#define __DB_ARENA_H__
+
+#include "ocr-types.h"
+
+/**
+ * @brief Initializes an arena covering a whole data block
+ *
+ * @param[in] base     Start of the data block
+ * @param[in] size     Size of the data block in bytes
+ * @return 0 on success or OCR_ENOMEM if the data block is too small
+ * to hold the arena's book-keeping and at least one chunk
+ */
+u8 dbArenaInit(void * base, u64 size);
+
+/**
+ * @brief Allocates a chunk from an arena
+ *
+ * The chunk is 8 byte aligned like the data block itself
+ *
+ * @param[in] base     Start of the data block holding the arena
+ * @param[in] size     Size in bytes of the chunk to allocate
+ * @param[out] offset  Offset of the chunk from base
+ * @return 0 on success, OCR_ENOMEM if no free chunk is large enough
+ * or OCR_EINVAL if there is no arena at base
+ */
+u8 dbArenaAlloc(void * base, u64 size, u64 * offset);
+
+/**
+ * @brief Frees a chunk returned by dbArenaAlloc
+ *
+ * @param[in] base     Start of the data block holding the arena
+ * @param[in] offset   Offset of the chunk as returned by dbArenaAlloc
+ * @return 0 on success or OCR_EINVAL if there is no arena at base or
+ * offset does not refer to an allocated chunk
+ */
+u8 dbArenaFree(void * base, u64 offset);
+
+#endif /* __DB_ARENA_H__ */
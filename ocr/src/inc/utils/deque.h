@@ -16,6 +16,11 @@
 #define INIT_DEQUE_CAPACITY 32768
 #endif
 
+#ifndef INIT_WST_DEQUE_CAPACITY
+// Initial size of growable work-stealing deques. Must be a power of two.
+#define INIT_WST_DEQUE_CAPACITY 256
+#endif
+
 /****************************************************/
 /* DEQUE TYPES                                      */
 /****************************************************/
@@ -99,6 +104,31 @@ typedef struct _ocrDequeDualLocked_t {
     volatile u32 lockT;
 } dequeDualLocked_t;
 
+/****************************************************/
+/* WORK-STEALING DEQUE                              */
+/****************************************************/
+
+/**
+ * @brief Circular buffer backing a work-stealing deque
+ *
+ * Buffers are replaced by a larger one when the owner pushes
+ * into a full deque. Retired buffers are chained through 'prev'
+ * and only freed when the deque is destroyed since a thief may
+ * still be reading from them.
+ */
+typedef struct _ocrDequeBuffer_t {
+    u32 capacity; // Always a power of two
+    struct _ocrDequeBuffer_t * prev;
+    volatile void ** data;
+} dequeBuffer_t;
+
+// Growable work-stealing deque (Chase-Lev)
+typedef struct _ocrDequeWst_t {
+    deque_t base;
+    ocrPolicyDomain_t * pd;
+    dequeBuffer_t * volatile buffer;
+} dequeWst_t;
+
 /****************************************************/
 /* DEQUE API                                        */
 /****************************************************/
@@ -59,6 +59,24 @@ void destructHashtable(hashtable_t * hashtable, deallocFct entryDeallocator, voi
 hashtable_t * newHashtableBucketLocked(ocrPolicyDomain_t * pd, u32 nbBuckets, hashFct hashing);
 void destructHashtableBucketLocked(hashtable_t * hashtable, deallocFct entryDeallocator, void * deallocatorParam);
 
+/*
+ * Sharded open-addressing hashtable.
+ * - Keys are non-zero 64 bits values (zero marks an empty slot).
+ * - 'hashing' selects the shard and is expected to consume the low bits of the
+ *   key (modulo); there are HASHTABLE_SHARDS_PER_WORKER shards per PD worker.
+ *   Inside a shard, slots are found by linear probing from the next key bits.
+ * - Readers never write shared memory; writers serialize per shard.
+ * - Shards grow fourfold online when they are 3/4 full.
+ * - 'nbBuckets' is the initial total capacity of the table.
+ */
+void * hashtableConcShardedGet(hashtable_t * hashtable, void * key);
+bool hashtableConcShardedPut(hashtable_t * hashtable, void * key, void * value);
+void * hashtableConcShardedTryPut(hashtable_t * hashtable, void * key, void * value);
+bool hashtableConcShardedRemove(hashtable_t * hashtable, void * key, void ** value);
+
+hashtable_t * newHashtableSharded(ocrPolicyDomain_t * pd, u32 nbBuckets, hashFct hashing);
+void destructHashtableSharded(hashtable_t * hashtable, deallocFct entryDeallocator, void * deallocatorParam);
+
 
 //
 // Exposed hashtable implementations
@@ -662,6 +662,32 @@ s32 populate_inst(ocrParamList_t **inst_param, int inst_param_size, void **insta
 
             snprintf(key, MAX_KEY_SZ, "%s:%s", secname, "size");
             ((paramListMemPlatformInst_t *)inst_param[j])->size = (u64)iniparser_getlonglong(dict, key, 0);
+            // Node and kind of the memory, used to place data-blocks
+            if (key_exists(dict, secname, "numa_node")) {
+                value = get_key_value(dict, secname, "numa_node", j-low);
+                ((paramListMemPlatformInst_t *)inst_param[j])->numa_node = (value < 0) ? 0 : value;
+            } else {
+                ((paramListMemPlatformInst_t *)inst_param[j])->numa_node = 0;
+            }
+            ((paramListMemPlatformInst_t *)inst_param[j])->highBandwidth = false;
+            if (key_exists(dict, secname, "highbw")) {
+                snprintf(key, MAX_KEY_SZ, "%s:%s", secname, "highbw");
+                INI_GET_INT (key, value, -1);
+                ((paramListMemPlatformInst_t *)inst_param[j])->highBandwidth = (value > 0);
+            }
+            ((paramListMemPlatformInst_t *)inst_param[j])->pages = MEM_PLATFORM_PAGES_DEFAULT;
+            if (key_exists(dict, secname, "hugepages")) {
+                char *valuestr;
+                snprintf(key, MAX_KEY_SZ, "%s:%s", secname, "hugepages");
+                INI_GET_STR (key, valuestr, "");
+                if (strcmp("transparent", valuestr) == 0) {
+                    ((paramListMemPlatformInst_t *)inst_param[j])->pages = MEM_PLATFORM_PAGES_TRANSPARENT;
+                } else if (strcmp("explicit", valuestr) == 0) {
+                    ((paramListMemPlatformInst_t *)inst_param[j])->pages = MEM_PLATFORM_PAGES_EXPLICIT;
+                } else if (strcmp("none", valuestr) != 0) {
+                    DPRINTF(DEBUG_LVL_WARN, "Error: Unsupported hugepages %s\n", valuestr);
+                }
+            }
 
 #ifdef ENABLE_MEM_PLATFORM_FSIM
             // Adjust the start and size according to size of ELF binary
@@ -778,6 +804,12 @@ s32 populate_inst(ocrParamList_t **inst_param, int inst_param_size, void **insta
                 } else {
                     ((paramListCompPlatformPthread_t *)inst_param[j])->binding = -1;
                 }
+                if (key_exists(dict, secname, "socket")) {
+                    value = get_key_value(dict, secname, "socket", j-low);
+                    ((paramListCompPlatformPthread_t *)inst_param[j])->socket = value;
+                } else {
+                    ((paramListCompPlatformPthread_t *)inst_param[j])->socket = -1;
+                }
             }
             break;
 #endif
@@ -870,7 +902,51 @@ s32 populate_inst(ocrParamList_t **inst_param, int inst_param_size, void **insta
         break;
     case schedulerHeuristic_type:
         for (j = low; j<=high; j++) {
-            ALLOC_PARAM_LIST(inst_param[j], paramListSchedulerHeuristic_t);
+            schedulerHeuristicType_t mytype = schedulerHeuristicMax_id;
+            TO_ENUM (mytype, inststr, schedulerHeuristicType_t, schedulerHeuristic_types, schedulerHeuristicMax_id);
+            switch(mytype) {
+#ifdef ENABLE_SCHEDULER_HEURISTIC_HC
+            case schedulerHeuristicHc_id:
+                {
+                    ALLOC_PARAM_LIST(inst_param[j], paramListSchedulerHeuristicHc_t);
+                    paramListSchedulerHeuristicHc_t *hcParams = (paramListSchedulerHeuristicHc_t*)inst_param[j];
+                    hcParams->stealVictim = HC_STEAL_VICTIM_ROUND_ROBIN;
+                    hcParams->stealBatch = HC_STEAL_BATCH_ONE;
+                    hcParams->workersPerSocket = 0;
+                    if (key_exists(dict, secname, "stealvictim")) {
+                        char *valuestr = NULL;
+                        snprintf(key, MAX_KEY_SZ, "%s:%s", secname, "stealvictim");
+                        INI_GET_STR (key, valuestr, "");
+                        if (strcmp(valuestr, "RANDOM") == 0) {
+                            hcParams->stealVictim = HC_STEAL_VICTIM_RANDOM;
+                        } else if (strcmp(valuestr, "LOCALITY") == 0) {
+                            hcParams->stealVictim = HC_STEAL_VICTIM_LOCALITY;
+                        } else if (strcmp(valuestr, "ROUND_ROBIN") != 0) {
+                            DPRINTF(DEBUG_LVL_WARN, "Error: Unsupported stealvictim %s\n", valuestr);
+                        }
+                    }
+                    if (key_exists(dict, secname, "stealbatch")) {
+                        char *valuestr = NULL;
+                        snprintf(key, MAX_KEY_SZ, "%s:%s", secname, "stealbatch");
+                        INI_GET_STR (key, valuestr, "");
+                        if (strcmp(valuestr, "HALF") == 0) {
+                            hcParams->stealBatch = HC_STEAL_BATCH_HALF;
+                        } else if (strcmp(valuestr, "ONE") != 0) {
+                            DPRINTF(DEBUG_LVL_WARN, "Error: Unsupported stealbatch %s\n", valuestr);
+                        }
+                    }
+                    if (key_exists(dict, secname, "workerspersocket")) {
+                        snprintf(key, MAX_KEY_SZ, "%s:%s", secname, "workerspersocket");
+                        INI_GET_INT (key, value, -1);
+                        hcParams->workersPerSocket = (value==-1)?0:value;
+                    }
+                }
+                break;
+#endif
+            default:
+                ALLOC_PARAM_LIST(inst_param[j], paramListSchedulerHeuristic_t);
+                break;
+            }
             ((paramListSchedulerHeuristic_t*)inst_param[j])->isMaster = false;
             if (key_exists(dict, secname, "kind")) {
                 char *valuestr = NULL;
@@ -911,7 +987,26 @@ s32 populate_inst(ocrParamList_t **inst_param, int inst_param_size, void **insta
                     workertype += 1;  // because workertype is 1-indexed, not 0-indexed
                     if (workertype == MAX_WORKERTYPE) workertype = SLAVE_WORKERTYPE; // reasonable default
                     ALLOC_PARAM_LIST(inst_param[j], paramListWorkerHcInst_t);
-                    ((paramListWorkerHcInst_t *)inst_param[j])->workerType = workertype;
+                    paramListWorkerHcInst_t *hcParams = (paramListWorkerHcInst_t *)inst_param[j];
+                    hcParams->workerType = workertype;
+                    hcParams->idleSpin = HC_IDLE_SPIN_DEFAULT;
+                    hcParams->idleYield = HC_IDLE_YIELD_DEFAULT;
+                    hcParams->parkTimeout = HC_PARK_TIMEOUT_DEFAULT;
+                    if (key_exists(dict, secname, "idlespin")) {
+                        snprintf(key, MAX_KEY_SZ, "%s:%s", secname, "idlespin");
+                        INI_GET_INT (key, value, -1);
+                        if (value >= 0) hcParams->idleSpin = value;
+                    }
+                    if (key_exists(dict, secname, "idleyield")) {
+                        snprintf(key, MAX_KEY_SZ, "%s:%s", secname, "idleyield");
+                        INI_GET_INT (key, value, -1);
+                        if (value >= 0) hcParams->idleYield = value;
+                    }
+                    if (key_exists(dict, secname, "parktimeout")) {
+                        snprintf(key, MAX_KEY_SZ, "%s:%s", secname, "parktimeout");
+                        INI_GET_INT (key, value, -1);
+                        if (value >= 0) hcParams->parkTimeout = value;
+                    }
                     ((paramListWorkerInst_t *)inst_param[j])->workerId = j; // using "id" for now, not a separate key
                 }
                 break;
@@ -961,6 +1056,10 @@ s32 populate_inst(ocrParamList_t **inst_param, int inst_param_size, void **insta
                     if (workertype == MAX_WORKERTYPE) workertype = SYSTEM_WORKERTYPE;
                     ALLOC_PARAM_LIST(inst_param[j], paramListWorkerHcInst_t);
                     ((paramListWorkerHcInst_t *)inst_param[j])->workerType = workertype;
+                    // The system worker has its own loop and never parks
+                    ((paramListWorkerHcInst_t *)inst_param[j])->idleSpin = 0;
+                    ((paramListWorkerHcInst_t *)inst_param[j])->idleYield = 0;
+                    ((paramListWorkerHcInst_t *)inst_param[j])->parkTimeout = 0;
                     ((paramListWorkerInst_t *)inst_param[j])->workerId = j;
                 }
                 break;
@@ -1304,21 +1403,22 @@ void add_dependence (type_enum fromtype, type_enum totype, char *refstr,
     }
 }
 
-s32 build_deps (dictionary *dict, s32 A, s32 B, char *refstr, void ***all_instances, ocrParamList_t ***inst_params) {
+s32 build_deps (dictionary *dict, section_t *sections, s32 nsec, s32 A, s32 B, char *refstr, void ***all_instances, ocrParamList_t ***inst_params) {
     s32 i, j, k;
     s32 low, high;
     s32 l;
     s32 depcount;
     s32 values_array[MAX_INSTANCES];
 
-    for (i = 0; i < iniparser_getnsec(dict); i++) {
-        // Go thru the secnames looking for instances of A
-        if (strncasecmp(inst_str[A], iniparser_getsecname(dict, i), strlen(inst_str[A]))==0) {
-            // For each secname, look up corresponding instance of A through id
-            read_range(dict, iniparser_getsecname(dict, i), "id", &low, &high);
+    for (i = 0; i < nsec; i++) {
+        // Go thru the sections looking for instances of A
+        if (sections[i].instIndex == A) {
+            // For each section, look up corresponding instance of A through id
+            low = sections[i].idLow;
+            high = sections[i].idHigh;
             for (j = low; j <= high; j++) {
                 // Parse corresponding dependences from secname
-                depcount = read_values(dict, iniparser_getsecname(dict, i), refstr, values_array);
+                depcount = read_values(dict, sections[i].name, refstr, values_array);
                 // Connect A with B
                 // Using a rough heuristic for now: if |from| == |to| then 1:1, else all:all
                 if (depcount == high-low+1) {
@@ -0,0 +1,290 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr-config.h"
+#ifdef SAL_LINUX
+
+#include "debug.h"
+#include "external/iniparser.h"
+#include "machine-description/ocr-machine.h"
+#include "ocr-types.h"
+#include "ocr-version.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define DEBUG_TYPE INIPARSING
+
+extern const char *type_str[];
+extern const char *inst_str[];
+extern int total_types;
+extern s32 read_range(dictionary *dict, char *sec, char *field, s32 *low, s32 *high);
+
+/* Format of a plan (offsets are from the start of the file):
+ *
+ * +--------------------------+
+ * |  header (planHeader_t)   |
+ * +--------------------------+
+ * |  hashes (entryCount)     | = used in place as the dictionary's hashes
+ * +--------------------------+
+ * |  entries (entryCount)    | = offsets of the key and value strings
+ * +--------------------------+
+ * |  sections (sectionCount) |
+ * +--------------------------+
+ * |  strings                 |
+ * +--------------------------+
+ */
+
+#define PLAN_MAGIC "OCRPLAN"
+#define PLAN_FORMAT 1
+
+typedef struct {
+    char magic[8];
+    u32 format;
+    u32 typeCount;        /**< Number of type names sections were matched against */
+    char ocrVersion[32];  /**< Version of the runtime that compiled the plan */
+    u32 size;             /**< Size of the whole plan */
+    u32 entryCount;
+    u32 sectionCount;
+    u32 hashOffset;
+    u32 entryOffset;
+    u32 sectionOffset;
+} planHeader_t;
+
+typedef struct {
+    u32 key;
+    u32 val;              /**< 0 for the entry of a section */
+} planEntry_t;
+
+typedef struct {
+    u32 name;
+    s32 typeIndex;
+    s32 instIndex;
+    s32 idLow;
+    s32 idHigh;
+} planSection_t;
+
+// Mapping backing the dictionary returned by load_config, if it was a plan
+static void *planBase = NULL;
+static u64 planSize = 0;
+
+s32 read_sections(dictionary *dict, section_t **sections) {
+    s32 i, j;
+    s32 nsec = 0;
+    section_t *secs = (section_t *)malloc(iniparser_getnsec(dict) * sizeof(section_t));
+
+    for (i = 0; i < dict->size; i++) {
+        // Sections are the keys that are not of the form "section:key"
+        if ((dict->key[i] == NULL) || (strchr(dict->key[i], ':') != NULL))
+            continue;
+        section_t *sec = &secs[nsec++];
+        sec->name = dict->key[i];
+        sec->typeIndex = -1;
+        sec->instIndex = -1;
+        sec->idLow = 0;
+        sec->idHigh = -1;
+        for (j = 0; j < total_types; j++) {
+            if ((sec->typeIndex == -1) && (strncasecmp(type_str[j], sec->name, strlen(type_str[j])) == 0))
+                sec->typeIndex = j;
+            if ((sec->instIndex == -1) && (strncasecmp(inst_str[j], sec->name, strlen(inst_str[j])) == 0))
+                sec->instIndex = j;
+        }
+        if (sec->instIndex != -1)
+            read_range(dict, sec->name, "id", &sec->idLow, &sec->idHigh);
+    }
+    *sections = secs;
+    return nsec;
+}
+
+static dictionary *load_plan(int fd, const char *file, planHeader_t *header, section_t **sections, s32 *nsec) {
+    struct stat st;
+    u32 i;
+
+    if ((header->format != PLAN_FORMAT) || (header->typeCount != total_types) ||
+        (strncmp(header->ocrVersion, OCR_VERSION, sizeof(header->ocrVersion)) != 0)) {
+        fprintf(stderr, "ERROR: %s was compiled by another version of OCR (%.32s); compile it again with -ocr:cfgcompile\n",
+                file, header->ocrVersion);
+        return NULL;
+    }
+    if ((fstat(fd, &st) != 0) || (st.st_size != header->size)) {
+        fprintf(stderr, "ERROR: %s is truncated\n", file);
+        return NULL;
+    }
+    // Strings are used in place. Values read as CSV get tokenized, hence the
+    // private writable mapping.
+    char *base = (char *)mmap(NULL, header->size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    if (base == MAP_FAILED) {
+        fprintf(stderr, "ERROR: cannot map %s\n", file);
+        return NULL;
+    }
+
+    dictionary *dict = (dictionary *)malloc(sizeof(dictionary));
+    dict->n = dict->size = header->entryCount;
+    dict->key = (char **)malloc(header->entryCount * sizeof(char *));
+    dict->val = (char **)malloc(header->entryCount * sizeof(char *));
+    dict->hash = (unsigned *)(base + header->hashOffset);
+    planEntry_t *entries = (planEntry_t *)(base + header->entryOffset);
+    for (i = 0; i < header->entryCount; i++) {
+        dict->key[i] = base + entries[i].key;
+        dict->val[i] = (entries[i].val == 0) ? NULL : base + entries[i].val;
+    }
+
+    section_t *secs = (section_t *)malloc(header->sectionCount * sizeof(section_t));
+    planSection_t *planSections = (planSection_t *)(base + header->sectionOffset);
+    for (i = 0; i < header->sectionCount; i++) {
+        secs[i].name = base + planSections[i].name;
+        secs[i].typeIndex = planSections[i].typeIndex;
+        secs[i].instIndex = planSections[i].instIndex;
+        secs[i].idLow = planSections[i].idLow;
+        secs[i].idHigh = planSections[i].idHigh;
+    }
+
+    planBase = base;
+    planSize = header->size;
+    *sections = secs;
+    *nsec = header->sectionCount;
+    DPRINTF(DEBUG_LVL_INFO, "Mapped plan %s: %"PRIu32" entries, %"PRIu32" sections\n",
+            file, header->entryCount, header->sectionCount);
+    return dict;
+}
+
+dictionary *load_config(const char *file, section_t **sections, s32 *nsec) {
+    planHeader_t header;
+    dictionary *dict = NULL;
+    int fd = open(file, O_RDONLY);
+
+    if (fd == -1)
+        return NULL;
+    if ((read(fd, &header, sizeof(header)) == sizeof(header)) &&
+        (memcmp(header.magic, PLAN_MAGIC, sizeof(header.magic)) == 0)) {
+        dict = load_plan(fd, file, &header, sections, nsec);
+        close(fd);
+        return dict;
+    }
+    close(fd);
+
+    dict = iniparser_load(file);
+    if (dict != NULL)
+        *nsec = read_sections(dict, sections);
+    return dict;
+}
+
+void free_config(dictionary *dict, section_t *sections) {
+    free(sections);
+    if (planBase != NULL) {
+        free(dict->key);
+        free(dict->val);
+        free(dict);
+        munmap(planBase, planSize);
+        planBase = NULL;
+    } else {
+        iniparser_freedict(dict);
+    }
+}
+
+static u32 plan_string(char *plan, u32 *cursor, const char *str) {
+    u32 offset = *cursor;
+    u32 len = strlen(str) + 1;
+    memcpy(plan + offset, str, len);
+    *cursor += len;
+    return offset;
+}
+
+s32 compile_config(const char *inifile, const char *planfile) {
+    section_t *sections;
+    s32 i, nsec, n = 0;
+    u32 stringSize = 0;
+
+    dictionary *dict = iniparser_load(inifile);
+    if (dict == NULL) {
+        fprintf(stderr, "ERROR: cannot parse runtime configuration file: %s\n", inifile);
+        return 1;
+    }
+
+    // Expand the values once and for all; the plan is used as is
+    for (i = 0; i < dict->size; i++) {
+        char *key = dict->key[i];
+        if (key == NULL)
+            continue;
+        if ((strncmp(key, "environment", 11) == 0) && ((key[11] == '\0') || (key[11] == ':'))) {
+            fprintf(stderr, "ERROR: %s has an [environment] section, whose values are read when the "
+                    "configuration is loaded; it cannot be compiled\n", inifile);
+            iniparser_freedict(dict);
+            return 1;
+        }
+        if (dict->val[i] != NULL) {
+            char *val = iniparser_getstring(dict, key, NULL);
+            if (strstr(val, "$(") || strstr(val, "${")) {
+                fprintf(stderr, "ERROR: cannot expand '%s' in %s\n", val, key);
+                iniparser_freedict(dict);
+                return 1;
+            }
+            stringSize += strlen(val) + 1;
+        }
+        stringSize += strlen(key) + 1;
+        n++;
+    }
+    nsec = read_sections(dict, &sections);
+    for (i = 0; i < nsec; i++)
+        stringSize += strlen(sections[i].name) + 1;
+
+    planHeader_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, PLAN_MAGIC, sizeof(header.magic));
+    header.format = PLAN_FORMAT;
+    header.typeCount = total_types;
+    strncpy(header.ocrVersion, OCR_VERSION, sizeof(header.ocrVersion) - 1);
+    header.entryCount = n;
+    header.sectionCount = nsec;
+    header.hashOffset = sizeof(planHeader_t);
+    header.entryOffset = header.hashOffset + n * sizeof(unsigned);
+    header.sectionOffset = header.entryOffset + n * sizeof(planEntry_t);
+    u32 cursor = header.sectionOffset + nsec * sizeof(planSection_t);
+    header.size = cursor + stringSize;
+
+    char *plan = (char *)calloc(1, header.size);
+    unsigned *hashes = (unsigned *)(plan + header.hashOffset);
+    planEntry_t *entries = (planEntry_t *)(plan + header.entryOffset);
+    planSection_t *planSections = (planSection_t *)(plan + header.sectionOffset);
+    memcpy(plan, &header, sizeof(header));
+    n = 0;
+    for (i = 0; i < dict->size; i++) {
+        if (dict->key[i] == NULL)
+            continue;
+        hashes[n] = dict->hash[i];
+        entries[n].key = plan_string(plan, &cursor, dict->key[i]);
+        entries[n].val = (dict->val[i] == NULL) ? 0 : plan_string(plan, &cursor, dict->val[i]);
+        n++;
+    }
+    for (i = 0; i < nsec; i++) {
+        planSections[i].name = plan_string(plan, &cursor, sections[i].name);
+        planSections[i].typeIndex = sections[i].typeIndex;
+        planSections[i].instIndex = sections[i].instIndex;
+        planSections[i].idLow = sections[i].idLow;
+        planSections[i].idHigh = sections[i].idHigh;
+    }
+    ASSERT(cursor == header.size);
+
+    s32 ret = 0;
+    FILE *fp = fopen(planfile, "w");
+    if ((fp == NULL) || (fwrite(plan, 1, header.size, fp) != header.size)) {
+        fprintf(stderr, "ERROR: cannot write %s\n", planfile);
+        ret = 1;
+    }
+    if (fp != NULL)
+        fclose(fp);
+    free(plan);
+    free(sections);
+    iniparser_freedict(dict);
+    return ret;
+}
+
+#endif
@@ -57,4 +57,24 @@ typedef struct {
     char *refstr;
 } dep_t;
 
+/* Section of the configuration matched against the type and instance names */
+
+typedef struct {
+    char *name;
+    s32 typeIndex;   /**< Index in type_str or -1 */
+    s32 instIndex;   /**< Index in inst_str or -1 */
+    s32 idLow;       /**< Range of ids of an instance section */
+    s32 idHigh;
+} section_t;
+
+/* Configurations can also be given as a binary plan compiled from an INI
+ * file (see -ocr:cfgcompile). A plan holds the dictionary with all values
+ * expanded and the sections already matched; it is mapped in memory
+ * instead of being parsed. */
+
+extern s32 read_sections(dictionary *dict, section_t **sections);
+extern dictionary *load_config(const char *file, section_t **sections, s32 *nsec);
+extern void free_config(dictionary *dict, section_t *sections);
+extern s32 compile_config(const char *inifile, const char *planfile);
+
 #endif
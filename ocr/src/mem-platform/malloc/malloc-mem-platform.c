@@ -20,6 +20,7 @@
 #include "ocr-mem-platform.h"
 #include "ocr-policy-domain.h"
 #include "mem-platform/malloc/malloc-mem-platform.h"
+#include "mem-platform/mem-platform-all.h"
 
 #include <stdlib.h>
 #include <string.h>
@@ -67,7 +68,16 @@ u8 mallocSwitchRunlevel(ocrMemPlatform_t *self, ocrPolicyDomain_t *PD, ocrRunlev
                 break; // We break out early since we are already initialized
             // This is where we need to update the memory
             // using the sysboot functions
-            self->startAddr = (u64)malloc(self->size);
+            ocrMemPlatformMalloc_t *rself = (ocrMemPlatformMalloc_t*)self;
+            if(rself->pages == MEM_PLATFORM_PAGES_DEFAULT) {
+                self->startAddr = (u64)malloc(self->size);
+            } else {
+                // Huge pages have to come straight from the OS. They are faulted in
+                // now, by the thread bringing the PD up, rather than by the first EDTs
+                self->startAddr = (u64)memPlatformMapPages(rself->pages, self->size, &(rself->mappedLength));
+                if(self->startAddr)
+                    memPlatformPrefault((void*)self->startAddr, rself->mappedLength);
+            }
             // Check that the mem-platform size in config file is reasonable
             ASSERT(self->startAddr);
             self->endAddr = self->startAddr + self->size;
@@ -78,7 +88,6 @@ u8 mallocSwitchRunlevel(ocrMemPlatform_t *self, ocrPolicyDomain_t *PD, ocrRunlev
             // zero beginning part to cover rangeTracker and pad, and allocator metadata part i.e. pool header (pool_t)
             memset((void *)self->startAddr , 0, MEM_PLATFORM_ZEROED_AREA_SIZE);
 
-            ocrMemPlatformMalloc_t *rself = (ocrMemPlatformMalloc_t*)self;
             rself->pRangeTracker = initializeRange(
                 16, self->startAddr, self->endAddr, USER_FREE_TAG);
         } else if((properties & RL_TEAR_DOWN) && RL_IS_LAST_PHASE_DOWN(PD, RL_NETWORK_OK, phase)) {
@@ -89,7 +98,12 @@ u8 mallocSwitchRunlevel(ocrMemPlatform_t *self, ocrPolicyDomain_t *PD, ocrRunlev
                 if(rself->pRangeTracker)    // in case of mallocproxy, pRangeTracker==0
                     destroyRange(rself->pRangeTracker);
                 // Here we can free the memory we allocated
-                free((void*)(self->startAddr));
+                if(rself->mappedLength) {
+                    memPlatformUnmapPages((void*)(self->startAddr), rself->mappedLength);
+                    rself->mappedLength = 0;
+                } else {
+                    free((void*)(self->startAddr));
+                }
                 self->startAddr = 0ULL;
             }
         }
@@ -220,6 +234,8 @@ ocrMemPlatform_t* newMemPlatformMalloc(ocrMemPlatformFactory_t * factory,
 void initializeMemPlatformMalloc(ocrMemPlatformFactory_t * factory, ocrMemPlatform_t * result, ocrParamList_t * perInstance) {
     initializeMemPlatformOcr(factory, result, perInstance);
     ocrMemPlatformMalloc_t *rself = (ocrMemPlatformMalloc_t*)result;
+    rself->pages = ((paramListMemPlatformInst_t *)perInstance)->pages;
+    rself->mappedLength = 0;
     INIT_LOCK(&(rself->lock));
 }
 
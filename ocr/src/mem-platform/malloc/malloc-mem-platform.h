@@ -28,6 +28,8 @@ typedef struct {
     ocrMemPlatform_t base;
     rangeTracker_t *pRangeTracker;
     u32 lock;
+    ocrMemPlatformPages_t pages;
+    u64 mappedLength; // Non-zero when the memory was mapped instead of malloc-ed
 } ocrMemPlatformMalloc_t;
 
 ocrMemPlatformFactory_t* newMemPlatformFactoryMalloc(ocrParamList_t *perType);
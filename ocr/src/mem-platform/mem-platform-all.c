@@ -7,6 +7,13 @@
 #include "mem-platform/mem-platform-all.h"
 #include "debug.h"
 
+#ifdef SAL_LINUX
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#define DEBUG_TYPE MEM_PLATFORM
+
 const char * memplatform_types[] = {
 #ifdef ENABLE_MEM_PLATFORM_MALLOC
     "malloc",
@@ -44,5 +51,56 @@ void initializeMemPlatformOcr(ocrMemPlatformFactory_t * factory, ocrMemPlatform_
     self->pd = NULL;
     self->fcts = factory->platformFcts;
     self->size = ((paramListMemPlatformInst_t *)perInstance)->size;
+    self->numaNode = ((paramListMemPlatformInst_t *)perInstance)->numa_node;
+    self->highBandwidth = ((paramListMemPlatformInst_t *)perInstance)->highBandwidth;
     self->startAddr = self->endAddr = 0ULL;
 }
+
+#ifdef SAL_LINUX
+// Size and alignment of the huge pages asked for
+#define HUGE_PAGE_SIZE (2ULL*1024*1024)
+
+void * memPlatformMapPages(ocrMemPlatformPages_t pages, u64 size, u64 *length) {
+    u64 rounded = (size + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+    char * addr = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    if (pages == MEM_PLATFORM_PAGES_EXPLICIT) {
+        addr = mmap(NULL, rounded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (addr == MAP_FAILED)
+            DPRINTF(DEBUG_LVL_WARN, "No huge pages reserved for %"PRIu64" bytes; using transparent huge pages\n", rounded);
+    }
+#endif
+    if (addr == MAP_FAILED) {
+        // Over-reserve then trim so that the memory starts on a huge page
+        char * raw = mmap(NULL, rounded + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED)
+            return NULL;
+        addr = (char *) (((u64) raw + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1));
+        if (addr != raw)
+            munmap(raw, addr - raw);
+        if (addr + rounded != raw + rounded + HUGE_PAGE_SIZE)
+            munmap(addr + rounded, (raw + HUGE_PAGE_SIZE) - addr);
+        if (pages != MEM_PLATFORM_PAGES_DEFAULT) {
+#ifdef MADV_HUGEPAGE
+            if (madvise(addr, rounded, MADV_HUGEPAGE) != 0)
+#endif
+                DPRINTF(DEBUG_LVL_WARN, "Transparent huge pages unavailable; using ordinary pages\n");
+        }
+    }
+    *length = rounded;
+    return addr;
+}
+
+void memPlatformUnmapPages(void * addr, u64 length) {
+    munmap(addr, length);
+}
+
+void memPlatformPrefault(void * addr, u64 length) {
+    u64 pageSize = (u64) sysconf(_SC_PAGESIZE);
+    u64 offset;
+    // Writing makes the kernel allocate the page (reading could map the zero page)
+    for (offset = 0; offset < length; offset += pageSize) {
+        ((volatile char *) addr)[offset] = 0;
+    }
+}
+#endif /* SAL_LINUX */
@@ -45,6 +45,35 @@ extern const char * memplatform_types[];
 
 ocrMemPlatformFactory_t *newMemPlatformFactory(memPlatformType_t type, ocrParamList_t *typeArg);
 
+#ifdef SAL_LINUX
+/**
+ * @brief Reserves memory from the OS backed by the requested kind of pages
+ *
+ * Explicit huge pages fall back to transparent ones which fall back to
+ * ordinary pages, with a warning each time. The memory starts on a huge
+ * page boundary.
+ *
+ * @param pages[in]    Kind of pages wanted
+ * @param size[in]     Number of bytes needed
+ * @param length[out]  Number of bytes reserved (to give back to memPlatformUnmapPages)
+ * @return The start of the memory or NULL if it could not be reserved
+ */
+void * memPlatformMapPages(ocrMemPlatformPages_t pages, u64 size, u64 *length);
+
+/**
+ * @brief Gives back memory reserved by memPlatformMapPages
+ */
+void memPlatformUnmapPages(void * addr, u64 length);
+
+/**
+ * @brief Faults in the memory from the calling thread
+ *
+ * Pages are then allocated (on the caller's NUMA node unless the memory
+ * is bound elsewhere) before the first data-block is carved out of them.
+ */
+void memPlatformPrefault(void * addr, u64 length);
+#endif
+
 #endif /* __MEM_PLATFORM_ALL_H__ */
 
 
@@ -20,10 +20,13 @@
 #include "ocr-mem-platform.h"
 #include "ocr-policy-domain.h"
 #include "mem-platform/numa-alloc/numa-alloc-mem-platform.h"
+#include "mem-platform/mem-platform-all.h"
 
 #include <stdlib.h>
 #include <string.h>
 
+#define DEBUG_TYPE MEM_PLATFORM
+
 // Poor man's basic lock
 #define INIT_LOCK(addr) do {*addr = 0;} while(0);
 #define LOCK(addr) do { hal_lock32(addr); } while(0);
@@ -68,13 +71,31 @@ u8 numaAllocSwitchRunlevel(ocrMemPlatform_t *self, ocrPolicyDomain_t *PD, ocrRun
             // This is where we need to update the memory
             // using the sysboot functions
             ocrMemPlatformNumaAlloc_t *rself = (ocrMemPlatformNumaAlloc_t*)self;
-            // 1. Check if NUMA is available
-            ASSERT(numa_available() != -1);
-            // 2. Check if the node number is reasonable
-            ASSERT(rself->numa_node <= numa_max_node());
-            // 3. Use strict policy. Strict means the allocation will fail if the memory cannot be allocated on the target node.
-            numa_set_strict(1);
-            self->startAddr = (u64)numa_alloc_onnode(self->size, rself->numa_node);
+            bool hasNode = (numa_available() != -1) && (rself->numa_node <= numa_max_node());
+            if(rself->pages != MEM_PLATFORM_PAGES_DEFAULT) {
+                // Huge pages are mapped by hand, bound to the node, then faulted in
+                self->startAddr = (u64)memPlatformMapPages(rself->pages, self->size, &(rself->mappedLength));
+                if(self->startAddr) {
+                    if(hasNode)
+                        numa_tonode_memory((void*)self->startAddr, rself->mappedLength, rself->numa_node);
+                    else
+                        DPRINTF(DEBUG_LVL_WARN, "NUMA node %"PRIu32" unavailable; huge pages are not bound\n", rself->numa_node);
+                    memPlatformPrefault((void*)self->startAddr, rself->mappedLength);
+                }
+            } else if(numa_available() == -1) {
+                // 1. Check if NUMA is available. Without it, the node is only a placement label
+                DPRINTF(DEBUG_LVL_WARN, "NUMA unavailable; memory for node %"PRIu32" comes from malloc\n", rself->numa_node);
+                rself->fromMalloc = true;
+                self->startAddr = (u64)malloc(self->size);
+            } else if(!hasNode) {
+                // 2. The machine has fewer nodes than configured (single-node for example)
+                DPRINTF(DEBUG_LVL_WARN, "NUMA node %"PRIu32" does not exist; using the local node\n", rself->numa_node);
+                self->startAddr = (u64)numa_alloc_local(self->size);
+            } else {
+                // 3. Use strict policy. Strict means the allocation will fail if the memory cannot be allocated on the target node.
+                numa_set_strict(1);
+                self->startAddr = (u64)numa_alloc_onnode(self->size, rself->numa_node);
+            }
             // Check that the mem-platform size in config file is reasonable
             ASSERT(self->startAddr);
             self->endAddr = self->startAddr + self->size;
@@ -95,7 +116,13 @@ u8 numaAllocSwitchRunlevel(ocrMemPlatform_t *self, ocrPolicyDomain_t *PD, ocrRun
                 if(rself->pRangeTracker)    // in case of numaAllocproxy, pRangeTracker==0
                     destroyRange(rself->pRangeTracker);
                 // Here we can free the memory we allocated
-                numa_free((void*)(self->startAddr), self->size);
+                if(rself->mappedLength) {
+                    memPlatformUnmapPages((void*)(self->startAddr), rself->mappedLength);
+                    rself->mappedLength = 0;
+                } else if(rself->fromMalloc)
+                    free((void*)(self->startAddr));
+                else
+                    numa_free((void*)(self->startAddr), self->size);
                 self->startAddr = 0ULL;
             }
         }
@@ -227,6 +254,9 @@ void initializeMemPlatformNumaAlloc(ocrMemPlatformFactory_t * factory, ocrMemPla
     initializeMemPlatformOcr(factory, result, perInstance);
     ocrMemPlatformNumaAlloc_t *rself = (ocrMemPlatformNumaAlloc_t*)result;
     rself->numa_node = ((paramListMemPlatformInst_t *)perInstance)->numa_node;
+    rself->fromMalloc = false;
+    rself->pages = ((paramListMemPlatformInst_t *)perInstance)->pages;
+    rself->mappedLength = 0;
     INIT_LOCK(&(rself->lock));
 }
 
@@ -30,6 +30,9 @@ typedef struct {
     rangeTracker_t *pRangeTracker;
     u32 numa_node;
     u32 lock;
+    bool fromMalloc; // No NUMA support at runtime
+    ocrMemPlatformPages_t pages;
+    u64 mappedLength; // Non-zero when huge pages were asked for
 } ocrMemPlatformNumaAlloc_t;
 
 ocrMemPlatformFactory_t* newMemPlatformFactoryNumaAlloc(ocrParamList_t *perType);
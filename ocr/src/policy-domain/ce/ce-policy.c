@@ -1953,7 +1953,7 @@ u8 cePolicyDomainProcessMessage(ocrPolicyDomain_t *self, ocrPolicyMsg_t *msg, u8
                 PD_MSG_FIELD_I(numberGuids), PD_MSG_FIELD_I(guidKind));
         PD_MSG_FIELD_O(returnDetail) = self->guidProviders[0]->fcts.guidReserve(
             self->guidProviders[0], &(PD_MSG_FIELD_O(startGuid)), &(PD_MSG_FIELD_O(skipGuid)),
-            PD_MSG_FIELD_I(numberGuids), PD_MSG_FIELD_I(guidKind));
+            &(PD_MSG_FIELD_O(locationSkip)), PD_MSG_FIELD_I(numberGuids), PD_MSG_FIELD_I(guidKind));
         DPRINTF(DEBUG_LVL_VERB, "GUID_RESERVE response: start "GUIDF"\n",
                 GUIDA(PD_MSG_FIELD_O(startGuid)));
 #undef PD_MSG
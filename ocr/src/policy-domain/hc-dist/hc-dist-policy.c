@@ -97,6 +97,15 @@ static void setReturnDetail(ocrPolicyMsg_t * msg, u8 returnDetail) {
 #define PD_TYPE PD_MSG_DEP_SATISFY
         PD_MSG_FIELD_O(returnDetail) = returnDetail;
 #undef PD_MSG
+#undef PD_TYPE
+    break;
+    }
+    case PD_MSG_DEP_SATISFY_BATCH:
+    {
+#define PD_MSG (msg)
+#define PD_TYPE PD_MSG_DEP_SATISFY_BATCH
+        PD_MSG_FIELD_O(returnDetail) = returnDetail;
+#undef PD_MSG
 #undef PD_TYPE
     break;
     }
@@ -326,6 +335,29 @@ typedef struct {
     ProxyTplNode_t * queueHead;
 } ProxyTpl_t;
 
+/**
+ * @brief Hashes a GUID key to a lookup lock (and template map bucket)
+ *
+ * The key is multiplied first because PTR GUIDs are addresses whose
+ * low bits do not vary
+ */
+static u32 proxyLookupHash(void * key, u32 nbBuckets) {
+    return ((u32) ((((u64) key) * 0x9E3779B97F4A7C15ULL) >> 32)) & (nbBuckets - 1);
+}
+
+/**
+ * @brief Returns the lock the proxy of a remote GUID is looked up under
+ */
+static inline u32 * proxyLookupLock(proxyLookupShard_t * shards, ocrGuid_t guid) {
+    // See BUG #928 on GUID issues
+#if GUID_BIT_COUNT == 64
+    u64 key = guid.guid;
+#elif GUID_BIT_COUNT == 128
+    u64 key = guid.lower;
+#endif
+    return &(shards[proxyLookupHash((void *) key, PROXY_LOOKUP_SHARDS)].lock);
+}
+
 void printResilientEventsList(ocrPolicyDomainHcDist_t * dself) {
 	hal_lock32(&(dself->lockResEvtList));
 	ResEventNode_t *node = dself->proxyListHead->next;
@@ -340,8 +372,9 @@ void printResilientEventsList(ocrPolicyDomainHcDist_t * dself) {
 
 static u8 registerRemoteMetaData(ocrPolicyDomain_t * pd, ocrFatGuid_t tplFatGuid) {
     ocrPolicyDomainHcDist_t * dself = (ocrPolicyDomainHcDist_t *) pd;
+    u32 * tplLock = proxyLookupLock(dself->tplLookup, tplFatGuid.guid);
     // The lock allows to not give out reference to the proxy while we work.
-    hal_lock32(&dself->lockTplLookup);
+    hal_lock32(tplLock);
     pd->guidProviders[0]->fcts.registerGuid(pd->guidProviders[0], tplFatGuid.guid, (u64) tplFatGuid.metaDataPtr);
     ProxyTpl_t * proxyTpl = NULL;
 
@@ -355,7 +388,7 @@ static u8 registerRemoteMetaData(ocrPolicyDomain_t * pd, ocrFatGuid_t tplFatGuid
 
     ASSERT(found && (proxyTpl != NULL));
     proxyTpl->count++;
-    hal_unlock32(&dself->lockTplLookup);
+    hal_unlock32(tplLock);
     // At this point all calls to 'resolveRemoteMetaData' see the update pointer
     // in the guid provider and do not try to get a reference on the proxy.
     // Other workers may already own a reference to the proxy and try to enqueue themselves.
@@ -368,12 +401,12 @@ static u8 registerRemoteMetaData(ocrPolicyDomain_t * pd, ocrFatGuid_t tplFatGuid
     } while(curValue != oldValue);
 
     // Also need to compete to check out and destroy the proxy
-    hal_lock32(&dself->lockTplLookup);
+    hal_lock32(tplLock);
     proxyTpl->count--;
     if (proxyTpl->count == 0) {
         pd->fcts.pdFree(pd, proxyTpl);
     }
-    hal_unlock32(&dself->lockTplLookup);
+    hal_unlock32(tplLock);
 
     ocrGuid_t processRequestTemplateGuid;
     ocrEdtTemplateCreate(&processRequestTemplateGuid, &processRequestEdt, 1, 0);
@@ -404,15 +437,16 @@ static u8 resolveRemoteMetaData(ocrPolicyDomain_t * pd, ocrFatGuid_t * tplFatGui
         // The edt will be rescheduled at a later time once the metadata has been resolved
         bool isBlocking = (msg->srcLocation == pd->myLocation);
         ocrPolicyDomainHcDist_t * dself = (ocrPolicyDomainHcDist_t *) pd;
+        u32 * tplLock = proxyLookupLock(dself->tplLookup, tplFatGuid->guid);
         // Nope, check the proxy template map
-        hal_lock32(&dself->lockTplLookup);
+        hal_lock32(tplLock);
         // Double check again if the template has been resolved.
         // Helps preserve the invariant that once a template is resolved
         // its proxy's reference count cannot increment. (lock compete in registerRemoteMetaData)
         pd->guidProviders[0]->fcts.getVal(pd->guidProviders[0], tplFatGuid->guid, &val, NULL);
         if (val != 0) {
             tplFatGuid->metaDataPtr = (void *) val;
-            hal_unlock32(&dself->lockTplLookup);
+            hal_unlock32(tplLock);
             return 0;
         }
         // Check if the proxy exists or not.
@@ -435,7 +469,7 @@ static u8 resolveRemoteMetaData(ocrPolicyDomain_t * pd, ocrFatGuid_t * tplFatGui
             ret = hashtableNonConcTryPut(dself->proxyTplMap, (void *) tplFatGuid->guid.lower, (void *) proxyTpl);
 #endif
             ASSERT(ret == proxyTpl);
-            hal_unlock32(&dself->lockTplLookup);
+            hal_unlock32(tplLock);
             // GUID is unknown, request a copy of the metadata
             PD_MSG_STACK(msgClone);
             getCurrentEnv(NULL, NULL, NULL, &msgClone);
@@ -450,7 +484,7 @@ static u8 resolveRemoteMetaData(ocrPolicyDomain_t * pd, ocrFatGuid_t * tplFatGui
 #undef PD_TYPE
         } else {
             proxyTpl->count++;
-            hal_unlock32(&dself->lockTplLookup);
+            hal_unlock32(tplLock);
         }
 
         if (isBlocking) {
@@ -501,12 +535,12 @@ static u8 resolveRemoteMetaData(ocrPolicyDomain_t * pd, ocrFatGuid_t * tplFatGui
             // This code becomes concurrent with the callback being invoked, possibly destroying 'msg'.
         }
         // Compete to check out of the proxy
-        hal_lock32(&dself->lockTplLookup);
+        hal_lock32(tplLock);
         proxyTpl->count--;
         if ((proxyTpl->count == 0) && (proxyTpl->queueHead == NULL)) {
             pd->fcts.pdFree(pd, proxyTpl);
         }
-        hal_unlock32(&dself->lockTplLookup);
+        hal_unlock32(tplLock);
         return (val == 0) ? OCR_EPEND : 0;
     } else {
         tplFatGuid->metaDataPtr = (void *) val;
@@ -588,7 +622,8 @@ static void resetProxyDb(ProxyDb_t * proxyDb) {
  * @param createIfAbsent    Create the proxy DB if not found.
  */
 static ProxyDb_t * getProxyDb(ocrPolicyDomain_t * pd, ocrGuid_t dbGuid, bool createIfAbsent) {
-    hal_lock32(&((ocrPolicyDomainHcDist_t *) pd)->lockDbLookup);
+    u32 * dbLock = proxyLookupLock(((ocrPolicyDomainHcDist_t *) pd)->dbLookup, dbGuid);
+    hal_lock32(dbLock);
     ProxyDb_t * proxyDb = NULL;
     u64 val;
     pd->guidProviders[0]->fcts.getVal(pd->guidProviders[0], dbGuid, &val, NULL);
@@ -597,14 +632,16 @@ static ProxyDb_t * getProxyDb(ocrPolicyDomain_t * pd, ocrGuid_t dbGuid, bool cre
             proxyDb = createProxyDb(pd);
             pd->guidProviders[0]->fcts.registerGuid(pd->guidProviders[0], dbGuid, (u64) proxyDb);
         } else {
-            hal_unlock32(&((ocrPolicyDomainHcDist_t *) pd)->lockDbLookup);
+            hal_unlock32(dbLock);
             return NULL;
         }
     } else {
         proxyDb = (ProxyDb_t *) val;
     }
-    proxyDb->refCount++;
-    hal_unlock32(&((ocrPolicyDomainHcDist_t *) pd)->lockDbLookup);
+    // References are only taken under the lookup lock so that the proxy
+    // cannot be destroyed meanwhile; they are dropped without it.
+    hal_xadd32(&(proxyDb->refCount), 1);
+    hal_unlock32(dbLock);
     return proxyDb;
 }
 
@@ -613,9 +650,7 @@ static ProxyDb_t * getProxyDb(ocrPolicyDomain_t * pd, ocrGuid_t dbGuid, bool cre
  * Warning: This is different from releasing a datablock.
  */
 static void relProxyDb(ocrPolicyDomain_t * pd, ProxyDb_t * proxyDb) {
-    hal_lock32(&((ocrPolicyDomainHcDist_t *) pd)->lockDbLookup);
-    proxyDb->refCount--;
-    hal_unlock32(&((ocrPolicyDomainHcDist_t *) pd)->lockDbLookup);
+    hal_xadd32(&(proxyDb->refCount), -1);
 }
 
 /**
@@ -975,6 +1010,10 @@ u8 hcDistProcessMessage(ocrPolicyDomain_t *self, ocrPolicyMsg_t *msg, u8 isBlock
 #define PD_MSG msg
 #define PD_TYPE PD_MSG_DB_CREATE
         // The placer may have altered msg->destLocation
+        if (PD_MSG_FIELD_IO(properties) & GUID_PROP_IS_LABELED) {
+            // Labeled GUIDs are created by the location they encode
+            RETRIEVE_LOCATION_FROM_GUID_MSG(self, msg->destLocation, IO);
+        }
 #undef PD_MSG
 #undef PD_TYPE
         break;
@@ -1028,6 +1067,18 @@ u8 hcDistProcessMessage(ocrPolicyDomain_t *self, ocrPolicyMsg_t *msg, u8 isBlock
 #endif
 #endif
 #undef PD_MSG
+#undef PD_TYPE
+        break;
+    }
+    case PD_MSG_DEP_SATISFY_BATCH:
+    {
+#define PD_MSG (msg)
+#define PD_TYPE PD_MSG_DEP_SATISFY_BATCH
+        // All the targets live in the same policy domain
+        RETRIEVE_LOCATION_FROM_GUID(self, msg->destLocation, PD_MSG_FIELD_I(targets)[0].guid);
+        DPRINTF(DEBUG_LVL_VVERB,"DEP_SATISFY_BATCH: target is %"PRId32" for %"PRIu32" dependences\n",
+                (u32) msg->destLocation, PD_MSG_FIELD_I(count));
+#undef PD_MSG
 #undef PD_TYPE
         break;
     }
@@ -1834,6 +1885,12 @@ u8 hcDistProcessMessage(ocrPolicyDomain_t *self, ocrPolicyMsg_t *msg, u8 isBlock
                 // not proxied DB would have been doing
 #define PD_MSG (response)
 #define PD_TYPE PD_MSG_DB_CREATE
+                if ((PD_MSG_FIELD_O(returnDetail) != 0) ||
+                    (PD_MSG_FIELD_IO(properties) & (GUID_PROP_IS_LABELED | DB_PROP_NO_ACQUIRE))) {
+                    // The destination did not acquire the DB (see PD_MSG_DB_CREATE in hc-policy)
+                    PD_MSG_FIELD_O(ptr) = NULL;
+                    break;
+                }
                 ocrGuid_t dbGuid = PD_MSG_FIELD_IO(guid.guid);
                 ProxyDb_t * proxyDb = createProxyDb(self);
                 proxyDb->state = PROXY_DB_RUN;
@@ -1887,14 +1944,15 @@ u8 hcDistProcessMessage(ocrPolicyDomain_t *self, ocrPolicyMsg_t *msg, u8 isBlock
                     // The release having occurred, the proxy's metadata is invalid.
                     if (queueIsEmpty(proxyDb->acquireQueue)) {
                         // There are no pending acquire for this DB, try to deallocate the proxy.
-                        hal_lock32(&((ocrPolicyDomainHcDist_t *) self)->lockDbLookup);
+                        u32 * dbLock = proxyLookupLock(((ocrPolicyDomainHcDist_t *) self)->dbLookup, dbGuid);
+                        hal_lock32(dbLock);
                         // Here nobody else can acquire a reference on the proxy
-                        if (proxyDb->refCount == 1) {
+                        if (hal_loadAcquire(&(proxyDb->refCount)) == 1) {
                             DPRINTF(DEBUG_LVL_VVERB,"DB_RELEASE response received for DB GUID "GUIDF", destroy proxy\n", GUIDA(dbGuid));
                             // Removes the entry for the proxy DB in the GUID provider
                             self->guidProviders[0]->fcts.unregisterGuid(self->guidProviders[0], dbGuid, (u64**) 0);
                             // Nobody else can get a reference on the proxy's lock now
-                            hal_unlock32(&((ocrPolicyDomainHcDist_t *) self)->lockDbLookup);
+                            hal_unlock32(dbLock);
                             // Deallocate the proxy DB and the cached ptr
                             // NOTE: we do not unlock proxyDb->lock not call relProxyDb
                             // since we're destroying the whole proxy and we're the last user.
@@ -1907,7 +1965,7 @@ u8 hcDistProcessMessage(ocrPolicyDomain_t *self, ocrPolicyMsg_t *msg, u8 isBlock
                             self->fcts.pdFree(self, proxyDb);
                         } else {
                             // Not deallocating the proxy then allow others to grab a reference
-                            hal_unlock32(&((ocrPolicyDomainHcDist_t *) self)->lockDbLookup);
+                            hal_unlock32(dbLock);
                             // Else no pending acquire enqueued but someone already got a reference
                             // to the proxyDb, repurpose the proxy for a new fetch
                             // Resetting the state to created means the any concurrent acquire
@@ -2482,7 +2540,18 @@ u8 hcDistPdSwitchRunlevel(ocrPolicyDomain_t *self, ocrRunlevel_t runlevel, u32 p
         u8 res = dself->baseSwitchRunlevel(self, runlevel, properties);
         if (properties & RL_BRING_UP) {
             if (runlevel == RL_GUID_OK) {
-                dself->proxyTplMap = newHashtableModulo(self, 10);
+                // Both lock arrays in one allocation starting on a cache line
+                dself->lookupAlloc = self->fcts.pdMalloc(self, 2 * PROXY_LOOKUP_SHARDS * sizeof(proxyLookupShard_t) + 63);
+                dself->dbLookup = (proxyLookupShard_t *) (((u64) dself->lookupAlloc + 63) & ~63ULL);
+                dself->tplLookup = &(dself->dbLookup[PROXY_LOOKUP_SHARDS]);
+                u32 i;
+                for (i = 0; i < PROXY_LOOKUP_SHARDS; i++) {
+                    dself->dbLookup[i].lock = 0;
+                    dself->tplLookup[i].lock = 0;
+                }
+                // One bucket per lookup lock: a bucket is only ever accessed under
+                // the lock of the GUIDs it holds (see proxyLookupLock)
+                dself->proxyTplMap = newHashtable(self, PROXY_LOOKUP_SHARDS, proxyLookupHash);
 
                 //ULFM resilience
                 ResEventNode_t * dummyHead = (ResEventNode_t *) self->fcts.pdMalloc(self, sizeof(ResEventNode_t));
@@ -2508,6 +2577,9 @@ u8 hcDistPdSwitchRunlevel(ocrPolicyDomain_t *self, ocrRunlevel_t runlevel, u32 p
                 // The template map should be empty. Do not check, because this
                 // data-structure should go away with #536 GUID metadata
                 destructHashtable(dself->proxyTplMap, NULL, NULL);
+                self->fcts.pdFree(self, dself->lookupAlloc);
+                dself->lookupAlloc = NULL;
+                dself->dbLookup = dself->tplLookup = NULL;
 
                 //ULFM resilience
                 ResEventNode_t *cur = dself->proxyListHead->next;
@@ -2691,8 +2763,9 @@ void initializePolicyDomainHcDist(ocrPolicyDomainFactory_t * factory,
     ocrPolicyDomainHcDist_t * hcDistPd = (ocrPolicyDomainHcDist_t *) self;
     hcDistPd->baseProcessMessage = derivedFactory->baseProcessMessage;
     hcDistPd->baseSwitchRunlevel = derivedFactory->baseSwitchRunlevel;
-    hcDistPd->lockDbLookup = 0;
-    hcDistPd->lockTplLookup = 0;
+    // Lookup locks are allocated with the template map in RL_GUID_OK
+    hcDistPd->dbLookup = hcDistPd->tplLookup = NULL;
+    hcDistPd->lookupAlloc = NULL;
     hcDistPd->shutdownAckCount = 0;
 
     //ULFM resilience
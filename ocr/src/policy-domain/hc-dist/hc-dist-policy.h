@@ -20,14 +20,26 @@
 /* OCR-HC DISTRIBUTED POLICY DOMAIN                   */
 /******************************************************/
 
+// Number of locks proxies for remote DBs and templates are looked up under.
+// A proxy's lock is selected by a hash of its GUID. Must be a power of two.
+#ifndef PROXY_LOOKUP_SHARDS
+#define PROXY_LOOKUP_SHARDS 64
+#endif
+
+typedef struct {
+    u32 lock;
+    u8 padding[60]; // Keep locks on distinct cache lines
+} __attribute__((aligned(64))) proxyLookupShard_t;
+
 typedef struct {
     ocrPolicyDomainHc_t base;
     u8 (*baseProcessMessage)(struct _ocrPolicyDomain_t *self, struct _ocrPolicyMsg_t *msg,
                              u8 isBlocking);
     u8 (*baseSwitchRunlevel)(struct _ocrPolicyDomain_t *self, ocrRunlevel_t, u32);
     u64 shutdownAckCount;
-    u32 lockDbLookup;  /**< Lock for querying proxies for remote DB */
-    u32 lockTplLookup; /**< Lock for querying proxies for remote template */
+    proxyLookupShard_t * dbLookup;  /**< Locks for querying proxies for remote DB */
+    proxyLookupShard_t * tplLookup; /**< Locks for querying proxies for remote template */
+    void * lookupAlloc;             /**< Allocation holding both lock arrays */
     hashtable_t * proxyTplMap;
 
     //ULFM Resilience
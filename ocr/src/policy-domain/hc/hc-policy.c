@@ -10,6 +10,8 @@
 
 #include "debug.h"
 #include "ocr-errors.h"
+#include "ocr-mem-platform.h"
+#include "ocr-mem-target.h"
 #include "ocr-db.h"
 #include "extensions/ocr-hints.h"
 #include "ocr-policy-domain.h"
@@ -124,6 +126,345 @@ void hcWorkerCallback(ocrPolicyDomain_t *self, u64 val) {
     }
 }
 
+#ifdef PD_MALLOC_CACHE
+// Cached objects are preceded by a header word. Its low bits look like a pool header
+// descriptor that no allocator type uses, which is how hcPdFree tells them apart from
+// blocks that came straight from an allocator. The rest holds the size class and the
+// index of the owning worker.
+#define PD_MALLOC_CACHE_TAG                 POOL_HEADER_TYPE_MASK
+COMPILE_ASSERT(allocatorMax_id <= PD_MALLOC_CACHE_TAG);
+#define PD_MALLOC_CACHE_HDR(cls, owner)     ((((u64)(owner)) << 16) | (((u64)(cls)) << 8) | PD_MALLOC_CACHE_TAG)
+#define PD_MALLOC_CACHE_HDR_CLASS(hdr)      ((u32)(((hdr) >> 8) & 0xFF))
+#define PD_MALLOC_CACHE_HDR_OWNER(hdr)      ((u32)((hdr) >> 16))
+#define PD_MALLOC_CACHE_CLASS_SIZE(cls)     (((u64)(cls) + 1) << PD_MALLOC_CACHE_GRANULE_SHIFT)
+// Free objects are chained through their first word
+#define PD_MALLOC_CACHE_NEXT(obj)           (*((void **) (obj)))
+
+COMPILE_ASSERT(PD_MALLOC_CACHE_CLASSES <= 256);
+
+// Returns the cache of the calling worker or NULL if it has none
+static pdMallocCache_t * mallocCacheCurrent(ocrPolicyDomain_t *self, u32 *workerIdx) {
+    ocrPolicyDomainHc_t * rself = (ocrPolicyDomainHc_t *) self;
+    if (rself->mallocCaches == NULL)
+        return NULL;
+    ocrPolicyDomain_t * pd = NULL;
+    ocrWorker_t * worker = NULL;
+    getCurrentEnv(&pd, &worker, NULL, NULL);
+    if ((pd != self) || (worker == NULL) || (worker->id >= self->workerCount))
+        return NULL;
+    *workerIdx = (u32) worker->id;
+    return &rself->mallocCaches[worker->id];
+}
+
+static void mallocCacheRelease(void * obj) {
+    allocatorFreeFunction(((u64 *) obj) - 1);
+}
+
+// Hands the pending batch of objects back to the worker that owns them
+static void mallocCacheFlushBatch(ocrPolicyDomainHc_t * rself, pdMallocCache_t * cache) {
+    if (cache->batchCount == 0)
+        return;
+    volatile u64 * remote = &(rself->mallocCaches[cache->batchOwner].remote[cache->batchClass]);
+    u64 head;
+    do {
+        head = *remote;
+        PD_MALLOC_CACHE_NEXT(cache->batchTail) = (void *) head;
+    } while (hal_cmpswap64(remote, head, (u64) cache->batchHead) != head);
+    cache->batchHead = NULL;
+    cache->batchTail = NULL;
+    cache->batchCount = 0;
+}
+
+// Moves the objects other workers handed back into the (empty) magazine
+static void * mallocCacheAdopt(pdMallocCache_t * cache, u32 cls) {
+    u64 head;
+    do {
+        head = cache->remote[cls];
+        if (head == 0)
+            return NULL;
+    } while (hal_cmpswap64(&(cache->remote[cls]), head, 0) != head);
+    // Keep at most a full magazine, the allocator gets the rest
+    u32 count = 1;
+    void * obj = (void *) head;
+    while ((count < PD_MALLOC_CACHE_DEPTH) && (PD_MALLOC_CACHE_NEXT(obj) != NULL)) {
+        ++count;
+        obj = PD_MALLOC_CACHE_NEXT(obj);
+    }
+    void * extra = PD_MALLOC_CACHE_NEXT(obj);
+    PD_MALLOC_CACHE_NEXT(obj) = NULL;
+    while (extra != NULL) {
+        obj = extra;
+        extra = PD_MALLOC_CACHE_NEXT(obj);
+        mallocCacheRelease(obj);
+    }
+    cache->local[cls] = (void *) head;
+    cache->count[cls] = count;
+#ifdef PD_MALLOC_CACHE_STATS
+    cache->bytesCached += count * PD_MALLOC_CACHE_CLASS_SIZE(cls);
+    if (cache->bytesCached > cache->peakBytesCached)
+        cache->peakBytesCached = cache->bytesCached;
+#endif
+    return (void *) head;
+}
+
+// Returns an object of at least 'size' bytes or NULL if the calling worker
+// cannot cache objects of that size
+static void * mallocCacheAllocate(ocrPolicyDomain_t *self, u64 size, u64 hints) {
+    u32 workerIdx;
+    pdMallocCache_t * cache;
+    if ((size == 0) || (size > PD_MALLOC_CACHE_MAX_SIZE) ||
+        ((cache = mallocCacheCurrent(self, &workerIdx)) == NULL))
+        return NULL;
+    u32 cls = (u32) ((size - 1) >> PD_MALLOC_CACHE_GRANULE_SHIFT);
+#ifdef PD_MALLOC_CACHE_STATS
+    cache->allocs++;
+#endif
+    void * obj = cache->local[cls];
+    if ((obj != NULL) || ((obj = mallocCacheAdopt(cache, cls)) != NULL)) {
+        cache->local[cls] = PD_MALLOC_CACHE_NEXT(obj);
+        cache->count[cls]--;
+#ifdef PD_MALLOC_CACHE_STATS
+        cache->hits++;
+        cache->bytesCached -= PD_MALLOC_CACHE_CLASS_SIZE(cls);
+#endif
+        return obj;
+    }
+    u64 * hdr = (u64 *) self->allocators[0]->fcts.allocate(self->allocators[0],
+                    PD_MALLOC_CACHE_CLASS_SIZE(cls) + sizeof(u64), hints);
+    if (hdr == NULL)
+        return NULL;
+    *hdr = PD_MALLOC_CACHE_HDR(cls, workerIdx);
+    return (void *) (hdr + 1);
+}
+
+// Takes back 'addr' if it was allocated by mallocCacheAllocate. Returns false
+// if it came straight from an allocator.
+static bool mallocCacheFree(ocrPolicyDomain_t *self, void * addr) {
+    u64 hdr = ((u64 *) addr)[-1];
+    if ((hdr & POOL_HEADER_TYPE_MASK) != PD_MALLOC_CACHE_TAG)
+        return false;
+    u32 cls = PD_MALLOC_CACHE_HDR_CLASS(hdr);
+    u32 owner = PD_MALLOC_CACHE_HDR_OWNER(hdr);
+    u32 workerIdx;
+    pdMallocCache_t * cache = mallocCacheCurrent(self, &workerIdx);
+    // The owner may not be one of our workers if the object was allocated
+    // by another policy domain: give it straight back to its allocator
+    if ((cache == NULL) || (owner >= self->workerCount)) {
+        mallocCacheRelease(addr);
+    } else if (owner == workerIdx) {
+        PD_MALLOC_CACHE_NEXT(addr) = cache->local[cls];
+        cache->local[cls] = addr;
+#ifdef PD_MALLOC_CACHE_STATS
+        cache->bytesCached += PD_MALLOC_CACHE_CLASS_SIZE(cls);
+        if (cache->bytesCached > cache->peakBytesCached)
+            cache->peakBytesCached = cache->bytesCached;
+#endif
+        if (++cache->count[cls] > PD_MALLOC_CACHE_DEPTH) {
+            // Keep half of the magazine and give the rest back to the allocator
+            while (cache->count[cls] > (PD_MALLOC_CACHE_DEPTH/2)) {
+                void * obj = cache->local[cls];
+                cache->local[cls] = PD_MALLOC_CACHE_NEXT(obj);
+                cache->count[cls]--;
+                mallocCacheRelease(obj);
+#ifdef PD_MALLOC_CACHE_STATS
+                cache->bytesCached -= PD_MALLOC_CACHE_CLASS_SIZE(cls);
+#endif
+            }
+        }
+    } else {
+        ocrPolicyDomainHc_t * rself = (ocrPolicyDomainHc_t *) self;
+#ifdef PD_MALLOC_CACHE_STATS
+        cache->remoteFrees++;
+#endif
+        if ((cache->batchCount != 0) && ((cache->batchOwner != owner) || (cache->batchClass != cls)))
+            mallocCacheFlushBatch(rself, cache);
+        PD_MALLOC_CACHE_NEXT(addr) = cache->batchHead;
+        if (cache->batchCount == 0) {
+            cache->batchTail = addr;
+            cache->batchOwner = owner;
+            cache->batchClass = cls;
+        }
+        cache->batchHead = addr;
+        if (++cache->batchCount == PD_MALLOC_CACHE_BATCH)
+            mallocCacheFlushBatch(rself, cache);
+    }
+    return true;
+}
+
+static void mallocCacheInit(ocrPolicyDomain_t *self) {
+    ocrPolicyDomainHc_t * rself = (ocrPolicyDomainHc_t *) self;
+    ASSERT(rself->mallocCaches == NULL);
+    // Allocated before caching is turned on so it comes straight from the allocator
+    pdMallocCache_t * caches = (pdMallocCache_t *) self->fcts.pdMalloc(self, sizeof(pdMallocCache_t) * self->workerCount);
+    u32 i, cls;
+    for (i = 0; i < self->workerCount; ++i) {
+        pdMallocCache_t * cache = &caches[i];
+        for (cls = 0; cls < PD_MALLOC_CACHE_CLASSES; ++cls) {
+            cache->local[cls] = NULL;
+            cache->count[cls] = 0;
+            cache->remote[cls] = 0;
+        }
+        cache->batchHead = NULL;
+        cache->batchTail = NULL;
+        cache->batchOwner = 0;
+        cache->batchClass = 0;
+        cache->batchCount = 0;
+#ifdef PD_MALLOC_CACHE_STATS
+        cache->allocs = 0;
+        cache->hits = 0;
+        cache->remoteFrees = 0;
+        cache->bytesCached = 0;
+        cache->peakBytesCached = 0;
+#endif
+    }
+    rself->mallocCaches = caches;
+}
+
+// Turns caching off and gives every cached object back to the allocator.
+// Only called when the workers are no longer running.
+static void mallocCacheDrain(ocrPolicyDomain_t *self) {
+    ocrPolicyDomainHc_t * rself = (ocrPolicyDomainHc_t *) self;
+    pdMallocCache_t * caches = rself->mallocCaches;
+    if (caches == NULL)
+        return;
+    u32 i, cls;
+    for (i = 0; i < self->workerCount; ++i) {
+        mallocCacheFlushBatch(rself, &caches[i]);
+    }
+    rself->mallocCaches = NULL;
+    for (i = 0; i < self->workerCount; ++i) {
+        pdMallocCache_t * cache = &caches[i];
+#ifdef PD_MALLOC_CACHE_STATS
+        PRINTF("PD malloc cache: worker %"PRIu32" allocs %"PRIu64" hit-rate %"PRIu64"%% remote-frees %"PRIu64
+               " bytes-cached %"PRIu64" (peak %"PRIu64")\n", i, cache->allocs,
+               (cache->allocs == 0) ? 0 : ((cache->hits * 100) / cache->allocs),
+               cache->remoteFrees, cache->bytesCached, cache->peakBytesCached);
+#endif
+        for (cls = 0; cls < PD_MALLOC_CACHE_CLASSES; ++cls) {
+            void * obj = cache->local[cls];
+            while (obj != NULL) {
+                void * next = PD_MALLOC_CACHE_NEXT(obj);
+                mallocCacheRelease(obj);
+                obj = next;
+            }
+            obj = (void *) cache->remote[cls];
+            while (obj != NULL) {
+                void * next = PD_MALLOC_CACHE_NEXT(obj);
+                mallocCacheRelease(obj);
+                obj = next;
+            }
+        }
+    }
+    self->fcts.pdFree(self, caches);
+}
+#endif /* PD_MALLOC_CACHE */
+
+// Appends allocator 'idx' as the 'count'-th entry of a prescription. Entries
+// after the first one have their low bit set so that allocateDatablock keeps
+// going even when the allocator index is 0.
+#define DB_PLACEMENT_APPEND(prescription, count, idx) do {                    \
+        (prescription) |= ((((u64)(idx)) << 1) | ((count) ? 1 : 0)) << (4*(count)); \
+        ++(count);                                                            \
+    } while(0)
+
+// Builds the data-block prescriptions from the memory underlying each allocator
+static void dbPlacementInit(ocrPolicyDomain_t *self) {
+    pdHcDbPlacement_t * placement = &(((ocrPolicyDomainHc_t *) self)->dbPlacement);
+    bool highBw[HC_DB_PLACEMENT_MAX_ALLOCATORS];
+    bool anyHighBw = false;
+    u32 allocatorCount = (self->allocatorCount > HC_DB_PLACEMENT_MAX_ALLOCATORS) ?
+        HC_DB_PLACEMENT_MAX_ALLOCATORS : self->allocatorCount;
+    u32 i, d, n;
+    placement->nodeCount = 0;
+    for (i = 0; i < allocatorCount; ++i) {
+        ocrAllocator_t * allocator = self->allocators[i];
+        u32 nodeId = 0;
+        highBw[i] = false;
+        if ((allocator != NULL) && (allocator->memoryCount != 0) &&
+            (allocator->memories[0]->memoryCount != 0)) {
+            ocrMemPlatform_t * mem = allocator->memories[0]->memories[0];
+            nodeId = mem->numaNode;
+            highBw[i] = mem->highBandwidth;
+            anyHighBw |= highBw[i];
+        }
+        for (n = 0; (n < placement->nodeCount) && (placement->nodeId[n] != nodeId); ++n);
+        if (n == placement->nodeCount) {
+            if (n == HC_DB_PLACEMENT_MAX_NODES) {
+                DPRINTF(DEBUG_LVL_WARN, "Data-block placement: node %"PRIu32" of allocator %"PRIu32" folded onto node %"PRIu32"\n",
+                        nodeId, i, placement->nodeId[0]);
+                n = 0;
+            } else {
+                placement->nodeId[n] = nodeId;
+                ++placement->nodeCount;
+            }
+        }
+        placement->allocatorNode[i] = n;
+    }
+    if ((placement->nodeCount < 2) && !anyHighBw) {
+        // Nothing to choose from: keep the default prescription
+        placement->nodeCount = 0;
+        return;
+    }
+    for (n = 0; n < placement->nodeCount; ++n) {
+        u64 near = 0, far = 0, fast = 0;
+        u32 nearCount = 0, farCount = 0, fastCount = 0;
+        // High-bandwidth memory is scarce: it is only used when asked for
+        // or when everything else is full
+        for (d = 0; d < placement->nodeCount; ++d) {
+            for (i = 0; i < allocatorCount; ++i) {
+                if (self->allocators[i] == NULL)
+                    continue;
+                if (placement->allocatorNode[i] == (n + d) % placement->nodeCount) {
+                    if (highBw[i]) {
+                        DB_PLACEMENT_APPEND(fast, fastCount, i);
+                    } else {
+                        DB_PLACEMENT_APPEND(near, nearCount, i);
+                    }
+                }
+                if (placement->allocatorNode[i] == (n + d + 1) % placement->nodeCount && !highBw[i])
+                    DB_PLACEMENT_APPEND(far, farCount, i);
+            }
+        }
+        for (d = 0; d < placement->nodeCount; ++d) {
+            for (i = 0; i < allocatorCount; ++i) {
+                if ((self->allocators[i] != NULL) && highBw[i] &&
+                    (placement->allocatorNode[i] == (n + d) % placement->nodeCount)) {
+                    DB_PLACEMENT_APPEND(near, nearCount, i);
+                    DB_PLACEMENT_APPEND(far, farCount, i);
+                }
+            }
+        }
+        // High-bandwidth first then the same order as near
+        for (d = 0; d < nearCount; ++d) {
+            u32 idx = (near >> (4*d + 1)) & 7;
+            if (!highBw[idx])
+                DB_PLACEMENT_APPEND(fast, fastCount, idx);
+        }
+        placement->nearPrescription[n] = near;
+        placement->farPrescription[n] = far;
+        placement->highBwPrescription[n] = fast;
+        DPRINTF(DEBUG_LVL_INFO, "Data-block placement for node %"PRIu32": near 0x%"PRIx64" far 0x%"PRIx64" highbw 0x%"PRIx64"\n",
+                placement->nodeId[n], near, far, fast);
+#ifdef HC_DB_PLACEMENT_STATS
+        placement->allocCount[n] = 0;
+        placement->allocBytes[n] = 0;
+        placement->fallbackCount[n] = 0;
+#endif
+    }
+}
+
+#ifdef HC_DB_PLACEMENT_STATS
+static void dbPlacementPrintStats(ocrPolicyDomain_t *self) {
+    pdHcDbPlacement_t * placement = &(((ocrPolicyDomainHc_t *) self)->dbPlacement);
+    u32 n;
+    for (n = 0; n < placement->nodeCount; ++n) {
+        PRINTF("PD DB placement: node %"PRIu32" allocs %"PRIu64" bytes %"PRIu64" fallbacks %"PRIu64"\n",
+               placement->nodeId[n], placement->allocCount[n], placement->allocBytes[n],
+               placement->fallbackCount[n]);
+    }
+}
+#endif
+
 // Function to cause run-level switches in this PD
 u8 hcPdSwitchRunlevel(ocrPolicyDomain_t *policy, ocrRunlevel_t runlevel, u32 properties) {
     s32 j, k=0;
@@ -273,6 +614,15 @@ u8 hcPdSwitchRunlevel(ocrPolicyDomain_t *policy, ocrRunlevel_t runlevel, u32 pro
     {
         phaseCount = ((policy->phasesPerRunlevel[RL_MEMORY_OK][0]) >> ((properties&RL_TEAR_DOWN)?4:0)) & 0xF;
         maxCount = policy->workerCount;
+#ifdef PD_MALLOC_CACHE
+        // Give the cached objects back before the allocators go away
+        if(properties & RL_TEAR_DOWN)
+            mallocCacheDrain(policy);
+#endif
+#ifdef HC_DB_PLACEMENT_STATS
+        if(properties & RL_TEAR_DOWN)
+            dbPlacementPrintStats(policy);
+#endif
         for(i = 0; i < phaseCount; ++i) {
             if(toReturn) break;
             GET_PHASE(i);
@@ -285,6 +635,12 @@ u8 hcPdSwitchRunlevel(ocrPolicyDomain_t *policy, ocrRunlevel_t runlevel, u32 pro
         if(toReturn) {
             DPRINTF(DEBUG_LVL_WARN, "RL_MEMORY_OK(%"PRId32") phase %"PRId32" failed: %"PRId32"\n", origProperties, curPhase, toReturn);
         }
+        else if(properties & RL_BRING_UP) {
+            dbPlacementInit(policy);
+#ifdef PD_MALLOC_CACHE
+            mallocCacheInit(policy);
+#endif
+        }
         break;
     }
     case RL_GUID_OK:
@@ -417,8 +773,9 @@ u8 hcPdSwitchRunlevel(ocrPolicyDomain_t *policy, ocrRunlevel_t runlevel, u32 pro
                     // Here we need to block because when we return from the function, we need to have
                     // transitioned
                     DPRINTF(DEBUG_LVL_VVERB, "switchRunlevel: synchronous switch to RL_COMPUTE_OK phase %"PRId32" ... will block\n", i);
+                    // Yield so that workers sharing our core can check in
                     while(rself->rlSwitch.checkedIn)
-                        ;
+                        hal_pause();
                     ASSERT(rself->rlSwitch.checkedIn == 0);
                 } else {
                     DPRINTF(DEBUG_LVL_VVERB, "switchRunlevel: asynchronous switch to RL_COMPUTE_OK phase %"PRId32"\n", i);
@@ -732,7 +1089,7 @@ static void* allocateDatablock (ocrPolicyDomain_t *self,
         prescription >>= 1;
         idx = prescription & 7;  // Get the index of the allocator to use.
         prescription >>= 3;
-        if ((idx > self->allocatorCount) || (self->allocators[idx] == NULL)) {
+        if ((idx >= self->allocatorCount) || (self->allocators[idx] == NULL)) {
             continue;  // Skip this allocator if it doesn't exist.
         }
         result = self->allocators[idx]->fcts.allocate(self->allocators[idx], size, 0);
@@ -759,18 +1116,68 @@ static u8 hcAllocateDb(ocrPolicyDomain_t *self, ocrFatGuid_t *guid, void** ptr,
     // eventually be eliminated here and instead, above this level, processed into the "prescription"
     // variable, which has been added to this argument list.  The prescription indicates an order in
     // which to attempt to allocate the block to a pool.
+    //
+    // When the allocators span several NUMA nodes (or some are high-bandwidth), the
+    // prescription is replaced by the one for the node of the creating worker. The
+    // DB hints then select the near, far or high-bandwidth order.
+    //
+    // Small data-blocks are allocated in one piece with their metadata, which
+    // the factory places in the metaSize bytes ahead of the data.
     u64 idx;
-    void *result = allocateDatablock (self, size, prescription, &idx);
+    pdHcDbPlacement_t * placement = &(((ocrPolicyDomainHc_t *) self)->dbPlacement);
+    u32 node = 0;
+    if (placement->nodeCount != 0) {
+        ocrWorker_t * worker;
+        getCurrentEnv(NULL, &worker, NULL, NULL);
+        u32 nodeId = (worker != NULL) ? worker->numaNode : hal_numaNode();
+        for (node = 0; (node < placement->nodeCount) && (placement->nodeId[node] != nodeId); ++node);
+        if (node == placement->nodeCount)
+            node = nodeId % placement->nodeCount;
+        prescription = placement->nearPrescription[node];
+        u64 hintValue = 0ULL;
+        if (hint != NULL_HINT) {
+            if (ocrGetHintValue(hint, OCR_HINT_DB_HIGHBW, &hintValue) == 0 && hintValue) {
+                prescription = placement->highBwPrescription[node];
+            } else if (ocrGetHintValue(hint, OCR_HINT_DB_FAR, &hintValue) == 0 && hintValue) {
+                prescription = placement->farPrescription[node];
+            }
+            // OCR_HINT_DB_NEAR and OCR_HINT_DB_INTER: the creating worker's node.
+            // So does OCR_HINT_DB_AFFINITY: it names a policy domain, not a NUMA
+            // node, and the creation was already routed to that policy domain.
+        }
+    }
+    u64 metaSize = 0;
+#ifdef HC_DB_COALLOC
+    // Providers that allocate a cell per GUID (PTR) would still cost two
+    // allocations, so co-allocating buys nothing there
+    if ((size <= HC_DB_COALLOC_MAX_SIZE) && !(properties & GUID_PROP_IS_LABELED)
+        && !self->guidProviders[0]->allocPerGuid) {
+        metaSize = self->dbFactories[0]->metaSize;
+        if (metaSize != 0)
+            properties |= DB_PROP_RT_COALLOC;
+    }
+#endif
+    void *result = allocateDatablock (self, metaSize + size, prescription, &idx);
+#ifdef HC_DB_PLACEMENT_STATS
+    if (result && (placement->nodeCount != 0)) {
+        u32 placedNode = placement->allocatorNode[idx];
+        hal_xadd64(&(placement->allocCount[placedNode]), 1);
+        hal_xadd64(&(placement->allocBytes[placedNode]), size);
+        if (idx != ((prescription >> 1) & 7))
+            hal_xadd64(&(placement->fallbackCount[placedNode]), 1);
+    }
+#endif
     if (result) {
         u8 returnValue = 0;
+        void *data = (void*)((u64)result + metaSize);
         returnValue = self->dbFactories[0]->instantiate(
             self->dbFactories[0], guid, self->allocators[idx]->fguid, self->fguid,
-            size, result, hint, properties, NULL);
+            size, data, hint, properties, NULL);
         if(returnValue == 0) {
-            *ptr = result;
+            *ptr = data;
         } else {
             // We need to free the memory that was allocated
-            hcMemUnAlloc(self, &(self->allocators[idx]->fguid), *ptr, DB_MEMTYPE);
+            hcMemUnAlloc(self, &(self->allocators[idx]->fguid), result, DB_MEMTYPE);
         }
         // This could be OCR_EGUIDEXISTS
         return returnValue;
@@ -790,6 +1197,15 @@ static u8 hcMemAlloc(ocrPolicyDomain_t *self, ocrFatGuid_t* allocator, u64 size,
     void* result;
     u64 idx;
     ASSERT (memType == GUID_MEMTYPE || memType == DB_MEMTYPE);
+#ifdef PD_MALLOC_CACHE
+    // Runtime metadata is recycled through the worker's cache. It only ever
+    // comes from the first allocator with the HC prescription.
+    if ((memType == GUID_MEMTYPE) && ((result = mallocCacheAllocate(self, size, 0)) != NULL)) {
+        *ptr = result;
+        *allocator = self->allocators[0]->fguid;
+        return 0;
+    }
+#endif
     result = allocateDatablock (self, size, prescription, &idx);
     if (result) {
         *ptr = result;
@@ -804,6 +1220,10 @@ static u8 hcMemAlloc(ocrPolicyDomain_t *self, ocrFatGuid_t* allocator, u64 size,
 static u8 hcMemUnAlloc(ocrPolicyDomain_t *self, ocrFatGuid_t* allocator,
                        void* ptr, ocrMemType_t memType) {
 #if 1
+#ifdef PD_MALLOC_CACHE
+    if (mallocCacheFree(self, ptr))
+        return 0;
+#endif
     allocatorFreeFunction(ptr);
     return 0;
 #else
@@ -1596,7 +2016,7 @@ u8 hcPolicyDomainProcessMessage(ocrPolicyDomain_t *self, ocrPolicyMsg_t *msg, u8
 #define PD_TYPE PD_MSG_GUID_RESERVE
         PD_MSG_FIELD_O(returnDetail) = self->guidProviders[0]->fcts.guidReserve(
             self->guidProviders[0], &(PD_MSG_FIELD_O(startGuid)), &(PD_MSG_FIELD_O(skipGuid)),
-            PD_MSG_FIELD_I(numberGuids), PD_MSG_FIELD_I(guidKind));
+            &(PD_MSG_FIELD_O(locationSkip)), PD_MSG_FIELD_I(numberGuids), PD_MSG_FIELD_I(guidKind));
 #undef PD_MSG
 #undef PD_TYPE
         msg->type &= ~PD_MSG_REQUEST;
@@ -2162,6 +2582,79 @@ u8 hcPolicyDomainProcessMessage(ocrPolicyDomain_t *self, ocrPolicyMsg_t *msg, u8
         break;
     }
 
+    case PD_MSG_DEP_SATISFY_BATCH: {
+        START_PROFILE(pd_hc_SatisfyBatch);
+#define PD_MSG msg
+#define PD_TYPE PD_MSG_DEP_SATISFY_BATCH
+        // Sent by a remote event to all its waiters living here (see drainWaiters)
+        ASSERT(!(msg->type & PD_MSG_REQ_RESPONSE));
+#ifdef ENABLE_EXTENSION_PAUSE
+        ocrPolicyDomainHc_t *rself = (ocrPolicyDomainHc_t *)self;
+#endif
+#ifdef HCEVT_BATCH_SATISFY
+        // Tasks made ready go to the scheduler together
+        ocrFatGuid_t readyGuids[HCEVT_READY_BATCH_COUNT];
+        ocrSchedReadyBatch_t batch;
+        batch.guids = readyGuids;
+        batch.count = 0;
+        batch.max = HCEVT_READY_BATCH_COUNT;
+#endif
+        ocrFatGuid_t payload = PD_MSG_FIELD_I(payload);
+        ocrSatisfyTarget_t * targets = PD_MSG_FIELD_I(targets);
+        u32 count = PD_MSG_FIELD_I(count);
+        u8 returnDetail = 0;
+        u32 i;
+        for (i = 0; (i < count) && (returnDetail == 0); ++i) {
+            ocrGuidKind dstKind;
+            ocrFatGuid_t dst;
+            dst.guid = targets[i].guid;
+            self->guidProviders[0]->fcts.getVal(
+                self->guidProviders[0], dst.guid, (u64*)(&(dst.metaDataPtr)), &dstKind);
+            if(dstKind & OCR_GUID_EVENT) {
+                ocrEvent_t *evt = (ocrEvent_t*)(dst.metaDataPtr);
+                ASSERT(evt->fctId == self->eventFactories[0]->factoryId);
+                returnDetail = self->eventFactories[0]->fcts[evt->kind].satisfy(
+                    evt, payload, targets[i].slot);
+            } else if(dstKind == OCR_GUID_EDT) {
+                ocrTask_t *edt = (ocrTask_t*)(dst.metaDataPtr);
+                ASSERT(edt->fctId == self->taskFactories[0]->factoryId);
+#ifdef HCEVT_BATCH_SATISFY
+#ifdef REG_ASYNC_SGL
+                returnDetail = hcTaskSatisfyBatched(edt, payload, targets[i].slot, targets[i].mode, &batch);
+#else
+                returnDetail = hcTaskSatisfyBatched(edt, payload, targets[i].slot, &batch);
+#endif
+#else
+#ifdef REG_ASYNC_SGL
+                returnDetail = self->taskFactories[0]->fcts.satisfyWithMode(
+                    edt, payload, targets[i].slot, targets[i].mode);
+#else
+                returnDetail = self->taskFactories[0]->fcts.satisfy(
+                    edt, payload, targets[i].slot);
+#endif
+#endif
+            } else {
+                DPRINTF(DEBUG_LVL_WARN, "Attempting to satisfy a GUID of type %"PRIx32", expected EDT\n", dstKind);
+                returnDetail = OCR_ENOTSUP;
+                ASSERT(0); // We can't satisfy anything else
+            }
+        }
+#ifdef HCEVT_BATCH_SATISFY
+        if (returnDetail == 0) {
+            returnDetail = hcTaskFlushReadyBatch(self, &batch);
+        }
+#endif
+#ifdef ENABLE_EXTENSION_PAUSE
+        rself->pqrFlags.prevDb = payload.guid;
+#endif
+        PD_MSG_FIELD_O(returnDetail) = returnDetail;
+#undef PD_MSG
+#undef PD_TYPE
+        msg->type &= ~PD_MSG_REQUEST;
+        EXIT_PROFILE;
+        break;
+    }
+
     case PD_MSG_DEP_UNREGSIGNALER: {
         //Not implemented: see #521, #522
         ASSERT(0);
@@ -2442,6 +2935,7 @@ u8 hcPdWaitMessage(ocrPolicyDomain_t *self,  ocrMsgHandle_t **handle) {
     return 0;
 }
 
+
 void* hcPdMalloc(ocrPolicyDomain_t *self, u64 size) {
     START_PROFILE(pd_hc_PdMalloc);
 #ifdef NANNYMODE_SYSALLOC
@@ -2449,6 +2943,11 @@ void* hcPdMalloc(ocrPolicyDomain_t *self, u64 size) {
     void* toReturn = malloc(size);
     ASSERT(toReturn != NULL);
 #else
+#ifdef PD_MALLOC_CACHE
+    void* cached = mallocCacheAllocate(self, size, OCR_ALLOC_HINT_RUNTIME);
+    if (cached != NULL)
+        RETURN_PROFILE(cached);
+#endif
     // Just try in the first allocator
     void* toReturn = NULL;
     toReturn = self->allocators[0]->fcts.allocate(self->allocators[0], size, OCR_ALLOC_HINT_RUNTIME);
@@ -2465,6 +2964,10 @@ void hcPdFree(ocrPolicyDomain_t *self, void* addr) {
     // Just try in the first allocator
     free(addr);
 #else
+#ifdef PD_MALLOC_CACHE
+    if (mallocCacheFree(self, addr))
+        RETURN_PROFILE();
+#endif
     // May result in leaks but better than the alternative...
     allocatorFreeFunction(addr);
 #endif
@@ -2502,6 +3005,11 @@ void initializePolicyDomainHc(ocrPolicyDomainFactory_t * factory, ocrPolicyDomai
 
     ocrPolicyDomainHc_t* derived = (ocrPolicyDomainHc_t*) self;
     derived->rlSwitch.legacySecondStart = false;
+    derived->parkedWorkers = 0;
+#ifdef PD_MALLOC_CACHE
+    derived->mallocCaches = NULL;
+#endif
+    derived->dbPlacement.nodeCount = 0;
 }
 
 static void destructPolicyDomainFactoryHc(ocrPolicyDomainFactory_t * factory) {
@@ -37,10 +37,101 @@ typedef struct {
     volatile ocrGuid_t prevDb; //Previous DB used for sat.
 } hcPqrFlags;
 
+#ifdef PD_MALLOC_CACHE
+// Size classes are multiples of PD_MALLOC_CACHE_GRANULE bytes
+#ifndef PD_MALLOC_CACHE_GRANULE_SHIFT
+#define PD_MALLOC_CACHE_GRANULE_SHIFT 5
+#endif
+#ifndef PD_MALLOC_CACHE_CLASSES
+#define PD_MALLOC_CACHE_CLASSES 32
+#endif
+// Maximum number of objects a worker keeps per size class
+#ifndef PD_MALLOC_CACHE_DEPTH
+#define PD_MALLOC_CACHE_DEPTH 64
+#endif
+// Number of objects freed for another worker before they are handed back
+#ifndef PD_MALLOC_CACHE_BATCH
+#define PD_MALLOC_CACHE_BATCH 16
+#endif
+#define PD_MALLOC_CACHE_GRANULE (1ULL << PD_MALLOC_CACHE_GRANULE_SHIFT)
+#define PD_MALLOC_CACHE_MAX_SIZE (PD_MALLOC_CACHE_CLASSES * PD_MALLOC_CACHE_GRANULE)
+
+/**
+ * @brief Per-worker cache of small objects allocated through pdMalloc
+ *
+ * Each worker recycles the objects it allocated from singly-linked
+ * magazines, one per size class. Objects freed by another worker are
+ * accumulated in a batch and pushed to the owner's 'remote' lists, which
+ * the owner adopts when its magazine runs dry.
+ */
+typedef struct _pdMallocCache_t {
+    void * local[PD_MALLOC_CACHE_CLASSES];  /**< Magazines, only touched by the owner */
+    u32 count[PD_MALLOC_CACHE_CLASSES];     /**< Number of objects in each magazine */
+    // Objects freed here on behalf of another worker
+    void * batchHead;
+    void * batchTail;
+    u32 batchOwner;
+    u32 batchClass;
+    u32 batchCount;
+#ifdef PD_MALLOC_CACHE_STATS
+    u64 allocs;         /**< Allocations that could be cached */
+    u64 hits;           /**< Allocations served from the magazines */
+    u64 remoteFrees;    /**< Objects freed on behalf of another worker */
+    u64 bytesCached;    /**< Bytes currently held in the magazines */
+    u64 peakBytesCached;
+#endif
+    u64 padding[8];
+    volatile u64 remote[PD_MALLOC_CACHE_CLASSES]; /**< Objects handed back by other workers */
+    u64 padding2[8];
+} pdMallocCache_t;
+#endif
+
+#ifdef HC_DB_COALLOC
+// Largest data-block allocated together with its metadata
+#ifndef HC_DB_COALLOC_MAX_SIZE
+#define HC_DB_COALLOC_MAX_SIZE 4096
+#endif
+#endif
+
+// Maximum number of NUMA nodes data-block placement distinguishes
+#ifndef HC_DB_PLACEMENT_MAX_NODES
+#define HC_DB_PLACEMENT_MAX_NODES 8
+#endif
+// Only the first allocators can be named in a prescription (3-bit index)
+#define HC_DB_PLACEMENT_MAX_ALLOCATORS 8
+
+/**
+ * @brief Order in which the allocators are tried for data-blocks
+ *
+ * Built at bring-up from the NUMA node and kind of memory underlying each
+ * allocator. Prescriptions are in the format walked by allocateDatablock
+ * and are indexed by node in the order nodes were first seen.
+ * Placement is off (nodeCount is 0) when all the allocators are on a
+ * single node and none of them is high-bandwidth.
+ */
+typedef struct {
+    u32 nodeCount;
+    u32 nodeId[HC_DB_PLACEMENT_MAX_NODES];          /**< NUMA node number of each node */
+    u32 allocatorNode[HC_DB_PLACEMENT_MAX_ALLOCATORS];
+    u64 nearPrescription[HC_DB_PLACEMENT_MAX_NODES];  /**< Node's own memory, then the next nodes' */
+    u64 farPrescription[HC_DB_PLACEMENT_MAX_NODES];   /**< Other nodes' memory first */
+    u64 highBwPrescription[HC_DB_PLACEMENT_MAX_NODES];/**< High-bandwidth memory first, then near */
+#ifdef HC_DB_PLACEMENT_STATS
+    volatile u64 allocCount[HC_DB_PLACEMENT_MAX_NODES];    /**< Data-blocks placed on each node */
+    volatile u64 allocBytes[HC_DB_PLACEMENT_MAX_NODES];
+    volatile u64 fallbackCount[HC_DB_PLACEMENT_MAX_NODES]; /**< Placed there because the preferred allocator was full */
+#endif
+} pdHcDbPlacement_t;
+
 typedef struct {
     ocrPolicyDomain_t base;
     pdHcResumeSwitchRL_t rlSwitch; // Used for asynchronous RL switch
     hcPqrFlags pqrFlags;
+    volatile u32 parkedWorkers; // Number of workers registered as sleepers
+#ifdef PD_MALLOC_CACHE
+    pdMallocCache_t * mallocCaches; // One per worker, NULL when caching is off
+#endif
+    pdHcDbPlacement_t dbPlacement;
 } ocrPolicyDomainHc_t;
 
 typedef struct {
@@ -299,6 +299,15 @@ u8 ocrPolicyMsgGetMsgSize(ocrPolicyMsg_t *msg, u64 *baseSize,
         break;
 #undef PD_TYPE
 
+    case PD_MSG_DEP_SATISFY_BATCH:
+#define PD_TYPE PD_MSG_DEP_SATISFY_BATCH
+        if(isIn) {
+            ASSERT(MAX_ALIGN % sizeof(u64) == 0);
+            *marshalledSize = sizeof(ocrSatisfyTarget_t)*PD_MSG_FIELD_I(count);
+        }
+        break;
+#undef PD_TYPE
+
     case PD_MSG_DB_ACQUIRE:
         if((flags & MARSHALL_DBPTR) && (!isIn)) {
 #define PD_TYPE PD_MSG_DB_ACQUIRE
@@ -811,6 +820,28 @@ u8 ocrPolicyMsgMarshallMsg(ocrPolicyMsg_t* msg, u64 baseSize, u8* buffer, u32 mo
 #undef PD_TYPE
     }
 
+    case PD_MSG_DEP_SATISFY_BATCH: {
+#define PD_TYPE PD_MSG_DEP_SATISFY_BATCH
+        if(isIn) {
+            ASSERT(PD_MSG_FIELD_I(count) != 0);
+            u64 s = sizeof(ocrSatisfyTarget_t)*PD_MSG_FIELD_I(count);
+            hal_memCopy(curPtr, PD_MSG_FIELD_I(targets), s, false);
+            // Now fixup the pointer
+            if(fixupPtrs) {
+                DPRINTF(DEBUG_LVL_VVERB, "Converting targets (%p) to 0x%"PRIx64"\n",
+                        PD_MSG_FIELD_I(targets), ((u64)(curPtr - startPtr)<<1) + isAddl);
+                PD_MSG_FIELD_I(targets) = (ocrSatisfyTarget_t*)((((u64)(curPtr - startPtr))<<1) + isAddl);
+            } else {
+                DPRINTF(DEBUG_LVL_VVERB, "Copying targets (%p) to %p\n",
+                        PD_MSG_FIELD_I(targets), curPtr);
+                PD_MSG_FIELD_I(targets) = (ocrSatisfyTarget_t*)curPtr;
+            }
+            curPtr += s;
+        }
+        break;
+#undef PD_TYPE
+    }
+
     case PD_MSG_DB_ACQUIRE: {
 #define PD_TYPE PD_MSG_DB_ACQUIRE
         // Set to zero if not outgoing message because in that case
@@ -1244,6 +1275,18 @@ u8 ocrPolicyMsgUnMarshallMsg(u8* mainBuffer, u8* addlBuffer,
 #undef PD_TYPE
     }
 
+    case PD_MSG_DEP_SATISFY_BATCH: {
+#define PD_TYPE PD_MSG_DEP_SATISFY_BATCH
+        if(isIn) {
+            u64 t = (u64)(PD_MSG_FIELD_I(targets));
+            PD_MSG_FIELD_I(targets) = (ocrSatisfyTarget_t*)((t&1?localAddlPtr:localMainPtr) + (t>>1));
+            DPRINTF(DEBUG_LVL_VVERB, "Converted field targets from 0x%"PRIx64" to 0x%"PRIx64"\n",
+                    t, (u64)PD_MSG_FIELD_I(targets));
+        }
+        break;
+#undef PD_TYPE
+    }
+
     case PD_MSG_DB_ACQUIRE: {
         if((flags & MARSHALL_DBPTR) && (!isIn)) {
 #define PD_TYPE PD_MSG_DB_ACQUIRE
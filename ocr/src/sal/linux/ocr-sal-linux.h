@@ -22,6 +22,19 @@ extern void salResume(u32 flag);
 
 extern void registerSignalHandler();
 
+/**
+ * @brief Blocks the calling thread while *addr == expected
+ *
+ * Returns after at most timeoutUs microseconds, on a matching
+ * salParkWake or spuriously; callers must re-check their condition
+ */
+extern void salParkWait(volatile u32 *addr, u32 expected, u64 timeoutUs);
+
+/**
+ * @brief Wakes up to count threads blocked in salParkWait on addr
+ */
+extern void salParkWake(volatile u32 *addr, u32 count);
+
 #define sal_abort()   hal_abort()
 
 #define sal_exit(x)   hal_exit(x)
@@ -38,6 +38,34 @@ u64 salGetTime(){
 }
 #endif /*__MACH__*/
 
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+void salParkWait(volatile u32 *addr, u32 expected, u64 timeoutUs) {
+    struct timespec ts;
+    ts.tv_sec = timeoutUs / 1000000UL;
+    ts.tv_nsec = (timeoutUs % 1000000UL) * 1000UL;
+    // Spurious returns (EAGAIN, EINTR, ETIMEDOUT) are fine: callers re-check *addr
+    syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, expected, &ts, NULL, 0);
+}
+
+void salParkWake(volatile u32 *addr, u32 count) {
+    syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, count, NULL, NULL, 0);
+}
+#else
+#include <sched.h>
+
+// No futex: degrade to a yield, the caller's timeout-driven loop does the rest
+void salParkWait(volatile u32 *addr, u32 expected, u64 timeoutUs) {
+    sched_yield();
+}
+
+void salParkWake(volatile u32 *addr, u32 count) {
+}
+#endif /*__linux__*/
+
 
 #ifdef ENABLE_EXTENSION_PAUSE
 
@@ -433,7 +433,7 @@ u8 ceSchedulerHeuristicNotifySimulate(ocrSchedulerHeuristic_t *self, ocrSchedule
 }
 
 u8 ceSchedulerHeuristicTransactInvoke(ocrSchedulerHeuristic_t *self, ocrSchedulerOpArgs_t *opArgs, ocrRuntimeHint_t *hints) {
-    ASSERT(0);
+    ASSERT(((ocrSchedulerOpTransactArgs_t*)opArgs)->properties == OCR_TRANSACT_PROP_BATCH);
     return OCR_ENOTSUP;
 }
 
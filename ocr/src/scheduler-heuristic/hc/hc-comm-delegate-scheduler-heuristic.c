@@ -409,7 +409,7 @@ static u8 hcCommDelegateSchedulerHeuristicNotifySimulate(ocrSchedulerHeuristic_t
 }
 
 static u8 hcCommDelegateSchedulerHeuristicTransactInvoke(ocrSchedulerHeuristic_t *self, ocrSchedulerOpArgs_t *opArgs, ocrRuntimeHint_t *hints) {
-    ASSERT(0);
+    ASSERT(((ocrSchedulerOpTransactArgs_t*)opArgs)->properties == OCR_TRANSACT_PROP_BATCH);
     return OCR_ENOTSUP;
 }
 
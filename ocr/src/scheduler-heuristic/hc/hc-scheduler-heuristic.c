@@ -18,6 +18,14 @@
 #include "ocr-workpile.h"
 #include "ocr-scheduler-object.h"
 #include "scheduler-heuristic/hc/hc-scheduler-heuristic.h"
+#ifdef ENABLE_WORKER_HC
+#include "worker/hc/hc-worker.h"
+#endif
+#ifdef ENABLE_COMP_PLATFORM_PTHREAD
+#include "comp-platform/pthread/pthread-comp-platform.h"
+#endif
+
+#define DEBUG_TYPE SCHEDULER_HEURISTIC
 
 /******************************************************/
 /* OCR-HC SCHEDULER_HEURISTIC                         */
@@ -26,6 +34,11 @@
 ocrSchedulerHeuristic_t* newSchedulerHeuristicHc(ocrSchedulerHeuristicFactory_t * factory, ocrParamList_t *perInstance) {
     ocrSchedulerHeuristic_t* self = (ocrSchedulerHeuristic_t*) runtimeChunkAlloc(sizeof(ocrSchedulerHeuristicHc_t), PERSISTENT_CHUNK);
     initializeSchedulerHeuristicOcr(factory, self, perInstance);
+    ocrSchedulerHeuristicHc_t *dself = (ocrSchedulerHeuristicHc_t*)self;
+    paramListSchedulerHeuristicHc_t *params = (paramListSchedulerHeuristicHc_t*)perInstance;
+    dself->stealVictim = params->stealVictim;
+    dself->stealBatch = params->stealBatch;
+    dself->workersPerSocket = params->workersPerSocket;
     return self;
 }
 
@@ -38,9 +51,80 @@ static void initializeContextHc(ocrSchedulerHeuristicContext_t *context, u64 con
     ocrSchedulerHeuristicContextHc_t *hcContext = (ocrSchedulerHeuristicContextHc_t*)context;
     hcContext->stealSchedulerObjectIndex = ((u64)-1);
     hcContext->mySchedulerObject = NULL;
+    hcContext->victims = NULL;
+    hcContext->randState = (contextId + 1) * 0x9E3779B97F4A7C15ULL;
+    hcContext->socket = 0;
     return;
 }
 
+// Assigns a socket to each context for HC_STEAL_VICTIM_LOCALITY. The socket is the
+// one the machine description gives for the worker's comp-platform ('socket' key)
+// or else the physical package of the CPU the worker is bound to. If that is unknown
+// for any worker, contexts are instead grouped by consecutive worker ids into sockets
+// of 'workersPerSocket' (which matches the block binding of the config generator).
+static void hcResolveSockets(ocrSchedulerHeuristicHc_t *dself, ocrPolicyDomain_t *PD) {
+    u32 count = dself->base.contextCount;
+    u32 i;
+    bool fromTopology = false;
+#ifdef ENABLE_COMP_PLATFORM_PTHREAD
+    fromTopology = true;
+    for (i = 0; fromTopology && (i < count); i++) {
+        ocrWorker_t *worker = PD->workers[i];
+        s32 socket = -1;
+        if ((worker->computeCount > 0) && (worker->computes[0]->platformCount > 0)) {
+            ocrCompPlatformPthread_t *platform = (ocrCompPlatformPthread_t*)worker->computes[0]->platforms[0];
+            socket = platform->socket;
+            if ((socket < 0) && (platform->binding >= 0))
+                socket = hal_cpuPackage((u32)platform->binding);
+        }
+        if (socket < 0) {
+            fromTopology = false;
+        } else {
+            ((ocrSchedulerHeuristicContextHc_t*)dself->base.contexts[worker->id])->socket = (u32)socket;
+        }
+    }
+#endif
+    if (fromTopology)
+        return;
+    DPRINTF(DEBUG_LVL_INFO, "Steal locality: topology unknown, using workerspersocket=%"PRIu32"\n", dself->workersPerSocket);
+    u32 perSocket = (dself->workersPerSocket == 0) ? count : dself->workersPerSocket;
+    for (i = 0; i < count; i++) {
+        ((ocrSchedulerHeuristicContextHc_t*)dself->base.contexts[i])->socket = i / perSocket;
+    }
+}
+
+// Distance between two contexts when stealing with HC_STEAL_VICTIM_LOCALITY.
+// The socket distance dominates; within a distance, victims are visited in
+// round-robin order starting from the thief's neighbor to spread thieves out.
+static u64 hcVictimDistance(ocrSchedulerHeuristicHc_t *dself, u32 thief, u32 victim) {
+    u32 count = dself->base.contextCount;
+    u32 thiefSocket = ((ocrSchedulerHeuristicContextHc_t*)dself->base.contexts[thief])->socket;
+    u32 victimSocket = ((ocrSchedulerHeuristicContextHc_t*)dself->base.contexts[victim])->socket;
+    u64 socketDist = (thiefSocket > victimSocket) ? (thiefSocket - victimSocket) : (victimSocket - thiefSocket);
+    return (socketDist * count) + ((victim + count - thief) % count);
+}
+
+// Builds the ordered list of victims of 'context'
+static void hcBuildVictims(ocrSchedulerHeuristicHc_t *dself, ocrSchedulerHeuristicContextHc_t *hcContext) {
+    u32 count = dself->base.contextCount;
+    u32 thief = (u32)hcContext->base.id;
+    u32 i, j;
+    for (i = 1; i < count; i++) {
+        hcContext->victims[i-1] = (thief + i) % count;
+    }
+    if (dself->stealVictim != HC_STEAL_VICTIM_LOCALITY)
+        return;
+    // Insertion sort, only done once at bring-up
+    for (i = 1; i < (count - 1); i++) {
+        u32 victim = hcContext->victims[i];
+        u64 dist = hcVictimDistance(dself, thief, victim);
+        for (j = i; (j > 0) && (hcVictimDistance(dself, thief, hcContext->victims[j-1]) > dist); j--) {
+            hcContext->victims[j] = hcContext->victims[j-1];
+        }
+        hcContext->victims[j] = victim;
+    }
+}
+
 u8 hcSchedulerHeuristicSwitchRunlevel(ocrSchedulerHeuristic_t *self, ocrPolicyDomain_t *PD, ocrRunlevel_t runlevel,
                                       phase_t phase, u32 properties, void (*callback)(ocrPolicyDomain_t*, u64), u64 val) {
 
@@ -74,6 +158,11 @@ u8 hcSchedulerHeuristicSwitchRunlevel(ocrSchedulerHeuristic_t *self, ocrPolicyDo
             u32 i;
             self->contexts = (ocrSchedulerHeuristicContext_t **)PD->fcts.pdMalloc(PD, self->contextCount * sizeof(ocrSchedulerHeuristicContext_t*));
             ocrSchedulerHeuristicContextHc_t *contextAlloc = (ocrSchedulerHeuristicContextHc_t *)PD->fcts.pdMalloc(PD, self->contextCount * sizeof(ocrSchedulerHeuristicContextHc_t));
+            u32 victimCount = self->contextCount - 1;
+            u32 *victimAlloc = NULL;
+            if (victimCount > 0) {
+                victimAlloc = (u32 *)PD->fcts.pdMalloc(PD, self->contextCount * victimCount * sizeof(u32));
+            }
             for (i = 0; i < self->contextCount; i++) {
                 ocrSchedulerHeuristicContext_t *context = (ocrSchedulerHeuristicContext_t *)&(contextAlloc[i]);
                 initializeContextHc(context, i);
@@ -86,9 +175,13 @@ u8 hcSchedulerHeuristicSwitchRunlevel(ocrSchedulerHeuristic_t *self, ocrPolicyDo
                 ocrSchedulerHeuristicContextHc_t *hcContext = (ocrSchedulerHeuristicContextHc_t*)context;
                 hcContext->stealSchedulerObjectIndex = ((u64)-1);
                 hcContext->mySchedulerObject = NULL;
+                hcContext->victims = (victimAlloc == NULL) ? NULL : &(victimAlloc[i * victimCount]);
             }
         }
         if((properties & RL_TEAR_DOWN) && RL_IS_LAST_PHASE_DOWN(PD, RL_MEMORY_OK, phase)) {
+            ocrSchedulerHeuristicContextHc_t *hcContext = (ocrSchedulerHeuristicContextHc_t*)self->contexts[0];
+            if (hcContext->victims != NULL)
+                PD->fcts.pdFree(PD, hcContext->victims);
             PD->fcts.pdFree(PD, self->contexts[0]);
             PD->fcts.pdFree(PD, self->contexts);
         }
@@ -102,11 +195,17 @@ u8 hcSchedulerHeuristicSwitchRunlevel(ocrSchedulerHeuristic_t *self, ocrPolicyDo
             u32 i;
             ocrSchedulerObject_t *rootObj = self->scheduler->rootObj;
             ocrSchedulerObjectFactory_t *rootFact = PD->schedulerObjectFactories[rootObj->fctId];
+            if (((ocrSchedulerHeuristicHc_t*)self)->stealVictim == HC_STEAL_VICTIM_LOCALITY)
+                hcResolveSockets((ocrSchedulerHeuristicHc_t*)self, PD);
             for (i = 0; i < self->contextCount; i++) {
                 ocrSchedulerHeuristicContextHc_t *hcContext = (ocrSchedulerHeuristicContextHc_t*)self->contexts[i];
                 hcContext->mySchedulerObject = rootFact->fcts.getSchedulerObjectForLocation(rootFact, rootObj, OCR_SCHEDULER_OBJECT_DEQUE, i, OCR_SCHEDULER_OBJECT_MAPPING_WORKER, 0);
                 ASSERT(hcContext->mySchedulerObject);
                 hcContext->stealSchedulerObjectIndex = (i + 1) % self->contextCount;
+                if (hcContext->victims != NULL) {
+                    hcBuildVictims((ocrSchedulerHeuristicHc_t*)self, hcContext);
+                    hcContext->stealSchedulerObjectIndex = hcContext->victims[0];
+                }
             }
         }
         break;
@@ -135,8 +234,52 @@ ocrSchedulerHeuristicContext_t* hcSchedulerHeuristicGetContext(ocrSchedulerHeuri
     return self->contexts[worker->id];
 }
 
-/* Find EDT for the worker to execute - This uses random workstealing to find work if no work is found owned deque */
+// Returns the context id of the 'attempt'-th victim of a steal sweep
+static u32 hcNextVictim(ocrSchedulerHeuristicHc_t *dself, ocrSchedulerHeuristicContextHc_t *hcContext, u32 attempt) {
+    if (dself->stealVictim == HC_STEAL_VICTIM_RANDOM) {
+        // xorshift64
+        u64 x = hcContext->randState;
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        hcContext->randState = x;
+        u32 count = dself->base.contextCount;
+        return (u32)((hcContext->base.id + 1 + (x % (count - 1))) % count);
+    }
+    return hcContext->victims[attempt];
+}
+
+// Steal from the deque of context 'victimId'. In HC_STEAL_BATCH_HALF mode, up to half
+// of the victim's EDTs are moved: the first one is returned in 'edtObj' and the others
+// are pushed in the thief's own deque.
+static u8 hcStealFrom(ocrSchedulerHeuristicHc_t *dself, ocrSchedulerHeuristicContextHc_t *hcContext, u64 victimId, ocrSchedulerObject_t *edtObj) {
+    ocrSchedulerObject_t *stealSchedulerObject = ((ocrSchedulerHeuristicContextHc_t*)dself->base.contexts[victimId])->mySchedulerObject;
+    if (stealSchedulerObject == NULL)
+        return 1;
+    ocrSchedulerObjectFactory_t *fact = dself->base.scheduler->pd->schedulerObjectFactories[stealSchedulerObject->fctId];
+    u8 retVal = fact->fcts.remove(fact, stealSchedulerObject, OCR_SCHEDULER_OBJECT_EDT, 1, edtObj, NULL, SCHEDULER_OBJECT_REMOVE_HEAD);
+    if ((dself->stealBatch != HC_STEAL_BATCH_HALF) || ocrGuidIsNull(edtObj->guid.guid))
+        return retVal;
+
+    // The victim is only sized once the steal succeeded so that failed attempts,
+    // which dominate when work is scarce, do not pay for a scan of the deque.
+    u64 available = fact->fcts.count(fact, stealSchedulerObject, SCHEDULER_OBJECT_COUNT_EDT) + 1;
+    if (available < 4)
+        return retVal;
+
+    // Move the rest of the batch straight into the thief's deque. Elements are
+    // still taken one CAS at a time on the victim's head: a single multi-element
+    // CAS would race with the owner popping from the tail.
+    u64 batch = available / 2;
+    if (batch > HC_STEAL_HALF_MAX)
+        batch = HC_STEAL_HALF_MAX;
+    fact->fcts.remove(fact, stealSchedulerObject, OCR_SCHEDULER_OBJECT_EDT, (u32)(batch - 1), hcContext->mySchedulerObject, NULL, SCHEDULER_OBJECT_REMOVE_HEAD);
+    return retVal;
+}
+
+/* Find EDT for the worker to execute - This uses workstealing to find work if no work is found owned deque */
 static u8 hcSchedulerHeuristicWorkEdtUserInvoke(ocrSchedulerHeuristic_t *self, ocrSchedulerHeuristicContext_t *context, ocrSchedulerOpArgs_t *opArgs, ocrRuntimeHint_t *hints) {
+    ocrSchedulerHeuristicHc_t *dself = (ocrSchedulerHeuristicHc_t*)self;
     ocrSchedulerOpWorkArgs_t *taskArgs = (ocrSchedulerOpWorkArgs_t*)opArgs;
     ocrSchedulerObject_t edtObj;
     edtObj.guid.guid = NULL_GUID;
@@ -154,21 +297,16 @@ static u8 hcSchedulerHeuristicWorkEdtUserInvoke(ocrSchedulerHeuristic_t *self, o
     if (ocrGuidIsNull(edtObj.guid.guid)) {
 
         //First try to steal from the last deque that was visited (probably had a successful steal)
-        ocrSchedulerObject_t *stealSchedulerObject = ((ocrSchedulerHeuristicContextHc_t*)self->contexts[hcContext->stealSchedulerObjectIndex])->mySchedulerObject;
-        ASSERT(stealSchedulerObject);
-        retVal = fact->fcts.remove(fact, stealSchedulerObject, OCR_SCHEDULER_OBJECT_EDT, 1, &edtObj, NULL, SCHEDULER_OBJECT_REMOVE_HEAD); //try cached deque first
+        retVal = hcStealFrom(dself, hcContext, hcContext->stealSchedulerObjectIndex, &edtObj); //try cached deque first
 
-        //If cached steal failed, then restart steal loop from starting index
+        //If cached steal failed, then sweep the victims as long as there's work in the system
         ocrSchedulerObject_t *rootObj = self->scheduler->rootObj;
         ocrSchedulerObjectFactory_t *sFact = self->scheduler->pd->schedulerObjectFactories[rootObj->fctId];
         while (ocrGuidIsNull(edtObj.guid.guid) && sFact->fcts.count(sFact, rootObj, (SCHEDULER_OBJECT_COUNT_EDT | SCHEDULER_OBJECT_COUNT_RECURSIVE) ) != 0) {
             u32 i;
             for (i = 1; ocrGuidIsNull(edtObj.guid.guid) && i < self->contextCount; i++) {
-                hcContext->stealSchedulerObjectIndex = (context->id + i) % self->contextCount; //simple round robin stealing
-                stealSchedulerObject = ((ocrSchedulerHeuristicContextHc_t*)self->contexts[hcContext->stealSchedulerObjectIndex])->mySchedulerObject;
-                if (stealSchedulerObject){
-                    retVal = fact->fcts.remove(fact, stealSchedulerObject, OCR_SCHEDULER_OBJECT_EDT, 1, &edtObj, NULL, SCHEDULER_OBJECT_REMOVE_HEAD);
-                }
+                hcContext->stealSchedulerObjectIndex = hcNextVictim(dself, hcContext, i - 1);
+                retVal = hcStealFrom(dself, hcContext, hcContext->stealSchedulerObjectIndex, &edtObj);
             }
         }
     }
@@ -218,7 +356,13 @@ static u8 hcSchedulerHeuristicNotifyEdtReadyInvoke(ocrSchedulerHeuristic_t *self
     ocrGuid_t taskGuid = notifyArgs->OCR_SCHED_ARG_FIELD(OCR_SCHED_NOTIFY_EDT_READY).guid.guid;
     OCR_TOOL_TRACE(false, OCR_TRACE_TYPE_EDT, OCR_ACTION_SCHEDULED, taskGuid, schedObj);
 #endif
-    return fact->fcts.insert(fact, schedObj, &edtObj, NULL, (SCHEDULER_OBJECT_INSERT_AFTER | SCHEDULER_OBJECT_INSERT_POSITION_TAIL));
+    u8 retCode = fact->fcts.insert(fact, schedObj, &edtObj, NULL, (SCHEDULER_OBJECT_INSERT_AFTER | SCHEDULER_OBJECT_INSERT_POSITION_TAIL));
+#ifdef ENABLE_WORKER_HC
+    // One new EDT: wake up at most one parked worker to steal it
+    if(retCode == 0)
+        hcWorkerWakeIdle(self->scheduler->pd, 1);
+#endif
+    return retCode;
 }
 
 u8 hcSchedulerHeuristicNotifyInvoke(ocrSchedulerHeuristic_t *self, ocrSchedulerOpArgs_t *opArgs, ocrRuntimeHint_t *hints) {
@@ -278,8 +422,31 @@ u8 hcSchedulerHeuristicNotifySimulate(ocrSchedulerHeuristic_t *self, ocrSchedule
 }
 
 u8 hcSchedulerHeuristicTransactInvoke(ocrSchedulerHeuristic_t *self, ocrSchedulerOpArgs_t *opArgs, ocrRuntimeHint_t *hints) {
-    ASSERT(0);
-    return OCR_ENOTSUP;
+    ocrSchedulerOpTransactArgs_t *transactArgs = (ocrSchedulerOpTransactArgs_t*)opArgs;
+    if (transactArgs->properties != OCR_TRANSACT_PROP_BATCH) {
+        ASSERT(0);
+        return OCR_ENOTSUP;
+    }
+    // Equivalent to one EDT_READY notify per EDT in the batch
+    ocrSchedulerHeuristicContext_t *context = self->fcts.getContext(self, opArgs->location);
+    ocrSchedulerHeuristicContextHc_t *hcContext = (ocrSchedulerHeuristicContextHc_t*)context;
+    ocrSchedulerObject_t *schedObj = hcContext->mySchedulerObject;
+    ASSERT(schedObj);
+    ocrSchedulerObjectFactory_t *fact = self->scheduler->pd->schedulerObjectFactories[schedObj->fctId];
+    ocrSchedulerObject_t edtObj;
+    edtObj.kind = OCR_SCHEDULER_OBJECT_EDT;
+    u32 i, count = transactArgs->guidCount;
+    for (i = 0; i < count; ++i) {
+        edtObj.guid = transactArgs->guids[i];
+#ifdef OCR_MONITOR_SCHEDULER
+        OCR_TOOL_TRACE(false, OCR_TRACE_TYPE_EDT, OCR_ACTION_SCHEDULED, edtObj.guid.guid, schedObj);
+#endif
+        RESULT_ASSERT(fact->fcts.insert(fact, schedObj, &edtObj, NULL, (SCHEDULER_OBJECT_INSERT_AFTER | SCHEDULER_OBJECT_INSERT_POSITION_TAIL)), ==, 0);
+    }
+#ifdef ENABLE_WORKER_HC
+    hcWorkerWakeIdle(self->scheduler->pd, count);
+#endif
+    return 0;
 }
 
 u8 hcSchedulerHeuristicTransactSimulate(ocrSchedulerHeuristic_t *self, ocrSchedulerHeuristicContext_t *context, ocrSchedulerOpArgs_t *opArgs, ocrRuntimeHint_t *hints) {
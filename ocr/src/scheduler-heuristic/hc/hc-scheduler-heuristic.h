@@ -19,11 +19,34 @@
 /* HC SCHEDULER_HEURISTIC                           */
 /****************************************************/
 
+#ifndef HC_STEAL_HALF_MAX
+// Maximum number of EDTs a steal-half operation moves at once
+#define HC_STEAL_HALF_MAX 32
+#endif
+
+// How a thief picks the deques it tries to steal from
+typedef enum {
+    HC_STEAL_VICTIM_ROUND_ROBIN = 0,    // Start at the thief's neighbor and go round robin
+    HC_STEAL_VICTIM_RANDOM      = 1,    // Uniformly random victim on each attempt
+    HC_STEAL_VICTIM_LOCALITY    = 2,    // Victims in the thief's socket first, then by increasing socket distance.
+                                        // Sockets come from the OS topology of the workers' bound CPUs; if
+                                        // that is not available, 'workerspersocket' is used instead
+} hcStealVictim_t;
+
+// How much work a successful steal takes from the victim
+typedef enum {
+    HC_STEAL_BATCH_ONE  = 0,            // A single EDT
+    HC_STEAL_BATCH_HALF = 1,            // Up to half of the victim's EDTs (bounded by HC_STEAL_HALF_MAX)
+} hcStealBatch_t;
+
 // Cached information about context
 typedef struct _ocrSchedulerHeuristicContextHc_t {
     ocrSchedulerHeuristicContext_t base;
     ocrSchedulerObject_t *mySchedulerObject;    // The deque owned by a specific worker (context)
     u64 stealSchedulerObjectIndex;        // Cached index of the deque lasted visited during steal attempts
+    u32 *victims;                         // Ordered victim context ids (contextCount-1 entries)
+    u64 randState;                        // Seed for random victim selection
+    u32 socket;                           // Socket of the worker (HC_STEAL_VICTIM_LOCALITY)
 #if 0 // Example fields for simulation mode
     ocrSchedulerObjectActionSet_t singleActionSet;
     ocrSchedulerObjectAction_t insertAction;
@@ -33,6 +56,10 @@ typedef struct _ocrSchedulerHeuristicContextHc_t {
 
 typedef struct _ocrSchedulerHeuristicHc_t {
     ocrSchedulerHeuristic_t base;
+    hcStealVictim_t stealVictim;
+    hcStealBatch_t stealBatch;
+    u32 workersPerSocket;                 // Fallback socket size for HC_STEAL_VICTIM_LOCALITY when
+                                          // the topology is unknown (0: single socket)
 } ocrSchedulerHeuristicHc_t;
 
 /****************************************************/
@@ -41,6 +68,9 @@ typedef struct _ocrSchedulerHeuristicHc_t {
 
 typedef struct _paramListSchedulerHeuristicHc_t {
     paramListSchedulerHeuristic_t base;
+    hcStealVictim_t stealVictim;
+    hcStealBatch_t stealBatch;
+    u32 workersPerSocket;
 } paramListSchedulerHeuristicHc_t;
 
 typedef struct _ocrSchedulerHeuristicFactoryHc_t {
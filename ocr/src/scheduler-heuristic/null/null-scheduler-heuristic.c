@@ -100,7 +100,7 @@ u8 nullSchedulerHeuristicNotifySimulate(ocrSchedulerHeuristic_t *self, ocrSchedu
 }
 
 u8 nullSchedulerHeuristicTransactInvoke(ocrSchedulerHeuristic_t *self, ocrSchedulerOpArgs_t *opArgs, ocrRuntimeHint_t *hints) {
-    ASSERT(0);
+    ASSERT(((ocrSchedulerOpTransactArgs_t*)opArgs)->properties == OCR_TRANSACT_PROP_BATCH);
     return OCR_ENOTSUP;
 }
 
@@ -247,7 +247,7 @@ static u8 placerAffinitySchedHeuristicNotifySimulate(ocrSchedulerHeuristic_t *se
 }
 
 static u8 placerAffinitySchedHeuristicTransactInvoke(ocrSchedulerHeuristic_t *self, ocrSchedulerOpArgs_t *opArgs, ocrRuntimeHint_t *hints) {
-    ASSERT(0);
+    ASSERT(((ocrSchedulerOpTransactArgs_t*)opArgs)->properties == OCR_TRANSACT_PROP_BATCH);
     return OCR_ENOTSUP;
 }
 
@@ -251,7 +251,7 @@ u8 prioritySchedulerHeuristicNotifySimulate(ocrSchedulerHeuristic_t *self, ocrSc
 }
 
 u8 prioritySchedulerHeuristicTransactInvoke(ocrSchedulerHeuristic_t *self, ocrSchedulerOpArgs_t *opArgs, ocrRuntimeHint_t *hints) {
-    ASSERT(0);
+    ASSERT(((ocrSchedulerOpTransactArgs_t*)opArgs)->properties == OCR_TRANSACT_PROP_BATCH);
     return OCR_ENOTSUP;
 }
 
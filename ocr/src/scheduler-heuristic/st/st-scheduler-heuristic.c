@@ -1916,6 +1916,8 @@ static u8 stSchedulerHeuristicTransactDb(ocrSchedulerHeuristic_t *self, ocrSched
 u8 stSchedulerHeuristicTransactInvoke(ocrSchedulerHeuristic_t *self, ocrSchedulerOpArgs_t *opArgs, ocrRuntimeHint_t *hints) {
     ocrSchedulerHeuristicContext_t *context = self->fcts.getContext(self, opArgs->location);
     ocrSchedulerOpTransactArgs_t *transactArgs = (ocrSchedulerOpTransactArgs_t*)opArgs;
+    if (transactArgs->properties == OCR_TRANSACT_PROP_BATCH)
+        return OCR_ENOTSUP;
     ASSERT(transactArgs->properties == OCR_TRANSACT_PROP_TRANSFER);
     ocrSchedulerObjectKind kind = transactArgs->schedObj.kind;
     switch(kind) {
@@ -436,7 +436,7 @@ u8 staticSchedulerHeuristicNotifySimulate(ocrSchedulerHeuristic_t *self, ocrSche
 }
 
 u8 staticSchedulerHeuristicTransactInvoke(ocrSchedulerHeuristic_t *self, ocrSchedulerOpArgs_t *opArgs, ocrRuntimeHint_t *hints) {
-    ASSERT(0);
+    ASSERT(((ocrSchedulerOpTransactArgs_t*)opArgs)->properties == OCR_TRANSACT_PROP_BATCH);
     return OCR_ENOTSUP;
 }
 
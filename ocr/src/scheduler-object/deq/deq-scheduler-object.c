@@ -114,6 +114,7 @@ u8 deqSchedulerObjectRemove(ocrSchedulerObjectFactory_t *fact, ocrSchedulerObjec
 
     for (i = 0; i < count; i++) {
         ocrGuid_t retGuid = NULL_GUID;
+        ocrTask_t *popTask = NULL;
         switch(properties) {
         case SCHEDULER_OBJECT_REMOVE_TAIL:
             {
@@ -121,7 +122,7 @@ u8 deqSchedulerObjectRemove(ocrSchedulerObjectFactory_t *fact, ocrSchedulerObjec
 
                 void *popVal = deq->popFromTail(deq, 0);
                 if(popVal != NULL){
-                    ocrTask_t *popTask = (ocrTask_t *)popVal;
+                    popTask = (ocrTask_t *)popVal;
                     retGuid = popTask->guid;
                 }
 
@@ -134,7 +135,7 @@ u8 deqSchedulerObjectRemove(ocrSchedulerObjectFactory_t *fact, ocrSchedulerObjec
 
                 void *popVal = deq->popFromHead(deq, 1);
                 if(popVal != NULL){
-                    ocrTask_t *popTask = (ocrTask_t *)popVal;
+                    popTask = (ocrTask_t *)popVal;
                     retGuid = popTask->guid;
                 }
 
@@ -154,6 +155,7 @@ u8 deqSchedulerObjectRemove(ocrSchedulerObjectFactory_t *fact, ocrSchedulerObjec
         } else {
             ocrSchedulerObject_t taken;
             taken.guid.guid = retGuid;
+            taken.guid.metaDataPtr = popTask;
             taken.kind = kind;
             ocrSchedulerObjectFactory_t *dstFactory = fact->pd->schedulerObjectFactories[dst->fctId];
             dstFactory->fcts.insert(dstFactory, dst, &taken, NULL, 0);
@@ -414,6 +414,12 @@ u8 hcSchedulerNotifyInvoke(ocrScheduler_t *self, ocrSchedulerOpArgs_t *opArgs, o
 }
 
 u8 hcSchedulerTransactInvoke(ocrScheduler_t *self, ocrSchedulerOpArgs_t *opArgs, ocrRuntimeHint_t *hints) {
+    ocrSchedulerOpTransactArgs_t *transactArgs = (ocrSchedulerOpTransactArgs_t*)opArgs;
+    if (transactArgs->properties == OCR_TRANSACT_PROP_BATCH) {
+        // Same as one EDT_READY notify per EDT
+        u32 count = transactArgs->guidCount;
+        return self->fcts.giveEdt(self, &count, transactArgs->guids);
+    }
     return OCR_ENOTSUP;
 }
 
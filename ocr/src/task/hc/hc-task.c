@@ -201,7 +201,8 @@ ocrTaskTemplateFactory_t * newTaskTemplateFactoryHc(ocrParamList_t* perType, u32
 /* OCR HC latch utilities                             */
 /******************************************************/
 
-// satisfies the incr slot of a finish latch event
+// satisfies the incr slot of a finish latch event and links the
+// source event, if any, to its decr slot
 static u8 finishLatchCheckin(ocrPolicyDomain_t *pd, ocrPolicyMsg_t *msg,
                              ocrFatGuid_t edtCheckin, ocrFatGuid_t sourceEvent, ocrFatGuid_t latchEvent) {
 #define PD_MSG (msg)
@@ -226,20 +227,65 @@ static u8 finishLatchCheckin(ocrPolicyDomain_t *pd, ocrPolicyMsg_t *msg,
     PD_MSG_FIELD_I(properties) = 0;
     RESULT_PROPAGATE(pd->fcts.processMessage(pd, msg, false));
 #undef PD_TYPE
-    // Tie the local latch event for this EDT's finish scope to its parent finish scope.
-    // All of the current EDT children will report to the local finish scope and when the
-    // local finish scope completes, it will notify the parent finish scope.
+    // Without a source event, the EDT checks out of the latch when it completes
+    // (see finishLatchCheckout)
+    if (!(ocrGuidIsNull(sourceEvent.guid))) {
+        // Tie the local latch event for this EDT's finish scope to its parent finish scope.
+        // All of the current EDT children will report to the local finish scope and when the
+        // local finish scope completes, it will notify the parent finish scope.
 #define PD_TYPE PD_MSG_DEP_ADD
-    msg->type = PD_MSG_DEP_ADD | PD_MSG_REQUEST;
-    PD_MSG_FIELD_IO(properties) = DB_MODE_CONST; // not called from add-dependence
-    PD_MSG_FIELD_I(source) = sourceEvent;
-    PD_MSG_FIELD_I(dest) = latchEvent;
-    PD_MSG_FIELD_I(slot) = OCR_EVENT_LATCH_DECR_SLOT;
-    PD_MSG_FIELD_I(currentEdt.guid) = NULL_GUID;
-    PD_MSG_FIELD_I(currentEdt.metaDataPtr) = NULL;
-    RESULT_PROPAGATE(pd->fcts.processMessage(pd, msg, false));
+        msg->type = PD_MSG_DEP_ADD | PD_MSG_REQUEST;
+        PD_MSG_FIELD_IO(properties) = DB_MODE_CONST; // not called from add-dependence
+        PD_MSG_FIELD_I(source) = sourceEvent;
+        PD_MSG_FIELD_I(dest) = latchEvent;
+        PD_MSG_FIELD_I(slot) = OCR_EVENT_LATCH_DECR_SLOT;
+        PD_MSG_FIELD_I(currentEdt.guid) = NULL_GUID;
+        PD_MSG_FIELD_I(currentEdt.metaDataPtr) = NULL;
+        RESULT_PROPAGATE(pd->fcts.processMessage(pd, msg, false));
+#undef PD_TYPE
+    }
 #undef PD_MSG
+    return 0;
+}
+
+// satisfies the decr slot of a finish latch event on behalf of a completing EDT.
+// As with an output event, a GUID returned by the EDT defers the decrement until
+// it is satisfied.
+static u8 finishLatchCheckout(ocrPolicyDomain_t *pd, ocrPolicyMsg_t *msg,
+                              ocrTask_t *task, ocrGuid_t retGuid, ocrGuid_t latchGuid) {
+#define PD_MSG (msg)
+    if(!(ocrGuidIsNull(retGuid) || ocrGuidIsFailure(retGuid))) {
+#define PD_TYPE PD_MSG_DEP_ADD
+        msg->type = PD_MSG_DEP_ADD | PD_MSG_REQUEST;
+        PD_MSG_FIELD_I(source.guid) = retGuid;
+        PD_MSG_FIELD_I(source.metaDataPtr) = NULL;
+        PD_MSG_FIELD_I(dest.guid) = latchGuid;
+        PD_MSG_FIELD_I(dest.metaDataPtr) = NULL;
+        PD_MSG_FIELD_I(currentEdt.guid) = task->guid;
+        PD_MSG_FIELD_I(currentEdt.metaDataPtr) = task;
+        PD_MSG_FIELD_I(slot) = OCR_EVENT_LATCH_DECR_SLOT;
+        PD_MSG_FIELD_IO(properties) = DB_MODE_CONST;
+#undef PD_TYPE
+    } else {
+#define PD_TYPE PD_MSG_DEP_SATISFY
+        msg->type = PD_MSG_DEP_SATISFY | PD_MSG_REQUEST;
+        PD_MSG_FIELD_I(satisfierGuid.guid) = task->guid;
+        PD_MSG_FIELD_I(satisfierGuid.metaDataPtr) = task;
+        PD_MSG_FIELD_I(guid.guid) = latchGuid;
+        PD_MSG_FIELD_I(guid.metaDataPtr) = NULL;
+        PD_MSG_FIELD_I(payload.guid) = NULL_GUID;
+        PD_MSG_FIELD_I(payload.metaDataPtr) = NULL;
+        PD_MSG_FIELD_I(currentEdt.guid) = task->guid;
+        PD_MSG_FIELD_I(currentEdt.metaDataPtr) = task;
+        PD_MSG_FIELD_I(slot) = OCR_EVENT_LATCH_DECR_SLOT;
+#ifdef REG_ASYNC_SGL
+        PD_MSG_FIELD_I(mode) = -1; //Doesn't matter for latch
+#endif
+        PD_MSG_FIELD_I(properties) = 0;
 #undef PD_TYPE
+    }
+    RESULT_PROPAGATE(pd->fcts.processMessage(pd, msg, false));
+#undef PD_MSG
     return 0;
 }
 
@@ -328,7 +374,9 @@ static u8 initTaskHcInternal(ocrTaskHc_t *task, ocrPolicyDomain_t * pd,
             RESULT_PROPAGATE(finishLatchCheckin(pd, &msg, edtCheckin, latchFGuid, parentLatch));
         }
 
-        // Check in the current EDT into the new finish scope and link its outputEvent to the current finish latch
+        // Check in the current EDT into the new finish scope. A finish EDT has no
+        // output event of its own and checks out of the latch when it completes.
+        ASSERT(ocrGuidIsNull(outputEvent.guid));
         getCurrentEnv(NULL, NULL, NULL, &msg);
         DPRINTF(DEBUG_LVL_INFO, "Checkin "GUIDF" on self flatch "GUIDF"\n", GUIDA(task->base.guid), GUIDA(latchFGuid.guid));
         RESULT_PROPAGATE(finishLatchCheckin(pd, &msg, edtCheckin, outputEvent, latchFGuid));
@@ -437,21 +485,11 @@ static u8 iterateDbFrontier(ocrTask_t *self) {
 }
 
 /**
- * @brief Give the task to the scheduler
- * Warning: The caller must ensure all dependencies have been satisfied
- * Note: static function only meant to factorize code.
+ * @brief Notify the scheduler that a single task is ready
  */
-static u8 scheduleTask(ocrTask_t *self) {
-    DPRINTF(DEBUG_LVL_INFO, "Schedule "GUIDF"\n", GUIDA(self->guid));
-    self->state = ALLACQ_EDTSTATE;
-    ocrPolicyDomain_t *pd = NULL;
+static u8 notifyTaskReady(ocrPolicyDomain_t *pd, ocrTask_t *self) {
     PD_MSG_STACK(msg);
-    getCurrentEnv(&pd, NULL, NULL, &msg);
-
-#ifdef OCR_MONITOR_SCHEDULER
-    OCR_TOOL_TRACE(false, OCR_TRACE_TYPE_SCHEDULER, OCR_ACTION_SCHED_MSG_SEND, self->guid);
-#endif
-
+    getCurrentEnv(NULL, NULL, NULL, &msg);
 #define PD_MSG (&msg)
 #define PD_TYPE PD_MSG_SCHED_NOTIFY
     msg.type = PD_MSG_SCHED_NOTIFY | PD_MSG_REQUEST;
@@ -465,6 +503,72 @@ static u8 scheduleTask(ocrTask_t *self) {
     return 0;
 }
 
+u8 hcTaskFlushReadyBatch(ocrPolicyDomain_t * pd, ocrSchedReadyBatch_t * batch) {
+    u32 count = batch->count;
+    if (count == 0) {
+        return 0;
+    }
+    batch->count = 0;
+    if (count > 1) {
+        PD_MSG_STACK(msg);
+        getCurrentEnv(NULL, NULL, NULL, &msg);
+#define PD_MSG (&msg)
+#define PD_TYPE PD_MSG_SCHED_TRANSACT
+        msg.type = PD_MSG_SCHED_TRANSACT | PD_MSG_REQUEST | PD_MSG_REQ_RESPONSE;
+        // Not targeted at a specific heuristic: goes to the master one
+        PD_MSG_FIELD_IO(schedArgs).base.heuristicId = ((u32)-1);
+        PD_MSG_FIELD_IO(schedArgs).properties = OCR_TRANSACT_PROP_BATCH;
+        PD_MSG_FIELD_IO(schedArgs).schedObj.guid.guid = NULL_GUID;
+        PD_MSG_FIELD_IO(schedArgs).schedObj.guid.metaDataPtr = NULL;
+        PD_MSG_FIELD_IO(schedArgs).schedObj.kind = OCR_SCHEDULER_OBJECT_EDT;
+        PD_MSG_FIELD_IO(schedArgs).guids = batch->guids;
+        PD_MSG_FIELD_IO(schedArgs).guidCount = count;
+        PD_MSG_FIELD_I(properties) = 0;
+        RESULT_PROPAGATE(pd->fcts.processMessage(pd, &msg, true));
+        if (PD_MSG_FIELD_O(returnDetail) == 0) {
+            return 0;
+        }
+#undef PD_MSG
+#undef PD_TYPE
+    }
+    // Single EDT or the scheduler does not take batches: notify one by one
+    u32 i;
+    for (i = 0; i < count; ++i) {
+        RESULT_PROPAGATE(notifyTaskReady(pd, (ocrTask_t *) batch->guids[i].metaDataPtr));
+    }
+    return 0;
+}
+
+/**
+ * @brief Give the task to the scheduler
+ * Warning: The caller must ensure all dependencies have been satisfied
+ * Note: static function only meant to factorize code.
+ *
+ * If 'batch' is not NULL the task is appended to it and the caller
+ * hands the whole batch to the scheduler (see hcTaskFlushReadyBatch).
+ */
+static u8 scheduleTask(ocrTask_t *self, ocrSchedReadyBatch_t * batch) {
+    DPRINTF(DEBUG_LVL_INFO, "Schedule "GUIDF"\n", GUIDA(self->guid));
+    self->state = ALLACQ_EDTSTATE;
+    ocrPolicyDomain_t *pd = NULL;
+    getCurrentEnv(&pd, NULL, NULL, NULL);
+
+#ifdef OCR_MONITOR_SCHEDULER
+    OCR_TOOL_TRACE(false, OCR_TRACE_TYPE_SCHEDULER, OCR_ACTION_SCHED_MSG_SEND, self->guid);
+#endif
+
+    if (batch != NULL) {
+        if (batch->count == batch->max) {
+            RESULT_PROPAGATE(hcTaskFlushReadyBatch(pd, batch));
+        }
+        batch->guids[batch->count].guid = self->guid;
+        batch->guids[batch->count].metaDataPtr = self;
+        batch->count++;
+        return 0;
+    }
+    return notifyTaskReady(pd, self);
+}
+
 /**
  * @brief Give the fully satisfied task to the scheduler
  */
@@ -489,8 +593,11 @@ static u8 scheduleSatisfiedTask(ocrTask_t *self) {
  * @brief Dependences of the tasks have been satisfied
  * Warning: The caller must ensure all dependencies have been satisfied
  * Note: static function only meant to factorize code.
+ *
+ * If the task acquires all its DBs right away, it is scheduled through
+ * 'batch' (which may be NULL, see scheduleTask).
  */
-static u8 taskAllDepvSatisfied(ocrTask_t *self) {
+static u8 taskAllDepvSatisfied(ocrTask_t *self, ocrSchedReadyBatch_t * batch) {
     DPRINTF(DEBUG_LVL_INFO, "All dependences satisfied for task "GUIDF"\n", GUIDA(self->guid));
     OCR_TOOL_TRACE(false, OCR_TRACE_TYPE_EDT, OCR_ACTION_RUNNABLE, traceTaskRunnable, self->guid);
     // Now check if there's anything to do before scheduling
@@ -524,7 +631,7 @@ static u8 taskAllDepvSatisfied(ocrTask_t *self) {
         //TODO: Keeping this here for 0.9 compatibility but
         //iterateDbFrontier and related code will eventually
         //move to the scheduler.
-        scheduleTask(self);
+        scheduleTask(self, batch);
     }
     return 0;
 }
@@ -669,14 +776,11 @@ u8 newTaskHc(ocrTaskFactory_t* factory, ocrFatGuid_t * edtGuid, ocrFatGuid_t edt
     u32 i;
     getCurrentEnv(&pd, NULL, &curTask, NULL);
     ocrFatGuid_t outputEvent = {.guid = NULL_GUID, .metaDataPtr = NULL};
-    // We need an output event for the EDT if either:
-    //  - the user requested one (outputEventPtr is non NULL)
-    //  - the EDT is a finish EDT (and therefore we need to link
-    //    the output event to the latch event)
-    //  - the EDT is within a finish scope (and we need to link to
-    //    that latch event)
-    if (outputEventPtr != NULL || hasProperty(properties, EDT_PROP_FINISH) ||
-            !(ocrGuidIsNull(parentLatch.guid))) {
+    // We need an output event for the EDT only if the user requested one
+    // (outputEventPtr is non NULL) and the EDT is not a finish EDT (the user
+    // then gets the finish latch). EDTs in a finish scope check in and out
+    // of their latch directly, unless the output event is linked to it.
+    if ((outputEventPtr != NULL) && !hasProperty(properties, EDT_PROP_FINISH)) {
         PD_MSG_STACK(msg);
         getCurrentEnv(NULL, NULL, NULL, &msg);
 #define PD_MSG (&msg)
@@ -829,7 +933,7 @@ u8 newTaskHc(ocrTaskFactory_t* factory, ocrFatGuid_t * edtGuid, ocrFatGuid_t edt
     if(base->depc == edt->slotSatisfiedCount) {
         DPRINTF(DEBUG_LVL_INFO,
                 "Scheduling task "GUIDF" due to initial satisfactions\n", GUIDA(base->guid));
-        RESULT_PROPAGATE2(taskAllDepvSatisfied(base), 1);
+        RESULT_PROPAGATE2(taskAllDepvSatisfied(base, NULL), 1);
     }
 
     return 0;
@@ -863,20 +967,21 @@ u8 dependenceResolvedTaskHc(ocrTask_t * self, ocrGuid_t dbGuid, void * localDbPt
         rself->resolvedDeps[rself->signalers[rself->frontierSlot-1].slot].ptr = localDbPtr;
     }
     if (!iterateDbFrontier(self)) {
-        scheduleTask(self);
+        scheduleTask(self, NULL);
     }
     return 0;
 }
 
 #ifdef REG_ASYNC_SGL
-u8 satisfyTaskHcWithMode(ocrTask_t * base, ocrFatGuid_t data, u32 slot, ocrDbAccessMode_t mode) {
+u8 hcTaskSatisfyBatched(ocrTask_t * base, ocrFatGuid_t data, u32 slot, ocrDbAccessMode_t mode,
+                        ocrSchedReadyBatch_t * batch) {
     ASSERT (((!ocrGuidIsNull(data.guid)) ? (mode != -1) : 1) && "Mode should alway be provided");
     ASSERT(!ocrGuidIsUninitialized(data.guid) && !ocrGuidIsError(data.guid));
     ASSERT((slot >= 0) && (slot < base->depc));
     ocrTaskHc_t * self = (ocrTaskHc_t *) base;
     self->signalers[slot].guid = data.guid;
     self->signalers[slot].mode = mode;
-    hal_fence();
+    hal_fenceRelease();
     u32 oldValue = hal_xadd32(&(self->slotSatisfiedCount), 1);
 
 #ifdef REG_ASYNC_SGL_DEBUG
@@ -888,11 +993,15 @@ u8 satisfyTaskHcWithMode(ocrTask_t * base, ocrFatGuid_t data, u32 slot, ocrDbAcc
 #endif
         // All dependences known
         ASSERT(self->slotSatisfiedCount = base->depc);
-        taskAllDepvSatisfied(base);
+        taskAllDepvSatisfied(base, batch);
     }
     return 0;
 }
 
+u8 satisfyTaskHcWithMode(ocrTask_t * base, ocrFatGuid_t data, u32 slot, ocrDbAccessMode_t mode) {
+    return hcTaskSatisfyBatched(base, data, slot, mode, NULL);
+}
+
 u8 satisfyTaskHc(ocrTask_t * base, ocrFatGuid_t data, u32 slot) {
     ASSERT(false && "mode required for satisfy in REG_ASYNC_SGL");
     return 0;
@@ -908,7 +1017,7 @@ u8 registerSignalerTaskHc(ocrTask_t * base, ocrFatGuid_t signalerGuid, u32 slot,
 
 #ifndef REG_ASYNC
 
-u8 satisfyTaskHc(ocrTask_t * base, ocrFatGuid_t data, u32 slot) {
+u8 hcTaskSatisfyBatched(ocrTask_t * base, ocrFatGuid_t data, u32 slot, ocrSchedReadyBatch_t * batch) {
     // An EDT has a list of signalers, but only registers
     // incrementally as signals arrive AND on non-persistent
     // events (latch or ONCE)
@@ -950,7 +1059,7 @@ u8 satisfyTaskHc(ocrTask_t * base, ocrFatGuid_t data, u32 slot) {
 
         hal_unlock32(&(self->lock));
         // All dependences have been satisfied, schedule the edt
-        RESULT_PROPAGATE(taskAllDepvSatisfied(base));
+        RESULT_PROPAGATE(taskAllDepvSatisfied(base, batch));
     } else {
         // Decide to keep both SLOT_SATISFIED_DB and SLOT_SATISFIED_EVT to be able to
         // disambiguate between events and db satisfaction. Not strictly necessary but
@@ -1042,6 +1151,10 @@ u8 satisfyTaskHc(ocrTask_t * base, ocrFatGuid_t data, u32 slot) {
     return 0;
 }
 
+u8 satisfyTaskHc(ocrTask_t * base, ocrFatGuid_t data, u32 slot) {
+    return hcTaskSatisfyBatched(base, data, slot, NULL);
+}
+
 /**
  * Can be invoked concurrently, however each invocation should be for a different slot
  */
@@ -1134,10 +1247,10 @@ u8 registerSignalerTaskHc(ocrTask_t * base, ocrFatGuid_t signalerGuid, u32 slot,
 
 #else /* REG_ASYNC */
 
-u8 satisfyTaskHc(ocrTask_t * base, ocrFatGuid_t data, u32 slot) {
+u8 hcTaskSatisfyBatched(ocrTask_t * base, ocrFatGuid_t data, u32 slot, ocrSchedReadyBatch_t * batch) {
     ocrTaskHc_t * self = (ocrTaskHc_t *) base;
     self->signalers[slot].guid = data.guid;
-    hal_fence();
+    hal_fenceRelease();
     u32 oldValue = hal_xadd32(&(self->slotSatisfiedCount), 1);
 #ifdef REG_ASYNC_SGL_DEBUG
     DPRINTF(DEBUG_LVL_WARN, "Satisfied task oldValue is %d and depc is %d \n", (int) oldValue, (int) base->depc);
@@ -1148,16 +1261,20 @@ u8 satisfyTaskHc(ocrTask_t * base, ocrFatGuid_t data, u32 slot) {
 #endif
         // All dependences known
         self->slotSatisfiedCount = base->depc;
-        taskAllDepvSatisfied(base);
+        taskAllDepvSatisfied(base, batch);
     }
     return 0;
 }
 
+u8 satisfyTaskHc(ocrTask_t * base, ocrFatGuid_t data, u32 slot) {
+    return hcTaskSatisfyBatched(base, data, slot, NULL);
+}
+
 u8 registerSignalerTaskHc(ocrTask_t * base, ocrFatGuid_t signalerGuid, u32 slot,
                             ocrDbAccessMode_t mode, bool isDepAdd) {
     ocrTaskHc_t * self = (ocrTaskHc_t *) base;
     self->signalers[slot].mode = mode;
-    hal_fence();
+    hal_fenceRelease();
     u32 oldValue = hal_xadd32(&(self->slotSatisfiedCount), 1);
 #ifdef REG_ASYNC_SGL_DEBUG
     DPRINTF(DEBUG_LVL_WARN, "Registered on task oldValue is %d and depc is %d \n", (int) oldValue, (int) base->depc);
@@ -1168,7 +1285,7 @@ u8 registerSignalerTaskHc(ocrTask_t * base, ocrFatGuid_t signalerGuid, u32 slot,
 #endif
         // All dependences known
         self->slotSatisfiedCount = base->depc;
-        taskAllDepvSatisfied(base);
+        taskAllDepvSatisfied(base, NULL);
     }
     return 0;
 }
@@ -1261,6 +1378,31 @@ u8 notifyDbReleaseTaskHc(ocrTask_t *base, ocrFatGuid_t db) {
     return OCR_ENOENT;
 }
 
+u8 getAcquiredDbTaskHc(ocrTask_t *base, ocrGuid_t db, void** ptr, ocrDbAccessMode_t* mode) {
+    ocrTaskHc_t *derived = (ocrTaskHc_t*)base;
+    u64 count = 0;
+    // DBs created by the EDT are acquired in RW
+    while(count < derived->countUnkDbs) {
+        if(ocrGuidIsEq(db, derived->unkDbs[count])) {
+            *ptr = NULL;
+            *mode = DB_MODE_RW;
+            return 0;
+        }
+        ++count;
+    }
+    count = 0;
+    while(count < base->depc) {
+        if(ocrGuidIsEq(db, derived->resolvedDeps[count].guid) &&
+           !(derived->doNotReleaseSlots[count / 64] & (1ULL << (count % 64)))) {
+            *ptr = derived->resolvedDeps[count].ptr;
+            *mode = derived->resolvedDeps[count].mode;
+            return 0;
+        }
+        ++count;
+    }
+    return OCR_ENOENT;
+}
+
 u8 taskExecute(ocrTask_t* base) {
     START_PROFILE(ta_hc_execute);
     ocrTaskHc_t* derived = (ocrTaskHc_t*)base;
@@ -1465,6 +1607,15 @@ u8 taskExecute(ocrTask_t* base) {
                 }
                 // Because the output event is non-persistent it is deallocated automatically
                 base->outputEvent = NULL_GUID;
+            } else {
+                // Check out of the finish scope this EDT checked in at creation
+                ocrGuid_t latchGuid = (!(ocrGuidIsNull(base->finishLatch))) ? base->finishLatch : base->parentLatch;
+                if(!(ocrGuidIsNull(latchGuid))) {
+                    getCurrentEnv(NULL, NULL, NULL, &msg);
+                    // Ignore failure for now
+                    // Bug #615
+                    finishLatchCheckout(pd, &msg, base, retGuid, latchGuid);
+                }
             }
             base->state = REAPING_EDTSTATE;
         }
@@ -1520,6 +1671,7 @@ ocrTaskFactory_t * newTaskFactoryHc(ocrParamList_t* perInstance, u32 factoryId)
     base->fcts.unregisterSignaler = FUNC_ADDR(u8 (*)(ocrTask_t*, ocrFatGuid_t, u32, bool), unregisterSignalerTaskHc);
     base->fcts.notifyDbAcquire = FUNC_ADDR(u8 (*)(ocrTask_t*, ocrFatGuid_t), notifyDbAcquireTaskHc);
     base->fcts.notifyDbRelease = FUNC_ADDR(u8 (*)(ocrTask_t*, ocrFatGuid_t), notifyDbReleaseTaskHc);
+    base->fcts.getAcquiredDb = FUNC_ADDR(u8 (*)(ocrTask_t*, ocrGuid_t, void**, ocrDbAccessMode_t*), getAcquiredDbTaskHc);
     base->fcts.execute = FUNC_ADDR(u8 (*)(ocrTask_t*), taskExecute);
     base->fcts.dependenceResolved = FUNC_ADDR(u8 (*)(ocrTask_t*, ocrGuid_t, void*, u32), dependenceResolvedTaskHc);
     base->fcts.setHint = FUNC_ADDR(u8 (*)(ocrTask_t*, ocrHint_t*), setHintTaskHc);
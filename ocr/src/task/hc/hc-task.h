@@ -84,6 +84,30 @@ typedef struct {
 } ocrTaskFactoryHc_t;
 
 ocrTaskFactory_t * newTaskFactoryHc(ocrParamList_t* perType, u32 factoryId);
+
+/**
+ * @brief Satisfy a slot of a local HC task, collecting it in 'batch' if it becomes ready
+ *
+ * Same as the task's satisfy function except that, if the satisfy makes the
+ * task ready right away, the task is appended to 'batch' instead of being
+ * notified to the scheduler on its own. Tasks that become ready later (for
+ * instance once a pending DB acquire completes) are notified individually.
+ */
+#ifdef REG_ASYNC_SGL
+u8 hcTaskSatisfyBatched(ocrTask_t * base, ocrFatGuid_t data, u32 slot, ocrDbAccessMode_t mode,
+                        ocrSchedReadyBatch_t * batch);
+#else
+u8 hcTaskSatisfyBatched(ocrTask_t * base, ocrFatGuid_t data, u32 slot, ocrSchedReadyBatch_t * batch);
+#endif
+
+/**
+ * @brief Hand the EDTs accumulated in a ready batch to the scheduler
+ *
+ * The batch goes out as a single OCR_TRANSACT_PROP_BATCH transaction. If the
+ * scheduler does not support it, each EDT is notified individually. The
+ * batch is empty on return.
+ */
+u8 hcTaskFlushReadyBatch(ocrPolicyDomain_t * pd, ocrSchedReadyBatch_t * batch);
 #endif /* ENABLE_TASK_HC */
 
 #endif /* ENABLE_TASK_HC or ENABLE_TASKTEMPLATE_HC */
@@ -0,0 +1,245 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+/**
+ * @brief Allocator managing memory inside a data block
+ *
+ * This is a two-level segregated fit allocator (in the spirit of TLSF):
+ * free chunks are binned by the position of the MSB of their size
+ * (first level) and by the next DB_ARENA_SL_LOG bits (second level).
+ * Bitmaps over the bins give constant time allocation except when only the
+ * bin of the requested size may hold a fitting chunk, which is then searched.
+ * Chunks are merged with their free neighbours as soon as they are freed.
+ */
+
+#include "ocr-hal.h"
+#include "debug.h"
+#include "ocr-errors.h"
+#include "ocr-types.h"
+#include "utils/ocr-utils.h"
+#include "utils/dbArena.h"
+
+#define DEBUG_TYPE UTIL
+
+#define DB_ARENA_MAGIC 0x6f63724172656e61ULL
+
+// Second level bins per first level bin
+#define DB_ARENA_SL_LOG 2
+#define DB_ARENA_SL_COUNT (1 << DB_ARENA_SL_LOG)
+// Sizes below DB_ARENA_SMALL all go in the first first level bin
+#define DB_ARENA_SMALL_LOG (DB_ARENA_SL_LOG + 3)
+#define DB_ARENA_SMALL (1ULL << DB_ARENA_SMALL_LOG)
+#define DB_ARENA_FL_MAX 64
+
+// A chunk starts with its size and the flags below. A free chunk then holds
+// the offsets of its neighbours in its bin and ends with a copy of its size
+// so that the chunk after it can find it when merging.
+#define CHUNK_USED      0x1ULL
+#define CHUNK_PREV_FREE 0x2ULL
+#define CHUNK_FLAGS     0x7ULL
+#define CHUNK_OVERHEAD  sizeof(u64)
+#define CHUNK_MIN       (4*sizeof(u64))
+
+typedef struct {
+    u64 magic;
+    u64 size;                     /**< Size of the data block, this header included */
+    u64 flBitmap;                 /**< Bit i set if a bin in first level i is not empty */
+    u32 lock;                     /**< Serializes concurrent writers of the data block */
+    u32 flCount;                  /**< Number of first level bins */
+    u8 slBitmap[DB_ARENA_FL_MAX]; /**< Non empty bins of each first level */
+    u64 bins[];                   /**< flCount*DB_ARENA_SL_COUNT offsets of the first free chunks */
+} dbArena_t;
+
+#define ARENA_AT(arena, offset) (*((u64*)(((u8*)(arena)) + (offset))))
+#define CHUNK_HEAD(arena, chunk) ARENA_AT(arena, chunk)
+#define CHUNK_NEXT(arena, chunk) ARENA_AT(arena, (chunk) + sizeof(u64))
+#define CHUNK_PREV(arena, chunk) ARENA_AT(arena, (chunk) + 2*sizeof(u64))
+#define CHUNK_SIZE(arena, chunk) (CHUNK_HEAD(arena, chunk) & ~CHUNK_FLAGS)
+
+static void arenaMapping(u64 size, u32 * fl, u32 * sl) {
+    if(size < DB_ARENA_SMALL) {
+        *fl = 0;
+        *sl = (u32)(size >> 3);
+    } else {
+        u32 msb = fls64(size);
+        *fl = msb - DB_ARENA_SMALL_LOG + 1;
+        *sl = (u32)(size >> (msb - DB_ARENA_SL_LOG)) & (DB_ARENA_SL_COUNT - 1);
+    }
+}
+
+static void arenaInsert(dbArena_t * arena, u64 chunk, u64 size) {
+    u32 fl, sl;
+    arenaMapping(size, &fl, &sl);
+    u64 * bin = &(arena->bins[fl*DB_ARENA_SL_COUNT + sl]);
+    CHUNK_HEAD(arena, chunk) = size | (CHUNK_HEAD(arena, chunk) & CHUNK_PREV_FREE);
+    CHUNK_NEXT(arena, chunk) = *bin;
+    CHUNK_PREV(arena, chunk) = 0;
+    if(*bin != 0) {
+        CHUNK_PREV(arena, *bin) = chunk;
+    }
+    *bin = chunk;
+    ARENA_AT(arena, chunk + size - sizeof(u64)) = size;
+    CHUNK_HEAD(arena, chunk + size) |= CHUNK_PREV_FREE;
+    arena->slBitmap[fl] |= (1 << sl);
+    arena->flBitmap |= (1ULL << fl);
+}
+
+static void arenaRemove(dbArena_t * arena, u64 chunk) {
+    u32 fl, sl;
+    u64 size = CHUNK_SIZE(arena, chunk);
+    arenaMapping(size, &fl, &sl);
+    u64 next = CHUNK_NEXT(arena, chunk);
+    u64 prev = CHUNK_PREV(arena, chunk);
+    if(next != 0) {
+        CHUNK_PREV(arena, next) = prev;
+    }
+    if(prev != 0) {
+        CHUNK_NEXT(arena, prev) = next;
+    } else {
+        arena->bins[fl*DB_ARENA_SL_COUNT + sl] = next;
+        if(next == 0) {
+            arena->slBitmap[fl] &= ~(1 << sl);
+            if(arena->slBitmap[fl] == 0) {
+                arena->flBitmap &= ~(1ULL << fl);
+            }
+        }
+    }
+    CHUNK_HEAD(arena, chunk + size) &= ~CHUNK_PREV_FREE;
+}
+
+// Returns a free chunk of at least size bytes or 0
+static u64 arenaFind(dbArena_t * arena, u64 size) {
+    u32 fl, sl;
+    // Round up to the next bin so that any chunk found is large enough
+    u64 rounded = size;
+    if(size >= DB_ARENA_SMALL) {
+        rounded += (1ULL << (fls64(size) - DB_ARENA_SL_LOG)) - 1;
+    }
+    arenaMapping(rounded, &fl, &sl);
+    if(fl < arena->flCount) {
+        u32 slMap = arena->slBitmap[fl] & (~0U << sl);
+        u64 flMap = (fl + 1 < DB_ARENA_FL_MAX) ? (arena->flBitmap & (~0ULL << (fl + 1))) : 0;
+        if(slMap != 0) {
+            return arena->bins[fl*DB_ARENA_SL_COUNT + ctz32(slMap)];
+        }
+        if(flMap != 0) {
+            fl = ctz64(flMap);
+            return arena->bins[fl*DB_ARENA_SL_COUNT + ctz32(arena->slBitmap[fl])];
+        }
+    }
+    // Only the bin holding size itself is left; its chunks may or may not fit
+    arenaMapping(size, &fl, &sl);
+    u64 chunk = (fl < arena->flCount) ? arena->bins[fl*DB_ARENA_SL_COUNT + sl] : 0;
+    while((chunk != 0) && (CHUNK_SIZE(arena, chunk) < size)) {
+        chunk = CHUNK_NEXT(arena, chunk);
+    }
+    return chunk;
+}
+
+static u64 arenaHeaderSize(u32 flCount) {
+    return sizeof(dbArena_t) + sizeof(u64)*flCount*DB_ARENA_SL_COUNT;
+}
+
+u8 dbArenaInit(void * base, u64 size) {
+    dbArena_t * arena = (dbArena_t *) base;
+    u32 fl, sl;
+    size &= ~(sizeof(u64) - 1);
+    arenaMapping(size, &fl, &sl);
+    u32 flCount = (fl + 1 < DB_ARENA_FL_MAX) ? fl + 1 : DB_ARENA_FL_MAX;
+    u64 first = arenaHeaderSize(flCount);
+    // The last word of the arena is a used chunk of size 0 that stops merges
+    if(size < (first + CHUNK_MIN + CHUNK_OVERHEAD)) {
+        return OCR_ENOMEM;
+    }
+    u64 end = size - CHUNK_OVERHEAD;
+    arena->size = size;
+    arena->flBitmap = 0;
+    arena->lock = 0;
+    arena->flCount = flCount;
+    u32 i;
+    for(i = 0; i < DB_ARENA_FL_MAX; ++i) {
+        arena->slBitmap[i] = 0;
+    }
+    for(i = 0; i < flCount*DB_ARENA_SL_COUNT; ++i) {
+        arena->bins[i] = 0;
+    }
+    CHUNK_HEAD(arena, end) = CHUNK_USED;
+    CHUNK_HEAD(arena, first) = 0;
+    arenaInsert(arena, first, end - first);
+    arena->magic = DB_ARENA_MAGIC;
+    return 0;
+}
+
+u8 dbArenaAlloc(void * base, u64 size, u64 * offset) {
+    dbArena_t * arena = (dbArena_t *) base;
+    if(arena->magic != DB_ARENA_MAGIC) {
+        return OCR_EINVAL;
+    }
+    // Chunk size including the overhead, rounded up to keep chunks aligned
+    u64 needed = (size + CHUNK_OVERHEAD + sizeof(u64) - 1) & ~(sizeof(u64) - 1);
+    if(needed < CHUNK_MIN) {
+        needed = CHUNK_MIN;
+    }
+    if(needed < size || needed > arena->size) {
+        return OCR_ENOMEM;
+    }
+    hal_lock32(&(arena->lock));
+    u64 chunk = arenaFind(arena, needed);
+    if(chunk == 0) {
+        hal_unlock32(&(arena->lock));
+        DPRINTF(DEBUG_LVL_VERB, "Arena @ %p cannot allocate %"PRIu64" bytes\n", base, size);
+        return OCR_ENOMEM;
+    }
+    arenaRemove(arena, chunk);
+    u64 chunkSize = CHUNK_SIZE(arena, chunk);
+    if(chunkSize - needed >= CHUNK_MIN) {
+        // Give back what we do not need
+        CHUNK_HEAD(arena, chunk + needed) = 0;
+        arenaInsert(arena, chunk + needed, chunkSize - needed);
+        chunkSize = needed;
+    }
+    CHUNK_HEAD(arena, chunk) = chunkSize | CHUNK_USED | (CHUNK_HEAD(arena, chunk) & CHUNK_PREV_FREE);
+    hal_unlock32(&(arena->lock));
+    *offset = chunk + CHUNK_OVERHEAD;
+    return 0;
+}
+
+u8 dbArenaFree(void * base, u64 offset) {
+    dbArena_t * arena = (dbArena_t *) base;
+    if(arena->magic != DB_ARENA_MAGIC) {
+        return OCR_EINVAL;
+    }
+    u64 chunk = offset - CHUNK_OVERHEAD;
+    if((offset & (sizeof(u64) - 1)) || (offset < CHUNK_OVERHEAD) ||
+       (chunk < arenaHeaderSize(arena->flCount)) || (offset >= arena->size)) {
+        return OCR_EINVAL;
+    }
+    hal_lock32(&(arena->lock));
+    u64 head = CHUNK_HEAD(arena, chunk);
+    if(!(head & CHUNK_USED) || ((head & ~CHUNK_FLAGS) == 0)) {
+        hal_unlock32(&(arena->lock));
+        DPRINTF(DEBUG_LVL_WARN, "Arena @ %p: offset %"PRIu64" is not an allocated chunk\n", base, offset);
+        return OCR_EINVAL;
+    }
+    u64 size = head & ~CHUNK_FLAGS;
+    u64 next = chunk + size;
+    if(!(CHUNK_HEAD(arena, next) & CHUNK_USED)) {
+        arenaRemove(arena, next);
+        size += CHUNK_SIZE(arena, next);
+    }
+    if(head & CHUNK_PREV_FREE) {
+        u64 prev = chunk - ARENA_AT(arena, chunk - sizeof(u64));
+        arenaRemove(arena, prev);
+        size += CHUNK_SIZE(arena, prev);
+        // So that freeing this chunk again is caught
+        CHUNK_HEAD(arena, chunk) = 0;
+        chunk = prev;
+    }
+    CHUNK_HEAD(arena, chunk) &= CHUNK_PREV_FREE;
+    arenaInsert(arena, chunk, size);
+    hal_unlock32(&(arena->lock));
+    return 0;
+}
@@ -171,44 +171,103 @@ void * nonConcDequePopHead(deque_t * self, u8 doTry) {
 /* CONCURRENT DEQUE BASED OPERATIONS                */
 /****************************************************/
 
+/*
+ * Allocate a circular buffer of 'capacity' slots for a work-stealing deque.
+ * The header and the slots are allocated in one chunk.
+ */
+static dequeBuffer_t * wstDequeNewBuffer(ocrPolicyDomain_t *pd, u32 capacity) {
+    ASSERT((capacity != 0) && ((capacity & (capacity - 1)) == 0));
+    dequeBuffer_t * buffer = (dequeBuffer_t *) pd->fcts.pdMalloc(pd, sizeof(dequeBuffer_t) + sizeof(void*)*capacity);
+    ASSERT(buffer != NULL);
+    buffer->capacity = capacity;
+    buffer->prev = NULL;
+    buffer->data = (volatile void **) (((u8 *) buffer) + sizeof(dequeBuffer_t));
+    return buffer;
+}
+
+/*
+ * Work-stealing deque destroy. Also frees all the buffers retired by a grow.
+ */
+void wstDequeDestroy(ocrPolicyDomain_t *pd, deque_t* self) {
+    dequeBuffer_t * buffer = ((dequeWst_t *) self)->buffer;
+    while (buffer != NULL) {
+        dequeBuffer_t * prev = buffer->prev;
+        pd->fcts.pdFree(pd, buffer);
+        buffer = prev;
+    }
+    pd->fcts.pdFree(pd, self);
+}
+
+/*
+ * Double the capacity of the deque. Only called by the owner.
+ * The live range [head, tail) is copied at the same logical indices
+ * so that concurrent thieves can indifferently read from the old or
+ * the new buffer. The old buffer is never written to again.
+ */
+static dequeBuffer_t * wstDequeGrow(dequeWst_t * self, dequeBuffer_t * old, s32 head, s32 tail) {
+    u32 capacity = old->capacity << 1;
+    ASSERT((capacity > old->capacity) && "DEQUE capacity overflow");
+    dequeBuffer_t * buffer = wstDequeNewBuffer(self->pd, capacity);
+    u32 oldMask = old->capacity - 1;
+    u32 mask = capacity - 1;
+    s32 i;
+    for (i = head; i < tail; ++i) {
+        buffer->data[((u32)i) & mask] = old->data[((u32)i) & oldMask];
+    }
+    buffer->prev = old;
+    DPRINTF(DEBUG_LVL_VERB, "Growing conc deque @ 0x%p from %"PRIu32" to %"PRIu32" slots h:%"PRId32" t:%"PRId32"\n",
+            self, old->capacity, capacity, head, tail);
+    // Publish the copied content before the buffer
+    hal_storeRelease(&(self->buffer), buffer);
+    self->base.data = buffer->data;
+    return buffer;
+}
+
 /*
  * push an entry onto the tail of the deque
  */
 void wstDequePushTail(deque_t* self, void* entry, u8 doTry) {
+    dequeWst_t * wself = (dequeWst_t *) self;
     s32 head = self->head;
     s32 tail = self->tail;
-    if (tail == INIT_DEQUE_CAPACITY + head) { /* deque looks full */
-        /* may not grow the deque if some interleaving steal occur */
-        ASSERT("DEQUE full, increase deque's size" && 0);
+    dequeBuffer_t * buffer = wself->buffer;
+    if ((tail - head) >= (s32) buffer->capacity) { /* deque looks full */
+        buffer = wstDequeGrow(wself, buffer, head, tail);
     }
-    s32 n = (self->tail) % INIT_DEQUE_CAPACITY;
-    self->data[n] = entry;
-    DPRINTF(DEBUG_LVL_VERB, "Pushing h:%"PRId32" t:%"PRId32" deq[%"PRId32"] elt:0x%p into conc deque @ 0x%p\n",
-            head, self->tail, n, entry, self);
-    hal_fence();
-    ++(self->tail);
+    u32 n = ((u32) tail) & (buffer->capacity - 1);
+    buffer->data[n] = entry;
+    DPRINTF(DEBUG_LVL_VERB, "Pushing h:%"PRId32" t:%"PRId32" deq[%"PRIu32"] elt:0x%p into conc deque @ 0x%p\n",
+            head, tail, n, entry, self);
+    // Thieves read the tail with acquire semantics: the entry is visible first
+    hal_storeRelease(&(self->tail), tail + 1);
 }
 
 /*
  * pop the task out of the deque from the tail
  */
 void * wstDequePopTail(deque_t * self, u8 doTry) {
-    hal_fence();
-    s32 tail = self->tail;
+    dequeWst_t * wself = (dequeWst_t *) self;
+    // Only the owner writes the tail
+    s32 tail = hal_loadRelaxed(&(self->tail));
     --tail;
-    self->tail = tail;
+    hal_storeRelaxed(&(self->tail), tail);
+    // The new tail must be visible to thieves before we read the head:
+    // this is the one store-load ordering of the protocol
     hal_fence();
-    s32 head = self->head;
+    s32 head = hal_loadRelaxed(&(self->head));
 
     if (tail < head) {
         self->tail = self->head;
         return NULL;
     }
-    void * rt = (void*) self->data[(tail) % INIT_DEQUE_CAPACITY];
+    // Only the owner replaces the buffer, no need to synchronize
+    dequeBuffer_t * buffer = wself->buffer;
+    u32 n = ((u32) tail) & (buffer->capacity - 1);
+    void * rt = (void*) buffer->data[n];
 
     if (tail > head) {
-        DPRINTF(DEBUG_LVL_VERB, "Popping (tail) h:%"PRId32" t:%"PRId32" deq[%"PRId32"] elt:0x%"PRIx64" from conc deque @ 0x%"PRIx64"\n",
-                head, tail, tail % INIT_DEQUE_CAPACITY, (u64)rt, (u64)self);
+        DPRINTF(DEBUG_LVL_VERB, "Popping (tail) h:%"PRId32" t:%"PRId32" deq[%"PRIu32"] elt:0x%"PRIx64" from conc deque @ 0x%"PRIx64"\n",
+                head, tail, n, (u64)rt, (u64)self);
         return rt;
     }
 
@@ -218,8 +277,8 @@ void * wstDequePopTail(deque_t * self, u8 doTry) {
 
     /* now the deque is empty */
     self->tail = self->head;
-    DPRINTF(DEBUG_LVL_VERB, "Popping (tail 2) h:%"PRId32" t:%"PRId32" deq[%"PRId32"] elt:0x%"PRIx64" from conc deque @ 0x%"PRIx64"\n",
-            head, tail, tail % INIT_DEQUE_CAPACITY, (u64)rt, (u64)self);
+    DPRINTF(DEBUG_LVL_VERB, "Popping (tail 2) h:%"PRId32" t:%"PRId32" deq[%"PRIu32"] elt:0x%"PRIx64" from conc deque @ 0x%"PRIx64"\n",
+            head, tail, n, (u64)rt, (u64)self);
     return rt;
 }
 
@@ -227,11 +286,12 @@ void * wstDequePopTail(deque_t * self, u8 doTry) {
  * the steal protocol
  */
 void * wstDequePopHead(deque_t * self, u8 doTry) {
+    dequeWst_t * wself = (dequeWst_t *) self;
     s32 head, tail;
     do {
-        head = self->head;
-        hal_fence();
-        tail = self->tail;
+        // The head is read before the tail
+        head = hal_loadAcquire(&(self->head));
+        tail = hal_loadAcquire(&(self->tail));
         if (tail <= head) {
             return NULL;
         }
@@ -240,19 +300,45 @@ void * wstDequePopHead(deque_t * self, u8 doTry) {
         // If the tail wraps around the buffer, so that H=x and T=H+N
         // as soon as the steal has done the cas, a push could happen
         // at index 'x' and overwrite the value to be stolen.
-
-        void * rt = (void *) self->data[head % INIT_DEQUE_CAPACITY];
+        // The buffer may be concurrently replaced by a grow. This is
+        // fine since both buffers hold the same value at index 'head'
+        // and retired buffers are kept alive until the deque is destroyed.
+        dequeBuffer_t * buffer = hal_loadAcquire(&(wself->buffer));
+        u32 n = ((u32) head) & (buffer->capacity - 1);
+        void * rt = (void *) buffer->data[n];
 
         /* compete with other thieves and possibly the owner (if the size == 1) */
         if (hal_cmpswap32(&self->head, head, head + 1) == head) { /* competing */
-            DPRINTF(DEBUG_LVL_VERB, "Popping (head) h:%"PRId32" t:%"PRId32" deq[%"PRId32"] elt:0x%"PRIx64" from conc deque @ 0x%"PRIx64"\n",
-                     head, tail, head % INIT_DEQUE_CAPACITY, (u64)rt, (u64)self);
+            DPRINTF(DEBUG_LVL_VERB, "Popping (head) h:%"PRId32" t:%"PRId32" deq[%"PRIu32"] elt:0x%"PRIx64" from conc deque @ 0x%"PRIx64"\n",
+                     head, tail, n, (u64)rt, (u64)self);
             return rt;
         }
     } while (doTry == 0);
     return NULL;
 }
 
+/*
+ * @brief constructor for growable work-stealing deques.
+ */
+static deque_t * newWstDeque(ocrPolicyDomain_t *pd, void * initValue) {
+    dequeWst_t * self = (dequeWst_t *) pd->fcts.pdMalloc(pd, sizeof(dequeWst_t));
+    ASSERT(self != NULL);
+    dequeBuffer_t * buffer = wstDequeNewBuffer(pd, INIT_WST_DEQUE_CAPACITY);
+    // This may not be necessary depending on the intented use
+    u32 i=0;
+    while(i < INIT_WST_DEQUE_CAPACITY) {
+        buffer->data[i] = initValue;
+        ++i;
+    }
+    self->pd = pd;
+    self->buffer = buffer;
+    self->base.head = 0;
+    self->base.tail = 0;
+    self->base.data = buffer->data;
+    self->base.destruct = wstDequeDestroy;
+    return (deque_t *) self;
+}
+
 /******************************************************/
 /* SINGLE LOCKED DEQUE BASED OPERATIONS               */
 /******************************************************/
@@ -359,10 +445,9 @@ void lockedDequePushTailSemiConc(deque_t* self, void* entry, u8 doTry) {
         ASSERT("DEQUE full, increase deque's size" && 0);
     }
     self->data[tail] = entry;
-    // The fence ensures a concurrent head pop cannot see
-    // self->tail increased without seeing the entry being written
-    hal_fence();
-    self->tail = ptail;
+    // A concurrent head pop cannot see self->tail
+    // increased without seeing the entry being written
+    hal_storeRelease(&(self->tail), ptail);
     hal_unlock32(&dself->lock);
 }
 
@@ -371,7 +456,7 @@ void lockedDequePushTailSemiConc(deque_t* self, void* entry, u8 doTry) {
  */
 void * nonConcDequePopHeadSemiConc(deque_t * self, u8 doTry) {
     u32 head = self->head;
-    u32 tail = self->tail;
+    u32 tail = hal_loadAcquire(&(self->tail));
     if (head == tail) {
         return NULL;
     }
@@ -397,7 +482,7 @@ deque_t * newDeque(ocrPolicyDomain_t *pd, void * initValue, ocrDequeType_t type)
     deque_t* self = NULL;
     switch(type) {
     case WORK_STEALING_DEQUE:
-        self = newBaseDeque(pd, initValue, NO_LOCK_BASE_DEQUE);
+        self = newWstDeque(pd, initValue);
         // Specialize push/pop implementations
         self->size = wstDequeSize;
         self->pushAtTail = wstDequePushTail;
@@ -299,10 +299,9 @@ void * hashtableConcTryPut(hashtable_t * hashtable, void * key, void * value) {
     ocrPolicyDomain_t * pd = hashtable->pd;
     while(tryPut) {
         // Lookup for the key
-        ocr_hashtable_entry * oldHead = hashtable->table[bucket];
         // Ensure oldHead is read before iterating
         //BUG #589 not sure which hashtable members should be volatile
-        hal_fence();
+        ocr_hashtable_entry * oldHead = hal_loadAcquire(&(hashtable->table[bucket]));
         ocr_hashtable_entry * entry = hashtableFindEntry(hashtable, key);
         if (entry == NULL) {
             // key is not there, try to CAS the head to insert it
@@ -435,6 +434,309 @@ bool hashtableConcBucketLockedRemove(hashtable_t * hashtable, void * key, void *
 }
 
 
+/******************************************************/
+/* CONCURRENT SHARDED HASHTABLE                       */
+/******************************************************/
+
+// Number of shards per worker of the PD (total rounded up to a power of two)
+#ifndef HASHTABLE_SHARDS_PER_WORKER
+#define HASHTABLE_SHARDS_PER_WORKER 4
+#endif
+
+// Initial capacity lower bound of a shard, must be a power of two
+#define HASHTABLE_SHARD_MIN_CAPACITY 16
+
+typedef struct _hashtableShardSlot_t {
+    volatile u64 key;     // 0 when the slot is empty
+    void * volatile value;
+} hashtableShardSlot_t;
+
+typedef struct _hashtableShardTable_t {
+    u32 capacity;                         // Power of two
+    u32 shardShift;                       // log2 of the number of shards
+    struct _hashtableShardTable_t * prev; // Table this one replaced on growth
+    hashtableShardSlot_t * slots;
+} hashtableShardTable_t;
+
+typedef struct _hashtableShard_t {
+    hashtableShardTable_t * volatile table;
+    // Sequence number: odd while a removal shifts entries around.
+    // Readers retry when it is odd or has changed during their lookup.
+    volatile u32 version;
+    u32 count;       // Number of keys in the table
+    halQLock_t lock; // Serializes writers
+    u8 padding[64 - 16 - sizeof(halQLock_t)]; // Keep shards on distinct cache lines
+} hashtableShard_t;
+
+typedef struct _hashtableSharded_t {
+    hashtable_t base;
+    u32 nbShards;
+    hashtableShard_t * shards;
+} hashtableSharded_t;
+
+// Keys are expected to be mostly sequential (GUID counters) and sharded
+// on their low bits. The home slot is taken from the bits right above
+// so that consecutive keys of a shard land in consecutive slots.
+static inline u32 shardSlotOf(u64 key, u32 shardShift, u32 capacity) {
+    return ((u32) (key >> shardShift)) & (capacity - 1);
+}
+
+static hashtableShardTable_t * shardNewTable(ocrPolicyDomain_t * pd, u32 capacity, u32 shardShift) {
+    // Header and slots are allocated in one chunk
+    hashtableShardTable_t * table = pd->fcts.pdMalloc(pd, sizeof(hashtableShardTable_t) +
+                                                      capacity * sizeof(hashtableShardSlot_t));
+    table->capacity = capacity;
+    table->shardShift = shardShift;
+    table->prev = NULL;
+    table->slots = (hashtableShardSlot_t *) (((u64) table) + sizeof(hashtableShardTable_t));
+    u32 i;
+    for (i = 0; i < capacity; i++) {
+        table->slots[i].key = 0;
+        table->slots[i].value = NULL;
+    }
+    return table;
+}
+
+/**
+ * @brief Returns the index of 'key' in 'table' or -1 if absent.
+ * Safe to call concurrently with writers: the probe is bounded by the
+ * table capacity and the caller validates the outcome against the version.
+ */
+static s64 shardFindSlot(hashtableShardTable_t * table, u64 key) {
+    u32 mask = table->capacity - 1;
+    u32 i = shardSlotOf(key, table->shardShift, table->capacity);
+    u32 probes = 0;
+    while (probes++ <= mask) {
+        u64 slotKey = table->slots[i].key;
+        if (slotKey == key) {
+            return i;
+        }
+        if (slotKey == 0) {
+            break;
+        }
+        i = (i + 1) & mask;
+    }
+    return -1;
+}
+
+// Writers only: the table must have at least one empty slot
+static void shardInsert(hashtableShardTable_t * table, u64 key, void * value) {
+    u32 mask = table->capacity - 1;
+    u32 i = shardSlotOf(key, table->shardShift, table->capacity);
+    while (table->slots[i].key != 0) {
+        i = (i + 1) & mask;
+    }
+    // Value first so that a reader matching the key reads a valid value
+    table->slots[i].value = value;
+    table->slots[i].key = key;
+}
+
+// Writers only: grows the table fourfold to limit rehashing when millions
+// of keys are live. The old table is retired, not freed, since concurrent
+// readers may still be probing it.
+static void shardGrow(ocrPolicyDomain_t * pd, hashtableShard_t * shard) {
+    hashtableShardTable_t * oldTable = shard->table;
+    hashtableShardTable_t * table = shardNewTable(pd, oldTable->capacity * 4, oldTable->shardShift);
+    u32 i;
+    for (i = 0; i < oldTable->capacity; i++) {
+        u64 key = oldTable->slots[i].key;
+        if (key != 0) {
+            shardInsert(table, key, oldTable->slots[i].value);
+        }
+    }
+    table->prev = oldTable;
+    // Make sure the slots are visible before the table is
+    hal_storeRelease(&(shard->table), table);
+    DPRINTF(DEBUG_LVL_VVERB, "Hashtable shard@%p grown to %"PRIu32" slots\n", shard, table->capacity);
+}
+
+// Writers only: inserts a new key, growing the table if needed
+static void shardPut(ocrPolicyDomain_t * pd, hashtableShard_t * shard, u64 key, void * value) {
+    if (((shard->count + 1) * 4) > (shard->table->capacity * 3)) {
+        shardGrow(pd, shard);
+    }
+    shardInsert(shard->table, key, value);
+    shard->count++;
+}
+
+static inline hashtableShard_t * shardOf(hashtable_t * hashtable, void * key) {
+    hashtableSharded_t * rhashtable = (hashtableSharded_t *) hashtable;
+    return &(rhashtable->shards[hashtable->hashing(key, rhashtable->nbShards)]);
+}
+
+/**
+ * @brief Create a new sharded hashtable with an initial total capacity of 'nbBuckets'.
+ */
+hashtable_t * newHashtableSharded(ocrPolicyDomain_t * pd, u32 nbBuckets, hashFct hashing) {
+    hashtableSharded_t * rhashtable = pd->fcts.pdMalloc(pd, sizeof(hashtableSharded_t));
+    u32 nbShards = 1;
+    u32 shardShift = 0;
+    while (nbShards < (pd->workerCount * HASHTABLE_SHARDS_PER_WORKER)) {
+        nbShards <<= 1;
+        shardShift++;
+    }
+    u32 capacity = HASHTABLE_SHARD_MIN_CAPACITY;
+    while ((capacity * nbShards) < nbBuckets) {
+        capacity <<= 1;
+    }
+    hashtable_t * hashtable = (hashtable_t *) rhashtable;
+    hashtable->pd = pd;
+    hashtable->nbBuckets = nbShards;
+    hashtable->table = NULL;
+    hashtable->hashing = hashing;
+    rhashtable->nbShards = nbShards;
+    rhashtable->shards = pd->fcts.pdMalloc(pd, nbShards * sizeof(hashtableShard_t));
+    u32 i;
+    for (i = 0; i < nbShards; i++) {
+        hashtableShard_t * shard = &(rhashtable->shards[i]);
+        shard->version = 0;
+        hal_qlockInit(&(shard->lock));
+        shard->count = 0;
+        shard->table = shardNewTable(pd, capacity, shardShift);
+    }
+    return hashtable;
+}
+
+/**
+ * @brief Destruct the hashtable and all its entries (do not deallocate keys and values pointers).
+ */
+void destructHashtableSharded(hashtable_t * hashtable, deallocFct entryDeallocator, void * deallocatorParam) {
+    ocrPolicyDomain_t * pd = hashtable->pd;
+    hashtableSharded_t * rhashtable = (hashtableSharded_t *) hashtable;
+    u32 i;
+    for (i = 0; i < rhashtable->nbShards; i++) {
+        hashtableShardTable_t * table = rhashtable->shards[i].table;
+        if (entryDeallocator != NULL) {
+            u32 j;
+            for (j = 0; j < table->capacity; j++) {
+                if (table->slots[j].key != 0) {
+                    entryDeallocator((void *) table->slots[j].key, table->slots[j].value, deallocatorParam);
+                }
+            }
+        }
+        while (table != NULL) {
+            hashtableShardTable_t * prev = table->prev;
+            pd->fcts.pdFree(pd, table);
+            table = prev;
+        }
+    }
+    pd->fcts.pdFree(pd, rhashtable->shards);
+    pd->fcts.pdFree(pd, rhashtable);
+}
+
+/**
+ * @brief get the value associated with a key
+ *
+ * Lock-free: the shard's version is read before and after the probe
+ * and the lookup is retried if a removal moved entries in between.
+ */
+void * hashtableConcShardedGet(hashtable_t * hashtable, void * key) {
+    hashtableShard_t * shard = shardOf(hashtable, key);
+    void * value = NULL;
+    u32 version;
+    do {
+        version = hal_loadAcquire(&(shard->version));
+        if (version & 1) {
+            continue;
+        }
+        hashtableShardTable_t * table = hal_loadAcquire(&(shard->table));
+        s64 idx = shardFindSlot(table, (u64) key);
+        value = (idx == -1) ? NULL : table->slots[idx].value;
+        // Order the probe before the version check
+        hal_fenceAcquire();
+    } while ((version & 1) || (version != hal_loadRelaxed(&(shard->version))));
+    return value;
+}
+
+/**
+ * @brief Put a key associated with a given value in the map.
+ * Overwrites the value if the key is already present.
+ */
+bool hashtableConcShardedPut(hashtable_t * hashtable, void * key, void * value) {
+    ASSERT(key != NULL);
+    hashtableShard_t * shard = shardOf(hashtable, key);
+    halQLockNode_t lockNode;
+    hal_qlock(&(shard->lock), &lockNode);
+    s64 idx = shardFindSlot(shard->table, (u64) key);
+    if (idx == -1) {
+        shardPut(hashtable->pd, shard, (u64) key, value);
+    } else {
+        shard->table->slots[idx].value = value;
+    }
+    hal_qunlock(&(shard->lock), &lockNode);
+    return true;
+}
+
+/**
+ * @brief Attempt to insert the key if absent.
+ * Return the current value associated with the key
+ * if present in the table, otherwise returns the value
+ * passed as parameter.
+ */
+void * hashtableConcShardedTryPut(hashtable_t * hashtable, void * key, void * value) {
+    ASSERT(key != NULL);
+    hashtableShard_t * shard = shardOf(hashtable, key);
+    halQLockNode_t lockNode;
+    hal_qlock(&(shard->lock), &lockNode);
+    s64 idx = shardFindSlot(shard->table, (u64) key);
+    if (idx == -1) {
+        shardPut(hashtable->pd, shard, (u64) key, value);
+    } else {
+        value = shard->table->slots[idx].value;
+    }
+    hal_qunlock(&(shard->lock), &lockNode);
+    return value;
+}
+
+/**
+ * @brief Removes a key from the table.
+ * If 'value' is not NULL, fill-in the pointer with the entry's value associated with 'key'.
+ * Returns true if entry has been found and removed.
+ *
+ * Uses backward-shift deletion so that no tombstones accumulate and
+ * tables only ever grow with the number of live keys.
+ */
+bool hashtableConcShardedRemove(hashtable_t * hashtable, void * key, void ** value) {
+    hashtableShard_t * shard = shardOf(hashtable, key);
+    halQLockNode_t lockNode;
+    hal_qlock(&(shard->lock), &lockNode);
+    hashtableShardTable_t * table = shard->table;
+    s64 idx = shardFindSlot(table, (u64) key);
+    if (idx == -1) {
+        hal_qunlock(&(shard->lock), &lockNode);
+        return false;
+    }
+    if (value != NULL) {
+        *value = table->slots[idx].value;
+    }
+    // Readers must see the odd version before any entry moves
+    hal_storeRelaxed(&(shard->version), shard->version + 1);
+    hal_fenceRelease();
+    u32 mask = table->capacity - 1;
+    u32 hole = (u32) idx;
+    u32 cur = hole;
+    while (true) {
+        cur = (cur + 1) & mask;
+        u64 curKey = table->slots[cur].key;
+        if (curKey == 0) {
+            break;
+        }
+        u32 home = shardSlotOf(curKey, table->shardShift, table->capacity);
+        // Move the entry into the hole if the hole sits between its home and itself
+        if (((cur - home) & mask) >= ((cur - hole) & mask)) {
+            table->slots[hole].value = table->slots[cur].value;
+            table->slots[hole].key = curKey;
+            hole = cur;
+        }
+    }
+    table->slots[hole].key = 0;
+    table->slots[hole].value = NULL;
+    shard->count--;
+    hal_storeRelease(&(shard->version), shard->version + 1);
+    hal_qunlock(&(shard->lock), &lockNode);
+    return true;
+}
+
 //
 // Variants of the generic hashtable through hashing function specialization
 //
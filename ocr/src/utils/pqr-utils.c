@@ -38,7 +38,8 @@ ocrGuid_t hcDumpNextEdt(ocrWorker_t *worker, u32 *size){
     wstObj = (ocrSchedulerObjectWst_t *)schedObj;
     deqObj = (ocrSchedulerObjectDeq_t *)wstObj->deques[worker->id];
 
-    u32 tail = (deqObj->deque->tail%INIT_DEQUE_CAPACITY);
+    dequeBuffer_t *buffer = ((dequeWst_t *)deqObj->deque)->buffer;
+    u32 tail = ((u32)(deqObj->deque->tail - 1)) & (buffer->capacity - 1);
     u32 deqSize = deqObj->deque->size(deqObj->deque);
 
     if(deqSize > 0){
@@ -48,9 +49,9 @@ ocrGuid_t hcDumpNextEdt(ocrWorker_t *worker, u32 *size){
         ocrFatGuid_t fguid;
         // See BUG #928 on GUIDs
 #if GUID_BIT_COUNT == 64
-        fguid.guid.guid = deqObj->deque->data[tail-1];
+        fguid.guid.guid = buffer->data[tail];
 #elif GUID_BIT_COUNT == 128
-        fguid.guid.lower = deqObj->deque->data[tail-1];
+        fguid.guid.lower = buffer->data[tail];
         fguid.guid.upper = 0x0;
 #endif
         fguid.metaDataPtr = NULL;
@@ -121,9 +122,7 @@ ocrGuid_t hcQueryAllEdts(ocrPolicyDomainHc_t *rself, void **result, u32 *qsize){
         wstObj = (ocrSchedulerObjectWst_t *)schedObj;
         deqObj = (ocrSchedulerObjectDeq_t *)wstObj->deques[i];
 
-        u32 head = (deqObj->deque->head%INIT_DEQUE_CAPACITY);
-        u32 tail = (deqObj->deque->tail%INIT_DEQUE_CAPACITY);
-        u32 deqSize = tail-head;
+        u32 deqSize = deqObj->deque->size(deqObj->deque);
 
         if(deqSize > 0){
             dataBlockSize += deqSize;
@@ -143,18 +142,19 @@ ocrGuid_t hcQueryAllEdts(ocrPolicyDomainHc_t *rself, void **result, u32 *qsize){
         wstObj = (ocrSchedulerObjectWst_t *)schedObj;
         deqObj = (ocrSchedulerObjectDeq_t *)wstObj->deques[i];
 
-        u32 head = (deqObj->deque->head%INIT_DEQUE_CAPACITY);
-        u32 tail = (deqObj->deque->tail%INIT_DEQUE_CAPACITY);
-        u32 deqSize = tail-head;
+        dequeBuffer_t *buffer = ((dequeWst_t *)deqObj->deque)->buffer;
+        s32 head = deqObj->deque->head;
+        s32 tail = deqObj->deque->tail;
+        u32 deqSize = deqObj->deque->size(deqObj->deque);
 
         if(deqSize > 0){
-            u32 j;
+            s32 j;
             for(j = head; j < tail; j++){
                 idxOffset++;
                 PD_MSG_STACK(msg);
                 getCurrentEnv(NULL, NULL, NULL, &msg);
                 ocrFatGuid_t fguid;
-                fguid.guid = (ocrGuid_t)deqObj->deque->data[j];
+                fguid.guid = (ocrGuid_t)buffer->data[((u32)j) & (buffer->capacity - 1)];
                 fguid.metaDataPtr = NULL;
 
             #define PD_MSG (&msg)
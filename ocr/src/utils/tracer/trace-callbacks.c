@@ -19,7 +19,7 @@ void __attribute__ ((weak)) traceTaskCreate(u64 location, bool evtType, ocrTrace
     //TRACING CALLBACKS - Task Create
     INIT_TRACE_OBJECT();
     TRACE_FIELD(TASK, taskCreate, tr, taskGuid) = edtGuid;
-    PUSH_TO_TRACE_DEQUE();
+    PUSH_TO_TRACE_BUFFER();
     return;
 }
 
@@ -30,7 +30,7 @@ void __attribute__ ((weak)) traceTaskRunnable(u64 location, bool evtType, ocrTra
     //TRACING CALLBACKS - Task Runnable
     INIT_TRACE_OBJECT();
     TRACE_FIELD(TASK, taskReadyToRun, tr, taskGuid) = edtGuid;
-    PUSH_TO_TRACE_DEQUE();
+    PUSH_TO_TRACE_BUFFER();
     return;
 }
 
@@ -42,7 +42,7 @@ void __attribute__ ((weak)) traceTaskAddDependence(u64 location, bool evtType, o
     INIT_TRACE_OBJECT();
     TRACE_FIELD(TASK, taskDepReady, tr, src) = src;
     TRACE_FIELD(TASK, taskDepReady, tr, dest) = dest;
-    PUSH_TO_TRACE_DEQUE();
+    PUSH_TO_TRACE_BUFFER();
     return;
 }
 
@@ -55,7 +55,7 @@ void __attribute__ ((weak)) traceTaskSatisfyDependence(u64 location, bool evtTyp
     INIT_TRACE_OBJECT();
     TRACE_FIELD(TASK, taskDepSatisfy, tr, taskGuid) = edtGuid;
     TRACE_FIELD(TASK, taskDepSatisfy, tr, satisfyee) = satisfyee;
-    PUSH_TO_TRACE_DEQUE();
+    PUSH_TO_TRACE_BUFFER();
     return;
 }
 
@@ -68,7 +68,7 @@ void __attribute__ ((weak)) traceTaskExecute(u64 location, bool evtType, ocrTrac
     INIT_TRACE_OBJECT();
     TRACE_FIELD(TASK, taskExeBegin, tr, taskGuid) = edtGuid;
     TRACE_FIELD(TASK, taskExeBegin, tr, funcPtr) = funcPtr;
-    PUSH_TO_TRACE_DEQUE();
+    PUSH_TO_TRACE_BUFFER();
     return;
 }
 
@@ -79,7 +79,7 @@ void __attribute__ ((weak)) traceTaskFinish(u64 location, bool evtType, ocrTrace
     //TRACING CALLBACKS - Task Finish
     INIT_TRACE_OBJECT();
     TRACE_FIELD(TASK, taskExeEnd, tr, taskGuid) = edtGuid;
-    PUSH_TO_TRACE_DEQUE();
+    PUSH_TO_TRACE_BUFFER();
     return;
 }
 
@@ -93,7 +93,7 @@ void __attribute__ ((weak)) traceTaskDataAcquire(u64 location, bool evtType, ocr
     TRACE_FIELD(TASK, taskDataAcquire, tr, taskGuid) = edtGuid;
     TRACE_FIELD(TASK, taskDataAcquire, tr, dbGuid) = dbGuid;
     TRACE_FIELD(TASK, taskDataAcquire, tr, dbSize) = dbSize;
-    PUSH_TO_TRACE_DEQUE();
+    PUSH_TO_TRACE_BUFFER();
     return;
 }
 
@@ -107,7 +107,7 @@ void __attribute__ ((weak)) traceTaskDataRelease(u64 location, bool evtType, ocr
     TRACE_FIELD(TASK, taskDataRelease, tr, taskGuid) = edtGuid;
     TRACE_FIELD(TASK, taskDataRelease, tr, dbGuid) = dbGuid;
     TRACE_FIELD(TASK, taskDataRelease, tr, dbSize) = dbSize;
-    PUSH_TO_TRACE_DEQUE();
+    PUSH_TO_TRACE_BUFFER();
     return;
 }
 
@@ -118,7 +118,7 @@ void __attribute__ ((weak)) traceTaskDestroy(u64 location, bool evtType, ocrTrac
     //TRACING CALLBACKS - Task Destroy
     INIT_TRACE_OBJECT();
     TRACE_FIELD(TASK, taskDestroy, tr, taskGuid) = edtGuid;
-    PUSH_TO_TRACE_DEQUE();
+    PUSH_TO_TRACE_BUFFER();
     return;
 }
 
@@ -129,7 +129,7 @@ void __attribute__ ((weak)) traceEventCreate(u64 location, bool evtType, ocrTrac
     //TRACING CALLBACKS - Event Create
     INIT_TRACE_OBJECT();
     TRACE_FIELD(EVENT, eventCreate, tr, eventGuid) = eventGuid;
-    PUSH_TO_TRACE_DEQUE();
+    PUSH_TO_TRACE_BUFFER();
     return;
 }
 
@@ -140,7 +140,7 @@ void __attribute__ ((weak)) traceEventDestroy(u64 location, bool evtType, ocrTra
     //TRACING CALLBACKS - Event Destroy
     INIT_TRACE_OBJECT();
     TRACE_FIELD(EVENT, eventDestroy, tr, eventGuid) = eventGuid;
-    PUSH_TO_TRACE_DEQUE();
+    PUSH_TO_TRACE_BUFFER();
     return;
 }
 
@@ -153,7 +153,7 @@ void __attribute__ ((weak)) traceEventSatisfyDependence(u64 location, bool evtTy
     INIT_TRACE_OBJECT();
     TRACE_FIELD(EVENT, eventDepSatisfy, tr, eventGuid) = eventGuid;
     TRACE_FIELD(EVENT, eventDepSatisfy, tr, satisfyee) = satisfyee;
-    PUSH_TO_TRACE_DEQUE();
+    PUSH_TO_TRACE_BUFFER();
     return;
 }
 
@@ -166,7 +166,7 @@ void __attribute__ ((weak)) traceEventAddDependence(u64 location, bool evtType,
     INIT_TRACE_OBJECT();
     TRACE_FIELD(EVENT, eventDepAdd, tr, src) = src;
     TRACE_FIELD(EVENT, eventDepAdd, tr, dest) = dest;
-    PUSH_TO_TRACE_DEQUE();
+    PUSH_TO_TRACE_BUFFER();
     return;
 }
 
@@ -178,7 +178,7 @@ void __attribute__ ((weak)) traceDataCreate(u64 location, bool evtType, ocrTrace
     INIT_TRACE_OBJECT();
     TRACE_FIELD(DATA, dataCreate, tr, dbGuid) = dbGuid;
     TRACE_FIELD(DATA, dataCreate, tr, dbSize) = dbSize;
-    PUSH_TO_TRACE_DEQUE();
+    PUSH_TO_TRACE_BUFFER();
     return;
 }
 
@@ -189,7 +189,7 @@ void __attribute__ ((weak)) traceDataDestroy(u64 location, bool evtType, ocrTrac
     //TRACING CALLBACKS - Data Destroy
     INIT_TRACE_OBJECT();
     TRACE_FIELD(DATA, dataDestroy, tr, dbGuid) = dbGuid;
-    PUSH_TO_TRACE_DEQUE();
+    PUSH_TO_TRACE_BUFFER();
     return;
 }
 
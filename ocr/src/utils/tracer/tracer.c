@@ -10,15 +10,80 @@
 #include "worker/hc/hc-worker.h"
 
 
-bool isDequeFull(deque_t *deq){
-    if(deq == NULL) return false;
-    s32 head = deq->head;
-    s32 tail = deq->tail;
-    if(tail == (INIT_DEQUE_CAPACITY + head)){
-        return true;
-    }else{
-        return false;
+traceBuffer_t *newTraceBuffer(ocrPolicyDomain_t *pd, ocrWorker_t *worker){
+    traceBuffer_t *buffer = (traceBuffer_t *)pd->fcts.pdMalloc(pd, sizeof(traceBuffer_t));
+    buffer->tail = 0;
+    buffer->headCache = 0;
+    buffer->lastTime = 0;
+    buffer->dropped = 0;
+    buffer->head = 0;
+    buffer->flushedDropped = 0;
+    buffer->location = (u64)pd->myLocation;
+    buffer->workerId = worker->id;
+    buffer->data = (u8 *)pd->fcts.pdMalloc(pd, TRACE_BUFFER_SIZE);
+    return buffer;
+}
+
+void destructTraceBuffer(ocrPolicyDomain_t *pd, traceBuffer_t *buffer){
+    pd->fcts.pdFree(pd, buffer->data);
+    pd->fcts.pdFree(pd, buffer);
+}
+
+//Encode a word as a mask of its non-zero bytes followed by these bytes
+static inline u32 encodeTraceWord(u8 *out, u64 word){
+    u32 len = 1;
+    u8 mask = 0;
+    u32 i;
+    for(i = 0; i < sizeof(u64); i++){
+        u8 byte = (u8)(word >> (i * 8));
+        if(byte != 0){
+            mask |= (1 << i);
+            out[len++] = byte;
+        }
+    }
+    out[0] = mask;
+    return len;
+}
+
+//Encode a trace object and append it to the worker's trace buffer, dropping it if the buffer is full.
+void traceRecord(ocrWorker_t *worker, ocrTraceObj_t *tr){
+    traceBuffer_t *buffer = (worker == NULL) ? NULL : ((ocrWorkerHc_t *)worker)->traceBuffer;
+    if(buffer == NULL) return;
+
+    u8 record[TRACE_RECORD_MAX];
+    u32 words = traceRecordWords(tr->typeSwitch, tr->actionSwitch);
+    ASSERT((1 + (sizeof(ocrGuid_t) / sizeof(u64)) + words) <= 16);
+    record[0] = (u8)(tr->typeSwitch - OCR_TRACE_TYPE_EDT);
+    record[1] = (u8)(tr->actionSwitch | (tr->eventType << 7));
+    u32 len = 2;
+    len += encodeTraceWord(&record[len], tr->time - buffer->lastTime);
+    u64 *parent = (u64 *)&(tr->parent);
+    u32 i;
+    for(i = 0; i < (sizeof(ocrGuid_t) / sizeof(u64)); i++){
+        len += encodeTraceWord(&record[len], parent[i]);
+    }
+    u64 *payload = (u64 *)&(tr->type);
+    for(i = 0; i < words; i++){
+        len += encodeTraceWord(&record[len], payload[i]);
+    }
+
+    u64 tail = buffer->tail;
+    if((tail + len - buffer->headCache) > TRACE_BUFFER_SIZE){
+        buffer->headCache = hal_loadAcquire(&(buffer->head));
+        if((tail + len - buffer->headCache) > TRACE_BUFFER_SIZE){
+            hal_storeRelaxed(&(buffer->dropped), buffer->dropped + 1);
+            return;
+        }
+    }
+    u32 offset = tail & (TRACE_BUFFER_SIZE - 1);
+    u32 first = (len < (TRACE_BUFFER_SIZE - offset)) ? len : (TRACE_BUFFER_SIZE - offset);
+    hal_memCopy(&(buffer->data[offset]), record, first, false);
+    if(first < len){
+        hal_memCopy(buffer->data, &record[first], len - first, false);
     }
+    buffer->lastTime = tr->time;
+    // Publish the record to the system worker
+    hal_storeRelease(&(buffer->tail), tail + len);
 }
 
 bool isSystem(ocrPolicyDomain_t *pd){
@@ -85,7 +150,7 @@ void populateTraceObject(u64 location, bool evtType, ocrTraceType_t objType, ocr
 
                 TRACE_FIELD(TASK, taskScheduled, tr, taskGuid) = curTask;
                 TRACE_FIELD(TASK, taskScheduled, tr, deq) = deq;
-                PUSH_TO_TRACE_DEQUE();
+                PUSH_TO_TRACE_BUFFER();
                 break;
             }
             case OCR_ACTION_SATISFY:
@@ -230,7 +295,7 @@ void populateTraceObject(u64 location, bool evtType, ocrTraceType_t objType, ocr
                 TRACE_FIELD(MESSAGE, msgEndToEnd, tr, rcvTime) = rcvTime;
                 TRACE_FIELD(MESSAGE, msgEndToEnd, tr, unMarshTime) = unMarshTime;
                 TRACE_FIELD(MESSAGE, msgEndToEnd, tr, type) = type;
-                PUSH_TO_TRACE_DEQUE();
+                PUSH_TO_TRACE_BUFFER();
                 break;
             }
 
@@ -277,7 +342,7 @@ void populateTraceObject(u64 location, bool evtType, ocrTraceType_t objType, ocr
                 //Handle trace object manually.  No callback for this trace event.
                 INIT_TRACE_OBJECT();
                 TRACE_FIELD(EXECUTION_UNIT, exeWorkRequest, tr, placeHolder) = NULL;
-                PUSH_TO_TRACE_DEQUE();
+                PUSH_TO_TRACE_BUFFER();
                 break;
             }
             case OCR_ACTION_WORK_TAKEN:
@@ -289,7 +354,7 @@ void populateTraceObject(u64 location, bool evtType, ocrTraceType_t objType, ocr
 
                 TRACE_FIELD(EXECUTION_UNIT, exeWorkTaken, tr, foundGuid) = curTask;
                 TRACE_FIELD(EXECUTION_UNIT, exeWorkTaken, tr, deq) = deq;
-                PUSH_TO_TRACE_DEQUE();
+                PUSH_TO_TRACE_BUFFER();
                 break;
             }
 
@@ -310,7 +375,7 @@ void populateTraceObject(u64 location, bool evtType, ocrTraceType_t objType, ocr
                 INIT_TRACE_OBJECT();
                 ocrGuid_t curTask = va_arg(ap, ocrGuid_t);
                 TRACE_FIELD(SCHEDULER, schedMsgSend, tr, taskGuid) = curTask;
-                PUSH_TO_TRACE_DEQUE();
+                PUSH_TO_TRACE_BUFFER();
             }
                 break;
 
@@ -320,7 +385,7 @@ void populateTraceObject(u64 location, bool evtType, ocrTraceType_t objType, ocr
                 INIT_TRACE_OBJECT();
                 ocrGuid_t curTask = va_arg(ap, ocrGuid_t);
                 TRACE_FIELD(SCHEDULER, schedMsgRcv, tr, taskGuid) = curTask;
-                PUSH_TO_TRACE_DEQUE();
+                PUSH_TO_TRACE_BUFFER();
             }
                 break;
 
@@ -330,7 +395,7 @@ void populateTraceObject(u64 location, bool evtType, ocrTraceType_t objType, ocr
                 INIT_TRACE_OBJECT();
                 ocrGuid_t curTask = va_arg(ap, ocrGuid_t);
                 TRACE_FIELD(SCHEDULER, schedInvoke, tr, taskGuid) = curTask;
-                PUSH_TO_TRACE_DEQUE();
+                PUSH_TO_TRACE_BUFFER();
             }
                 break;
 
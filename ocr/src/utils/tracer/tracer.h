@@ -10,6 +10,7 @@
 #ifdef ENABLE_WORKER_SYSTEM
 
 #include <stdarg.h>
+#include <string.h>
 
 #define TRACE_TYPE_NAME(ID) _type_##ID
 
@@ -23,7 +24,6 @@
  */
 
 
-bool isDequeFull(deque_t *deq);
 bool isSystem(ocrPolicyDomain_t *pd);
 bool isSupportedTraceType(bool evtType, ocrTraceType_t ttype, ocrTraceAction_t atype);
 void populateTraceObject(u64 location, bool evtType, ocrTraceType_t objType, ocrTraceAction_t actionType,
@@ -36,7 +36,9 @@ void populateTraceObject(u64 location, bool evtType, ocrTraceType_t objType, ocr
     ocrPolicyDomain_t *pd = NULL;                                           \
     ocrWorker_t *worker = NULL;                                             \
     getCurrentEnv(&pd, &worker, NULL, NULL);                                \
-    ocrTraceObj_t *tr = pd->fcts.pdMalloc(pd, sizeof(ocrTraceObj_t));       \
+    ocrTraceObj_t traceObj;                                                 \
+    ocrTraceObj_t *tr = &traceObj;                                          \
+    memset(&(tr->type), 0, sizeof(tr->type));                              \
                                                                             \
     tr->typeSwitch = objType;                                               \
     tr->actionSwitch = actionType;                                          \
@@ -46,13 +48,8 @@ void populateTraceObject(u64 location, bool evtType, ocrTraceType_t objType, ocr
     tr->parent = parent;                                                    \
     tr->eventType = evtType;
 
-#define PUSH_TO_TRACE_DEQUE()                                                                       \
-    while(isDequeFull(((ocrWorkerHc_t*)worker)->sysDeque)){                                         \
-        hal_pause();                                                                                \
-    }                                                                                               \
-                                                                                                    \
-    ((ocrWorkerHc_t *)worker)->sysDeque->pushAtTail(((ocrWorkerHc_t *)worker)->sysDeque, tr, 0);
-
+#define PUSH_TO_TRACE_BUFFER()                                              \
+    traceRecord(worker, tr);
 
 typedef struct {
 
@@ -269,6 +266,130 @@ typedef struct {
     }type;
 }ocrTraceObj_t;
 
+/*
+ * Binary trace format
+ *
+ * Each worker encodes its trace objects into its own ring buffer, which the
+ * system worker flushes in chunks into one file per policy domain:
+ *
+ *   file   := traceFileHeader_t chunk*
+ *   chunk  := traceChunkHeader_t record*
+ *   record := u8 type, u8 action | (eventType << 7), word time,
+ *             word parent[guid words], word payload[traceRecordWords(type, action)]
+ *
+ * 'type' is relative to OCR_TRACE_TYPE_EDT. 'time' is the difference with the
+ * previous record of the same worker. Each word is encoded as a byte whose
+ * bit i tells whether byte i of the word is non-zero, followed by the
+ * non-zero bytes, lowest first. The payload words are those of the action's
+ * structure in ocrTraceObj_t. Records of a chunk all come from the worker
+ * and policy domain the chunk header names.
+ */
+
+#define TRACE_FILE_MAGIC "OCRTRACE"
+#define TRACE_FILE_VERSION 1
+
+// Upper bound on the size of an encoded record (header and up to 16 words)
+#define TRACE_RECORD_MAX (2 + 9 * 16)
+
+typedef struct {
+    char magic[8];
+    u32 version;
+    u32 guidWords;          /* Number of words of a GUID */
+} traceFileHeader_t;
+
+typedef struct {
+    u64 location;           /* PD of the records */
+    u64 workerId;           /* Worker of the records */
+    u64 dropped;            /* Records dropped since the previous chunk of the worker */
+    u64 size;               /* Size of the records, in bytes */
+} traceChunkHeader_t;
+
+#define TRACE_ACTION_WORDS(ttype, taction) \
+    (sizeof(((ocrTraceObj_t *) 0)->type._type_##ttype.action.taction) / sizeof(u64))
+
+/**
+ * @brief Number of payload words of a trace record
+ */
+static inline u32 traceRecordWords(ocrTraceType_t ttype, ocrTraceAction_t atype) {
+    switch(ttype) {
+    case OCR_TRACE_TYPE_EDT:
+        switch(atype) {
+        case OCR_ACTION_CREATE:       return TRACE_ACTION_WORDS(TASK, taskCreate);
+        case OCR_ACTION_DESTROY:      return TRACE_ACTION_WORDS(TASK, taskDestroy);
+        case OCR_ACTION_RUNNABLE:     return TRACE_ACTION_WORDS(TASK, taskReadyToRun);
+        case OCR_ACTION_SCHEDULED:    return TRACE_ACTION_WORDS(TASK, taskScheduled);
+        case OCR_ACTION_ADD_DEP:      return TRACE_ACTION_WORDS(TASK, taskDepReady);
+        case OCR_ACTION_SATISFY:      return TRACE_ACTION_WORDS(TASK, taskDepSatisfy);
+        case OCR_ACTION_EXECUTE:      return TRACE_ACTION_WORDS(TASK, taskExeBegin);
+        case OCR_ACTION_FINISH:       return TRACE_ACTION_WORDS(TASK, taskExeEnd);
+        case OCR_ACTION_DATA_ACQUIRE: return TRACE_ACTION_WORDS(TASK, taskDataAcquire);
+        case OCR_ACTION_DATA_RELEASE: return TRACE_ACTION_WORDS(TASK, taskDataRelease);
+        default: return 0;
+        }
+    case OCR_TRACE_TYPE_EVENT:
+        switch(atype) {
+        case OCR_ACTION_CREATE:       return TRACE_ACTION_WORDS(EVENT, eventCreate);
+        case OCR_ACTION_DESTROY:      return TRACE_ACTION_WORDS(EVENT, eventDestroy);
+        case OCR_ACTION_ADD_DEP:      return TRACE_ACTION_WORDS(EVENT, eventDepAdd);
+        case OCR_ACTION_SATISFY:      return TRACE_ACTION_WORDS(EVENT, eventDepSatisfy);
+        default: return 0;
+        }
+    case OCR_TRACE_TYPE_MESSAGE:
+        return (atype == OCR_ACTION_END_TO_END) ? TRACE_ACTION_WORDS(MESSAGE, msgEndToEnd) : 0;
+    case OCR_TRACE_TYPE_DATABLOCK:
+        switch(atype) {
+        case OCR_ACTION_CREATE:       return TRACE_ACTION_WORDS(DATA, dataCreate);
+        case OCR_ACTION_DESTROY:      return TRACE_ACTION_WORDS(DATA, dataDestroy);
+        default: return 0;
+        }
+    case OCR_TRACE_TYPE_WORKER:
+        switch(atype) {
+        case OCR_ACTION_WORK_REQUEST: return TRACE_ACTION_WORDS(EXECUTION_UNIT, exeWorkRequest);
+        case OCR_ACTION_WORK_TAKEN:   return TRACE_ACTION_WORDS(EXECUTION_UNIT, exeWorkTaken);
+        default: return 0;
+        }
+    case OCR_TRACE_TYPE_SCHEDULER:
+        switch(atype) {
+        case OCR_ACTION_SCHED_MSG_SEND: return TRACE_ACTION_WORDS(SCHEDULER, schedMsgSend);
+        case OCR_ACTION_SCHED_MSG_RCV:  return TRACE_ACTION_WORDS(SCHEDULER, schedMsgRcv);
+        case OCR_ACTION_SCHED_INVOKE:   return TRACE_ACTION_WORDS(SCHEDULER, schedInvoke);
+        default: return 0;
+        }
+    default:
+        return 0;
+    }
+}
+
+// Size of a worker's trace buffer in bytes, must be a power of two
+#ifndef TRACE_BUFFER_SIZE
+#define TRACE_BUFFER_SIZE (1 << 20)
+#endif
+
+/*
+ * Single-producer single-consumer ring of encoded records. The worker owning
+ * the buffer appends records and drops them, counting, when the buffer is
+ * full. The system worker consumes them. 'head' and 'tail' only grow.
+ */
+typedef struct _traceBuffer_t {
+    // Producer side
+    volatile u64 tail;
+    u64 headCache;          /* Last value of head seen by the producer */
+    u64 lastTime;           /* Timestamp of the last record written */
+    volatile u64 dropped;
+    u8 padding0[32];
+    // Consumer side
+    volatile u64 head;
+    u64 flushedDropped;     /* Value of dropped at the last flush */
+    u64 location;
+    u64 workerId;
+    u8 padding1[32];
+    u8 *data;
+} traceBuffer_t;
+
+traceBuffer_t *newTraceBuffer(ocrPolicyDomain_t *pd, ocrWorker_t *worker);
+void destructTraceBuffer(ocrPolicyDomain_t *pd, traceBuffer_t *buffer);
+void traceRecord(ocrWorker_t *worker, ocrTraceObj_t *tr);
+
 #endif /* ENABLE_WORKER_SYSTEM */
 void doTrace(u64 location, u64 wrkr, ocrGuid_t taskGuid, ...);
 
@@ -115,6 +115,36 @@ ocrGuid_t processRequestEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[
     return NULL_GUID;
 }
 
+/******************************************************/
+/* INCOMING REQUESTS DISPATCH                         */
+/******************************************************/
+
+// Default handler: the request is processed by a compute worker so that it can block
+static void dispatchPromote(ocrWorker_t * worker, ocrPolicyMsg_t * message) {
+#ifdef UTASK_COMM
+    createUTask(worker->pd, message);
+#else
+    u64 msgParamv = (u64) message;
+    createProcessRequestEdt(worker->pd, ((ocrWorkerHcComm_t *) worker)->processRequestTemplate, &msgParamv);
+#endif
+}
+
+// Processes the request on the spot, sparing the creation, scheduling and
+// destruction of an EDT. Only suitable for requests that never wait on a
+// remote response: the communication worker talks to the comm-platform
+// directly and cannot wait on itself.
+static void dispatchInline(ocrWorker_t * worker, ocrPolicyMsg_t * message) {
+    u64 msgParamv = (u64) message;
+    processRequestEdt(1, &msgParamv, 0, NULL);
+}
+
+void hcCommWorkerRegisterDispatch(ocrWorker_t * worker, u32 msgType, hcCommDispatchFct_t fct) {
+    ocrWorkerHcComm_t * rworker = (ocrWorkerHcComm_t *) worker;
+    u32 idx = HCCOMM_DISPATCH_IDX(msgType & PD_MSG_TYPE_ONLY);
+    ASSERT(idx < HCCOMM_DISPATCH_COUNT);
+    rworker->dispatch[idx] = fct;
+}
+
 static u8 takeFromSchedulerAndSend(ocrWorker_t * worker, ocrPolicyDomain_t * pd) {
     // When the communication-worker is not stopping only a single iteration is
     // executed. Otherwise it is executed until the scheduler's 'take' do not
@@ -231,8 +261,8 @@ static void workerLoopHcCommInternal(ocrWorker_t * worker, ocrPolicyDomain_t *pd
                 DPRINTF(DEBUG_LVL_VVERB,"hc-comm-worker: Received message, msgId: %"PRId64" type:0x%"PRIx32" prop:0x%"PRIx64"\n",
                                         message->msgId, message->type, handle->properties);
                 // This is an outstanding request, delegate to PD for processing
-                u64 msgParamv = (u64) message;
             #ifdef HYBRID_COMM_COMP_WORKER // Experimental see documentation
+                u64 msgParamv = (u64) message;
                 // Execute selected 'sterile' messages on the spot
                 if ((message->type & PD_MSG_TYPE_ONLY) == PD_MSG_DB_ACQUIRE) {
                     DPRINTF(DEBUG_LVL_VVERB,"hc-comm-worker: Execute message, msgId: %"PRId64"\n", pd->myLocation, message->msgId);
@@ -245,56 +275,39 @@ static void workerLoopHcCommInternal(ocrWorker_t * worker, ocrPolicyDomain_t *pd
                     #endif
                 }
             #else
-                if ((message->type & PD_MSG_TYPE_ONLY) == PD_MSG_DB_ACQUIRE) {
+                u32 msgType = (message->type & PD_MSG_TYPE_ONLY);
+                bool blockingAcquire = false;
+                if (msgType == PD_MSG_DB_ACQUIRE) {
                     //BUG #190
 #define PD_MSG (message)
 #define PD_TYPE PD_MSG_DB_ACQUIRE
-                    bool blockingAcquire = ((message->type & PD_MSG_RESPONSE) && (PD_MSG_FIELD_IO(edtSlot) == EDT_SLOT_NONE));
+                    blockingAcquire = ((message->type & PD_MSG_RESPONSE) && (PD_MSG_FIELD_IO(edtSlot) == EDT_SLOT_NONE));
 #undef PD_MSG
 #undef PD_TYPE
-                    if (blockingAcquire) {
-                        // This going through the PD mecanism to deal with the incoming acquire response
-                        // and dequeue EDTs that may be waiting on the acquire.
-                        // The PD will not call the acquire callback because there's none in that case.
-                        processRequestEdt(1, &msgParamv, 0, NULL);
-                        // This is to unblock the calling blocked on the acquire
-                        ocrFatGuid_t fatGuid;
-                        fatGuid.guid = NULL_GUID;
-                        fatGuid.metaDataPtr = handle;
-                        PD_MSG_STACK(giveMsg);
-                        getCurrentEnv(NULL, NULL, NULL, &giveMsg);
-                    #define PD_MSG (&giveMsg)
-                    #define PD_TYPE PD_MSG_SCHED_NOTIFY
-                        giveMsg.type = PD_MSG_SCHED_NOTIFY | PD_MSG_REQUEST;
-                        PD_MSG_FIELD_IO(schedArgs).kind = OCR_SCHED_NOTIFY_COMM_READY;
-                        PD_MSG_FIELD_IO(schedArgs).OCR_SCHED_ARG_FIELD(OCR_SCHED_NOTIFY_COMM_READY).guid = fatGuid;
-                        RESULT_ASSERT(pd->fcts.processMessage(pd, &giveMsg, false), ==, 0);
-                    #undef PD_MSG
-                    #undef PD_TYPE
-                    } else {
-                        #ifdef UTASK_COMM
-                        createUTask(pd, message);
-                        #else
-                        createProcessRequestEdt(pd, processRequestTemplate, &msgParamv);
-                        #endif
-                        // We do not need the handle anymore
-                        handle->destruct(handle);
-                    }
+                }
+                if (blockingAcquire) {
+                    // This going through the PD mecanism to deal with the incoming acquire response
+                    // and dequeue EDTs that may be waiting on the acquire.
+                    // The PD will not call the acquire callback because there's none in that case.
+                    u64 msgParamv = (u64) message;
+                    processRequestEdt(1, &msgParamv, 0, NULL);
+                    // This is to unblock the calling blocked on the acquire
+                    ocrFatGuid_t fatGuid;
+                    fatGuid.guid = NULL_GUID;
+                    fatGuid.metaDataPtr = handle;
+                    PD_MSG_STACK(giveMsg);
+                    getCurrentEnv(NULL, NULL, NULL, &giveMsg);
+                #define PD_MSG (&giveMsg)
+                #define PD_TYPE PD_MSG_SCHED_NOTIFY
+                    giveMsg.type = PD_MSG_SCHED_NOTIFY | PD_MSG_REQUEST;
+                    PD_MSG_FIELD_IO(schedArgs).kind = OCR_SCHED_NOTIFY_COMM_READY;
+                    PD_MSG_FIELD_IO(schedArgs).OCR_SCHED_ARG_FIELD(OCR_SCHED_NOTIFY_COMM_READY).guid = fatGuid;
+                    RESULT_ASSERT(pd->fcts.processMessage(pd, &giveMsg, false), ==, 0);
+                #undef PD_MSG
+                #undef PD_TYPE
                 } else {
-#ifdef COMMWRK_PROCESS_SATISFY // This is for benchmarking purpose to measure overhead of delegating processing
-                    if ((message->type & PD_MSG_TYPE_ONLY) == PD_MSG_DEP_SATISFY) {
-                        DPRINTF(DEBUG_LVL_VVERB,"hc-comm-worker: Process PD_MSG_DEP_SATISFY message, type=0x%"PRIx64" msgId: %"PRIu64"\n",  message->type, message->msgId);
-                        processRequestEdt(1, &msgParamv, 0, NULL);
-                    } else {
-#endif
-                        #ifdef UTASK_COMM
-                        createUTask(pd, message);
-                        #else
-                        createProcessRequestEdt(pd, processRequestTemplate, &msgParamv);
-                        #endif
-#ifdef COMMWRK_PROCESS_SATISFY
-                    }
-#endif
+                    ocrWorkerHcComm_t * rworker = (ocrWorkerHcComm_t *) worker;
+                    rworker->dispatch[HCCOMM_DISPATCH_IDX(msgType)](worker, message);
                     // We do not need the handle anymore
                     handle->destruct(handle);
                 }
@@ -665,6 +678,20 @@ void initializeWorkerHcComm(ocrWorkerFactory_t * factory, ocrWorker_t *self, ocr
     workerHcComm->baseSwitchRunlevel = derivedFactory->baseSwitchRunlevel;
     workerHcComm->processRequestTemplate = NULL_GUID;
     workerHcComm->flushOutgoingComm = false;
+    u32 i;
+    for (i = 0; i < HCCOMM_DISPATCH_COUNT; i++) {
+        workerHcComm->dispatch[i] = FUNC_ADDR(void (*)(ocrWorker_t*, ocrPolicyMsg_t*), dispatchPromote);
+    }
+    // Acquires complete or are queued without waiting on other PDs.
+    // Satisfy and EDT creation stay promoted: they may register an EDT on a
+    // remote event, which is a blocking two-way message. Release stays promoted
+    // too: it may grant queued waiters, and their asynchronous acquire responses
+    // cannot be sent through the simple comm-api (their DB pointer would be
+    // marshalled twice).
+    hcCommWorkerRegisterDispatch(self, PD_MSG_DB_ACQUIRE, FUNC_ADDR(void (*)(ocrWorker_t*, ocrPolicyMsg_t*), dispatchInline));
+#ifdef COMMWRK_PROCESS_SATISFY // This is for benchmarking purpose to measure overhead of delegating processing
+    hcCommWorkerRegisterDispatch(self, PD_MSG_DEP_SATISFY, FUNC_ADDR(void (*)(ocrWorker_t*, ocrPolicyMsg_t*), dispatchInline));
+#endif
 }
 
 /******************************************************/
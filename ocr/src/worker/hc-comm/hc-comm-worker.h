@@ -15,6 +15,22 @@
 #include "utils/list.h"
 #include "ocr-worker.h"
 
+struct _ocrPolicyMsg_t;
+
+// Handlers for incoming requests are indexed by message type. The low 12 bits
+// of a type are a one-hot operation class and bits 12 to 15 the operation id
+// within that class.
+#define HCCOMM_DISPATCH_CLASS_COUNT 11
+#define HCCOMM_DISPATCH_COUNT (HCCOMM_DISPATCH_CLASS_COUNT << 4)
+#define HCCOMM_DISPATCH_IDX(type) ((fls32((type) & 0xFFF) << 4) | (((type) >> 12) & 0xF))
+
+/**
+ * @brief Processes an incoming request on behalf of the communication worker
+ *
+ * The handler takes ownership of the message.
+ */
+typedef void (*hcCommDispatchFct_t)(struct _ocrWorker_t * worker, struct _ocrPolicyMsg_t * message);
+
 typedef struct {
     ocrWorkerFactoryHc_t base;
     void (*baseInitialize) (struct _ocrWorkerFactory_t * factory,
@@ -30,9 +46,20 @@ typedef struct {
                      phase_t phase, u32 properties, void (*callback)(struct _ocrPolicyDomain_t*, u64), u64 val);
     ocrGuid_t processRequestTemplate;
     bool flushOutgoingComm;
+    hcCommDispatchFct_t dispatch[HCCOMM_DISPATCH_COUNT]; /**< Incoming request handlers */
 } ocrWorkerHcComm_t;
 
 ocrWorkerFactory_t* newOcrWorkerFactoryHcComm(ocrParamList_t *perType);
 
+/**
+ * @brief Registers the handler an HC communication worker invokes for
+ * incoming requests of type 'msgType'
+ *
+ * By default requests are promoted to an EDT (or a micro-task with UTASK_COMM)
+ * so that they may block. Handlers running on the communication worker itself
+ * must be short and never wait on a remote response.
+ */
+void hcCommWorkerRegisterDispatch(ocrWorker_t * worker, u32 msgType, hcCommDispatchFct_t fct);
+
 #endif /* ENABLE_WORKER_HC_COMM */
 #endif /* __HC_COMM_WORKER_H__ */
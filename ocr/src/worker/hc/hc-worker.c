@@ -31,6 +31,10 @@
 #include "utils/profiler/profiler.h"
 #endif
 
+#ifdef OCR_TRACE_BINARY
+#include "utils/tracer/tracer.h"
+#endif
+
 #define DEBUG_TYPE WORKER
 
 #if defined(UTASK_COMM) || defined(UTASK_COMM2)
@@ -41,6 +45,77 @@
 /* OCR-HC WORKER                                      */
 /******************************************************/
 
+static void hcWorkerUnpark(ocrWorkerHc_t *hcWorker, ocrPolicyDomain_t *pd) {
+    if(hcWorker->parkArmed) {
+        hcWorker->parked = 0;
+        hal_xadd32((u32*)&(((ocrPolicyDomainHc_t*)pd)->parkedWorkers), -1);
+        hcWorker->parkArmed = false;
+    }
+}
+
+/**
+ * @brief Called after a work shift that found no work
+ *
+ * Spins for 'idleSpin' shifts, yields the core for 'idleYield' more
+ * and then parks. Parking takes two empty shifts: the first one registers
+ * the worker as a sleeper so that producers publishing work after the
+ * registration wake it up; the second, if still unsuccessful, blocks.
+ * The wait is bounded by 'parkTimeout' so that work made available
+ * without a wake-up (other heuristics, remote messages) is still picked up.
+ */
+static void hcWorkerIdle(ocrWorker_t *worker, ocrPolicyDomain_t *pd) {
+    ocrWorkerHc_t *hcWorker = (ocrWorkerHc_t *) worker;
+    u32 shifts = ++hcWorker->idleShifts;
+    if(shifts <= hcWorker->idleSpin) {
+        return;
+    }
+    if((shifts <= (hcWorker->idleSpin + hcWorker->idleYield)) || (hcWorker->parkTimeout == 0)
+#ifdef ENABLE_EXTENSION_BLOCKING_SUPPORT
+        // A helping worker polls for its blocked EDT's condition; do not delay it
+       || hcWorker->isHelping
+#endif
+       ) {
+        hal_pause();
+        return;
+    }
+    if(!hcWorker->parkArmed) {
+        hcWorker->parkArmed = true;
+        hcWorker->parked = 1;
+        // Full barrier: pairs with the fence in hcWorkerWakeIdle
+        hal_xadd32((u32*)&(((ocrPolicyDomainHc_t*)pd)->parkedWorkers), 1);
+        return;
+    }
+    if((hcWorker->parked == 1) && (worker->curState == worker->desiredState)) {
+        DPRINTF(DEBUG_LVL_VVERB, "Worker %"PRIu64" parking\n", hcWorker->id);
+        salParkWait(&(hcWorker->parked), 1, hcWorker->parkTimeout);
+    }
+    // Woken up or timed out; the next empty shift re-registers
+    hcWorkerUnpark(hcWorker, pd);
+}
+
+static void hcWorkerWake(ocrWorkerHc_t *hcWorker) {
+    if((hcWorker->parked == 1) && (hal_cmpswap32((u32*)&(hcWorker->parked), 1, 0) == 1)) {
+        salParkWake(&(hcWorker->parked), 1);
+    }
+}
+
+void hcWorkerWakeIdle(ocrPolicyDomain_t *pd, u32 count) {
+    ocrPolicyDomainHc_t *rself = (ocrPolicyDomainHc_t *) pd;
+    // Order the caller's publication of work before reading the sleeper count
+    hal_fence();
+    if(rself->parkedWorkers == 0) {
+        return;
+    }
+    u64 i;
+    for(i = 0; (i < pd->workerCount) && (count != 0); ++i) {
+        ocrWorkerHc_t *hcWorker = (ocrWorkerHc_t *) pd->workers[i];
+        if((hcWorker->parked == 1) && (hal_cmpswap32((u32*)&(hcWorker->parked), 1, 0) == 1)) {
+            salParkWake(&(hcWorker->parked), 1);
+            --count;
+        }
+    }
+}
+
 static void hcWorkShift(ocrWorker_t * worker) {
 
     START_PROFILE(wo_hc_workShift);
@@ -76,6 +151,8 @@ static void hcWorkShift(ocrWorker_t * worker) {
         // We got a response
         ocrFatGuid_t taskGuid = PD_MSG_FIELD_IO(schedArgs).OCR_SCHED_ARG_FIELD(OCR_SCHED_WORK_EDT_USER).edt;
         if(!(ocrGuidIsNull(taskGuid.guid))){
+            hcWorker->idleShifts = 0;
+            hcWorkerUnpark(hcWorker, pd);
             ocrTask_t * curTask = (ocrTask_t*)taskGuid.metaDataPtr;
 #ifdef ENABLE_EXTENSION_BLOCKING_SUPPORT
             if (((curTask->flags & OCR_TASK_FLAG_LONG) != 0) && (((ocrWorkerHc_t *) worker)->isHelping)) {
@@ -116,6 +193,8 @@ static void hcWorkShift(ocrWorker_t * worker) {
 
             // Important for this to be the last
             worker->curTask = NULL;
+        } else {
+            hcWorkerIdle(worker, pd);
         }
 
     } else {
@@ -315,15 +394,23 @@ u8 hcWorkerSwitchRunlevel(ocrWorker_t *self, ocrPolicyDomain_t *PD, ocrRunlevel_
             self->pd = PD;
         break;
     case RL_MEMORY_OK:
+#if defined(ENABLE_WORKER_SYSTEM) && defined(OCR_TRACE_BINARY)
         //Check that OCR has been configured to utilize system worker.
-        //worker[n-1] by convention. If so initialize deques
+        //worker[n-1] by convention. If so initialize trace buffers
         if(PD->workers[(PD->workerCount)-1]->type == SYSTEM_WORKERTYPE){
             if(self->type == MASTER_WORKERTYPE || self->type == SLAVE_WORKERTYPE) {
-                if(((ocrWorkerHc_t *)self)->sysDeque == NULL){
-                    ((ocrWorkerHc_t*)self)->sysDeque = newDeque(self->pd, NULL, NON_CONCURRENT_DEQUE);
+                ocrWorkerHc_t * workerHc = (ocrWorkerHc_t *)self;
+                if((properties & RL_BRING_UP) && (workerHc->traceBuffer == NULL)){
+                    workerHc->traceBuffer = newTraceBuffer(self->pd, self);
+                }
+                if((properties & RL_TEAR_DOWN) && (workerHc->traceBuffer != NULL)){
+                    // The system worker flushed the buffer when leaving RL_COMPUTE_OK
+                    destructTraceBuffer(self->pd, workerHc->traceBuffer);
+                    workerHc->traceBuffer = NULL;
                 }
             }
         }
+#endif
         break;
     case RL_GUID_OK:
         break;
@@ -383,6 +470,7 @@ u8 hcWorkerSwitchRunlevel(ocrWorker_t *self, ocrPolicyDomain_t *PD, ocrRunlevel_
                 self->callbackArg = val;
                 hal_fence();
                 self->desiredState = GET_STATE(RL_COMPUTE_OK, phase);
+                hcWorkerWake((ocrWorkerHc_t*)self);
             } else {
                 ASSERT(false && "Unexpected phase on runlevel RL_COMPUTE_OK teardown");
             }
@@ -423,8 +511,8 @@ u8 hcWorkerSwitchRunlevel(ocrWorker_t *self, ocrPolicyDomain_t *PD, ocrRunlevel_
                 // We make sure that we actually fully booted before shutting down.
                 // Addresses a race where a worker still hasn't started but
                 // another worker has started and executes the shutdown protocol
-                //while(self->curState != GET_STATE(RL_USER_OK, (phase+1))){
-                while(self->curState != GET_STATE(RL_USER_OK, (phase+1)));
+                while(self->curState != GET_STATE(RL_USER_OK, (phase+1)))
+                    hal_pause();
                 ASSERT(self->curState == GET_STATE(RL_USER_OK, (phase+1)));
             }
 
@@ -436,6 +524,7 @@ u8 hcWorkerSwitchRunlevel(ocrWorker_t *self, ocrPolicyDomain_t *PD, ocrRunlevel_
             hal_fence();
             // Breaks the worker's compute loop
             self->desiredState = GET_STATE(RL_USER_OK, phase);
+            hcWorkerWake((ocrWorkerHc_t*)self);
         }
         break;
     default:
@@ -455,7 +544,8 @@ void* hcRunWorker(ocrWorker_t * worker) {
     worker->curState = GET_STATE(RL_COMPUTE_OK, 0);
 
     // We wait until we transition to the next RL
-    while(worker->curState == worker->desiredState) ;
+    while(worker->curState == worker->desiredState)
+        hal_pause();
 
     // At this point, we should be going to RL_USER_OK
     ASSERT(worker->desiredState == GET_STATE(RL_USER_OK, (RL_GET_PHASE_COUNT_DOWN(worker->pd, RL_USER_OK))));
@@ -509,6 +599,13 @@ void initializeWorkerHc(ocrWorkerFactory_t * factory, ocrWorker_t* self, ocrPara
         workerHc->hcType = HC_WORKER_COMP;
     }
     workerHc->legacySecondStart = false;
+    workerHc->traceBuffer = NULL;
+    workerHc->idleSpin = ((paramListWorkerHcInst_t*)perInstance)->idleSpin;
+    workerHc->idleYield = ((paramListWorkerHcInst_t*)perInstance)->idleYield;
+    workerHc->parkTimeout = ((paramListWorkerHcInst_t*)perInstance)->parkTimeout;
+    workerHc->idleShifts = 0;
+    workerHc->parkArmed = false;
+    workerHc->parked = 0;
 #ifdef ENABLE_EXTENSION_BLOCKING_SUPPORT
     workerHc->isHelping = 0;
     workerHc->stealFirst = 0;
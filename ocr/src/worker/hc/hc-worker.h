@@ -15,6 +15,23 @@
 #include "ocr-worker.h"
 #include "utils/deque.h"
 
+// Idle protocol: after HC_IDLE_SPIN_DEFAULT consecutive empty work shifts
+// a worker yields its core for HC_IDLE_YIELD_DEFAULT more shifts and then
+// parks for at most HC_PARK_TIMEOUT_DEFAULT microseconds or until woken up.
+// Overridable per worker with the 'idlespin', 'idleyield' and 'parktimeout'
+// config keys; a zero park timeout disables parking altogether.
+#ifndef HC_IDLE_SPIN_DEFAULT
+#define HC_IDLE_SPIN_DEFAULT 1024
+#endif
+
+#ifndef HC_IDLE_YIELD_DEFAULT
+#define HC_IDLE_YIELD_DEFAULT 64
+#endif
+
+#ifndef HC_PARK_TIMEOUT_DEFAULT
+#define HC_PARK_TIMEOUT_DEFAULT 1000
+#endif
+
 typedef struct {
     ocrWorkerFactory_t base;
 } ocrWorkerFactoryHc_t;
@@ -22,6 +39,9 @@ typedef struct {
 typedef struct _paramListWorkerHcInst_t {
     paramListWorkerInst_t base;
     ocrWorkerType_t workerType;
+    u32 idleSpin;
+    u32 idleYield;
+    u32 parkTimeout;
 } paramListWorkerHcInst_t;
 
 typedef enum {
@@ -45,7 +65,14 @@ typedef struct {
 #endif
     hcWorkerType_t hcType;
     u8 legacySecondStart;
-    deque_t *sysDeque;
+    struct _traceBuffer_t *traceBuffer; // Trace records for the system worker
+    // Idle protocol state (see HC_IDLE_SPIN_DEFAULT)
+    u32 idleSpin;
+    u32 idleYield;
+    u32 parkTimeout;
+    u32 idleShifts;     // Consecutive work shifts that found no work
+    bool parkArmed;     // Registered as a sleeper in the PD
+    volatile u32 parked; // Futex word: 1 while (about to be) asleep
 #ifdef ENABLE_EXTENSION_BLOCKING_SUPPORT
     u32 isHelping;
     bool stealFirst;
@@ -54,5 +81,13 @@ typedef struct {
 
 ocrWorkerFactory_t* newOcrWorkerFactoryHc(ocrParamList_t *perType);
 
+/**
+ * @brief Wakes up to 'count' parked HC workers of 'pd'
+ *
+ * Called by producers after making work available. Cheap when
+ * no worker is parked.
+ */
+void hcWorkerWakeIdle(ocrPolicyDomain_t *pd, u32 count);
+
 #endif /* ENABLE_WORKER_HC */
 #endif /* __HC_WORKER_H__ */
@@ -15,9 +15,13 @@
 #include "ocr-sysboot.h"
 #include "worker/hc/hc-worker.h"
 #include "worker/system/system-worker.h"
-#include "utils/deque.h"
 #include "utils/tracer/tracer.h"
-#include "utils/tracer/trace-events.h"
+
+#ifdef OCR_TRACE_BINARY
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 #define DEBUG_TYPE WORKER
 
@@ -26,107 +30,167 @@
  *
  * @brief: Worker type responsible for monitoring runtime
  * events and reporting them through a tracing protocol.
+ * Computation workers encode their trace records into
+ * their own ring buffer (see tracer.h); the system worker
+ * writes them in chunks into a mapped per-PD trace file.
  */
 /*********************************************************/
 
 #define IDX_OFFSET OCR_TRACE_TYPE_EDT
 
-//Utility functions
-bool allDequesEmpty(ocrPolicyDomain_t *pd){
-    u32 i;
-    for(i = 0; i < ((pd->workerCount)-1); i++){
-        s32 head = ((ocrWorkerHc_t *)pd->workers[i])->sysDeque->head;
-        s32 tail = ((ocrWorkerHc_t *)pd->workers[i])->sysDeque->tail;
+#ifdef OCR_TRACE_BINARY
 
-        if(tail-head > 0)
-            return false;
-    }
+// Size of the windows of the trace file mapped at once, a multiple of the page size
+#ifndef TRACE_FILE_WINDOW
+#define TRACE_FILE_WINDOW (64 << 20)
+#endif
+
+// Trace buffers are flushed once they hold at least that many bytes (and
+// entirely when the system worker shuts down)
+#ifndef TRACE_FLUSH_THRESHOLD
+#define TRACE_FLUSH_THRESHOLD (TRACE_BUFFER_SIZE / 4)
+#endif
+
+//Trace file of the policy domain, written through a mapped window
+typedef struct {
+    int fd;
+    u8 *window;
+    u64 windowOffset;
+    u64 cursor;             // Size of the trace written so far
+} traceFile_t;
+
+static bool mapTraceWindow(traceFile_t *tf){
+    if(ftruncate(tf->fd, tf->windowOffset + TRACE_FILE_WINDOW) != 0)
+        return false;
+    void *window = mmap(NULL, TRACE_FILE_WINDOW, PROT_WRITE, MAP_SHARED, tf->fd, tf->windowOffset);
+    if(window == MAP_FAILED)
+        return false;
+    tf->window = (u8 *)window;
     return true;
 }
 
-//Do custom processing for trace objects if provided by DPRINTF.
-#ifdef OCR_TRACE_BINARY
-void processTraceObject(ocrTraceObj_t *trace, FILE *f){
+static void writeTrace(traceFile_t *tf, const void *src, u64 size){
+    const u8 *bytes = (const u8 *)src;
+    while((size > 0) && (tf->window != NULL)){
+        u64 offset = tf->cursor - tf->windowOffset;
+        if(offset == TRACE_FILE_WINDOW){
+            munmap(tf->window, TRACE_FILE_WINDOW);
+            tf->windowOffset += TRACE_FILE_WINDOW;
+            offset = 0;
+            if(!mapTraceWindow(tf)){
+                PRINTF("WARNING: cannot extend the trace file, the remainder of the trace is lost\n");
+                tf->window = NULL;
+                return;
+            }
+        }
+        u64 len = (size < (TRACE_FILE_WINDOW - offset)) ? size : (TRACE_FILE_WINDOW - offset);
+        hal_memCopy(&(tf->window[offset]), bytes, len, false);
+        tf->cursor += len;
+        bytes += len;
+        size -= len;
+    }
+}
+
+static void openTraceFile(traceFile_t *tf, u64 location){
+    char traceName[32];
+    SNPRINTF(traceName, 31, "trace_%"PRIu64".bin", location);
+    tf->window = NULL;
+    tf->windowOffset = 0;
+    tf->cursor = 0;
+    //One file per policy domain
+    tf->fd = open(traceName, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if((tf->fd == -1) || !mapTraceWindow(tf)){
+        PRINTF("WARNING: cannot map trace file %s, tracing is disabled\n", traceName);
+        return;
+    }
+    traceFileHeader_t header;
+    memset(&header, 0, sizeof(header));
+    hal_memCopy(header.magic, TRACE_FILE_MAGIC, sizeof(header.magic), false);
+    header.version = TRACE_FILE_VERSION;
+    header.guidWords = sizeof(ocrGuid_t) / sizeof(u64);
+    writeTrace(tf, &header, sizeof(header));
+}
+
+static void closeTraceFile(traceFile_t *tf){
+    if(tf->window != NULL)
+        munmap(tf->window, TRACE_FILE_WINDOW);
+    if(tf->fd != -1){
+        if(ftruncate(tf->fd, tf->cursor) != 0)
+            PRINTF("WARNING: cannot truncate the trace file\n");
+        close(tf->fd);
+    }
+}
 
-    fwrite(trace, sizeof(ocrTraceObj_t), 1, f);
-    return;
+//Write the records of a worker's trace buffer as one chunk. Returns the number of bytes flushed.
+static u64 flushTraceBuffer(traceFile_t *tf, traceBuffer_t *buffer, u64 threshold){
+    u64 head = buffer->head;
+    u64 tail = hal_loadAcquire(&(buffer->tail));
+    u64 dropped = hal_loadRelaxed(&(buffer->dropped));
+    if(((tail - head) < threshold) || ((tail == head) && (dropped == buffer->flushedDropped)))
+        return 0;
+
+    traceChunkHeader_t chunk;
+    chunk.location = buffer->location;
+    chunk.workerId = buffer->workerId;
+    chunk.dropped = dropped - buffer->flushedDropped;
+    chunk.size = tail - head;
+    writeTrace(tf, &chunk, sizeof(chunk));
+    u32 offset = head & (TRACE_BUFFER_SIZE - 1);
+    u64 first = (chunk.size < (TRACE_BUFFER_SIZE - offset)) ? chunk.size : (TRACE_BUFFER_SIZE - offset);
+    writeTrace(tf, &(buffer->data[offset]), first);
+    writeTrace(tf, buffer->data, chunk.size - first);
+    buffer->flushedDropped = dropped;
+    // Give the space back to the producer
+    hal_storeRelease(&(buffer->head), tail);
+    return chunk.size;
 }
-#endif
 
-void drainAllDeques(FILE *f){
-    ocrPolicyDomain_t *pd;
-    getCurrentEnv(&pd, NULL, NULL, NULL);
+static u64 flushTraceBuffers(ocrPolicyDomain_t *pd, traceFile_t *tf, u64 threshold){
+    u64 flushed = 0;
     u32 i;
-    //Iterate over each worker's deque
+    //WARNING:  Broken abstraction.  Currently only supported on x86 so system worker
+    //          looks directly into hc-worker. See bug #830
     for(i = 0; i < ((pd->workerCount)-1); i++){
-        deque_t *deq = ((ocrWorkerHc_t *)pd->workers[i])->sysDeque;
-        s32 head = deq->head;
-        s32 tail = deq->tail;
-        s32 remaining = tail-head;
-        u32 j;
-        for(j = 0; j < remaining; j++){
-            //Pop and process all remaining records
-            ocrTraceObj_t *tr = (ocrTraceObj_t *)(deq->popFromHead(deq,0));
-            ASSERT(tr != NULL);
-
-#ifdef OCR_TRACE_BINARY
-            processTraceObject(tr, f);
-#endif
-            pd->fcts.pdFree(pd, tr);
-        }
+        traceBuffer_t *buffer = ((ocrWorkerHc_t *)pd->workers[i])->traceBuffer;
+        if(buffer != NULL)
+            flushed += flushTraceBuffer(tf, buffer, threshold);
     }
+    return flushed;
 }
 
-void drainCurrentDeque(ocrWorker_t *worker, FILE *f, s32 head, s32 tail, deque_t *deq){
-    s32 remaining = tail-head;
+static void reportTraceDrops(ocrPolicyDomain_t *pd){
+    u64 dropped = 0;
     u32 i;
-    for(i = 0; i < remaining; i++){
-        ocrTraceObj_t *tr = (ocrTraceObj_t *)(deq->popFromHead(deq, 0));
-        ASSERT(tr != NULL);
-#ifdef OCR_TRACE_BINARY
-        processTraceObject(tr, f);
-#endif
-        worker->pd->fcts.pdFree(worker->pd, tr);
+    for(i = 0; i < ((pd->workerCount)-1); i++){
+        traceBuffer_t *buffer = ((ocrWorkerHc_t *)pd->workers[i])->traceBuffer;
+        if(buffer != NULL)
+            dropped += buffer->flushedDropped;
     }
+    if(dropped != 0)
+        PRINTF("WARNING: %"PRIu64" trace records were dropped on PD 0x%"PRIx64"; consider increasing TRACE_BUFFER_SIZE\n",
+               dropped, (u64)pd->myLocation);
 }
+#endif
 
-//workLoop for system worker: strictly responsible for querying/processing records in trace queues.
+//workLoop for system worker: strictly responsible for flushing the workers' trace buffers.
 void workerLoopSystem(ocrWorker_t *worker){
 
     ASSERT(worker->curState == GET_STATE(RL_USER_OK, (RL_GET_PHASE_COUNT_DOWN(worker->pd, RL_USER_OK))));
 
 #ifdef OCR_TRACE_BINARY
-    ocrPolicyDomain_t *pd;
-    getCurrentEnv(&pd, NULL, NULL, NULL);
-    u64 location = pd->myLocation;
-
-    char traceName[32];
-    SNPRINTF(traceName, 31, "trace_%lu.bin", location);
-
-    //open file for binary writing. (One per policy domain)
-    FILE *f = fopen(traceName, "w");
+    traceFile_t tf;
+    openTraceFile(&tf, (u64)worker->pd->myLocation);
 #endif
 
     u8 continueLoop = true;
-    bool toDrain = false;
 
     do {
         while(worker->curState == worker->desiredState){
-            u32 i;
-            //Iterate over all comp. workers trace deques and pop records if they exist.
-            for(i = 0; i < ((worker->pd->workerCount)-1); i++){
-                //WARNING:  Broken abstraction.  Currently only supported on x86 so system worker
-                //          looks directly into hc-worker. See bug #830
-                deque_t *deq = ((ocrWorkerHc_t *)worker->pd->workers[i])->sysDeque;
-                s32 head = deq->head;
-                s32 tail = deq->tail;
-                if(tail-head > 0){
-                    //Atleast one trace object on deque.  Drain.
 #ifdef OCR_TRACE_BINARY
-                    drainCurrentDeque(worker, f, head, tail, deq);
+            //Batch the writes: only flush the buffers that filled up enough
+            if(flushTraceBuffers(worker->pd, &tf, TRACE_FLUSH_THRESHOLD) == 0)
 #endif
-                }
-            }
+                hal_pause();
         }
 
         ((ocrWorkerSystem_t *)worker)->readyForShutdown = true;
@@ -147,10 +211,12 @@ void workerLoopSystem(ocrWorker_t *worker){
             if(RL_IS_FIRST_PHASE_DOWN(worker->pd, RL_COMPUTE_OK, phase)) {
                 worker->curState = worker->desiredState;
                 //We have succesfully shifted out of USER runlevel, and are breaking out of
-                //our workLoop... Check if deques still contain items.
-                if(!(allDequesEmpty(worker->pd))){
-                    toDrain = true;
-                }
+                //our workLoop... Write what remains in the buffers.
+#ifdef OCR_TRACE_BINARY
+                flushTraceBuffers(worker->pd, &tf, 0);
+                reportTraceDrops(worker->pd);
+                closeTraceFile(&tf);
+#endif
 
                 if(worker->callback != NULL){
                     worker->callback(worker->pd, worker->callbackArg);
@@ -167,17 +233,6 @@ void workerLoopSystem(ocrWorker_t *worker){
             ASSERT(0);
         }
     } while(continueLoop);
-
-    if(toDrain){
-
-#ifdef OCR_TRACE_BINARY
-        drainAllDeques(f);
-        fclose(f);
-#endif
-
-    }
-
-
 }
 
 
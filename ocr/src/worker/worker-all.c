@@ -74,7 +74,16 @@ void initializeWorkerOcr(ocrWorkerFactory_t * factory, ocrWorker_t * self, ocrPa
     self->fguid.metaDataPtr = self;
     self->pd = NULL;
     self->location = 0;
+    self->numaNode = 0;
     self->curTask = NULL;
+#ifdef ENABLE_EXTENSION_LABELING
+    u32 i;
+    for(i = 0; i < GUID_MAP_CACHE_SIZE; ++i) {
+        self->guidMapCache[i].guid = NULL_GUID;
+        self->guidMapCache[i].map = NULL;
+        self->guidMapCache[i].epoch = 0;
+    }
+#endif
     self->fcts = factory->workerFcts;
     self->curState = self->desiredState = GET_STATE(RL_CONFIG_PARSE, 0);
     self->callback = NULL;
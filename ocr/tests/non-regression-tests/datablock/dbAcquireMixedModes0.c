@@ -0,0 +1,128 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr.h"
+
+/**
+ * DESC: Many EDTs acquire the same datablock concurrently in RO, EW, RW and
+ * CONST modes. RO readers join without waiting while EW and RW writers are
+ * queued and granted. EW writers must never overlap with each other nor with
+ * RW and CONST users and every increment they make must be accounted for.
+ */
+
+#define NB_EDTS 256
+#define NB_INCR 64
+
+// Layout of the datablock
+#define CTR_IDX  0
+#define BUSY_IDX 1
+
+typedef struct {
+    ocrGuid_t latchGuid;
+} ctx_t;
+
+ocrGuid_t terminateEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 * data = (u64 *) depv[1].ptr;
+    ASSERT(data[BUSY_IDX] == 0);
+    ASSERT(data[CTR_IDX] == ((NB_EDTS / 4) * NB_INCR));
+    PRINTF("Everybody checked out\n");
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+ocrGuid_t ewEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    volatile u64 * data = (volatile u64 *) depv[0].ptr;
+    ctx_t * ctx = (ctx_t *) depv[1].ptr;
+    ASSERT(data[BUSY_IDX] == 0);
+    data[BUSY_IDX] = 1;
+    u32 i;
+    for(i = 0; i < NB_INCR; i++) {
+        data[CTR_IDX] = data[CTR_IDX] + 1;
+    }
+    data[BUSY_IDX] = 0;
+    ocrEventSatisfySlot(ctx->latchGuid, NULL_GUID, OCR_EVENT_LATCH_DECR_SLOT);
+    return NULL_GUID;
+}
+
+// RW and CONST users must never see an EW writer in flight
+ocrGuid_t sharedEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    volatile u64 * data = (volatile u64 *) depv[0].ptr;
+    ctx_t * ctx = (ctx_t *) depv[1].ptr;
+    ASSERT(data[BUSY_IDX] == 0);
+    ocrEventSatisfySlot(ctx->latchGuid, NULL_GUID, OCR_EVENT_LATCH_DECR_SLOT);
+    return NULL_GUID;
+}
+
+// RO readers may see anything, they only stress the lock-free join
+ocrGuid_t roEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ctx_t * ctx = (ctx_t *) depv[1].ptr;
+    ocrEventSatisfySlot(ctx->latchGuid, NULL_GUID, OCR_EVENT_LATCH_DECR_SLOT);
+    return NULL_GUID;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t dataGuid;
+    u64 * data;
+    ocrDbCreate(&dataGuid, (void **)&data, sizeof(u64)*2, DB_PROP_NONE, NULL_HINT, NO_ALLOC);
+    data[CTR_IDX] = 0;
+    data[BUSY_IDX] = 0;
+    ocrDbRelease(dataGuid);
+
+    ocrGuid_t latchGuid;
+    ocrEventCreate(&latchGuid, OCR_EVENT_LATCH_T, false);
+    ctx_t * ctx;
+    ocrGuid_t ctxGuid;
+    ocrDbCreate(&ctxGuid, (void **)&ctx, sizeof(ctx_t), DB_PROP_NONE, NULL_HINT, NO_ALLOC);
+    ctx->latchGuid = latchGuid;
+    ocrDbRelease(ctxGuid);
+
+    ocrGuid_t terminateTplGuid;
+    ocrEdtTemplateCreate(&terminateTplGuid, terminateEdt, 0 /*paramc*/, 2 /*depc*/);
+    ocrGuid_t terminateGuid;
+    ocrEdtCreate(&terminateGuid, terminateTplGuid, EDT_PARAM_DEF, /*paramv=*/NULL, EDT_PARAM_DEF, /*depv=*/NULL,
+                 EDT_PROP_NONE, NULL_HINT, /*outEvent=*/NULL);
+    ocrAddDependence(latchGuid, terminateGuid, 0, DB_MODE_CONST);
+    ocrAddDependence(dataGuid, terminateGuid, 1, DB_MODE_CONST);
+
+    // Check in every user upfront so that the latch cannot trigger early
+    u32 i;
+    for(i = 0; i < (1 + NB_EDTS); i++) {
+        ocrEventSatisfySlot(latchGuid, NULL_GUID, OCR_EVENT_LATCH_INCR_SLOT);
+    }
+
+    ocrGuid_t ewTplGuid;
+    ocrEdtTemplateCreate(&ewTplGuid, ewEdt, 0 /*paramc*/, 2 /*depc*/);
+    ocrGuid_t sharedTplGuid;
+    ocrEdtTemplateCreate(&sharedTplGuid, sharedEdt, 0 /*paramc*/, 2 /*depc*/);
+    ocrGuid_t roTplGuid;
+    ocrEdtTemplateCreate(&roTplGuid, roEdt, 0 /*paramc*/, 2 /*depc*/);
+    for(i = 0; i < NB_EDTS; i++) {
+        ocrGuid_t tplGuid = roTplGuid;
+        ocrDbAccessMode_t mode = DB_MODE_RO;
+        switch(i % 4) {
+        case 1:
+            tplGuid = ewTplGuid;
+            mode = DB_MODE_EW;
+            break;
+        case 2:
+            tplGuid = sharedTplGuid;
+            mode = DB_MODE_RW;
+            break;
+        case 3:
+            tplGuid = sharedTplGuid;
+            mode = DB_MODE_CONST;
+            break;
+        }
+        ocrGuid_t edtGuid;
+        ocrEdtCreate(&edtGuid, tplGuid, EDT_PARAM_DEF, /*paramv=*/NULL, EDT_PARAM_DEF, /*depv=*/NULL,
+                     EDT_PROP_NONE, NULL_HINT, /*outEvent=*/NULL);
+        ocrAddDependence(ctxGuid, edtGuid, 1, DB_MODE_CONST);
+        ocrAddDependence(dataGuid, edtGuid, 0, mode);
+    }
+
+    ocrEventSatisfySlot(latchGuid, NULL_GUID, OCR_EVENT_LATCH_DECR_SLOT);
+    return NULL_GUID;
+}
@@ -0,0 +1,76 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr.h"
+
+/**
+ * DESC: Copy a large datablock (split across several EDTs) and a slice of
+ * a datablock carried by an event with ocrDbCopy
+ */
+
+// Large enough for the copy to be split
+#define NB_ELEM (3*1024*1024/sizeof(u64) + 3)
+#define SLICE_OFFSET 5
+#define SLICE_ELEM 16
+
+ocrGuid_t checkEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 * fullPtr = depv[0].ptr;
+    u64 * slicePtr = depv[1].ptr;
+    u64 i = 0;
+    while (i < NB_ELEM) {
+        ASSERT(fullPtr[i] == i);
+        i++;
+    }
+    i = 0;
+    while (i < SLICE_ELEM) {
+        ASSERT(slicePtr[SLICE_OFFSET + i] == i);
+        i++;
+    }
+    ASSERT(slicePtr[0] == 0);
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t srcGuid, fullGuid, sliceGuid;
+    u64 * srcPtr;
+    u64 * slicePtr;
+    void * fullPtr;
+    ocrDbCreate(&srcGuid, (void **) &srcPtr, sizeof(u64)*NB_ELEM, DB_PROP_NONE, NULL_HINT, NO_ALLOC);
+    ocrDbCreate(&fullGuid, &fullPtr, sizeof(u64)*NB_ELEM, DB_PROP_NONE, NULL_HINT, NO_ALLOC);
+    ocrDbCreate(&sliceGuid, (void **) &slicePtr, sizeof(u64)*(SLICE_OFFSET + SLICE_ELEM), DB_PROP_NONE, NULL_HINT, NO_ALLOC);
+    u64 i = 0;
+    while (i < NB_ELEM) {
+        srcPtr[i] = i;
+        i++;
+    }
+    slicePtr[0] = 0;
+    ocrDbRelease(srcGuid);
+    ocrDbRelease(fullGuid);
+    ocrDbRelease(sliceGuid);
+
+    ocrGuid_t evtGuid;
+    u8 ret = ocrDbCopy(srcGuid, 0, srcGuid, sizeof(u64), sizeof(u64)*2, 0, &evtGuid);
+    ASSERT(ret == OCR_EPERM);
+    ret = ocrDbCopy(sliceGuid, 0, srcGuid, 0, sizeof(u64)*NB_ELEM, 0, &evtGuid);
+    ASSERT(ret == OCR_ENOMEM);
+
+    ocrGuid_t fullEvtGuid, sliceEvtGuid;
+    ret = ocrDbCopy(fullGuid, 0, srcGuid, 0, sizeof(u64)*NB_ELEM, 0, &fullEvtGuid);
+    ASSERT(ret == 0);
+    ocrEventCreate(&evtGuid, OCR_EVENT_STICKY_T, EVT_PROP_TAKES_ARG);
+    ret = ocrDbCopy(sliceGuid, sizeof(u64)*SLICE_OFFSET, evtGuid, 0, sizeof(u64)*SLICE_ELEM, 0, &sliceEvtGuid);
+    ASSERT(ret == 0);
+
+    ocrGuid_t checkTplGuid, checkEdtGuid;
+    ocrEdtTemplateCreate(&checkTplGuid, checkEdt, 0, 2);
+    ocrGuid_t checkDepv[2] = {fullEvtGuid, sliceEvtGuid};
+    ocrEdtCreate(&checkEdtGuid, checkTplGuid, 0, NULL, 2, checkDepv, EDT_PROP_NONE, NULL_HINT, NULL);
+    ocrEdtTemplateDestroy(checkTplGuid);
+
+    ocrEventSatisfy(evtGuid, srcGuid);
+    return NULL_GUID;
+}
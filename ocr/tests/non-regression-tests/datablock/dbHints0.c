@@ -0,0 +1,44 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr.h"
+
+/**
+ * DESC: Create datablocks with each of the DB placement hints, including
+ * some too large for small memories so that the runtime has to fall back
+ */
+
+#define NB_ELEM 1024
+#define NB_LARGE_ELEM (1024*1024)
+
+static void createAndCheck(ocrHintProp_t prop, u64 nbElem) {
+    ocrHint_t dbHint;
+    ocrHintInit(&dbHint, OCR_HINT_DB_T);
+    ocrSetHintValue(&dbHint, prop, 1);
+    ocrGuid_t dbGuid;
+    u64 * dbPtr;
+    u8 res = ocrDbCreate(&dbGuid, (void **) &dbPtr, sizeof(u64)*nbElem, DB_PROP_NONE, &dbHint, NO_ALLOC);
+    ASSERT(res == 0);
+    u64 i;
+    for (i = 0; i < nbElem; i++) {
+        dbPtr[i] = i;
+    }
+    for (i = 0; i < nbElem; i++) {
+        ASSERT(dbPtr[i] == i);
+    }
+    ocrDbDestroy(dbGuid);
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    createAndCheck(OCR_HINT_DB_NEAR, NB_ELEM);
+    createAndCheck(OCR_HINT_DB_INTER, NB_ELEM);
+    createAndCheck(OCR_HINT_DB_FAR, NB_ELEM);
+    createAndCheck(OCR_HINT_DB_HIGHBW, NB_ELEM);
+    createAndCheck(OCR_HINT_DB_HIGHBW, NB_LARGE_ELEM);
+    createAndCheck(OCR_HINT_DB_FAR, NB_LARGE_ELEM);
+    ocrShutdown();
+    return NULL_GUID;
+}
@@ -0,0 +1,105 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr.h"
+
+/**
+ * DESC: Allocate and free chunks inside a datablock with ocrDbMalloc and
+ * ocrDbMallocOffset and use the offsets from other EDTs
+ */
+
+#define DB_SIZE (64*1024)
+#define NB_CHUNKS 32
+
+// Size of the i-th chunk, in u64
+#define CHUNK_ELEM(i) (((i) % 7) * 5 + 1)
+
+ocrGuid_t readOnlyEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 offset;
+    // Allocating requires a writable acquire
+    u8 ret = ocrDbMallocOffset(depv[0].guid, sizeof(u64), &offset);
+    ASSERT(ret == OCR_EACCES);
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+ocrGuid_t checkEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t dbGuid = depv[0].guid;
+    u8 * base = (u8 *) depv[0].ptr;
+    u32 i;
+    u8 ret;
+    for (i = 0; i < NB_CHUNKS; i += 2) {
+        u64 * chunk = (u64 *) (base + paramv[i]);
+        u32 j;
+        for (j = 0; j < CHUNK_ELEM(i); j++) {
+            ASSERT(chunk[j] == ((((u64) i) << 32) | j));
+        }
+        ret = ocrDbFreeOffset(dbGuid, paramv[i]);
+        ASSERT(ret == 0);
+    }
+    // Everything is free again so the free space must have been merged back
+    void * big;
+    ret = ocrDbMalloc(dbGuid, DB_SIZE/2, &big);
+    ASSERT(ret == 0);
+    ret = ocrDbFree(dbGuid, big);
+    ASSERT(ret == 0);
+    ret = ocrDbFree(dbGuid, big);
+    ASSERT(ret == OCR_EINVAL);
+
+    ocrGuid_t roTplGuid, roEdtGuid;
+    ocrEdtTemplateCreate(&roTplGuid, readOnlyEdt, 0, 1);
+    ocrEdtCreate(&roEdtGuid, roTplGuid, 0, NULL, 1, NULL, EDT_PROP_NONE, NULL_HINT, NULL);
+    ocrAddDependence(dbGuid, roEdtGuid, 0, DB_MODE_CONST);
+    ocrEdtTemplateDestroy(roTplGuid);
+    return NULL_GUID;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t plainGuid, dbGuid;
+    void * ptr;
+    u64 offsets[NB_CHUNKS];
+    u64 offset;
+    u8 ret;
+
+    ocrDbCreate(&plainGuid, &ptr, DB_SIZE, DB_PROP_NONE, NULL_HINT, NO_ALLOC);
+    ret = ocrDbMallocOffset(plainGuid, sizeof(u64), &offset);
+    ASSERT(ret == OCR_EINVAL);
+    ocrDbDestroy(plainGuid);
+
+    ret = ocrDbCreate(&dbGuid, &ptr, DB_SIZE, DB_PROP_NO_ACQUIRE, NULL_HINT, ARENA_ALLOC);
+    ASSERT(ret == OCR_EINVAL);
+    ret = ocrDbCreate(&dbGuid, &ptr, DB_SIZE, DB_PROP_NONE, NULL_HINT, ARENA_ALLOC);
+    ASSERT(ret == 0);
+    u8 * base = (u8 *) ptr;
+    ret = ocrDbMallocOffset(dbGuid, DB_SIZE, &offset);
+    ASSERT(ret == OCR_ENOMEM);
+
+    u32 i;
+    for (i = 0; i < NB_CHUNKS; i++) {
+        ret = ocrDbMallocOffset(dbGuid, sizeof(u64) * CHUNK_ELEM(i), &offsets[i]);
+        ASSERT(ret == 0);
+        ASSERT((offsets[i] % sizeof(u64)) == 0);
+        ASSERT((offsets[i] + sizeof(u64) * CHUNK_ELEM(i)) <= DB_SIZE);
+        u64 * chunk = (u64 *) (base + offsets[i]);
+        u32 j;
+        for (j = 0; j < CHUNK_ELEM(i); j++) {
+            chunk[j] = (((u64) i) << 32) | j;
+        }
+    }
+    // Free every other chunk; the others are checked (and freed) by another EDT
+    for (i = 1; i < NB_CHUNKS; i += 2) {
+        ret = ocrDbFree(dbGuid, base + offsets[i]);
+        ASSERT(ret == 0);
+    }
+    ocrDbRelease(dbGuid);
+
+    ocrGuid_t checkTplGuid, checkEdtGuid;
+    ocrEdtTemplateCreate(&checkTplGuid, checkEdt, NB_CHUNKS, 1);
+    ocrEdtCreate(&checkEdtGuid, checkTplGuid, NB_CHUNKS, offsets, 1, &dbGuid,
+                 EDT_PROP_NONE, NULL_HINT, NULL);
+    ocrEdtTemplateDestroy(checkTplGuid);
+    return NULL_GUID;
+}
@@ -0,0 +1,57 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr.h"
+
+/**
+ * DESC: Create datablocks of sizes on both sides of the runtime's small
+ * datablock threshold, check their content in a consumer EDT and destroy them
+ */
+
+#define NB_DBS 7
+
+static u64 dbSizes[NB_DBS] = {1, 8, 64, 4095, 4096, 4097, 65536};
+
+static u8 pattern(u32 db, u64 i) {
+    return (u8) (db * 31 + i);
+}
+
+ocrGuid_t checkEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u32 d;
+    for (d = 0; d < depc; d++) {
+        u8 * ptr = (u8 *) depv[d].ptr;
+        ASSERT(ptr != NULL);
+        u64 i;
+        for (i = 0; i < dbSizes[d]; i++) {
+            ASSERT(ptr[i] == pattern(d, i));
+        }
+        ocrDbDestroy(depv[d].guid);
+    }
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t dbGuids[NB_DBS];
+    u32 d;
+    for (d = 0; d < NB_DBS; d++) {
+        u8 * ptr;
+        u8 res = ocrDbCreate(&dbGuids[d], (void **) &ptr, dbSizes[d], DB_PROP_NONE, NULL_HINT, NO_ALLOC);
+        ASSERT(res == 0);
+        u64 i;
+        for (i = 0; i < dbSizes[d]; i++) {
+            ptr[i] = pattern(d, i);
+        }
+        ocrDbRelease(dbGuids[d]);
+    }
+    ocrGuid_t checkTemplateGuid;
+    ocrEdtTemplateCreate(&checkTemplateGuid, checkEdt, 0, NB_DBS);
+    ocrGuid_t checkEdtGuid;
+    ocrEdtCreate(&checkEdtGuid, checkTemplateGuid, 0, NULL, NB_DBS, dbGuids,
+                 EDT_PROP_NONE, NULL_HINT, NULL);
+    ocrEdtTemplateDestroy(checkTemplateGuid);
+    return NULL_GUID;
+}
@@ -0,0 +1,76 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr.h"
+#include "extensions/ocr-affinity.h"
+
+/**
+ * DESC: OCR-DIST - satisfy a local sticky event that has many EDT waiters spread over all PDs
+ */
+
+// Number of waiters created on each PD
+#define N 64
+
+#define PAYLOAD 0xf00d
+
+ocrGuid_t done(u32 paramc, u64 paramv[], u32 depc, ocrEdtDep_t depv[]) {
+    PRINTF("Success!\n");
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+ocrGuid_t consumer(u32 paramc, u64 paramv[], u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t latchGuid = ((ocrGuid_t *) paramv)[0];
+    u64 * data = (u64 *) depv[0].ptr;
+    ASSERT(data[0] == PAYLOAD);
+    ocrEventSatisfySlot(latchGuid, NULL_GUID, OCR_EVENT_LATCH_DECR_SLOT);
+    return NULL_GUID;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64 paramv[], u32 depc, ocrEdtDep_t depv[]) {
+    u64 affinityCount;
+    ocrAffinityCount(AFFINITY_PD, &affinityCount);
+    ASSERT(affinityCount >= 1);
+    ocrGuid_t affinities[affinityCount];
+    ocrAffinityGet(AFFINITY_PD, &affinityCount, affinities);
+
+    ocrGuid_t latchGuid;
+    ocrEventCreate(&latchGuid, OCR_EVENT_LATCH_T, EVT_PROP_NONE);
+    ocrAddDependence(NULL_GUID, latchGuid, OCR_EVENT_LATCH_INCR_SLOT, DB_MODE_CONST);
+    ocrGuid_t doneTemplateGuid;
+    ocrEdtTemplateCreate(&doneTemplateGuid, done, 0, 1);
+    ocrGuid_t doneGuid;
+    ocrEdtCreate(&doneGuid, doneTemplateGuid, 0, NULL, 1, &latchGuid,
+        EDT_PROP_NONE, NULL_HINT, NULL);
+
+    ocrGuid_t stickyGuid;
+    ocrEventCreate(&stickyGuid, OCR_EVENT_STICKY_T, EVT_PROP_TAKES_ARG);
+
+    // Interleave the affinities so that waiters for the same PD are not contiguous
+    ocrGuid_t consumerTemplateGuid;
+    ocrEdtTemplateCreate(&consumerTemplateGuid, consumer, sizeof(ocrGuid_t)/sizeof(u64), 1);
+    ocrHint_t edtHint;
+    ocrHintInit(&edtHint, OCR_HINT_EDT_T);
+    u64 i, a;
+    for(i = 0; i < N; i++) {
+        for(a = 0; a < affinityCount; a++) {
+            ocrSetHintValue(&edtHint, OCR_HINT_EDT_AFFINITY, ocrAffinityToHintValue(affinities[a]));
+            ocrAddDependence(NULL_GUID, latchGuid, OCR_EVENT_LATCH_INCR_SLOT, DB_MODE_CONST);
+            ocrGuid_t edtGuid;
+            ocrEdtCreate(&edtGuid, consumerTemplateGuid, EDT_PARAM_DEF, (u64 *) &latchGuid, 1, &stickyGuid,
+                EDT_PROP_NONE, &edtHint, NULL);
+        }
+    }
+    ocrAddDependence(NULL_GUID, latchGuid, OCR_EVENT_LATCH_DECR_SLOT, DB_MODE_CONST);
+
+    ocrGuid_t dbGuid;
+    u64 * dbPtr;
+    ocrDbCreate(&dbGuid, (void **) &dbPtr, sizeof(u64), DB_PROP_NONE, NULL_HINT, NO_ALLOC);
+    dbPtr[0] = PAYLOAD;
+    ocrDbRelease(dbGuid);
+    ocrEventSatisfy(stickyGuid, dbGuid);
+    return NULL_GUID;
+}
@@ -0,0 +1,99 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr.h"
+
+/**
+ * DESC: Many EDTs concurrently add dependences from a sticky event while
+ * another EDT satisfies it. The waiter list grows over several overflow
+ * chunks and every consumer must run exactly once.
+ */
+
+#define NB_REGISTRARS 8
+#define NB_CONSUMERS 64
+
+typedef struct {
+    ocrGuid_t evtGuid;
+    ocrGuid_t latchGuid;
+} ctx_t;
+
+ocrGuid_t terminateEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    PRINTF("Everybody checked out\n");
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+ocrGuid_t consumerEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ctx_t * ctx = (ctx_t *) depv[1].ptr;
+    ocrEventSatisfySlot(ctx->latchGuid, NULL_GUID, OCR_EVENT_LATCH_DECR_SLOT);
+    return NULL_GUID;
+}
+
+ocrGuid_t registrarEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ctx_t * ctx = (ctx_t *) depv[0].ptr;
+    ocrGuid_t consumerTplGuid;
+    ocrEdtTemplateCreate(&consumerTplGuid, consumerEdt, 0 /*paramc*/, 2 /*depc*/);
+    u32 i;
+    for(i = 0; i < NB_CONSUMERS; i++) {
+        ocrGuid_t consumerGuid;
+        ocrEdtCreate(&consumerGuid, consumerTplGuid, EDT_PARAM_DEF, /*paramv=*/NULL, EDT_PARAM_DEF, /*depv=*/NULL,
+                     EDT_PROP_NONE, NULL_HINT, /*outEvent=*/NULL);
+        ocrAddDependence(depv[0].guid, consumerGuid, 1, DB_MODE_CONST);
+        ocrAddDependence(ctx->evtGuid, consumerGuid, 0, DB_MODE_CONST);
+    }
+    return NULL_GUID;
+}
+
+ocrGuid_t satisfierEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ctx_t * ctx = (ctx_t *) depv[0].ptr;
+    ocrEventSatisfy(ctx->evtGuid, NULL_GUID);
+    return NULL_GUID;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t evtGuid;
+    ocrEventCreate(&evtGuid, OCR_EVENT_STICKY_T, false);
+    ocrGuid_t latchGuid;
+    ocrEventCreate(&latchGuid, OCR_EVENT_LATCH_T, false);
+
+    ctx_t * ctx;
+    ocrGuid_t ctxGuid;
+    ocrDbCreate(&ctxGuid, (void **)&ctx, sizeof(ctx_t), DB_PROP_NONE, NULL_HINT, NO_ALLOC);
+    ctx->evtGuid = evtGuid;
+    ctx->latchGuid = latchGuid;
+    ocrDbRelease(ctxGuid);
+
+    ocrGuid_t terminateTplGuid;
+    ocrEdtTemplateCreate(&terminateTplGuid, terminateEdt, 0 /*paramc*/, 1 /*depc*/);
+    ocrGuid_t terminateGuid;
+    ocrEdtCreate(&terminateGuid, terminateTplGuid, EDT_PARAM_DEF, /*paramv=*/NULL, EDT_PARAM_DEF, /*depv=*/&latchGuid,
+                 EDT_PROP_NONE, NULL_HINT, /*outEvent=*/NULL);
+
+    // Check in every consumer upfront so that the latch cannot trigger early
+    u32 i;
+    for(i = 0; i < (1 + (NB_REGISTRARS * NB_CONSUMERS)); i++) {
+        ocrEventSatisfySlot(latchGuid, NULL_GUID, OCR_EVENT_LATCH_INCR_SLOT);
+    }
+
+    ocrGuid_t registrarTplGuid;
+    ocrEdtTemplateCreate(&registrarTplGuid, registrarEdt, 0 /*paramc*/, 1 /*depc*/);
+    ocrGuid_t satisfierTplGuid;
+    ocrEdtTemplateCreate(&satisfierTplGuid, satisfierEdt, 0 /*paramc*/, 1 /*depc*/);
+    for(i = 0; i < NB_REGISTRARS; i++) {
+        ocrGuid_t registrarGuid;
+        ocrEdtCreate(&registrarGuid, registrarTplGuid, EDT_PARAM_DEF, /*paramv=*/NULL, EDT_PARAM_DEF, /*depv=*/&ctxGuid,
+                     EDT_PROP_NONE, NULL_HINT, /*outEvent=*/NULL);
+        if (i == (NB_REGISTRARS / 2)) {
+            // Satisfy the event while registrations are in flight
+            ocrGuid_t satisfierGuid;
+            ocrEdtCreate(&satisfierGuid, satisfierTplGuid, EDT_PARAM_DEF, /*paramv=*/NULL, EDT_PARAM_DEF, /*depv=*/&ctxGuid,
+                         EDT_PROP_NONE, NULL_HINT, /*outEvent=*/NULL);
+        }
+    }
+
+    ocrEventSatisfySlot(latchGuid, NULL_GUID, OCR_EVENT_LATCH_DECR_SLOT);
+    return NULL_GUID;
+}
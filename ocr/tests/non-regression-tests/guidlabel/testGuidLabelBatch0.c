@@ -0,0 +1,83 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr.h"
+
+#ifdef ENABLE_EXTENSION_LABELING
+#include "extensions/ocr-labeling.h"
+
+/**
+ * DESC: batched conversions return the same GUIDs as the single ones, for
+ * ranges and maps, including after other maps have been destroyed
+ */
+
+#define NB_GUIDS 64
+#define DIM 8
+
+ocrGuid_t mapFunc(ocrGuid_t startGuid, u64 stride, s64* params, s64* tuple) {
+    ocrGuid_t guid = startGuid;
+    guid.guid += (tuple[0]*params[0] + tuple[1])*stride;
+    return guid;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t guids[NB_GUIDS], batchGuids[NB_GUIDS];
+    u64 i;
+
+    // Indices of a local range then of a distributed one, looked up after
+    // the first range is destroyed
+    ocrGuid_t rangeGuid;
+    ocrGuidRangeCreate(&rangeGuid, NB_GUIDS, GUID_USER_EVENT_STICKY);
+    for (i = 0; i < NB_GUIDS; i++) {
+        ocrGuidFromIndex(&guids[i], rangeGuid, i);
+    }
+    ASSERT(ocrGuidFromIndices(batchGuids, rangeGuid, 0, NB_GUIDS) == 0);
+    for (i = 0; i < NB_GUIDS; i++) {
+        ASSERT(ocrGuidIsEq(guids[i], batchGuids[i]));
+    }
+    ASSERT(ocrGuidFromIndices(batchGuids, rangeGuid, NB_GUIDS/2, NB_GUIDS/2) == 0);
+    ASSERT(ocrGuidIsEq(guids[NB_GUIDS/2], batchGuids[0]));
+    ASSERT(ocrGuidFromIndices(batchGuids, rangeGuid, NB_GUIDS/2, NB_GUIDS/2 + 1) == OCR_EINVAL);
+    ocrGuidMapDestroy(rangeGuid);
+
+    ocrGuidRangeCreateDistributed(&rangeGuid, NB_GUIDS, GUID_USER_DB, GUID_DIST_BLOCK);
+    for (i = 0; i < NB_GUIDS; i++) {
+        ocrGuidFromIndex(&guids[i], rangeGuid, i);
+    }
+    ASSERT(ocrGuidFromIndices(batchGuids, rangeGuid, 0, NB_GUIDS) == 0);
+    for (i = 0; i < NB_GUIDS; i++) {
+        ASSERT(ocrGuidIsEq(guids[i], batchGuids[i]));
+    }
+    ocrGuidMapDestroy(rangeGuid);
+
+    // Labels of a map
+    s64 params[1] = {DIM};
+    s64 tuples[NB_GUIDS*2];
+    ocrGuid_t mapGuid;
+    ocrGuidMapCreate(&mapGuid, 1, mapFunc, params, NB_GUIDS, GUID_USER_EVENT_STICKY);
+    for (i = 0; i < NB_GUIDS; i++) {
+        tuples[2*i] = i / DIM;
+        tuples[2*i+1] = i % DIM;
+        ocrGuidFromLabel(&guids[i], mapGuid, &tuples[2*i]);
+    }
+    ASSERT(ocrGuidFromLabels(batchGuids, mapGuid, tuples, 2, NB_GUIDS) == 0);
+    for (i = 0; i < NB_GUIDS; i++) {
+        ASSERT(ocrGuidIsEq(guids[i], batchGuids[i]));
+    }
+    ocrGuidMapDestroy(mapGuid);
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+#else
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    PRINTF("Test disabled - ENABLE_EXTENSION_LABELING not defined\n");
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+#endif
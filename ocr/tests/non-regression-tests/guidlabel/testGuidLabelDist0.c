@@ -0,0 +1,137 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr.h"
+
+#ifdef ENABLE_EXTENSION_LABELING
+#include "extensions/ocr-affinity.h"
+#include "extensions/ocr-labeling.h"
+
+/**
+ * DESC: distributed GUID ranges: each PD creates the objects owned by its
+ * neighbor, which must end up created exactly once by their owner
+ */
+
+#define NB_GUIDS 40
+
+typedef struct {
+    ocrGuid_t evtRange;
+    ocrGuid_t dbRange;
+    u64 pdId;
+} rangeParams_t;
+
+#define PARAMC (sizeof(rangeParams_t)/sizeof(u64))
+
+// Checks the owner of each index and creates the objects owned by the next PD
+ocrGuid_t createEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    rangeParams_t * params = (rangeParams_t *) paramv;
+    ocrGuid_t evtRange = params->evtRange;
+    ocrGuid_t dbRange = params->dbRange;
+    u64 pdId = params->pdId;
+    u64 nbPds;
+    ocrAffinityCount(AFFINITY_PD, &nbPds);
+    u64 blockSize = (NB_GUIDS + nbPds - 1) / nbPds;
+    u64 target = (pdId + 1) % nbPds;
+    u64 i;
+    for (i = 0; i < NB_GUIDS; i++) {
+        ocrGuid_t evtGuid, dbGuid, affGuid, ownerGuid;
+        u64 count = 1;
+        ocrGuidFromIndex(&evtGuid, evtRange, i);
+        ocrAffinityQuery(evtGuid, &count, &affGuid);
+        ocrAffinityGetAt(AFFINITY_PD, i % nbPds, &ownerGuid);
+        ASSERT(ocrGuidIsEq(affGuid, ownerGuid));
+        ocrGuidFromIndex(&dbGuid, dbRange, i);
+        ocrAffinityQuery(dbGuid, &count, &affGuid);
+        ocrAffinityGetAt(AFFINITY_PD, i / blockSize, &ownerGuid);
+        ASSERT(ocrGuidIsEq(affGuid, ownerGuid));
+        if ((i % nbPds) == target) {
+            u8 retCode = ocrEventCreate(&evtGuid, OCR_EVENT_STICKY_T, GUID_PROP_IS_LABELED | GUID_PROP_CHECK);
+            ASSERT(retCode == 0);
+        }
+        if ((i / blockSize) == target) {
+            void * ptr;
+            u8 retCode = ocrDbCreate(&dbGuid, &ptr, sizeof(u64), GUID_PROP_IS_LABELED | GUID_PROP_CHECK, NULL_HINT, NO_ALLOC);
+            ASSERT(retCode == 0);
+        }
+    }
+    return NULL_GUID;
+}
+
+// Each object exists: a second creation fails
+ocrGuid_t checkEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    rangeParams_t * params = (rangeParams_t *) paramv;
+    ocrGuid_t evtRange = params->evtRange;
+    ocrGuid_t dbRange = params->dbRange;
+    u64 i;
+    for (i = 0; i < NB_GUIDS; i++) {
+        ocrGuid_t evtGuid, dbGuid;
+        void * ptr;
+        ocrGuidFromIndex(&evtGuid, evtRange, i);
+        u8 retCode = ocrEventCreate(&evtGuid, OCR_EVENT_STICKY_T, GUID_PROP_IS_LABELED | GUID_PROP_CHECK);
+        ASSERT(retCode == OCR_EGUIDEXISTS);
+        ocrEventDestroy(evtGuid);
+        ocrGuidFromIndex(&dbGuid, dbRange, i);
+        retCode = ocrDbCreate(&dbGuid, &ptr, sizeof(u64), GUID_PROP_IS_LABELED | GUID_PROP_CHECK, NULL_HINT, NO_ALLOC);
+        ASSERT(retCode == OCR_EGUIDEXISTS);
+        ocrDbDestroy(dbGuid);
+    }
+    ocrGuidMapDestroy(evtRange);
+    ocrGuidMapDestroy(dbRange);
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+ocrGuid_t spawnEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 nbPds;
+    ocrAffinityCount(AFFINITY_PD, &nbPds);
+    ocrGuid_t createTplGuid;
+    ocrEdtTemplateCreate(&createTplGuid, createEdt, PARAMC, 0);
+    rangeParams_t params = *((rangeParams_t *) paramv);
+    u64 i;
+    for (i = 0; i < nbPds; i++) {
+        params.pdId = i;
+        ocrGuid_t affGuid;
+        ocrAffinityGetAt(AFFINITY_PD, i, &affGuid);
+        ocrHint_t edtHint;
+        ocrHintInit(&edtHint, OCR_HINT_EDT_T);
+        ocrSetHintValue(&edtHint, OCR_HINT_EDT_AFFINITY, ocrAffinityToHintValue(affGuid));
+        ocrGuid_t edtGuid;
+        ocrEdtCreate(&edtGuid, createTplGuid, PARAMC, (u64 *) &params, 0, NULL, EDT_PROP_NONE, &edtHint, NULL);
+    }
+    ocrEdtTemplateDestroy(createTplGuid);
+    return NULL_GUID;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t evtRange, dbRange;
+    ocrGuidRangeCreateDistributed(&evtRange, NB_GUIDS, GUID_USER_EVENT_STICKY, GUID_DIST_CYCLIC);
+    ocrGuidRangeCreateDistributed(&dbRange, NB_GUIDS, GUID_USER_DB, GUID_DIST_BLOCK);
+    rangeParams_t params;
+    params.evtRange = evtRange;
+    params.dbRange = dbRange;
+    params.pdId = 0;
+
+    ocrGuid_t spawnTplGuid, checkTplGuid;
+    ocrEdtTemplateCreate(&spawnTplGuid, spawnEdt, PARAMC, 0);
+    ocrEdtTemplateCreate(&checkTplGuid, checkEdt, PARAMC, 1);
+    ocrGuid_t spawnGuid, spawnOutGuid, checkGuid;
+    ocrEdtCreate(&checkGuid, checkTplGuid, PARAMC, (u64 *) &params, 1, NULL, EDT_PROP_NONE, NULL_HINT, NULL);
+    ocrEdtCreate(&spawnGuid, spawnTplGuid, PARAMC, (u64 *) &params, 0, NULL, EDT_PROP_FINISH, NULL_HINT, &spawnOutGuid);
+    ocrAddDependence(spawnOutGuid, checkGuid, 0, DB_MODE_CONST);
+    ocrEdtTemplateDestroy(spawnTplGuid);
+    ocrEdtTemplateDestroy(checkTplGuid);
+    return NULL_GUID;
+}
+
+#else
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    PRINTF("Test disabled - ENABLE_EXTENSION_LABELING not defined\n");
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+#endif
@@ -0,0 +1,109 @@
+/*
+ * This file is subject to the license agreement located in the file LICENSE
+ * and cannot be distributed without it. This notice cannot be
+ * removed or modified.
+ */
+
+#include "ocr.h"
+
+/**
+ * DESC: RT-API: Test 'ocrDbPlacementStats'. Creates data-blocks with each of
+ * the DB placement hints and checks where the runtime says it put them.
+ * Only checks something when data-block placement is on and its statistics
+ * are built in (HC_DB_PLACEMENT_STATS), for instance with the
+ * jenkins-numa-2n-highbw-lockableDB.cfg machine configuration.
+ */
+
+// Only tested when OCR runtime API is available
+#ifdef ENABLE_EXTENSION_RTITF
+
+#include "extensions/ocr-runtime-itf.h"
+
+#define MAX_NODES 8
+#define SMALL_SIZE 1024
+// Larger than any high-bandwidth memory of the test configurations
+#define LARGE_SIZE (4*1024*1024)
+
+typedef struct {
+    u32 nodeCount;
+    u64 count[MAX_NODES];
+    u64 fallbacks[MAX_NODES];
+} placementStats_t;
+
+static void readStats(placementStats_t * stats) {
+    u32 n;
+    u64 nodeId;
+    for (n = 0; n < MAX_NODES; n++) {
+        if (ocrDbPlacementStats(n, &nodeId, &(stats->count[n]), &(stats->fallbacks[n])) != 0)
+            break;
+    }
+    stats->nodeCount = n;
+}
+
+// Creates a data-block and returns the index of the node it was placed on
+static u32 createAndLocate(ocrHintProp_t prop, u64 size, bool * fellBack) {
+    placementStats_t before, after;
+    readStats(&before);
+    ocrHint_t dbHint;
+    ocrHintInit(&dbHint, OCR_HINT_DB_T);
+    ocrSetHintValue(&dbHint, prop, 1);
+    ocrGuid_t dbGuid;
+    u64 * dbPtr;
+    u8 res = ocrDbCreate(&dbGuid, (void **) &dbPtr, size, DB_PROP_NONE, &dbHint, NO_ALLOC);
+    ASSERT(res == 0);
+    readStats(&after);
+    ASSERT(after.nodeCount == before.nodeCount);
+    // Exactly one node got exactly one data-block
+    u32 n, placedNode = after.nodeCount;
+    for (n = 0; n < after.nodeCount; n++) {
+        if (after.count[n] != before.count[n]) {
+            ASSERT(placedNode == after.nodeCount);
+            ASSERT(after.count[n] == (before.count[n] + 1));
+            placedNode = n;
+        } else {
+            ASSERT(after.fallbacks[n] == before.fallbacks[n]);
+        }
+    }
+    ASSERT(placedNode < after.nodeCount);
+    ASSERT(after.fallbacks[placedNode] <= (before.fallbacks[placedNode] + 1));
+    *fellBack = (after.fallbacks[placedNode] != before.fallbacks[placedNode]);
+    ocrDbDestroy(dbGuid);
+    return placedNode;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    placementStats_t stats;
+    readStats(&stats);
+    if (stats.nodeCount == 0) {
+        PRINTF("No DB placement statistics\n");
+        ocrShutdown();
+        return NULL_GUID;
+    }
+    bool fellBack;
+    // Small data-blocks always fit in the preferred memory. Which node that
+    // is depends on where the worker runs, so only the counters are checked
+    u32 nearNode = createAndLocate(OCR_HINT_DB_NEAR, SMALL_SIZE, &fellBack);
+    ASSERT(!fellBack);
+    createAndLocate(OCR_HINT_DB_INTER, SMALL_SIZE, &fellBack);
+    ASSERT(!fellBack);
+    createAndLocate(OCR_HINT_DB_FAR, SMALL_SIZE, &fellBack);
+    ASSERT(!fellBack);
+    createAndLocate(OCR_HINT_DB_HIGHBW, SMALL_SIZE, &fellBack);
+    ASSERT(!fellBack);
+    // Does not fit in high-bandwidth memory: still created, wherever it is
+    createAndLocate(OCR_HINT_DB_HIGHBW, LARGE_SIZE, &fellBack);
+    PRINTF("DB placement: %"PRIu32" nodes, near node %"PRIu32", large high-bandwidth DB %s\n",
+           stats.nodeCount, nearNode, fellBack ? "fell back" : "placed as asked");
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+#else
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    PRINTF("No RT API\n");
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+#endif
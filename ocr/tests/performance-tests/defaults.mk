@@ -38,7 +38,7 @@ DB_NB_ELT ?= 10
 # Size of each unit in the above
 DB_TYPE ?= u64
 
-C_DEFINES := -DENABLE_EXTENSION_AFFINITY -DENABLE_EXTENSION_RTITF -DENABLE_EXTENSION_PARAMS_EVT -DENABLE_EXTENSION_COUNTED_EVT \
+C_DEFINES := -DENABLE_EXTENSION_AFFINITY -DENABLE_EXTENSION_RTITF -DENABLE_EXTENSION_PARAMS_EVT -DENABLE_EXTENSION_COUNTED_EVT -DENABLE_EXTENSION_LABELING \
              -DDB_NBS=$(DB_NBS) -DNB_EVT_COUNTED_DEPS=$(NB_EVT_COUNTED_DEPS) -DNB_ITERS=$(NB_ITERS) -DNB_INSTANCES=$(NB_INSTANCES)\
              -DDEPV_SZ=$(DEPV_SZ) -DPARAMC_SZ=$(PARAMC_SZ) -DFAN_OUT=$(FAN_OUT)\
              -DDB_SZ=$(DB_SZ) -DNODE_FANOUT=$(NODE_FANOUT)\
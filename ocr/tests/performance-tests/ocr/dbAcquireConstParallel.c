@@ -0,0 +1,94 @@
+#include "perfs.h"
+#include "ocr.h"
+
+// DESC: NB_WORKERS * NB_INSTANCES EDTs all depend on the same datablock in
+//       DB_ACCESS_MODE (DB_MODE_CONST by default) and are released together.
+//       Stresses concurrent read-only acquisition and release of a single DB.
+// TIME: From the release of the EDTs to the completion of the last one
+// FREQ: Done once
+//
+// VARIABLES:
+// - NB_INSTANCES
+// - NB_WORKERS
+// - DB_ACCESS_MODE: DB_MODE_CONST or DB_MODE_RO
+
+#ifndef DB_ACCESS_MODE
+#define DB_ACCESS_MODE DB_MODE_CONST
+#endif
+
+#define NB_READERS (NB_WORKERS * NB_INSTANCES)
+
+ocrGuid_t sinkEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    timestamp_t stop;
+    get_time(&stop);
+    timestamp_t * start = (timestamp_t *) depv[2].ptr;
+    print_throughput("Acquire", NB_READERS, usec_to_sec(elapsed_usec(start, &stop)));
+    ocrDbDestroy(depv[0].guid);
+    ocrDbDestroy(depv[2].guid);
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+ocrGuid_t readerEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    DB_TYPE * data = (DB_TYPE *) depv[1].ptr;
+    // Touch the data so that the acquisition is not optimized away
+    return (data[0] == 0) ? NULL_GUID : NULL_GUID;
+}
+
+ocrGuid_t spawnEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t dbGuid = depv[0].guid;
+    ocrGuid_t startEvtGuid;
+    ocrEventCreate(&startEvtGuid, OCR_EVENT_STICKY_T, false);
+    ocrGuid_t readerTemplateGuid;
+    ocrEdtTemplateCreate(&readerTemplateGuid, readerEdt, 0, 2);
+    u32 i;
+    for (i = 0; i < NB_READERS; i++) {
+        ocrGuid_t readerGuid;
+        ocrEdtCreate(&readerGuid, readerTemplateGuid, 0, NULL, 2, NULL,
+                     EDT_PROP_NONE, NULL_HINT, NULL);
+        ocrAddDependence(dbGuid, readerGuid, 1, DB_ACCESS_MODE);
+        ocrAddDependence(startEvtGuid, readerGuid, 0, DB_MODE_CONST);
+    }
+    ocrEdtTemplateDestroy(readerTemplateGuid);
+    // The timer starts once every reader is set up and only waits on the start event
+    timestamp_t * start = (timestamp_t *) depv[1].ptr;
+    get_time(start);
+    ocrEventSatisfy(startEvtGuid, NULL_GUID);
+    ocrEventDestroy(startEvtGuid);
+    return NULL_GUID;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    DB_TYPE * data;
+    ocrGuid_t dbGuid;
+    ocrDbCreate(&dbGuid, (void **) &data, sizeof(DB_TYPE) * DB_NB_ELT, 0, NULL_HINT, NO_ALLOC);
+    data[0] = 1;
+    ocrDbRelease(dbGuid);
+
+    timestamp_t * start;
+    ocrGuid_t timerDbGuid;
+    ocrDbCreate(&timerDbGuid, (void **) &start, sizeof(timestamp_t), 0, NULL_HINT, NO_ALLOC);
+    ocrDbRelease(timerDbGuid);
+
+    ocrGuid_t sinkTemplateGuid;
+    ocrEdtTemplateCreate(&sinkTemplateGuid, sinkEdt, 0, 3);
+    ocrGuid_t sinkGuid;
+    ocrEdtCreate(&sinkGuid, sinkTemplateGuid, 0, NULL, 3, NULL,
+                 EDT_PROP_NONE, NULL_HINT, NULL);
+
+    // The finish EDT only completes once all the readers are done
+    ocrGuid_t spawnTemplateGuid;
+    ocrEdtTemplateCreate(&spawnTemplateGuid, spawnEdt, 0, 2);
+    ocrGuid_t spawnGuid;
+    ocrGuid_t spawnOutputGuid;
+    ocrEdtCreate(&spawnGuid, spawnTemplateGuid, 0, NULL, 2, NULL,
+                 EDT_PROP_FINISH, NULL_HINT, &spawnOutputGuid);
+    ocrAddDependence(dbGuid, sinkGuid, 0, DB_MODE_RW);
+    ocrAddDependence(spawnOutputGuid, sinkGuid, 1, DB_MODE_CONST);
+    ocrAddDependence(timerDbGuid, sinkGuid, 2, DB_MODE_CONST);
+    ocrAddDependence(dbGuid, spawnGuid, 0, DB_MODE_CONST);
+    ocrAddDependence(timerDbGuid, spawnGuid, 1, DB_MODE_RW);
+    ocrEdtTemplateDestroy(spawnTemplateGuid);
+    ocrEdtTemplateDestroy(sinkTemplateGuid);
+    return NULL_GUID;
+}
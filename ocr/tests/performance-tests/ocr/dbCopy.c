@@ -0,0 +1,84 @@
+#include "perfs.h"
+#include "ocr.h"
+
+// DESC: NB_INSTANCES concurrent ocrDbCopy of COPY_SIZE bytes between two
+//       datablocks. Copies larger than the runtime's chunk size are split
+//       across workers.
+// TIME: From the first ocrDbCopy call to the completion of the last copy
+// FREQ: Done once
+//
+// VARIABLES:
+// - NB_INSTANCES
+// - COPY_SIZE: Number of bytes copied by each call
+
+#ifndef COPY_SIZE
+#define COPY_SIZE (4*1024*1024)
+#endif
+
+ocrGuid_t sinkEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    timestamp_t stop;
+    get_time(&stop);
+    timestamp_t * start = (timestamp_t *) depv[3].ptr;
+    double elapsed = usec_to_sec(elapsed_usec(start, &stop));
+    print_throughput("Copy", NB_INSTANCES, elapsed);
+    PRINTF("MB/s: %f\n", (((double) COPY_SIZE) * NB_INSTANCES) / (elapsed * 1024 * 1024));
+    ocrDbDestroy(depv[0].guid);
+    ocrDbDestroy(depv[1].guid);
+    ocrDbDestroy(depv[3].guid);
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+ocrGuid_t spawnEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t * dbGuids = (ocrGuid_t *) paramv;
+    timestamp_t * start = (timestamp_t *) depv[0].ptr;
+    get_time(start);
+    // All copies write the same bytes so they are allowed to overlap
+    u32 i;
+    for (i = 0; i < NB_INSTANCES; i++) {
+        ocrDbCopy(dbGuids[0], 0, dbGuids[1], 0, COPY_SIZE, 0, NULL);
+    }
+    return NULL_GUID;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    char * data;
+    ocrGuid_t srcGuid, dstGuid;
+    ocrDbCreate(&srcGuid, (void **) &data, COPY_SIZE, 0, NULL_HINT, NO_ALLOC);
+    u64 i;
+    for (i = 0; i < COPY_SIZE; i++) {
+        data[i] = (char) i;
+    }
+    ocrDbRelease(srcGuid);
+    ocrDbCreate(&dstGuid, (void **) &data, COPY_SIZE, 0, NULL_HINT, NO_ALLOC);
+    ocrDbRelease(dstGuid);
+
+    timestamp_t * start;
+    ocrGuid_t timerDbGuid;
+    ocrDbCreate(&timerDbGuid, (void **) &start, sizeof(timestamp_t), 0, NULL_HINT, NO_ALLOC);
+    ocrDbRelease(timerDbGuid);
+
+    ocrGuid_t sinkTemplateGuid;
+    ocrEdtTemplateCreate(&sinkTemplateGuid, sinkEdt, 0, 4);
+    ocrGuid_t sinkGuid;
+    ocrEdtCreate(&sinkGuid, sinkTemplateGuid, 0, NULL, 4, NULL,
+                 EDT_PROP_NONE, NULL_HINT, NULL);
+
+    // The finish EDT only completes once all the copies are done
+    ocrGuid_t spawnTemplateGuid;
+    u32 spawnParamc = (sizeof(ocrGuid_t) * 2 + sizeof(u64) - 1) / sizeof(u64);
+    ocrEdtTemplateCreate(&spawnTemplateGuid, spawnEdt, spawnParamc, 1);
+    ocrGuid_t dbGuids[2] = {dstGuid, srcGuid};
+    ocrGuid_t spawnGuid;
+    ocrGuid_t spawnOutputGuid;
+    ocrEdtCreate(&spawnGuid, spawnTemplateGuid, spawnParamc, (u64 *) dbGuids, 1, NULL,
+                 EDT_PROP_FINISH, NULL_HINT, &spawnOutputGuid);
+    ocrAddDependence(dstGuid, sinkGuid, 0, DB_MODE_RW);
+    ocrAddDependence(srcGuid, sinkGuid, 1, DB_MODE_RW);
+    ocrAddDependence(spawnOutputGuid, sinkGuid, 2, DB_MODE_CONST);
+    ocrAddDependence(timerDbGuid, sinkGuid, 3, DB_MODE_CONST);
+    ocrAddDependence(timerDbGuid, spawnGuid, 0, DB_MODE_RW);
+    ocrEdtTemplateDestroy(spawnTemplateGuid);
+    ocrEdtTemplateDestroy(sinkTemplateGuid);
+    return NULL_GUID;
+}
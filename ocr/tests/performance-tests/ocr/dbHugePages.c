@@ -0,0 +1,125 @@
+#include "perfs.h"
+#include "ocr.h"
+
+#include <string.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// DESC: Touches one u64 per page of a DB_BYTES datablock in a scattered order,
+//       then streams over the whole datablock. With ordinary pages nearly every
+//       scattered access misses in the TLB.
+// TIME: Duration of the scattered walk and of the stream, accumulated over the walks
+// FREQ: Done 'NB_WALKS' times
+//
+// VARIABLES:
+// - DB_BYTES: Size of the datablock
+// - NB_WALKS
+//
+// Compare a run with CFGARG_HUGEPAGES=none against one with
+// CFGARG_HUGEPAGES=transparent (or explicit). Only datablocks carved out of the
+// mem-platform pool are affected: use a pool allocator (CFGARG_ALLOCTYPE=quick)
+// and size it for DB_BYTES with CFGARG_ALLOC (in MB).
+// dTLB misses are read from perf_event when the kernel allows it.
+
+#ifndef DB_BYTES
+#define DB_BYTES (256*1024*1024)
+#endif
+
+#ifndef NB_WALKS
+#define NB_WALKS 10
+#endif
+
+#define PAGE_BYTES 4096
+// Odd multiplier so that the walk visits every page once when the page count is a power of 2
+#define WALK_MULT 40503
+
+static int openTlbCounter() {
+#ifdef __linux__
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int) syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+    return -1;
+#endif
+}
+
+static u64 readTlbCounter(int fd) {
+    u64 value = 0;
+#ifdef __linux__
+    if ((fd < 0) || (read(fd, &value, sizeof(value)) != sizeof(value)))
+        value = 0;
+#endif
+    return value;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 * data;
+    ocrGuid_t dataGuid;
+    ocrDbCreate(&dataGuid, (void **) &data, DB_BYTES, DB_PROP_NONE, NULL_HINT, NO_ALLOC);
+    u64 nbElems = DB_BYTES / sizeof(u64);
+    u64 nbPages = DB_BYTES / PAGE_BYTES;
+    u64 elemsPerPage = PAGE_BYTES / sizeof(u64);
+    u64 i;
+    for (i = 0; i < nbElems; i++) {
+        data[i] = i;
+    }
+
+    int tlbFd = openTlbCounter();
+    u64 walkTlbMisses = 0, streamTlbMisses = 0, before;
+    long walkTimer = 0, streamTimer = 0;
+    volatile u64 sum = 0;
+    u32 it;
+    for (it = 0; it < NB_WALKS; it++) {
+        timestamp_t start, stop;
+        u64 acc = 0;
+        before = readTlbCounter(tlbFd);
+#ifdef __linux__
+        if (tlbFd >= 0) ioctl(tlbFd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+        get_time(&start);
+        for (i = 0; i < nbPages; i++) {
+            acc += data[((i * WALK_MULT) % nbPages) * elemsPerPage];
+        }
+        get_time(&stop);
+        walkTimer += elapsed_usec(&start, &stop);
+        walkTlbMisses += readTlbCounter(tlbFd) - before;
+
+        before = readTlbCounter(tlbFd);
+        get_time(&start);
+        for (i = 0; i < nbElems; i++) {
+            acc += data[i];
+        }
+        get_time(&stop);
+#ifdef __linux__
+        if (tlbFd >= 0) ioctl(tlbFd, PERF_EVENT_IOC_DISABLE, 0);
+#endif
+        streamTimer += elapsed_usec(&start, &stop);
+        streamTlbMisses += readTlbCounter(tlbFd) - before;
+        sum += acc;
+    }
+
+    print_throughput("PageWalk", ((unsigned long long) NB_WALKS) * nbPages, usec_to_sec(walkTimer));
+    PRINTF("Stream MB/s: %f\n", (((double) DB_BYTES) * NB_WALKS) / (usec_to_sec(streamTimer) * 1024 * 1024));
+    if (tlbFd >= 0) {
+        PRINTF("dTLB misses per page walked: %f\n", ((double) walkTlbMisses) / (((double) NB_WALKS) * nbPages));
+        PRINTF("dTLB misses per MB streamed: %f\n", ((double) streamTlbMisses) / (((double) DB_BYTES) * NB_WALKS / (1024 * 1024)));
+        close(tlbFd);
+    } else {
+        PRINTF("dTLB misses: not available (perf_event_open failed)\n");
+    }
+
+    ocrDbDestroy(dataGuid);
+    ocrShutdown();
+    return NULL_GUID;
+}
@@ -0,0 +1,51 @@
+#include "perfs.h"
+#include "ocr.h"
+
+// DESC: Carve NB_INSTANCES chunks of CHUNK_SIZE bytes out of one ARENA_ALLOC
+//       datablock with ocrDbMallocOffset, then free them all
+// TIME: Duration of all the allocations, then of all the frees
+// FREQ: Done once
+//
+// VARIABLES:
+// - NB_INSTANCES
+// - CHUNK_SIZE: Number of bytes requested by each allocation
+
+#ifndef CHUNK_SIZE
+#define CHUNK_SIZE 64
+#endif
+
+// Leave room for the allocator's header and per chunk overhead
+#define ARENA_SIZE (((u64) NB_INSTANCES) * (CHUNK_SIZE + 2*sizeof(u64)) + 4096)
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    void * ptr;
+    ocrGuid_t arenaGuid;
+    ocrDbCreate(&arenaGuid, &ptr, ARENA_SIZE, DB_PROP_NONE, NULL_HINT, ARENA_ALLOC);
+    u64 * offsets;
+    ocrGuid_t offsetsGuid;
+    ocrDbCreate(&offsetsGuid, (void **) &offsets, sizeof(u64) * NB_INSTANCES, DB_PROP_NONE, NULL_HINT, NO_ALLOC);
+
+    timestamp_t start, mid, stop;
+    u64 i;
+    u8 retval = 0;
+    get_time(&start);
+    for (i = 0; i < NB_INSTANCES; i++) {
+        retval |= ocrDbMallocOffset(arenaGuid, CHUNK_SIZE, &offsets[i]);
+    }
+    get_time(&mid);
+    for (i = 0; i < NB_INSTANCES; i++) {
+        retval |= ocrDbFreeOffset(arenaGuid, offsets[i]);
+    }
+    get_time(&stop);
+    if (retval) {
+        PRINTF("Invalid run! Please check that ARENA_SIZE fits NB_INSTANCES chunks\n");
+    }
+
+    print_throughput("Malloc", NB_INSTANCES, usec_to_sec(elapsed_usec(&start, &mid)));
+    print_throughput("Free", NB_INSTANCES, usec_to_sec(elapsed_usec(&mid, &stop)));
+
+    ocrDbDestroy(offsetsGuid);
+    ocrDbDestroy(arenaGuid);
+    ocrShutdown();
+    return NULL_GUID;
+}
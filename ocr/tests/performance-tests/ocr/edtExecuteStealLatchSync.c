@@ -0,0 +1,79 @@
+#include "perfs.h"
+#include "ocr.h"
+
+// DESC: One worker creates all the tasks while the other workers
+//       steal them. Tasks are pushed faster than they are stolen so
+//       that the creator's work-stealing deque keeps growing.
+//       Sink EDT depends on a latch event all tasks satisfy on decrement slot.
+// TIME: Completion of all tasks
+// FREQ: Create 'NB_INSTANCES' EDTs once
+//
+// VARIABLES:
+// - NB_INSTANCES
+// - NB_ITERS: amount of busy work in each task
+
+ocrGuid_t terminateEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    timestamp_t * timers = (timestamp_t *) depv[1].ptr;
+    get_time(&timers[2]);
+    print_throughput("Creation", NB_INSTANCES, elapsed_sec(&timers[0], &timers[1]));
+    summary_throughput_timer(&timers[0], &timers[2], NB_INSTANCES);
+    ocrShutdown(); // This is the last EDT to execute, terminate
+    return NULL_GUID;
+}
+
+ocrGuid_t workEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t evLchGuid = *((ocrGuid_t *) paramv);
+    volatile u64 acc = 0;
+    u64 i;
+    for (i = 0; i < NB_ITERS; i++) {
+        acc += i;
+    }
+    ocrEventSatisfySlot(evLchGuid, NULL_GUID, OCR_EVENT_LATCH_DECR_SLOT);
+    return NULL_GUID;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t terminateEdtTemplateGuid;
+    // Latch events to synchronize + timer DB
+    ocrEdtTemplateCreate(&terminateEdtTemplateGuid, terminateEdt, 0, 2);
+
+    ocrGuid_t terminateEdtGuid;
+    ocrEdtCreate(&terminateEdtGuid, terminateEdtTemplateGuid,
+                 0, NULL, 2, NULL, EDT_PROP_NONE, NULL_HINT, NULL);
+
+    ocrGuid_t evLchGuid;
+    ocrEventCreate(&evLchGuid, OCR_EVENT_LATCH_T, false);
+    ocrAddDependence(evLchGuid, terminateEdtGuid, 0, DB_MODE_CONST);
+
+    u64 k = 0;
+    while (k < (NB_INSTANCES+1)) {
+        // incr for number of edt + mainEdt
+        ocrEventSatisfySlot(evLchGuid, NULL_GUID, OCR_EVENT_LATCH_INCR_SLOT);
+        k++;
+    }
+
+    timestamp_t * dbPtr;
+    ocrGuid_t dbGuid;
+    ocrDbCreate(&dbGuid, (void **)&dbPtr, (sizeof(timestamp_t)*3), 0, NULL_HINT, NO_ALLOC);
+
+    get_time(&dbPtr[0]);
+
+    ocrGuid_t workEdtTemplateGuid;
+    ocrEdtTemplateCreate(&workEdtTemplateGuid, workEdt, 1, 0);
+
+    u64 i = 0;
+    while (i < NB_INSTANCES) {
+        ocrGuid_t workEdtGuid;
+        ocrEdtCreate(&workEdtGuid, workEdtTemplateGuid,
+                     1, (u64 *) &evLchGuid, 0, NULL, EDT_PROP_NONE, NULL_HINT, NULL);
+        i++;
+    }
+    ocrEdtTemplateDestroy(workEdtTemplateGuid);
+
+    get_time(&dbPtr[1]);
+    ocrDbRelease(dbGuid);
+    ocrAddDependence(dbGuid, terminateEdtGuid, 1, DB_MODE_CONST);
+
+    ocrEventSatisfySlot(evLchGuid, NULL_GUID, OCR_EVENT_LATCH_DECR_SLOT);
+    return NULL_GUID;
+}
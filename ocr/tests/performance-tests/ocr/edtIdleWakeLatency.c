@@ -0,0 +1,72 @@
+#include "perfs.h"
+#include "ocr.h"
+
+#include <time.h>
+#include <unistd.h>
+
+// DESC: A chain of EDTs where each EDT sleeps for an idle gap, creates its
+//       successor and sleeps again, holding on to its worker but not to
+//       a core. All other workers are idle during the gaps and the successor
+//       has to be picked up by one of them.
+//       Reports the average time between the creation of an EDT and
+//       the start of its execution (wake-up latency) and the process
+//       CPU time spent per second of wall time (idle CPU usage).
+// TIME: Completion of the chain
+// FREQ: Create 'NB_INSTANCES' EDTs one after the other
+//
+// VARIABLES:
+// - NB_INSTANCES: length of the chain
+// - NB_ITERS: idle gap in microseconds
+
+#define PARAMC 5
+
+static u64 now_usec() {
+    timestamp_t t;
+    get_time(&t);
+    return ((u64) t.tv_sec) * 1000000ULL + t.tv_usec;
+}
+
+// paramv[0]: remaining EDTs in the chain
+// paramv[1]: creation time of this EDT (usec)
+// paramv[2]: accumulated wake-up latency (usec)
+// paramv[3]: process CPU time at the start of the chain (clock ticks)
+// paramv[4]: start time of the chain (usec)
+ocrGuid_t chainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 start = now_usec();
+    u64 latency = paramv[2] + (start - paramv[1]);
+    if (paramv[0] == 0) {
+        double wallSec = ((double) (now_usec() - paramv[4])) / 1000000;
+        double cpuSec = ((double) (clock() - (clock_t) paramv[3])) / CLOCKS_PER_SEC;
+        PRINTF("Wake latency (us) : %f\n", ((double) latency) / (NB_INSTANCES+1));
+        PRINTF("CPU time      (s) : %f\n", cpuSec);
+        PRINTF("CPU per wall sec  : %f\n", cpuSec / wallSec);
+        summary_throughput_dbl(wallSec, NB_INSTANCES);
+        ocrShutdown();
+        return NULL_GUID;
+    }
+    usleep(NB_ITERS);
+    ocrGuid_t chainTemplateGuid;
+    ocrEdtTemplateCreate(&chainTemplateGuid, chainEdt, PARAMC, 0);
+    u64 nparamv[PARAMC] = {paramv[0] - 1, 0, latency, paramv[3], paramv[4]};
+    nparamv[1] = now_usec();
+    ocrGuid_t nextGuid;
+    ocrEdtCreate(&nextGuid, chainTemplateGuid, PARAMC, nparamv, 0, NULL,
+                 EDT_PROP_NONE, NULL_HINT, NULL);
+    ocrEdtTemplateDestroy(chainTemplateGuid);
+    // Hold this worker so that the successor is run by an idle worker
+    usleep(NB_ITERS);
+    return NULL_GUID;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t chainTemplateGuid;
+    ocrEdtTemplateCreate(&chainTemplateGuid, chainEdt, PARAMC, 0);
+    u64 start = now_usec();
+    u64 nparamv[PARAMC] = {NB_INSTANCES, start, 0, (u64) clock(), start};
+    ocrGuid_t chainGuid;
+    ocrEdtCreate(&chainGuid, chainTemplateGuid, PARAMC, nparamv, 0, NULL,
+                 EDT_PROP_NONE, NULL_HINT, NULL);
+    ocrEdtTemplateDestroy(chainTemplateGuid);
+    return NULL_GUID;
+}
+#include "helper.h"
@@ -0,0 +1,83 @@
+#include "perfs.h"
+#include "ocr.h"
+
+// DESC: NB_WORKERS EDTs concurrently create NB_INSTANCES sticky events each,
+//       then destroy them. Stresses concurrent GUID generation.
+// TIME: Creation of the events, measured in each EDT. The slowest EDT
+//       determines the aggregate rate.
+// FREQ: Done once per EDT.
+//
+// VARIABLES:
+// - NB_INSTANCES
+// - NB_WORKERS
+
+ocrGuid_t sinkEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    long maxTimer = 0;
+    u32 i;
+    for (i = 0; i < depc; i++) {
+        long * timer = (long *) depv[i].ptr;
+        if (*timer > maxTimer) {
+            maxTimer = *timer;
+        }
+        ocrDbDestroy(depv[i].guid);
+    }
+    print_throughput("Creation", NB_WORKERS * NB_INSTANCES, usec_to_sec(maxTimer));
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+ocrGuid_t createEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t * evtGuids;
+    ocrGuid_t evtDbGuid;
+    ocrDbCreate(&evtDbGuid, (void **) &evtGuids, sizeof(ocrGuid_t) * NB_INSTANCES, 0, NULL_HINT, NO_ALLOC);
+    timestamp_t start;
+    timestamp_t stop;
+    get_time(&start);
+    u32 i = 0;
+    while (i < NB_INSTANCES) {
+        ocrEventCreate(&evtGuids[i], OCR_EVENT_STICKY_T, false);
+        i++;
+    }
+    get_time(&stop);
+    i = 0;
+    while (i < NB_INSTANCES) {
+        ocrEventDestroy(evtGuids[i]);
+        i++;
+    }
+    ocrDbDestroy(evtDbGuid);
+    // Hand the creation time over to the sink through the output event
+    long * timer;
+    ocrGuid_t timerDbGuid;
+    ocrDbCreate(&timerDbGuid, (void **) &timer, sizeof(long), 0, NULL_HINT, NO_ALLOC);
+    *timer = elapsed_usec(&start, &stop);
+    ocrDbRelease(timerDbGuid);
+    return timerDbGuid;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t sinkTemplateGuid;
+    ocrEdtTemplateCreate(&sinkTemplateGuid, sinkEdt, 0, NB_WORKERS);
+    ocrGuid_t sinkGuid;
+    ocrEdtCreate(&sinkGuid, sinkTemplateGuid, 0, NULL, NB_WORKERS, NULL,
+                 EDT_PROP_NONE, NULL_HINT, NULL);
+
+    // Start all the creating EDTs together once their outputs are wired to the sink
+    ocrGuid_t startEvtGuid;
+    ocrEventCreate(&startEvtGuid, OCR_EVENT_STICKY_T, false);
+    ocrGuid_t createTemplateGuid;
+    ocrEdtTemplateCreate(&createTemplateGuid, createEdt, 0, 1);
+    u32 i;
+    for (i = 0; i < NB_WORKERS; i++) {
+        ocrGuid_t createGuid;
+        ocrGuid_t outputEvtGuid;
+        ocrEdtCreate(&createGuid, createTemplateGuid, 0, NULL, 1, NULL,
+                     EDT_PROP_NONE, NULL_HINT, &outputEvtGuid);
+        ocrAddDependence(outputEvtGuid, sinkGuid, i, DB_MODE_RO);
+        ocrAddDependence(startEvtGuid, createGuid, 0, DB_MODE_CONST);
+    }
+    ocrEventSatisfy(startEvtGuid, NULL_GUID);
+    ocrEventDestroy(startEvtGuid);
+    ocrEdtTemplateDestroy(createTemplateGuid);
+    ocrEdtTemplateDestroy(sinkTemplateGuid);
+    return NULL_GUID;
+}
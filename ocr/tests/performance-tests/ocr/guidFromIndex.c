@@ -0,0 +1,83 @@
+#include "perfs.h"
+#include "ocr.h"
+#include "extensions/ocr-labeling.h"
+
+// DESC: Converts the NB_INSTANCES indices of a GUID range to GUIDs one call at
+//       a time, then in a single ocrGuidFromIndices call. Same for the labels
+//       of a GUID map with ocrGuidFromLabel and ocrGuidFromLabels.
+// TIME: Duration of each kind of conversion, accumulated over the iterations
+// FREQ: Done 'NB_ITERS' times
+//
+// VARIABLES:
+// - NB_INSTANCES
+// - NB_ITERS
+//
+// Ranges and maps reserve GUIDs: the GUID provider must support it (CFGARG_GUID=LABELED)
+
+static ocrGuid_t mapFunc(ocrGuid_t startGuid, u64 stride, s64* params, s64* tuple) {
+    ocrGuid_t guid = startGuid;
+    guid.guid += tuple[0]*stride;
+    return guid;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t rangeGuid, mapGuid;
+    ocrGuidRangeCreate(&rangeGuid, NB_INSTANCES, GUID_USER_EVENT_STICKY);
+    ocrGuidMapCreate(&mapGuid, 0, mapFunc, NULL, NB_INSTANCES, GUID_USER_EVENT_STICKY);
+    ocrGuid_t * guids;
+    ocrGuid_t guidsGuid;
+    ocrDbCreate(&guidsGuid, (void **) &guids, sizeof(ocrGuid_t) * NB_INSTANCES, DB_PROP_NONE, NULL_HINT, NO_ALLOC);
+    s64 * labels;
+    ocrGuid_t labelsGuid;
+    ocrDbCreate(&labelsGuid, (void **) &labels, sizeof(s64) * NB_INSTANCES, DB_PROP_NONE, NULL_HINT, NO_ALLOC);
+    u64 i;
+    for (i = 0; i < NB_INSTANCES; i++) {
+        labels[i] = i;
+    }
+
+    long indexTimer = 0, indicesTimer = 0, labelTimer = 0, labelsTimer = 0;
+    u8 retval = 0;
+    int it = 0;
+    while (it < NB_ITERS) {
+        timestamp_t start, stop;
+        get_time(&start);
+        for (i = 0; i < NB_INSTANCES; i++) {
+            retval |= ocrGuidFromIndex(&guids[i], rangeGuid, i);
+        }
+        get_time(&stop);
+        indexTimer += elapsed_usec(&start, &stop);
+
+        get_time(&start);
+        retval |= ocrGuidFromIndices(guids, rangeGuid, 0, NB_INSTANCES);
+        get_time(&stop);
+        indicesTimer += elapsed_usec(&start, &stop);
+
+        get_time(&start);
+        for (i = 0; i < NB_INSTANCES; i++) {
+            retval |= ocrGuidFromLabel(&guids[i], mapGuid, &labels[i]);
+        }
+        get_time(&stop);
+        labelTimer += elapsed_usec(&start, &stop);
+
+        get_time(&start);
+        retval |= ocrGuidFromLabels(guids, mapGuid, labels, 1, NB_INSTANCES);
+        get_time(&stop);
+        labelsTimer += elapsed_usec(&start, &stop);
+        it++;
+    }
+    if (retval) {
+        PRINTF("Invalid run! Please check that the GUID provider supports labeling\n");
+    }
+
+    print_throughput("FromIndex", NB_ITERS * NB_INSTANCES, usec_to_sec(indexTimer));
+    print_throughput("FromIndices", NB_ITERS * NB_INSTANCES, usec_to_sec(indicesTimer));
+    print_throughput("FromLabel", NB_ITERS * NB_INSTANCES, usec_to_sec(labelTimer));
+    print_throughput("FromLabels", NB_ITERS * NB_INSTANCES, usec_to_sec(labelsTimer));
+
+    ocrDbDestroy(labelsGuid);
+    ocrDbDestroy(guidsGuid);
+    ocrGuidMapDestroy(mapGuid);
+    ocrGuidMapDestroy(rangeGuid);
+    ocrShutdown();
+    return NULL_GUID;
+}
@@ -0,0 +1,146 @@
+#include "perfs.h"
+#include "ocr.h"
+#include "extensions/ocr-affinity.h"
+
+// DESC: NB_DBS datablocks are created on the last PD. NB_WORKERS * NB_INSTANCES
+//       EDTs on the first PD each depend on one of them in DB_ACCESS_MODE
+//       (DB_MODE_RO by default) and are released together. Stresses the
+//       concurrent lookup and release of proxies for remote datablocks.
+// TIME: From the release of the EDTs to the completion of the last one
+// FREQ: Done once
+//
+// VARIABLES:
+// - NB_DBS
+// - NB_INSTANCES
+// - NB_WORKERS
+// - DB_ACCESS_MODE: DB_MODE_RO, DB_MODE_CONST or DB_MODE_RW
+
+#ifndef NB_DBS
+#define NB_DBS 64
+#endif
+
+#ifndef DB_ACCESS_MODE
+#define DB_ACCESS_MODE DB_MODE_RO
+#endif
+
+#define NB_READERS (NB_WORKERS * NB_INSTANCES)
+
+ocrGuid_t sinkEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    timestamp_t stop;
+    get_time(&stop);
+    ocrGuid_t * dbs = (ocrGuid_t *) depv[1].ptr;
+    timestamp_t * start = (timestamp_t *) depv[2].ptr;
+    print_throughput("Acquire", NB_READERS, usec_to_sec(elapsed_usec(start, &stop)));
+    u32 i;
+    for (i = 0; i < NB_DBS; i++) {
+        ocrDbDestroy(dbs[i]);
+    }
+    ocrDbDestroy(depv[1].guid);
+    ocrDbDestroy(depv[2].guid);
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+ocrGuid_t readerEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    DB_TYPE * data = (DB_TYPE *) depv[1].ptr;
+    // Touch the data so that the acquisition is not optimized away
+    return (data[0] == 0) ? NULL_GUID : NULL_GUID;
+}
+
+ocrGuid_t spawnEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t * dbs = (ocrGuid_t *) depv[1].ptr;
+    ocrGuid_t startEvtGuid;
+    ocrEventCreate(&startEvtGuid, OCR_EVENT_STICKY_T, false);
+    ocrGuid_t readerTemplateGuid;
+    ocrEdtTemplateCreate(&readerTemplateGuid, readerEdt, 0, 2);
+    ocrGuid_t curAffGuid;
+    ocrAffinityGetCurrent(&curAffGuid);
+    ocrHint_t edtHint;
+    ocrHintInit(&edtHint, OCR_HINT_EDT_T);
+    ocrSetHintValue(&edtHint, OCR_HINT_EDT_AFFINITY, ocrAffinityToHintValue(curAffGuid));
+    u32 i;
+    for (i = 0; i < NB_READERS; i++) {
+        ocrGuid_t readerGuid;
+        ocrEdtCreate(&readerGuid, readerTemplateGuid, 0, NULL, 2, NULL,
+                     EDT_PROP_NONE, &edtHint, NULL);
+        ocrAddDependence(dbs[i % NB_DBS], readerGuid, 1, DB_ACCESS_MODE);
+        ocrAddDependence(startEvtGuid, readerGuid, 0, DB_MODE_CONST);
+    }
+    ocrEdtTemplateDestroy(readerTemplateGuid);
+    // The timer starts once every reader is set up and only waits on the start event
+    timestamp_t * start = (timestamp_t *) depv[2].ptr;
+    get_time(start);
+    ocrEventSatisfy(startEvtGuid, NULL_GUID);
+    ocrEventDestroy(startEvtGuid);
+    return NULL_GUID;
+}
+
+// Runs on the last PD: creates the datablocks the readers acquire
+ocrGuid_t remoteSetupEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t * dbs = (ocrGuid_t *) depv[0].ptr;
+    u32 i;
+    for (i = 0; i < NB_DBS; i++) {
+        DB_TYPE * data;
+        ocrDbCreate(&dbs[i], (void **) &data, sizeof(DB_TYPE) * DB_NB_ELT, 0, NULL_HINT, NO_ALLOC);
+        data[0] = 1;
+        ocrDbRelease(dbs[i]);
+    }
+    return NULL_GUID;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t curAffGuid;
+    ocrAffinityGetCurrent(&curAffGuid);
+    u64 affinityCount;
+    ocrAffinityCount(AFFINITY_PD, &affinityCount);
+    ocrGuid_t remoteAffGuid;
+    ocrAffinityGetAt(AFFINITY_PD, affinityCount-1, &remoteAffGuid);
+
+    ocrHint_t dbHint;
+    ocrHintInit(&dbHint, OCR_HINT_DB_T);
+    ocrSetHintValue(&dbHint, OCR_HINT_DB_AFFINITY, ocrAffinityToHintValue(curAffGuid));
+    ocrGuid_t * dbs;
+    ocrGuid_t dbsGuid;
+    ocrDbCreate(&dbsGuid, (void **) &dbs, sizeof(ocrGuid_t) * NB_DBS, 0, &dbHint, NO_ALLOC);
+    ocrDbRelease(dbsGuid);
+    timestamp_t * start;
+    ocrGuid_t timerDbGuid;
+    ocrDbCreate(&timerDbGuid, (void **) &start, sizeof(timestamp_t), 0, &dbHint, NO_ALLOC);
+    ocrDbRelease(timerDbGuid);
+
+    ocrHint_t edtHint;
+    ocrHintInit(&edtHint, OCR_HINT_EDT_T);
+    ocrSetHintValue(&edtHint, OCR_HINT_EDT_AFFINITY, ocrAffinityToHintValue(remoteAffGuid));
+    ocrGuid_t setupTemplateGuid;
+    ocrEdtTemplateCreate(&setupTemplateGuid, remoteSetupEdt, 0, 1);
+    ocrGuid_t setupGuid;
+    ocrGuid_t setupOutputGuid;
+    ocrEdtCreate(&setupGuid, setupTemplateGuid, 0, NULL, 1, NULL,
+                 EDT_PROP_NONE, &edtHint, &setupOutputGuid);
+
+    ocrSetHintValue(&edtHint, OCR_HINT_EDT_AFFINITY, ocrAffinityToHintValue(curAffGuid));
+    ocrGuid_t sinkTemplateGuid;
+    ocrEdtTemplateCreate(&sinkTemplateGuid, sinkEdt, 0, 3);
+    ocrGuid_t sinkGuid;
+    ocrEdtCreate(&sinkGuid, sinkTemplateGuid, 0, NULL, 3, NULL,
+                 EDT_PROP_NONE, &edtHint, NULL);
+
+    // The finish EDT only completes once all the readers are done
+    ocrGuid_t spawnTemplateGuid;
+    ocrEdtTemplateCreate(&spawnTemplateGuid, spawnEdt, 0, 3);
+    ocrGuid_t spawnGuid;
+    ocrGuid_t spawnOutputGuid;
+    ocrEdtCreate(&spawnGuid, spawnTemplateGuid, 0, NULL, 3, NULL,
+                 EDT_PROP_FINISH, &edtHint, &spawnOutputGuid);
+    ocrAddDependence(spawnOutputGuid, sinkGuid, 0, DB_MODE_CONST);
+    ocrAddDependence(dbsGuid, sinkGuid, 1, DB_MODE_RW);
+    ocrAddDependence(timerDbGuid, sinkGuid, 2, DB_MODE_CONST);
+    ocrAddDependence(setupOutputGuid, spawnGuid, 0, DB_MODE_CONST);
+    ocrAddDependence(dbsGuid, spawnGuid, 1, DB_MODE_CONST);
+    ocrAddDependence(timerDbGuid, spawnGuid, 2, DB_MODE_RW);
+    ocrAddDependence(dbsGuid, setupGuid, 0, DB_MODE_RW);
+    ocrEdtTemplateDestroy(setupTemplateGuid);
+    ocrEdtTemplateDestroy(spawnTemplateGuid);
+    ocrEdtTemplateDestroy(sinkTemplateGuid);
+    return NULL_GUID;
+}
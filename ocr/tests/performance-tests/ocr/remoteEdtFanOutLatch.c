@@ -0,0 +1,76 @@
+#include "perfs.h"
+#include "ocr.h"
+#include "extensions/ocr-affinity.h"
+
+// DESC: One EDT creates NB_INSTANCES EDTs round-robin on all the other PDs.
+//       Each remote EDT decrements a latch event co-located with the
+//       creator. Keeps many messages in flight in both directions.
+// TIME: From the first creation to the latch being satisfied
+// FREQ: Create 'NB_INSTANCES' EDTs once
+//
+// VARIABLES:
+// - NB_INSTANCES
+
+static u64 now_usec() {
+    timestamp_t t;
+    get_time(&t);
+    return ((u64) t.tv_sec) * 1000000ULL + t.tv_usec;
+}
+
+ocrGuid_t sinkEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 stop = now_usec();
+    summary_throughput_dbl(((double) (stop - paramv[0])) / 1000000, NB_INSTANCES);
+    ocrShutdown();
+    return NULL_GUID;
+}
+
+ocrGuid_t workEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrGuid_t latchGuid = *((ocrGuid_t *) paramv);
+    ocrEventSatisfySlot(latchGuid, NULL_GUID, OCR_EVENT_LATCH_DECR_SLOT);
+    return NULL_GUID;
+}
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    u64 count = 0;
+    ocrAffinityCount(AFFINITY_PD, &count);
+    ocrGuid_t affinities[count];
+    ocrAffinityGet(AFFINITY_PD, &count, affinities);
+    ocrGuid_t curAffinity;
+    ocrAffinityGetCurrent(&curAffinity);
+
+    ocrGuid_t latchGuid;
+    ocrEventCreate(&latchGuid, OCR_EVENT_LATCH_T, false);
+    u32 i;
+    // One more increment holds the latch until all the EDTs are created
+    for (i = 0; i < (NB_INSTANCES+1); i++) {
+        ocrEventSatisfySlot(latchGuid, NULL_GUID, OCR_EVENT_LATCH_INCR_SLOT);
+    }
+
+    u64 start = now_usec();
+    ocrGuid_t sinkTemplateGuid;
+    ocrEdtTemplateCreate(&sinkTemplateGuid, sinkEdt, 1, 1);
+    ocrGuid_t sinkGuid;
+    ocrEdtCreate(&sinkGuid, sinkTemplateGuid, 1, &start, 1, &latchGuid,
+                 EDT_PROP_NONE, NULL_HINT, NULL);
+
+    ocrGuid_t workTemplateGuid;
+    ocrEdtTemplateCreate(&workTemplateGuid, workEdt, 1, 0);
+    ocrHint_t edtHint;
+    ocrHintInit(&edtHint, OCR_HINT_EDT_T);
+    u64 k = 0;
+    for (i = 0; i < NB_INSTANCES; i++) {
+        // Skip the current PD unless it is the only one
+        if ((count > 1) && ocrGuidIsEq(affinities[k], curAffinity)) {
+            k = (k + 1) % count;
+        }
+        ocrSetHintValue(&edtHint, OCR_HINT_EDT_AFFINITY, ocrAffinityToHintValue(affinities[k]));
+        k = (k + 1) % count;
+        ocrGuid_t workGuid;
+        ocrEdtCreate(&workGuid, workTemplateGuid, 1, (u64 *) &latchGuid, 0, NULL,
+                     EDT_PROP_NONE, &edtHint, NULL);
+    }
+    ocrEventSatisfySlot(latchGuid, NULL_GUID, OCR_EVENT_LATCH_DECR_SLOT);
+    ocrEdtTemplateDestroy(workTemplateGuid);
+    ocrEdtTemplateDestroy(sinkTemplateGuid);
+    return NULL_GUID;
+}
@@ -0,0 +1,16 @@
+#include "perfs.h"
+#include "ocr.h"
+
+// DESC: Empty application; measures the cost of bringing the runtime up and down
+// TIME: From mainEdt's start to process exit, measured outside of the program.
+//       Build OCR with OCR_STARTUP_TIMINGS for the breakdown per runlevel.
+// FREQ: Done once per process
+//
+// VARIABLES:
+// None. Compare configurations by passing either an INI configuration or
+// its binary plan (see -ocr:cfgcompile) with -ocr:cfg
+
+ocrGuid_t mainEdt(u32 paramc, u64* paramv, u32 depc, ocrEdtDep_t depv[]) {
+    ocrShutdown();
+    return NULL_GUID;
+}